@@ -45,8 +45,41 @@ typedef struct EbAV1FrameInfo {
 
     /* Frame presentation time */
     uint64_t frame_presentation_time;
+
+    /* Luma area of the returned picture that matches a full decode when a
+     * region of interest is set with svt_av1_dec_set_roi(). Covers the whole
+     * picture otherwise. */
+    uint32_t roi_x;
+    uint32_t roi_y;
+    uint32_t roi_width;
+    uint32_t roi_height;
+
+    /* Set when blocks of that area were predicted from parts of a reference
+     * picture outside its own exact area, or from a reference picture that
+     * had this flag set. The area may then differ from a full decode. The
+     * check is conservative: warped and scaled prediction from a partially
+     * reconstructed reference always set it, and once set it is inherited by
+     * every picture referencing the flagged one, so it usually stays set
+     * until the next intra frame. When clear, the area matches a full decode
+     * exactly. */
+    EbBool roi_ref_missing;
 } EbAV1FrameInfo;
 
+/* Region of interest of the decoded pictures, in luma samples. */
+typedef struct EbSvtAv1DecRoi {
+    uint32_t x;
+    uint32_t y;
+    /* A width or height of 0 reconstructs the whole picture */
+    uint32_t width;
+    uint32_t height;
+    /* Extra margin around the region reconstructed in pictures used as
+     * reference. This is a heuristic, the decoder does not know the motion of
+     * the following frames when a reference is reconstructed: the margin
+     * should cover the largest motion into the region plus the 8-tap filter
+     * reach, otherwise those frames report roi_ref_missing. */
+    uint32_t ref_margin;
+} EbSvtAv1DecRoi;
+
 typedef struct EbSvtAv1DecConfiguration {
     /* Bitstream operating point to decode.
      *
@@ -86,7 +119,8 @@ typedef struct EbSvtAv1DecConfiguration {
     uint32_t compressed_ten_bit_format; //remove?
 
     /* Outputs 8-bit pictures even if the bitstream has higher bit depth.
-     * Ignored if the bitstream is 8-bit
+     * Ignored if the bitstream is 8-bit, and with external frame buffers, which
+     * return the pictures as decoded.
      *
      * Default is 0. */
 
@@ -107,7 +141,10 @@ typedef struct EbSvtAv1DecConfiguration {
     uint32_t threads;
 
     /* Number of frames that can be processed
-       in parallel. Default is 1 */
+       in parallel. Default is 1, multi frame
+       parallelism is not supported yet and
+       other values are set to 1 with a
+       warning */
     uint32_t num_p_frames;
 
     // Application Specific parameters
@@ -122,6 +159,44 @@ typedef struct EbSvtAv1DecConfiguration {
  *
  * Default is 0. */
     EbBool is_16bit_pipeline;
+
+    /* External frame buffer callbacks. When both are set, the memory of the
+     * reference and output pictures is obtained through get_frame_buffer and
+     * handed back through release_frame_buffer once the decoder and the
+     * application no longer reference it. svt_av1_dec_get_picture() then
+     * returns the decoded picture by reference instead of copying it; such a
+     * picture stays valid until svt_av1_dec_release_picture() is called. At
+     * most 4 pictures can be held at a time: svt_av1_dec_get_picture() returns
+     * EB_ErrorInsufficientResources while 4 are held and keeps the picture for
+     * a later call; svt_av1_dec_frame() then returns
+     * EB_ErrorInsufficientResources, without consuming data, until that
+     * picture has been obtained. Pictures still held, including those of a
+     * previous sequence geometry, are released by svt_av1_dec_deinit(). A
+     * picture buffer that cannot be obtained fails svt_av1_dec_frame() with
+     * EB_ErrorInsufficientResources. Ignored when is_16bit_pipeline is set.
+     *
+     * Default is NULL. */
+    EbAllocateFrameBuffer get_frame_buffer;
+    EbReleaseFrameBuffer  release_frame_buffer;
+    /* Passed back to the frame buffer callbacks. */
+    void *frame_buffer_priv;
+
+    /* Outputs 10-bit pictures (samples shifted up by 2) when the bitstream is
+     * 8-bit. Ignored if eight_bit_output is set or the bitstream is not 8-bit,
+     * and with external frame buffers. Film grain, when applied, is synthesized
+     * at the coded bit depth before the conversion.
+     *
+     * Default is 0. */
+    EbBool ten_bit_output;
+
+    /* Outputs 4:2:0 pictures with the Cb and Cr samples interleaved in the cb
+     * plane: NV12 for 8-bit output, P010 (16-bit samples, MSB aligned, luma
+     * included) otherwise. cb_stride then counts the samples of the
+     * interleaved plane and cr is NULL. Ignored for other chroma formats and
+     * with external frame buffers.
+     *
+     * Default is 0. */
+    EbBool nv12_output;
 } EbSvtAv1DecConfiguration;
 
 /* STEP 1: Call the library to construct a Component Handle.
@@ -182,6 +257,30 @@ EB_API EbErrorType svt_av1_dec_get_picture(EbComponentType *   svt_dec_component
                                           EbBufferHeaderType *p_buffer,
                                           EbAV1StreamInfo *stream_info, EbAV1FrameInfo *frame_info);
 
+/* Return a picture obtained by reference from svt_av1_dec_get_picture()
+     * when external frame buffers are in use. Its planes must not be accessed
+     * afterwards.
+     *
+     * Parameter:
+     * @ *svt_dec_component     Decoder handle.
+     * @ *p_buffer              Header pointer filled by svt_av1_dec_get_picture(). */
+EB_API EbErrorType svt_av1_dec_release_picture(EbComponentType *   svt_dec_component,
+                                              EbBufferHeaderType *p_buffer);
+
+/* Restrict the reconstruction to the tiles covering a region of interest,
+     * applies from the next decoded frame on. The whole bitstream is still
+     * parsed, only the selected tiles are reconstructed and loop filtered.
+     * Samples outside the selected tiles are undefined and a border of a few
+     * samples inside them may differ from a full decode, frame_info of
+     * svt_av1_dec_get_picture() reports the exact area. Frames using superres
+     * are always fully reconstructed.
+     *
+     * Parameter:
+     * @ *svt_dec_component     Decoder handle.
+     * @ *roi                   Region, NULL reconstructs the whole picture. */
+EB_API EbErrorType svt_av1_dec_set_roi(EbComponentType *     svt_dec_component,
+                                      const EbSvtAv1DecRoi *roi);
+
 /* STEP 6: Deinitialize decoder library.
      *
      * Parameter:
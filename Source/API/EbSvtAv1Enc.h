@@ -29,8 +29,20 @@ extern "C" {
     0x00000002 // signals that the packet contains a show existing frame at the end
 #define EB_BUFFERFLAG_HAS_TD 0x00000004 // signals that the packet contains a TD
 #define EB_BUFFERFLAG_IS_ALT_REF 0x00000008 // signals that the packet contains an ALT_REF frame
+#define EB_BUFFERFLAG_APP_BUFFER \
+    0x00000010 // signals that p_buffer was allocated through output_buffer_alloc and is owned by the application
 #define EB_BUFFERFLAG_ERROR_MASK \
-    0xFFFFFFF0 // mask for signalling error assuming top flags fit in 4 bits. To be changed, if more flags are added.
+    0xFFFFFFE0 // mask for signalling error assuming top flags fit in 5 bits. To be changed, if more flags are added.
+
+/* Callback function to allocate an output packet buffer.
+ *
+ * This function is called by the encoder to get the p_buffer of an
+ * output packet, which the frame OBUs are then written into.
+ * Parameters:
+ * @  size  requested buffer size in bytes.
+ * @  private_data is the private data that can be used by the allocator
+ * Returns the buffer, or NULL to fall back to the encoder's own allocation. */
+typedef uint8_t *(*EbAllocateOutputBuffer)(uint32_t size, void *private_data);
 
 /************************************************
  * Prediction Structure Config Entry
@@ -187,7 +199,8 @@ typedef struct EbSvtAv1EncConfiguration {
     * Default is 4. */
     uint32_t partition_depth;
 
-    /* Instruct the library to calculate the recon to source for PSNR calculation
+    /* Instruct the library to calculate the recon to source for PSNR calculation,
+    * 2 also logs the mode decision candidate class statistics
     *
     * Default is 0.*/
     uint32_t stat_report;
@@ -650,6 +663,13 @@ typedef struct EbSvtAv1EncConfiguration {
    *
    * Default is 0. */
   int32_t manual_pred_struct_entry_num;
+  /* Allocator for the output packet buffers. Packets whose buffer comes from
+   * it are flagged with EB_BUFFERFLAG_APP_BUFFER, and
+   * svt_av1_enc_release_out_buffer() then leaves the buffer to the application.
+   *
+   * Default is NULL (the encoder allocates the packets). */
+  EbAllocateOutputBuffer output_buffer_alloc;
+  void *                 output_buffer_private_data;
 } EbSvtAv1EncConfiguration;
 
 /* STEP 1: Call the library to construct a Component Handle.
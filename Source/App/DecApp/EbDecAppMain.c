@@ -96,16 +96,20 @@ void write_frame(EbBufferHeaderType *recon_buffer, CliInput *cli) {
         }
         assert(img->color_fmt <= EB_YUV444);
 
+        /* NV12 / P010 : Cb and Cr interleaved in the cb plane */
+        if (img->cr == NULL) w <<= 1;
         for (y = 0; y < h; ++y) {
             fwrite(buf, bytes_per_sample, w, cli->out_file);
             buf += (stride * bytes_per_sample);
         }
 
-        buf    = img->cr;
-        stride = img->cr_stride;
-        for (y = 0; y < h; ++y) {
-            fwrite(buf, bytes_per_sample, w, cli->out_file);
-            buf += (stride * bytes_per_sample);
+        if (img->cr != NULL) {
+            buf    = img->cr;
+            stride = img->cr_stride;
+            for (y = 0; y < h; ++y) {
+                fwrite(buf, bytes_per_sample, w, cli->out_file);
+                buf += (stride * bytes_per_sample);
+            }
         }
     }
 
@@ -59,6 +59,15 @@ static void set_num_pframes(const char *value, EbSvtAv1DecConfiguration *cfg) {
         cfg->num_p_frames = 1;
     }
 };
+static void set_eight_bit_output(const char *value, EbSvtAv1DecConfiguration *cfg) {
+    cfg->eight_bit_output = (EbBool)strtoul(value, NULL, 0);
+};
+static void set_ten_bit_output(const char *value, EbSvtAv1DecConfiguration *cfg) {
+    cfg->ten_bit_output = (EbBool)strtoul(value, NULL, 0);
+};
+static void set_nv12_output(const char *value, EbSvtAv1DecConfiguration *cfg) {
+    cfg->nv12_output = (EbBool)strtoul(value, NULL, 0);
+};
 
 /**********************************
   * Config Entry Array
@@ -75,6 +84,10 @@ ConfigEntry config_entry[] = {
     {COLOUR_SPACE_TOKEN, "InputColourSpace", 1, set_colour_space},
     {THREADS_TOKEN, "ThreadCount", 1, set_num_thread},
     {FRAME_PLL_TOKEN, "PllFrameCount", 1, set_num_pframes},
+    // Output format
+    {EIGHT_BIT_OUTPUT_TOKEN, "EightBitOutput", 0, set_eight_bit_output},
+    {TEN_BIT_OUTPUT_TOKEN, "TenBitOutput", 0, set_ten_bit_output},
+    {NV12_OUTPUT_TOKEN, "Nv12Output", 0, set_nv12_output},
     // Termination
     {NULL, NULL, 0, NULL}};
 
@@ -97,6 +110,9 @@ static void show_help() {
     H0( " -fps-summary              Show fps summary");
     H0( " -skip-film-grain          Disable Film Grain");
     H0( " -16bit-pipeline           Enable 16b pipeline. [1 - enable, 0 - disable]");
+    H0( " -eight-bit-output         Output 8-bit pictures for 10-bit streams");
+    H0( " -ten-bit-output           Output 10-bit pictures for 8-bit streams");
+    H0( " -nv12                     Output 4:2:0 as NV12, or P010 above 8-bit");
 
     exit(1);
 }
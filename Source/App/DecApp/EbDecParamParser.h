@@ -45,6 +45,9 @@
 #define FPS_SUMMARY_TOKEN "-fps-summary"
 #define FILM_GRAIN_TOKEN "-skip-film-grain"
 #define ANNEX_B_TOKEN "-annex-b"
+#define EIGHT_BIT_OUTPUT_TOKEN "-eight-bit-output"
+#define TEN_BIT_OUTPUT_TOKEN "-ten-bit-output"
+#define NV12_OUTPUT_TOKEN "-nv12"
 #define MAX_NUM_TOKENS 200
 
 #define EB_STRCMP(target, token) strcmp(target, token)
@@ -269,17 +269,17 @@ void write_md5(EbBufferHeaderType *recon_buffer, Md5Context *md5) {
 
         stride = img->cb_stride;
 
-        //cb MD5 generation
+        //cb MD5 generation, NV12 / P010 hold Cb and Cr interleaved in the cb plane
         buf = img->cb;
         for (y = 0; y < h; ++y) {
-            md5_update(md5, buf, w * bytes_per_sample);
+            md5_update(md5, buf, (img->cr == NULL ? 2 * w : w) * bytes_per_sample);
             buf += (stride * bytes_per_sample);
         }
 
         //cr MD5 generation
         buf    = img->cr;
         stride = img->cr_stride;
-        for (y = 0; y < h; ++y) {
+        for (y = 0; buf != NULL && y < h; ++y) {
             md5_update(md5, buf, w * bytes_per_sample);
             buf += (stride * bytes_per_sample);
         }
@@ -0,0 +1,516 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <immintrin.h>
+#include "EbDefinitions.h"
+#include "common_dsp_rtcd.h"
+#include "synonyms.h"
+#include "synonyms_avx2.h"
+#include "transpose_sse2.h"
+
+#if DLF_DUAL_EDGE_AVX2
+/*
+ * High bit depth deblocking of two adjacent 4-sample edges.
+ *
+ * Every 256-bit vector pq[i] holds tap i of both sides of the edge: the 8 p_i
+ * samples in the low 128-bit lane and the 8 q_i samples in the high lane.
+ * Samples 0..3 of a lane belong to the first edge and 4..7 to the second.
+ * The filter taps are mirror images of each other across the edge, so with
+ * the lane swapped vector qp[i] every output pair op_k / oq_k is computed by
+ * a single expression.
+ */
+
+static INLINE __m256i swap_pq(const __m256i pq) { return _mm256_permute4x64_epi64(pq, 0x4e); }
+
+static INLINE __m256i abs_diff_16(const __m256i a, const __m256i b) {
+    return _mm256_abs_epi16(_mm256_sub_epi16(a, b));
+}
+
+// Broadcast the thresholds of edge 0 to samples 0..3 and edge 1 to 4..7.
+static INLINE __m256i dual_thresh(const uint8_t *t0, const uint8_t *t1, int32_t shift) {
+    const __m128i t = _mm_unpacklo_epi64(_mm_set1_epi16((int16_t)(*t0 << shift)),
+                                         _mm_set1_epi16((int16_t)(*t1 << shift)));
+    return yy_set_m128i(t, t);
+}
+
+// All ones where max(|pq[i] - pq[ref(i)]|) of both sides is <= th.
+static INLINE __m256i max_below(__m256i max, const __m256i th) {
+    max = _mm256_max_epi16(max, swap_pq(max));
+    return _mm256_cmpeq_epi16(_mm256_subs_epu16(max, th), _mm256_setzero_si256());
+}
+
+static INLINE __m256i filter_mask_dual(const __m256i *pq, const __m256i *qp, int32_t taps,
+                                       const __m256i limit, const __m256i blimit) {
+    __m256i max = abs_diff_16(pq[1], pq[0]);
+    for (int32_t i = 2; i < taps; i++) max = _mm256_max_epi16(max, abs_diff_16(pq[i], pq[i - 1]));
+
+    const __m256i edge = _mm256_add_epi16(_mm256_slli_epi16(abs_diff_16(pq[0], qp[0]), 1),
+                                          _mm256_srli_epi16(abs_diff_16(pq[1], qp[1]), 1));
+    const __m256i edge_ok =
+        _mm256_cmpeq_epi16(_mm256_subs_epu16(edge, blimit), _mm256_setzero_si256());
+    return _mm256_and_si256(max_below(max, limit), edge_ok);
+}
+
+static INLINE __m256i flat_mask_dual(const __m256i *pq, int32_t start, int32_t end,
+                                     const __m256i th) {
+    __m256i max = abs_diff_16(pq[start], pq[0]);
+    for (int32_t i = start + 1; i < end; i++) max = _mm256_max_epi16(max, abs_diff_16(pq[i], pq[0]));
+    return max_below(max, th);
+}
+
+static INLINE __m256i clamp_16(const __m256i x, const __m256i min, const __m256i max) {
+    return _mm256_max_epi16(_mm256_min_epi16(x, max), min);
+}
+
+// 4-tap filter: op0/oq0 in out[0] and op1/oq1 in out[1].
+static INLINE void filter4_dual(const __m256i *pq, const __m256i *qp, const __m256i mask,
+                                const __m256i hev, int32_t bd, __m256i *out) {
+    const int16_t t80v = (int16_t)(0x80 << (bd - 8));
+    const __m256i t80  = _mm256_set1_epi16(t80v);
+    const __m256i pmax = _mm256_set1_epi16(t80v - 1);
+    const __m256i pmin = _mm256_set1_epi16(-t80v);
+    // The p side adds the filter and the q side subtracts it
+    const __m256i sign = _mm256_setr_epi16(1, 1, 1, 1, 1, 1, 1, 1, -1, -1, -1, -1, -1, -1, -1, -1);
+    // filter2 = (filter + 3) >> 3 for the p side, filter1 = (filter + 4) >> 3 for the q side
+    const __m256i t3t4 = _mm256_setr_epi16(3, 3, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4);
+
+    // The filter value is computed in the p lane, then broadcast to both lanes
+    __m256i       filt = _mm256_and_si256(clamp_16(_mm256_sub_epi16(pq[1], qp[1]), pmin, pmax), hev);
+    const __m256i diff = _mm256_sub_epi16(qp[0], pq[0]);
+    filt = _mm256_add_epi16(filt, _mm256_add_epi16(diff, _mm256_add_epi16(diff, diff)));
+    filt = _mm256_and_si256(clamp_16(filt, pmin, pmax), mask);
+    filt = _mm256_permute4x64_epi64(filt, 0x44);
+
+    const __m256i filt12 = _mm256_srai_epi16(clamp_16(_mm256_add_epi16(filt, t3t4), pmin, pmax), 3);
+    const __m256i ps0    = _mm256_sub_epi16(pq[0], t80);
+    out[0] = _mm256_add_epi16(
+        clamp_16(_mm256_add_epi16(ps0, _mm256_sign_epi16(filt12, sign)), pmin, pmax), t80);
+
+    // Outer taps use ROUND_POWER_OF_TWO(filter1, 1) when there is no high edge variance
+    __m256i filt1 = _mm256_permute4x64_epi64(filt12, 0xee);
+    filt1 = _mm256_srai_epi16(_mm256_add_epi16(filt1, _mm256_set1_epi16(1)), 1);
+    filt1 = _mm256_andnot_si256(hev, filt1);
+    const __m256i ps1 = _mm256_sub_epi16(pq[1], t80);
+    out[1] = _mm256_add_epi16(
+        clamp_16(_mm256_add_epi16(ps1, _mm256_sign_epi16(filt1, sign)), pmin, pmax), t80);
+}
+
+// 5-tap filter [1, 2, 2, 2, 1]: out[0..1]
+static INLINE void filter6_dual(const __m256i *pq, const __m256i *qp, __m256i *out) {
+    // op0 = p2 + 2 * p1 + 2 * p0 + 2 * q0 + q1
+    __m256i sum = _mm256_add_epi16(_mm256_add_epi16(pq[1], pq[0]), qp[0]);
+    sum = _mm256_add_epi16(_mm256_add_epi16(sum, sum), _mm256_add_epi16(pq[2], qp[1]));
+    sum = _mm256_add_epi16(sum, _mm256_set1_epi16(4));
+    out[0] = _mm256_srli_epi16(sum, 3);
+    // op1 = 3 * p2 + 2 * p1 + 2 * p0 + q0
+    sum = _mm256_add_epi16(sum, _mm256_add_epi16(pq[2], pq[2]));
+    sum = _mm256_sub_epi16(sum, _mm256_add_epi16(qp[0], qp[1]));
+    out[1] = _mm256_srli_epi16(sum, 3);
+}
+
+// 7-tap filter [1, 1, 1, 2, 1, 1, 1]: out[0..2]
+static INLINE void filter8_dual(const __m256i *pq, const __m256i *qp, __m256i *out) {
+    // op0 = p3 + p2 + p1 + 2 * p0 + q0 + q1 + q2
+    __m256i sum = _mm256_add_epi16(_mm256_add_epi16(pq[3], pq[2]), _mm256_add_epi16(pq[1], pq[0]));
+    sum = _mm256_add_epi16(sum, _mm256_add_epi16(pq[0], qp[0]));
+    sum = _mm256_add_epi16(sum, _mm256_add_epi16(qp[1], qp[2]));
+    sum = _mm256_add_epi16(sum, _mm256_set1_epi16(4));
+    out[0] = _mm256_srli_epi16(sum, 3);
+    // op1 = op0 + p3 + p1 - p0 - q2
+    sum = _mm256_add_epi16(sum, _mm256_add_epi16(pq[3], pq[1]));
+    sum = _mm256_sub_epi16(sum, _mm256_add_epi16(pq[0], qp[2]));
+    out[1] = _mm256_srli_epi16(sum, 3);
+    // op2 = op1 + p3 + p2 - p1 - q1
+    sum = _mm256_add_epi16(sum, _mm256_add_epi16(pq[3], pq[2]));
+    sum = _mm256_sub_epi16(sum, _mm256_add_epi16(pq[1], qp[1]));
+    out[2] = _mm256_srli_epi16(sum, 3);
+}
+
+// 13-tap filter [1, 1, 1, 1, 1, 2, 2, 2, 1, 1, 1, 1, 1]: out[0..5]. The sums
+// reach 16 * 4095 at 12 bit, which still fits the unsigned 16-bit lanes.
+static INLINE void filter14_dual(const __m256i *pq, const __m256i *qp, __m256i *out) {
+    // op0 = p6 + p5 + p4 + p3 + p2 + 2 * (p1 + p0 + q0) + q1 + q2 + q3 + q4 + q5
+    __m256i sum = _mm256_add_epi16(_mm256_add_epi16(pq[1], pq[0]), qp[0]);
+    sum = _mm256_add_epi16(sum, sum);
+    sum = _mm256_add_epi16(sum, _mm256_add_epi16(_mm256_add_epi16(pq[6], pq[5]),
+                                                 _mm256_add_epi16(pq[4], pq[3])));
+    sum = _mm256_add_epi16(sum, _mm256_add_epi16(_mm256_add_epi16(pq[2], qp[1]),
+                                                 _mm256_add_epi16(qp[2], qp[3])));
+    sum = _mm256_add_epi16(sum, _mm256_add_epi16(_mm256_add_epi16(qp[4], qp[5]),
+                                                 _mm256_set1_epi16(8)));
+    out[0] = _mm256_srli_epi16(sum, 4);
+    // op(k) = op(k - 1) + p6 + p(k + 1) - p(k - 2) - q(6 - k), with p(-1) = q0
+    for (int32_t k = 1; k < 5; k++) {
+        sum = _mm256_add_epi16(sum, _mm256_add_epi16(pq[6], pq[k + 1]));
+        sum = _mm256_sub_epi16(sum, _mm256_add_epi16(k == 1 ? qp[0] : pq[k - 2], qp[6 - k]));
+        out[k] = _mm256_srli_epi16(sum, 4);
+    }
+    // op5 = op4 + 2 * p6 - p3 - q1
+    sum = _mm256_add_epi16(sum, _mm256_add_epi16(pq[6], pq[6]));
+    sum = _mm256_sub_epi16(sum, _mm256_add_epi16(pq[3], qp[1]));
+    out[5] = _mm256_srli_epi16(sum, 4);
+}
+
+// Filters pq[] in place. Returns 0 when no sample of either edge is modified.
+static AOM_FORCE_INLINE int32_t highbd_lpf_dual_avx2(__m256i *pq, int32_t taps,
+                                                     const uint8_t *blimit0, const uint8_t *limit0,
+                                                     const uint8_t *thresh0, const uint8_t *blimit1,
+                                                     const uint8_t *limit1, const uint8_t *thresh1,
+                                                     int32_t bd) {
+    const int32_t shift   = bd - 8;
+    const int32_t n_mask  = taps == 4 ? 2 : taps == 6 ? 3 : 4;
+    const int32_t n_input = taps == 14 ? 7 : n_mask;
+    __m256i       qp[7];
+    for (int32_t i = 0; i < n_input; i++) qp[i] = swap_pq(pq[i]);
+
+    const __m256i mask = filter_mask_dual(pq,
+                                          qp,
+                                          n_mask,
+                                          dual_thresh(limit0, limit1, shift),
+                                          dual_thresh(blimit0, blimit1, shift));
+    if (_mm256_testz_si256(mask, mask)) return 0;
+
+    const __m256i hev = _mm256_xor_si256(
+        max_below(abs_diff_16(pq[1], pq[0]), dual_thresh(thresh0, thresh1, shift)),
+        _mm256_set1_epi16(-1));
+    __m256i out[6];
+    filter4_dual(pq, qp, mask, hev, bd, out);
+    if (taps == 4) {
+        pq[0] = out[0];
+        pq[1] = out[1];
+        return 1;
+    }
+
+    const __m256i flat_th = _mm256_set1_epi16((int16_t)(1 << shift));
+    const __m256i flat    = _mm256_and_si256(flat_mask_dual(pq, 1, n_mask, flat_th), mask);
+    __m256i       flat_out[6];
+    if (taps == 6) {
+        if (!_mm256_testz_si256(flat, flat)) {
+            filter6_dual(pq, qp, flat_out);
+            out[0] = _mm256_blendv_epi8(out[0], flat_out[0], flat);
+            out[1] = _mm256_blendv_epi8(out[1], flat_out[1], flat);
+        }
+        pq[0] = out[0];
+        pq[1] = out[1];
+        return 1;
+    }
+
+    out[2] = pq[2];
+    if (!_mm256_testz_si256(flat, flat)) {
+        filter8_dual(pq, qp, flat_out);
+        for (int32_t i = 0; i < 3; i++) out[i] = _mm256_blendv_epi8(out[i], flat_out[i], flat);
+
+        if (taps == 14) {
+            const __m256i flat2 = _mm256_and_si256(flat_mask_dual(pq, 4, 7, flat_th), flat);
+            if (!_mm256_testz_si256(flat2, flat2)) {
+                out[3] = pq[3];
+                out[4] = pq[4];
+                out[5] = pq[5];
+                filter14_dual(pq, qp, flat_out);
+                for (int32_t i = 0; i < 6; i++)
+                    out[i] = _mm256_blendv_epi8(out[i], flat_out[i], flat2);
+                for (int32_t i = 3; i < 6; i++) pq[i] = out[i];
+            }
+        }
+    }
+    for (int32_t i = 0; i < 3; i++) pq[i] = out[i];
+    return 1;
+}
+
+static AOM_FORCE_INLINE void highbd_lpf_horizontal_dual_avx2(
+    uint16_t *s, int32_t pitch, int32_t taps, const uint8_t *blimit0, const uint8_t *limit0,
+    const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1,
+    const uint8_t *thresh1, int32_t bd) {
+    const int32_t n_input  = taps == 14 ? 7 : taps == 8 ? 4 : taps == 6 ? 3 : 2;
+    const int32_t n_output = taps == 14 ? 6 : taps == 8 ? 3 : 2;
+    __m256i       pq[7];
+
+    for (int32_t i = 0; i < n_input; i++) pq[i] = yy_loadu2_128(s + i * pitch, s - (i + 1) * pitch);
+
+    if (!highbd_lpf_dual_avx2(pq, taps, blimit0, limit0, thresh0, blimit1, limit1, thresh1, bd))
+        return;
+
+    for (int32_t i = 0; i < n_output; i++) yy_storeu2_128(s + i * pitch, s - (i + 1) * pitch, pq[i]);
+}
+
+// 4, 6 and 8 taps: 8 rows of p3..q3 are transposed so that x[3 - i] holds
+// the p_i column and x[4 + i] the q_i column.
+static AOM_FORCE_INLINE void highbd_lpf_vertical_dual_avx2(
+    uint16_t *s, int32_t pitch, int32_t taps, const uint8_t *blimit0, const uint8_t *limit0,
+    const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1,
+    const uint8_t *thresh1, int32_t bd) {
+    const int32_t n_input  = taps == 8 ? 4 : taps == 6 ? 3 : 2;
+    const int32_t n_output = taps == 8 ? 3 : 2;
+    __m128i       x[8];
+    __m256i       pq[4];
+    int32_t       i;
+
+    for (i = 0; i < 8; i++) x[i] = _mm_loadu_si128((const __m128i *)(s - 4 + i * pitch));
+    transpose_16bit_8x8(x, x);
+    for (i = 0; i < n_input; i++) pq[i] = yy_set_m128i(x[4 + i], x[3 - i]);
+
+    if (!highbd_lpf_dual_avx2(pq, taps, blimit0, limit0, thresh0, blimit1, limit1, thresh1, bd))
+        return;
+
+    for (i = 0; i < n_output; i++) {
+        x[3 - i] = _mm256_castsi256_si128(pq[i]);
+        x[4 + i] = _mm256_extracti128_si256(pq[i], 1);
+    }
+    transpose_16bit_8x8(x, x);
+
+    // Only write back the modified columns: p1..q1, or p2..q2 for 8 taps
+    for (i = 0; i < 8; i++) {
+        if (taps == 8) {
+            _mm_storel_epi64((__m128i *)(s - 3 + i * pitch), _mm_srli_si128(x[i], 2));
+            _mm_storel_epi64((__m128i *)(s - 1 + i * pitch), _mm_srli_si128(x[i], 6));
+        } else
+            _mm_storel_epi64((__m128i *)(s - 2 + i * pitch), _mm_srli_si128(x[i], 4));
+    }
+}
+
+void aom_highbd_lpf_horizontal_4_dual_avx2(uint16_t *s, int32_t pitch, const uint8_t *blimit0,
+                                           const uint8_t *limit0, const uint8_t *thresh0,
+                                           const uint8_t *blimit1, const uint8_t *limit1,
+                                           const uint8_t *thresh1, int32_t bd) {
+    highbd_lpf_horizontal_dual_avx2(
+        s, pitch, 4, blimit0, limit0, thresh0, blimit1, limit1, thresh1, bd);
+}
+
+void aom_highbd_lpf_horizontal_6_dual_avx2(uint16_t *s, int32_t pitch, const uint8_t *blimit0,
+                                           const uint8_t *limit0, const uint8_t *thresh0,
+                                           const uint8_t *blimit1, const uint8_t *limit1,
+                                           const uint8_t *thresh1, int32_t bd) {
+    highbd_lpf_horizontal_dual_avx2(
+        s, pitch, 6, blimit0, limit0, thresh0, blimit1, limit1, thresh1, bd);
+}
+
+void aom_highbd_lpf_horizontal_8_dual_avx2(uint16_t *s, int32_t pitch, const uint8_t *blimit0,
+                                           const uint8_t *limit0, const uint8_t *thresh0,
+                                           const uint8_t *blimit1, const uint8_t *limit1,
+                                           const uint8_t *thresh1, int32_t bd) {
+    highbd_lpf_horizontal_dual_avx2(
+        s, pitch, 8, blimit0, limit0, thresh0, blimit1, limit1, thresh1, bd);
+}
+
+void aom_highbd_lpf_horizontal_14_dual_avx2(uint16_t *s, int32_t pitch, const uint8_t *blimit0,
+                                            const uint8_t *limit0, const uint8_t *thresh0,
+                                            const uint8_t *blimit1, const uint8_t *limit1,
+                                            const uint8_t *thresh1, int32_t bd) {
+    highbd_lpf_horizontal_dual_avx2(
+        s, pitch, 14, blimit0, limit0, thresh0, blimit1, limit1, thresh1, bd);
+}
+
+void aom_highbd_lpf_vertical_4_dual_avx2(uint16_t *s, int32_t pitch, const uint8_t *blimit0,
+                                         const uint8_t *limit0, const uint8_t *thresh0,
+                                         const uint8_t *blimit1, const uint8_t *limit1,
+                                         const uint8_t *thresh1, int32_t bd) {
+    highbd_lpf_vertical_dual_avx2(
+        s, pitch, 4, blimit0, limit0, thresh0, blimit1, limit1, thresh1, bd);
+}
+
+void aom_highbd_lpf_vertical_6_dual_avx2(uint16_t *s, int32_t pitch, const uint8_t *blimit0,
+                                         const uint8_t *limit0, const uint8_t *thresh0,
+                                         const uint8_t *blimit1, const uint8_t *limit1,
+                                         const uint8_t *thresh1, int32_t bd) {
+    highbd_lpf_vertical_dual_avx2(
+        s, pitch, 6, blimit0, limit0, thresh0, blimit1, limit1, thresh1, bd);
+}
+
+void aom_highbd_lpf_vertical_8_dual_avx2(uint16_t *s, int32_t pitch, const uint8_t *blimit0,
+                                         const uint8_t *limit0, const uint8_t *thresh0,
+                                         const uint8_t *blimit1, const uint8_t *limit1,
+                                         const uint8_t *thresh1, int32_t bd) {
+    highbd_lpf_vertical_dual_avx2(
+        s, pitch, 8, blimit0, limit0, thresh0, blimit1, limit1, thresh1, bd);
+}
+
+// 14 taps: rows are split into p7..p0 (x[7 - i] holds p_i after the
+// transpose) and q0..q7 (y[i] holds q_i).
+void aom_highbd_lpf_vertical_14_dual_avx2(uint16_t *s, int32_t pitch, const uint8_t *blimit0,
+                                          const uint8_t *limit0, const uint8_t *thresh0,
+                                          const uint8_t *blimit1, const uint8_t *limit1,
+                                          const uint8_t *thresh1, int32_t bd) {
+    __m128i x[8], y[8];
+    __m256i pq[7];
+    int32_t i;
+
+    for (i = 0; i < 8; i++) {
+        x[i] = _mm_loadu_si128((const __m128i *)(s - 8 + i * pitch));
+        y[i] = _mm_loadu_si128((const __m128i *)(s + i * pitch));
+    }
+    transpose_16bit_8x8(x, x);
+    transpose_16bit_8x8(y, y);
+    for (i = 0; i < 7; i++) pq[i] = yy_set_m128i(y[i], x[7 - i]);
+
+    if (!highbd_lpf_dual_avx2(pq, 14, blimit0, limit0, thresh0, blimit1, limit1, thresh1, bd))
+        return;
+
+    for (i = 0; i < 6; i++) {
+        x[7 - i] = _mm256_castsi256_si128(pq[i]);
+        y[i]     = _mm256_extracti128_si256(pq[i], 1);
+    }
+    transpose_16bit_8x8(x, x);
+    transpose_16bit_8x8(y, y);
+
+    // Only write back the modified columns p5..q5
+    for (i = 0; i < 8; i++) {
+        _mm_storel_epi64((__m128i *)(s - 6 + i * pitch), _mm_srli_si128(x[i], 4));
+        _mm_storeu_si128((__m128i *)(s - 2 + i * pitch), _mm_alignr_epi8(y[i], x[i], 12));
+    }
+}
+
+/*
+ * 8-bit deblocking of two adjacent 4-sample edges. The samples are widened to
+ * 16 bits and filtered by highbd_lpf_dual_avx2() with bd = 8, whose arithmetic
+ * is the one of the 8-bit filters.
+ */
+
+// Packs the p lane of v to the low 8 bytes and the q lane to the high 8 bytes.
+static INLINE __m128i pack_pq(const __m256i v) {
+    return _mm_packus_epi16(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+}
+
+static AOM_FORCE_INLINE void lpf_horizontal_dual_avx2(
+    uint8_t *s, int32_t pitch, int32_t taps, const uint8_t *blimit0, const uint8_t *limit0,
+    const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1,
+    const uint8_t *thresh1) {
+    const int32_t n_input  = taps == 14 ? 7 : taps == 8 ? 4 : taps == 6 ? 3 : 2;
+    const int32_t n_output = taps == 14 ? 6 : taps == 8 ? 3 : 2;
+    __m256i       pq[7];
+
+    for (int32_t i = 0; i < n_input; i++) {
+        pq[i] = _mm256_cvtepu8_epi16(
+            _mm_unpacklo_epi64(xx_loadl_64(s - (i + 1) * pitch), xx_loadl_64(s + i * pitch)));
+    }
+
+    if (!highbd_lpf_dual_avx2(pq, taps, blimit0, limit0, thresh0, blimit1, limit1, thresh1, 8))
+        return;
+
+    for (int32_t i = 0; i < n_output; i++) {
+        const __m128i v = pack_pq(pq[i]);
+        xx_storel_64(s - (i + 1) * pitch, v);
+        xx_storel_64(s + i * pitch, _mm_srli_si128(v, 8));
+    }
+}
+
+// 4, 6 and 8 taps: same layout as highbd_lpf_vertical_dual_avx2().
+static AOM_FORCE_INLINE void lpf_vertical_dual_avx2(
+    uint8_t *s, int32_t pitch, int32_t taps, const uint8_t *blimit0, const uint8_t *limit0,
+    const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1,
+    const uint8_t *thresh1) {
+    const int32_t n_input  = taps == 8 ? 4 : taps == 6 ? 3 : 2;
+    const int32_t n_output = taps == 8 ? 3 : 2;
+    __m128i       x[8];
+    __m256i       pq[4];
+    int32_t       i;
+
+    for (i = 0; i < 8; i++) x[i] = _mm_cvtepu8_epi16(xx_loadl_64(s - 4 + i * pitch));
+    transpose_16bit_8x8(x, x);
+    for (i = 0; i < n_input; i++) pq[i] = yy_set_m128i(x[4 + i], x[3 - i]);
+
+    if (!highbd_lpf_dual_avx2(pq, taps, blimit0, limit0, thresh0, blimit1, limit1, thresh1, 8))
+        return;
+
+    for (i = 0; i < n_output; i++) {
+        x[3 - i] = _mm256_castsi256_si128(pq[i]);
+        x[4 + i] = _mm256_extracti128_si256(pq[i], 1);
+    }
+    transpose_16bit_8x8(x, x);
+
+    // Only write back the modified columns: p1..q1, or p2..q2 for 8 taps
+    for (i = 0; i < 8; i++) {
+        const __m128i row = _mm_packus_epi16(x[i], x[i]);
+        if (taps == 8) {
+            xx_storel_32(s - 3 + i * pitch, _mm_srli_si128(row, 1));
+            xx_storel_32(s - 1 + i * pitch, _mm_srli_si128(row, 3));
+        } else
+            xx_storel_32(s - 2 + i * pitch, _mm_srli_si128(row, 2));
+    }
+}
+
+void aom_lpf_horizontal_4_dual_avx2(uint8_t *s, int32_t pitch, const uint8_t *blimit0,
+                                    const uint8_t *limit0, const uint8_t *thresh0,
+                                    const uint8_t *blimit1, const uint8_t *limit1,
+                                    const uint8_t *thresh1) {
+    lpf_horizontal_dual_avx2(s, pitch, 4, blimit0, limit0, thresh0, blimit1, limit1, thresh1);
+}
+
+void aom_lpf_horizontal_6_dual_avx2(uint8_t *s, int32_t pitch, const uint8_t *blimit0,
+                                    const uint8_t *limit0, const uint8_t *thresh0,
+                                    const uint8_t *blimit1, const uint8_t *limit1,
+                                    const uint8_t *thresh1) {
+    lpf_horizontal_dual_avx2(s, pitch, 6, blimit0, limit0, thresh0, blimit1, limit1, thresh1);
+}
+
+void aom_lpf_horizontal_8_dual_avx2(uint8_t *s, int32_t pitch, const uint8_t *blimit0,
+                                    const uint8_t *limit0, const uint8_t *thresh0,
+                                    const uint8_t *blimit1, const uint8_t *limit1,
+                                    const uint8_t *thresh1) {
+    lpf_horizontal_dual_avx2(s, pitch, 8, blimit0, limit0, thresh0, blimit1, limit1, thresh1);
+}
+
+void aom_lpf_horizontal_14_dual_avx2(uint8_t *s, int32_t pitch, const uint8_t *blimit0,
+                                     const uint8_t *limit0, const uint8_t *thresh0,
+                                     const uint8_t *blimit1, const uint8_t *limit1,
+                                     const uint8_t *thresh1) {
+    lpf_horizontal_dual_avx2(s, pitch, 14, blimit0, limit0, thresh0, blimit1, limit1, thresh1);
+}
+
+void aom_lpf_vertical_4_dual_avx2(uint8_t *s, int32_t pitch, const uint8_t *blimit0,
+                                  const uint8_t *limit0, const uint8_t *thresh0,
+                                  const uint8_t *blimit1, const uint8_t *limit1,
+                                  const uint8_t *thresh1) {
+    lpf_vertical_dual_avx2(s, pitch, 4, blimit0, limit0, thresh0, blimit1, limit1, thresh1);
+}
+
+void aom_lpf_vertical_6_dual_avx2(uint8_t *s, int32_t pitch, const uint8_t *blimit0,
+                                  const uint8_t *limit0, const uint8_t *thresh0,
+                                  const uint8_t *blimit1, const uint8_t *limit1,
+                                  const uint8_t *thresh1) {
+    lpf_vertical_dual_avx2(s, pitch, 6, blimit0, limit0, thresh0, blimit1, limit1, thresh1);
+}
+
+void aom_lpf_vertical_8_dual_avx2(uint8_t *s, int32_t pitch, const uint8_t *blimit0,
+                                  const uint8_t *limit0, const uint8_t *thresh0,
+                                  const uint8_t *blimit1, const uint8_t *limit1,
+                                  const uint8_t *thresh1) {
+    lpf_vertical_dual_avx2(s, pitch, 8, blimit0, limit0, thresh0, blimit1, limit1, thresh1);
+}
+
+// 14 taps: same layout as aom_highbd_lpf_vertical_14_dual_avx2().
+void aom_lpf_vertical_14_dual_avx2(uint8_t *s, int32_t pitch, const uint8_t *blimit0,
+                                   const uint8_t *limit0, const uint8_t *thresh0,
+                                   const uint8_t *blimit1, const uint8_t *limit1,
+                                   const uint8_t *thresh1) {
+    __m128i x[8], y[8];
+    __m256i pq[7];
+    int32_t i;
+
+    for (i = 0; i < 8; i++) {
+        x[i] = _mm_cvtepu8_epi16(xx_loadl_64(s - 8 + i * pitch));
+        y[i] = _mm_cvtepu8_epi16(xx_loadl_64(s + i * pitch));
+    }
+    transpose_16bit_8x8(x, x);
+    transpose_16bit_8x8(y, y);
+    for (i = 0; i < 7; i++) pq[i] = yy_set_m128i(y[i], x[7 - i]);
+
+    if (!highbd_lpf_dual_avx2(pq, 14, blimit0, limit0, thresh0, blimit1, limit1, thresh1, 8))
+        return;
+
+    for (i = 0; i < 6; i++) {
+        x[7 - i] = _mm256_castsi256_si128(pq[i]);
+        y[i]     = _mm256_extracti128_si256(pq[i], 1);
+    }
+    transpose_16bit_8x8(x, x);
+    transpose_16bit_8x8(y, y);
+
+    // Only write back the modified columns p5..q5
+    for (i = 0; i < 8; i++) {
+        const __m128i row = _mm_packus_epi16(x[i], y[i]);
+        xx_storel_64(s - 6 + i * pitch, _mm_srli_si128(row, 2));
+        xx_storel_32(s + 2 + i * pitch, _mm_srli_si128(row, 10));
+    }
+}
+#endif
@@ -6,6 +6,10 @@
 #include <emmintrin.h>
 #include <immintrin.h>
 #include <stdint.h>
+#include "EbDefinitions.h"
+#if DEC_OUT_CONVERT
+#include "EbPackUnPack_C.h"
+#endif
 
 void eb_enc_un_pack8_bit_data_avx2_intrin(uint16_t *in_16bit_buffer, uint32_t in_stride,
                                           uint8_t *out_8bit_buffer, uint32_t out_stride,
@@ -284,3 +288,208 @@ void eb_enc_un_pack8_bit_data_avx2_intrin(uint16_t *in_16bit_buffer, uint32_t in
         }
     }
 }
+
+#if DEC_OUT_CONVERT
+/* Rounding right shift of 16 samples, the 8-bit saturation is left to the pack */
+static INLINE __m256i dec_out_round_shift_avx2(const __m256i val, const __m256i round,
+                                               const __m128i shift) {
+    return _mm256_srl_epi16(_mm256_add_epi16(val, round), shift);
+}
+
+void eb_dec_out_pack_u16_to_u8_avx2(const uint16_t *src, uint32_t src_stride, uint8_t *dst,
+                                    uint32_t dst_stride, uint32_t width, uint32_t height,
+                                    uint32_t shift) {
+    const uint32_t w32   = width & ~31;
+    const __m256i  round = _mm256_set1_epi16(shift ? (int16_t)(1 << (shift - 1)) : 0);
+    const __m128i  sh    = _mm_cvtsi32_si128(shift);
+
+    for (uint32_t j = 0; j < height; j++) {
+        const uint16_t *s = src + j * src_stride;
+        uint8_t *       d = dst + j * dst_stride;
+        for (uint32_t k = 0; k < w32; k += 32) {
+            const __m256i a = dec_out_round_shift_avx2(
+                _mm256_loadu_si256((const __m256i *)(s + k)), round, sh);
+            const __m256i b = dec_out_round_shift_avx2(
+                _mm256_loadu_si256((const __m256i *)(s + k + 16)), round, sh);
+            _mm256_storeu_si256((__m256i *)(d + k),
+                                _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xD8));
+        }
+    }
+
+    if (width > w32)
+        eb_dec_out_pack_u16_to_u8_c(
+            src + w32, src_stride, dst + w32, dst_stride, width - w32, height, shift);
+}
+
+void eb_dec_out_unpack_u8_to_u16_avx2(const uint8_t *src, uint32_t src_stride, uint16_t *dst,
+                                      uint32_t dst_stride, uint32_t width, uint32_t height,
+                                      uint32_t shift) {
+    const uint32_t w16 = width & ~15;
+    const __m128i  sh  = _mm_cvtsi32_si128(shift);
+
+    for (uint32_t j = 0; j < height; j++) {
+        const uint8_t *s = src + j * src_stride;
+        uint16_t *     d = dst + j * dst_stride;
+        for (uint32_t k = 0; k < w16; k += 16) {
+            const __m256i a = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(s + k)));
+            _mm256_storeu_si256((__m256i *)(d + k), _mm256_sll_epi16(a, sh));
+        }
+    }
+
+    if (width > w16)
+        eb_dec_out_unpack_u8_to_u16_c(
+            src + w16, src_stride, dst + w16, dst_stride, width - w16, height, shift);
+}
+
+void eb_dec_out_shift_u16_avx2(const uint16_t *src, uint32_t src_stride, uint16_t *dst,
+                               uint32_t dst_stride, uint32_t width, uint32_t height,
+                               uint32_t shift) {
+    const uint32_t w16 = width & ~15;
+    const __m128i  sh  = _mm_cvtsi32_si128(shift);
+
+    for (uint32_t j = 0; j < height; j++) {
+        const uint16_t *s = src + j * src_stride;
+        uint16_t *      d = dst + j * dst_stride;
+        for (uint32_t k = 0; k < w16; k += 16) {
+            const __m256i a = _mm256_loadu_si256((const __m256i *)(s + k));
+            _mm256_storeu_si256((__m256i *)(d + k), _mm256_sll_epi16(a, sh));
+        }
+    }
+
+    if (width > w16)
+        eb_dec_out_shift_u16_c(
+            src + w16, src_stride, dst + w16, dst_stride, width - w16, height, shift);
+}
+
+void eb_dec_out_interleave_u8_avx2(const uint8_t *src_u, const uint8_t *src_v,
+                                   uint32_t src_stride, uint8_t *dst, uint32_t dst_stride,
+                                   uint32_t width, uint32_t height) {
+    const uint32_t w32 = width & ~31;
+
+    for (uint32_t j = 0; j < height; j++) {
+        const uint8_t *u = src_u + j * src_stride;
+        const uint8_t *v = src_v + j * src_stride;
+        uint8_t *      d = dst + j * dst_stride;
+        for (uint32_t k = 0; k < w32; k += 32) {
+            const __m256i a  = _mm256_loadu_si256((const __m256i *)(u + k));
+            const __m256i b  = _mm256_loadu_si256((const __m256i *)(v + k));
+            const __m256i lo = _mm256_unpacklo_epi8(a, b);
+            const __m256i hi = _mm256_unpackhi_epi8(a, b);
+            _mm256_storeu_si256((__m256i *)(d + 2 * k), _mm256_permute2x128_si256(lo, hi, 0x20));
+            _mm256_storeu_si256((__m256i *)(d + 2 * k + 32),
+                                _mm256_permute2x128_si256(lo, hi, 0x31));
+        }
+    }
+
+    if (width > w32)
+        eb_dec_out_interleave_u8_c(src_u + w32,
+                                   src_v + w32,
+                                   src_stride,
+                                   dst + 2 * w32,
+                                   dst_stride,
+                                   width - w32,
+                                   height);
+}
+
+void eb_dec_out_interleave_u16_to_u8_avx2(const uint16_t *src_u, const uint16_t *src_v,
+                                          uint32_t src_stride, uint8_t *dst, uint32_t dst_stride,
+                                          uint32_t width, uint32_t height, uint32_t shift) {
+    const uint32_t w16   = width & ~15;
+    const __m256i  round = _mm256_set1_epi16(shift ? (int16_t)(1 << (shift - 1)) : 0);
+    const __m128i  sh    = _mm_cvtsi32_si128(shift);
+    /* packus leaves u0..u7 v0..v7 in each lane, interleave them in place */
+    const __m256i shuf = _mm256_setr_epi8(
+        0, 8, 1, 9, 2, 10, 3, 11, 4, 12, 5, 13, 6, 14, 7, 15,
+        0, 8, 1, 9, 2, 10, 3, 11, 4, 12, 5, 13, 6, 14, 7, 15);
+
+    for (uint32_t j = 0; j < height; j++) {
+        const uint16_t *u = src_u + j * src_stride;
+        const uint16_t *v = src_v + j * src_stride;
+        uint8_t *       d = dst + j * dst_stride;
+        for (uint32_t k = 0; k < w16; k += 16) {
+            const __m256i a = dec_out_round_shift_avx2(
+                _mm256_loadu_si256((const __m256i *)(u + k)), round, sh);
+            const __m256i b = dec_out_round_shift_avx2(
+                _mm256_loadu_si256((const __m256i *)(v + k)), round, sh);
+            _mm256_storeu_si256((__m256i *)(d + 2 * k),
+                                _mm256_shuffle_epi8(_mm256_packus_epi16(a, b), shuf));
+        }
+    }
+
+    if (width > w16)
+        eb_dec_out_interleave_u16_to_u8_c(src_u + w16,
+                                          src_v + w16,
+                                          src_stride,
+                                          dst + 2 * w16,
+                                          dst_stride,
+                                          width - w16,
+                                          height,
+                                          shift);
+}
+
+static INLINE void dec_out_store_interleave_u16_avx2(uint16_t *dst, const __m256i a,
+                                                     const __m256i b) {
+    const __m256i lo = _mm256_unpacklo_epi16(a, b);
+    const __m256i hi = _mm256_unpackhi_epi16(a, b);
+    _mm256_storeu_si256((__m256i *)dst, _mm256_permute2x128_si256(lo, hi, 0x20));
+    _mm256_storeu_si256((__m256i *)(dst + 16), _mm256_permute2x128_si256(lo, hi, 0x31));
+}
+
+void eb_dec_out_interleave_u8_to_u16_avx2(const uint8_t *src_u, const uint8_t *src_v,
+                                          uint32_t src_stride, uint16_t *dst, uint32_t dst_stride,
+                                          uint32_t width, uint32_t height, uint32_t shift) {
+    const uint32_t w16 = width & ~15;
+    const __m128i  sh  = _mm_cvtsi32_si128(shift);
+
+    for (uint32_t j = 0; j < height; j++) {
+        const uint8_t *u = src_u + j * src_stride;
+        const uint8_t *v = src_v + j * src_stride;
+        uint16_t *     d = dst + j * dst_stride;
+        for (uint32_t k = 0; k < w16; k += 16) {
+            const __m256i a = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(u + k)));
+            const __m256i b = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(v + k)));
+            dec_out_store_interleave_u16_avx2(
+                d + 2 * k, _mm256_sll_epi16(a, sh), _mm256_sll_epi16(b, sh));
+        }
+    }
+
+    if (width > w16)
+        eb_dec_out_interleave_u8_to_u16_c(src_u + w16,
+                                          src_v + w16,
+                                          src_stride,
+                                          dst + 2 * w16,
+                                          dst_stride,
+                                          width - w16,
+                                          height,
+                                          shift);
+}
+
+void eb_dec_out_interleave_u16_avx2(const uint16_t *src_u, const uint16_t *src_v,
+                                    uint32_t src_stride, uint16_t *dst, uint32_t dst_stride,
+                                    uint32_t width, uint32_t height, uint32_t shift) {
+    const uint32_t w16 = width & ~15;
+    const __m128i  sh  = _mm_cvtsi32_si128(shift);
+
+    for (uint32_t j = 0; j < height; j++) {
+        const uint16_t *u = src_u + j * src_stride;
+        const uint16_t *v = src_v + j * src_stride;
+        uint16_t *      d = dst + j * dst_stride;
+        for (uint32_t k = 0; k < w16; k += 16) {
+            const __m256i a = _mm256_loadu_si256((const __m256i *)(u + k));
+            const __m256i b = _mm256_loadu_si256((const __m256i *)(v + k));
+            dec_out_store_interleave_u16_avx2(
+                d + 2 * k, _mm256_sll_epi16(a, sh), _mm256_sll_epi16(b, sh));
+        }
+    }
+
+    if (width > w16)
+        eb_dec_out_interleave_u16_c(src_u + w16,
+                                    src_v + w16,
+                                    src_stride,
+                                    dst + 2 * w16,
+                                    dst_stride,
+                                    width - w16,
+                                    height,
+                                    shift);
+}
+#endif
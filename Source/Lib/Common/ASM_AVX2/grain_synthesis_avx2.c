@@ -0,0 +1,282 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include "EbDefinitions.h"
+
+#if FILM_GRAIN_SIMD
+#include <immintrin.h>
+#include "common_dsp_rtcd.h"
+
+static INLINE __m256i fgn_load_u8_8_avx2(const uint8_t *src) {
+    return _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)src));
+}
+
+static INLINE __m256i fgn_load_u16_8_avx2(const uint16_t *src) {
+    return _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)src));
+}
+
+static INLINE void fgn_store_u8_8_avx2(uint8_t *dst, const __m256i val) {
+    const __m128i w = _mm_packus_epi32(_mm256_castsi256_si128(val),
+                                       _mm256_extracti128_si256(val, 1));
+    _mm_storel_epi64((__m128i *)dst, _mm_packus_epi16(w, w));
+}
+
+static INLINE void fgn_store_u16_8_avx2(uint16_t *dst, const __m256i val) {
+    _mm_storeu_si128((__m128i *)dst,
+                     _mm_packus_epi32(_mm256_castsi256_si128(val),
+                                      _mm256_extracti128_si256(val, 1)));
+}
+
+// Average of the horizontal luma pairs under 8 subsampled chroma samples
+static INLINE __m256i fgn_average_luma_u8_avx2(const uint8_t *luma) {
+    const __m256i l = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)luma));
+    const __m256i s = _mm256_madd_epi16(l, _mm256_set1_epi16(1));
+    return _mm256_srai_epi32(_mm256_add_epi32(s, _mm256_set1_epi32(1)), 1);
+}
+
+static INLINE __m256i fgn_average_luma_u16_avx2(const uint16_t *luma) {
+    const __m256i l = _mm256_loadu_si256((const __m256i *)luma);
+    const __m256i s = _mm256_madd_epi16(l, _mm256_set1_epi16(1));
+    return _mm256_srai_epi32(_mm256_add_epi32(s, _mm256_set1_epi32(1)), 1);
+}
+
+// scale_lut(): the table carries a duplicated last entry, so lut[x + 1] is
+// always readable and the x == 255 case needs no special handling.
+static INLINE __m256i fgn_scale_lut_avx2(const int32_t *scaling_lut, const __m256i index,
+                                         const int32_t bit_depth) {
+    if (bit_depth == 8) return _mm256_i32gather_epi32(scaling_lut, index, 4);
+
+    const __m128i shift = _mm_cvtsi32_si128(bit_depth - 8);
+    const __m256i x     = _mm256_srl_epi32(index, shift);
+    const __m256i frac  = _mm256_and_si256(index, _mm256_set1_epi32((1 << (bit_depth - 8)) - 1));
+    const __m256i a     = _mm256_i32gather_epi32(scaling_lut, x, 4);
+    const __m256i b     = _mm256_i32gather_epi32(scaling_lut + 1, x, 4);
+    const __m256i d     = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(b, a), frac),
+                                       _mm256_set1_epi32(1 << (bit_depth - 9)));
+    return _mm256_add_epi32(a, _mm256_sra_epi32(d, shift));
+}
+
+// pixel + ((scale * grain + round) >> scaling_shift), clipped to [min, max]
+static INLINE __m256i fgn_blend_avx2(const __m256i pix, const __m256i scale, const __m256i grain,
+                                     const __m256i round, const __m128i shift,
+                                     const __m256i min_val, const __m256i max_val) {
+    const __m256i noise =
+        _mm256_sra_epi32(_mm256_add_epi32(_mm256_mullo_epi32(scale, grain), round), shift);
+    return _mm256_min_epi32(_mm256_max_epi32(_mm256_add_epi32(pix, noise), min_val), max_val);
+}
+
+// ((average_luma * luma_mult + mult * chroma) >> 6) + offset, clipped to the LUT input range
+static INLINE __m256i fgn_chroma_index_avx2(const __m256i average_luma, const __m256i chroma,
+                                            const __m256i luma_mult, const __m256i mult,
+                                            const __m256i offset, const __m256i max_index) {
+    const __m256i m = _mm256_add_epi32(_mm256_mullo_epi32(average_luma, luma_mult),
+                                       _mm256_mullo_epi32(chroma, mult));
+    const __m256i v = _mm256_add_epi32(_mm256_srai_epi32(m, 6), offset);
+    return _mm256_min_epi32(_mm256_max_epi32(v, _mm256_setzero_si256()), max_index);
+}
+
+void eb_fgn_add_noise_luma_avx2(uint8_t *luma, int32_t luma_stride, const int32_t *grain,
+                                int32_t grain_stride, int32_t width, int32_t height,
+                                const FgnScaleParams *sp) {
+    const int32_t w8 = width & ~7;
+
+    if (w8) {
+        const __m256i round   = _mm256_set1_epi32(1 << (sp->scaling_shift - 1));
+        const __m128i shift   = _mm_cvtsi32_si128(sp->scaling_shift);
+        const __m256i min_val = _mm256_set1_epi32(sp->min_value);
+        const __m256i max_val = _mm256_set1_epi32(sp->max_value);
+
+        for (int32_t i = 0; i < height; i++) {
+            uint8_t *      l = luma + i * luma_stride;
+            const int32_t *g = grain + i * grain_stride;
+            for (int32_t j = 0; j < w8; j += 8) {
+                const __m256i pix   = fgn_load_u8_8_avx2(l + j);
+                const __m256i scale = _mm256_i32gather_epi32(sp->scaling_lut, pix, 4);
+                const __m256i gr    = _mm256_loadu_si256((const __m256i *)(g + j));
+                fgn_store_u8_8_avx2(l + j,
+                                    fgn_blend_avx2(pix, scale, gr, round, shift, min_val, max_val));
+            }
+        }
+    }
+
+    if (width > w8)
+        eb_fgn_add_noise_luma_c(
+            luma + w8, luma_stride, grain + w8, grain_stride, width - w8, height, sp);
+}
+
+void eb_fgn_add_noise_luma_hbd_avx2(uint16_t *luma, int32_t luma_stride, const int32_t *grain,
+                                    int32_t grain_stride, int32_t width, int32_t height,
+                                    const FgnScaleParams *sp) {
+    const int32_t w8 = width & ~7;
+
+    if (w8) {
+        const __m256i round   = _mm256_set1_epi32(1 << (sp->scaling_shift - 1));
+        const __m128i shift   = _mm_cvtsi32_si128(sp->scaling_shift);
+        const __m256i min_val = _mm256_set1_epi32(sp->min_value);
+        const __m256i max_val = _mm256_set1_epi32(sp->max_value);
+
+        for (int32_t i = 0; i < height; i++) {
+            uint16_t *     l = luma + i * luma_stride;
+            const int32_t *g = grain + i * grain_stride;
+            for (int32_t j = 0; j < w8; j += 8) {
+                const __m256i pix   = fgn_load_u16_8_avx2(l + j);
+                const __m256i scale = fgn_scale_lut_avx2(sp->scaling_lut, pix, sp->bit_depth);
+                const __m256i gr    = _mm256_loadu_si256((const __m256i *)(g + j));
+                fgn_store_u16_8_avx2(l + j,
+                                     fgn_blend_avx2(pix, scale, gr, round, shift, min_val, max_val));
+            }
+        }
+    }
+
+    if (width > w8)
+        eb_fgn_add_noise_luma_hbd_c(
+            luma + w8, luma_stride, grain + w8, grain_stride, width - w8, height, sp);
+}
+
+void eb_fgn_add_noise_chroma_avx2(uint8_t *chroma, int32_t chroma_stride, const uint8_t *luma,
+                                  int32_t luma_stride, const int32_t *grain, int32_t grain_stride,
+                                  int32_t width, int32_t height, int32_t chroma_subsamp_x,
+                                  int32_t chroma_subsamp_y, const FgnScaleParams *sp) {
+    const int32_t w8 = width & ~7;
+
+    if (w8) {
+        const __m256i round     = _mm256_set1_epi32(1 << (sp->scaling_shift - 1));
+        const __m128i shift     = _mm_cvtsi32_si128(sp->scaling_shift);
+        const __m256i min_val   = _mm256_set1_epi32(sp->min_value);
+        const __m256i max_val   = _mm256_set1_epi32(sp->max_value);
+        const __m256i luma_mult = _mm256_set1_epi32(sp->luma_mult);
+        const __m256i mult      = _mm256_set1_epi32(sp->mult);
+        const __m256i offset    = _mm256_set1_epi32(sp->offset);
+        const __m256i max_index = _mm256_set1_epi32((256 << (sp->bit_depth - 8)) - 1);
+
+        for (int32_t i = 0; i < height; i++) {
+            uint8_t *      c = chroma + i * chroma_stride;
+            const uint8_t *l = luma + (i << chroma_subsamp_y) * luma_stride;
+            const int32_t *g = grain + i * grain_stride;
+            for (int32_t j = 0; j < w8; j += 8) {
+                const __m256i average_luma = chroma_subsamp_x
+                                                 ? fgn_average_luma_u8_avx2(l + (j << 1))
+                                                 : fgn_load_u8_8_avx2(l + j);
+                const __m256i pix   = fgn_load_u8_8_avx2(c + j);
+                const __m256i index = fgn_chroma_index_avx2(
+                    average_luma, pix, luma_mult, mult, offset, max_index);
+                const __m256i scale = fgn_scale_lut_avx2(sp->scaling_lut, index, 8);
+                const __m256i gr    = _mm256_loadu_si256((const __m256i *)(g + j));
+                fgn_store_u8_8_avx2(c + j,
+                                    fgn_blend_avx2(pix, scale, gr, round, shift, min_val, max_val));
+            }
+        }
+    }
+
+    if (width > w8)
+        eb_fgn_add_noise_chroma_c(chroma + w8,
+                                  chroma_stride,
+                                  luma + (w8 << chroma_subsamp_x),
+                                  luma_stride,
+                                  grain + w8,
+                                  grain_stride,
+                                  width - w8,
+                                  height,
+                                  chroma_subsamp_x,
+                                  chroma_subsamp_y,
+                                  sp);
+}
+
+void eb_fgn_add_noise_chroma_hbd_avx2(uint16_t *chroma, int32_t chroma_stride,
+                                      const uint16_t *luma, int32_t luma_stride,
+                                      const int32_t *grain, int32_t grain_stride, int32_t width,
+                                      int32_t height, int32_t chroma_subsamp_x,
+                                      int32_t chroma_subsamp_y, const FgnScaleParams *sp) {
+    const int32_t w8 = width & ~7;
+
+    if (w8) {
+        const __m256i round     = _mm256_set1_epi32(1 << (sp->scaling_shift - 1));
+        const __m128i shift     = _mm_cvtsi32_si128(sp->scaling_shift);
+        const __m256i min_val   = _mm256_set1_epi32(sp->min_value);
+        const __m256i max_val   = _mm256_set1_epi32(sp->max_value);
+        const __m256i luma_mult = _mm256_set1_epi32(sp->luma_mult);
+        const __m256i mult      = _mm256_set1_epi32(sp->mult);
+        const __m256i offset    = _mm256_set1_epi32(sp->offset);
+        const __m256i max_index = _mm256_set1_epi32((256 << (sp->bit_depth - 8)) - 1);
+
+        for (int32_t i = 0; i < height; i++) {
+            uint16_t *      c = chroma + i * chroma_stride;
+            const uint16_t *l = luma + (i << chroma_subsamp_y) * luma_stride;
+            const int32_t * g = grain + i * grain_stride;
+            for (int32_t j = 0; j < w8; j += 8) {
+                const __m256i average_luma = chroma_subsamp_x
+                                                 ? fgn_average_luma_u16_avx2(l + (j << 1))
+                                                 : fgn_load_u16_8_avx2(l + j);
+                const __m256i pix   = fgn_load_u16_8_avx2(c + j);
+                const __m256i index = fgn_chroma_index_avx2(
+                    average_luma, pix, luma_mult, mult, offset, max_index);
+                const __m256i scale = fgn_scale_lut_avx2(sp->scaling_lut, index, sp->bit_depth);
+                const __m256i gr    = _mm256_loadu_si256((const __m256i *)(g + j));
+                fgn_store_u16_8_avx2(c + j,
+                                     fgn_blend_avx2(pix, scale, gr, round, shift, min_val, max_val));
+            }
+        }
+    }
+
+    if (width > w8)
+        eb_fgn_add_noise_chroma_hbd_c(chroma + w8,
+                                      chroma_stride,
+                                      luma + (w8 << chroma_subsamp_x),
+                                      luma_stride,
+                                      grain + w8,
+                                      grain_stride,
+                                      width - w8,
+                                      height,
+                                      chroma_subsamp_x,
+                                      chroma_subsamp_y,
+                                      sp);
+}
+
+void eb_fgn_hor_boundary_overlap_avx2(const int32_t *top_block, int32_t top_stride,
+                                      const int32_t *bottom_block, int32_t bottom_stride,
+                                      int32_t *dst_block, int32_t dst_stride, int32_t width,
+                                      int32_t height, int32_t grain_min, int32_t grain_max) {
+    // top / bottom weights of each overlapped row, in 1/32 units
+    static const int32_t weights[2][2][2] = {{{23, 22}, {0, 0}}, {{27, 17}, {17, 27}}};
+    const int32_t        w8               = width & ~7;
+
+    if (height != 1 && height != 2) return;
+
+    if (w8) {
+        const __m256i round   = _mm256_set1_epi32(16);
+        const __m256i min_val = _mm256_set1_epi32(grain_min);
+        const __m256i max_val = _mm256_set1_epi32(grain_max);
+
+        for (int32_t i = 0; i < height; i++) {
+            const __m256i  w_top = _mm256_set1_epi32(weights[height - 1][i][0]);
+            const __m256i  w_bot = _mm256_set1_epi32(weights[height - 1][i][1]);
+            const int32_t *t     = top_block + i * top_stride;
+            const int32_t *b     = bottom_block + i * bottom_stride;
+            int32_t *      d     = dst_block + i * dst_stride;
+            for (int32_t j = 0; j < w8; j += 8) {
+                const __m256i top = _mm256_loadu_si256((const __m256i *)(t + j));
+                const __m256i bot = _mm256_loadu_si256((const __m256i *)(b + j));
+                __m256i       sum = _mm256_add_epi32(_mm256_mullo_epi32(top, w_top),
+                                               _mm256_mullo_epi32(bot, w_bot));
+                sum = _mm256_srai_epi32(_mm256_add_epi32(sum, round), 5);
+                _mm256_storeu_si256((__m256i *)(d + j),
+                                    _mm256_min_epi32(_mm256_max_epi32(sum, min_val), max_val));
+            }
+        }
+    }
+
+    if (width > w8)
+        eb_fgn_hor_boundary_overlap_c(top_block + w8,
+                                      top_stride,
+                                      bottom_block + w8,
+                                      bottom_stride,
+                                      dst_block + w8,
+                                      dst_stride,
+                                      width - w8,
+                                      height,
+                                      grain_min,
+                                      grain_max);
+}
+#endif
@@ -766,6 +766,56 @@ void eb_av1_selfguided_restoration_avx2(const uint8_t *dgd8, int32_t width, int3
     }
 }
 
+#if SGR_INTEGRAL_CACHE
+void eb_av1_sgr_integral_images_avx2(const uint8_t *dgd8, int32_t width, int32_t height,
+                                     int32_t dgd_stride, int32_t *ii, int32_t highbd) {
+    const int32_t  buf_stride      = sgr_ii_stride(width);
+    const int32_t  width_ext       = width + 2 * SGRPROJ_BORDER_HORZ;
+    const int32_t  height_ext      = height + 2 * SGRPROJ_BORDER_VERT;
+    const int32_t  dgd_diag_border = SGRPROJ_BORDER_HORZ + dgd_stride * SGRPROJ_BORDER_VERT;
+    const uint8_t *dgd0            = dgd8 - dgd_diag_border;
+    int32_t *      ctl             = ii + 7;
+    int32_t *      dtl             = ii + SGRPROJ_II_BUF_ELTS + 7;
+
+    if (highbd)
+        integral_images_highbd(
+            CONVERT_TO_SHORTPTR(dgd0), dgd_stride, width_ext, height_ext, ctl, dtl, buf_stride);
+    else
+        integral_images(dgd0, dgd_stride, width_ext, height_ext, ctl, dtl, buf_stride);
+}
+
+// Same as eb_av1_selfguided_restoration_avx2(), with the integral images
+// built beforehand by eb_av1_sgr_integral_images().
+void eb_av1_selfguided_restoration_from_ii_avx2(const uint8_t *dgd8, int32_t width, int32_t height,
+                                                int32_t dgd_stride, const int32_t *ii,
+                                                int32_t *flt0, int32_t *flt1, int32_t flt_stride,
+                                                int32_t sgr_params_idx, int32_t bit_depth,
+                                                int32_t highbd) {
+    DECLARE_ALIGNED(32, int32_t, buf[2 * SGRPROJ_II_BUF_ELTS]);
+    const int32_t buf_stride      = sgr_ii_stride(width);
+    const int32_t buf_diag_border = SGRPROJ_BORDER_HORZ + buf_stride * SGRPROJ_BORDER_VERT;
+
+    int32_t *      A = buf + 7 + 1 + buf_stride + buf_diag_border;
+    int32_t *      b = buf + SGRPROJ_II_BUF_ELTS + 7 + 1 + buf_stride + buf_diag_border;
+    const int32_t *C = sgr_ii_origin(ii, buf_stride);
+    const int32_t *D = sgr_ii_origin(ii + SGRPROJ_II_BUF_ELTS, buf_stride);
+
+    const SgrParamsType *const params = &eb_sgr_params[sgr_params_idx];
+    assert(!(params->r[0] == 0 && params->r[1] == 0));
+
+    if (params->r[0] > 0) {
+        calc_ab_fast(A, b, C, D, width, height, buf_stride, bit_depth, sgr_params_idx, 0);
+        final_filter_fast(
+            flt0, flt_stride, A, b, buf_stride, dgd8, dgd_stride, width, height, highbd);
+    }
+
+    if (params->r[1] > 0) {
+        calc_ab(A, b, C, D, width, height, buf_stride, bit_depth, sgr_params_idx, 1);
+        final_filter(flt1, flt_stride, A, b, buf_stride, dgd8, dgd_stride, width, height, highbd);
+    }
+}
+
+#endif
 void eb_apply_selfguided_restoration_avx2(const uint8_t *dat8, int32_t width, int32_t height,
                                           int32_t stride, int32_t eps, const int32_t *xqd,
                                           uint8_t *dst8, int32_t dst_stride, int32_t *tmpbuf,
@@ -0,0 +1,231 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include "EbDefinitions.h"
+
+#if FILM_GRAIN_SIMD && !defined(NON_AVX512_SUPPORT)
+#include <immintrin.h>
+#include "common_dsp_rtcd.h"
+
+static INLINE __m512i fgn_load_u8_16_avx512(const uint8_t *src) {
+    return _mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i *)src));
+}
+
+static INLINE __m512i fgn_load_u16_16_avx512(const uint16_t *src) {
+    return _mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i *)src));
+}
+
+// Values are already clipped to the pixel range, the saturating narrowing is a plain pack
+static INLINE void fgn_store_u8_16_avx512(uint8_t *dst, const __m512i val) {
+    _mm_storeu_si128((__m128i *)dst, _mm512_cvtusepi32_epi8(val));
+}
+
+static INLINE void fgn_store_u16_16_avx512(uint16_t *dst, const __m512i val) {
+    _mm256_storeu_si256((__m256i *)dst, _mm512_cvtusepi32_epi16(val));
+}
+
+// Average of the horizontal luma pairs under 16 subsampled chroma samples
+static INLINE __m512i fgn_average_luma_u8_avx512(const uint8_t *luma) {
+    const __m512i l = _mm512_cvtepu8_epi16(_mm256_loadu_si256((const __m256i *)luma));
+    const __m512i s = _mm512_madd_epi16(l, _mm512_set1_epi16(1));
+    return _mm512_srai_epi32(_mm512_add_epi32(s, _mm512_set1_epi32(1)), 1);
+}
+
+static INLINE __m512i fgn_average_luma_u16_avx512(const uint16_t *luma) {
+    const __m512i l = _mm512_loadu_si512((const __m512i *)luma);
+    const __m512i s = _mm512_madd_epi16(l, _mm512_set1_epi16(1));
+    return _mm512_srai_epi32(_mm512_add_epi32(s, _mm512_set1_epi32(1)), 1);
+}
+
+static INLINE __m512i fgn_scale_lut_avx512(const int32_t *scaling_lut, const __m512i index,
+                                           const int32_t bit_depth) {
+    if (bit_depth == 8) return _mm512_i32gather_epi32(index, scaling_lut, 4);
+
+    const __m128i shift = _mm_cvtsi32_si128(bit_depth - 8);
+    const __m512i x     = _mm512_srl_epi32(index, shift);
+    const __m512i frac  = _mm512_and_si512(index, _mm512_set1_epi32((1 << (bit_depth - 8)) - 1));
+    const __m512i a     = _mm512_i32gather_epi32(x, scaling_lut, 4);
+    const __m512i b     = _mm512_i32gather_epi32(x, scaling_lut + 1, 4);
+    const __m512i d     = _mm512_add_epi32(_mm512_mullo_epi32(_mm512_sub_epi32(b, a), frac),
+                                       _mm512_set1_epi32(1 << (bit_depth - 9)));
+    return _mm512_add_epi32(a, _mm512_sra_epi32(d, shift));
+}
+
+static INLINE __m512i fgn_blend_avx512(const __m512i pix, const __m512i scale, const __m512i grain,
+                                       const __m512i round, const __m128i shift,
+                                       const __m512i min_val, const __m512i max_val) {
+    const __m512i noise =
+        _mm512_sra_epi32(_mm512_add_epi32(_mm512_mullo_epi32(scale, grain), round), shift);
+    return _mm512_min_epi32(_mm512_max_epi32(_mm512_add_epi32(pix, noise), min_val), max_val);
+}
+
+static INLINE __m512i fgn_chroma_index_avx512(const __m512i average_luma, const __m512i chroma,
+                                              const __m512i luma_mult, const __m512i mult,
+                                              const __m512i offset, const __m512i max_index) {
+    const __m512i m = _mm512_add_epi32(_mm512_mullo_epi32(average_luma, luma_mult),
+                                       _mm512_mullo_epi32(chroma, mult));
+    const __m512i v = _mm512_add_epi32(_mm512_srai_epi32(m, 6), offset);
+    return _mm512_min_epi32(_mm512_max_epi32(v, _mm512_setzero_si512()), max_index);
+}
+
+void eb_fgn_add_noise_luma_avx512(uint8_t *luma, int32_t luma_stride, const int32_t *grain,
+                                  int32_t grain_stride, int32_t width, int32_t height,
+                                  const FgnScaleParams *sp) {
+    const int32_t w16 = width & ~15;
+
+    if (w16) {
+        const __m512i round   = _mm512_set1_epi32(1 << (sp->scaling_shift - 1));
+        const __m128i shift   = _mm_cvtsi32_si128(sp->scaling_shift);
+        const __m512i min_val = _mm512_set1_epi32(sp->min_value);
+        const __m512i max_val = _mm512_set1_epi32(sp->max_value);
+
+        for (int32_t i = 0; i < height; i++) {
+            uint8_t *      l = luma + i * luma_stride;
+            const int32_t *g = grain + i * grain_stride;
+            for (int32_t j = 0; j < w16; j += 16) {
+                const __m512i pix   = fgn_load_u8_16_avx512(l + j);
+                const __m512i scale = _mm512_i32gather_epi32(pix, sp->scaling_lut, 4);
+                const __m512i gr    = _mm512_loadu_si512((const __m512i *)(g + j));
+                fgn_store_u8_16_avx512(
+                    l + j, fgn_blend_avx512(pix, scale, gr, round, shift, min_val, max_val));
+            }
+        }
+    }
+
+    if (width > w16)
+        eb_fgn_add_noise_luma_avx2(
+            luma + w16, luma_stride, grain + w16, grain_stride, width - w16, height, sp);
+}
+
+void eb_fgn_add_noise_luma_hbd_avx512(uint16_t *luma, int32_t luma_stride, const int32_t *grain,
+                                      int32_t grain_stride, int32_t width, int32_t height,
+                                      const FgnScaleParams *sp) {
+    const int32_t w16 = width & ~15;
+
+    if (w16) {
+        const __m512i round   = _mm512_set1_epi32(1 << (sp->scaling_shift - 1));
+        const __m128i shift   = _mm_cvtsi32_si128(sp->scaling_shift);
+        const __m512i min_val = _mm512_set1_epi32(sp->min_value);
+        const __m512i max_val = _mm512_set1_epi32(sp->max_value);
+
+        for (int32_t i = 0; i < height; i++) {
+            uint16_t *     l = luma + i * luma_stride;
+            const int32_t *g = grain + i * grain_stride;
+            for (int32_t j = 0; j < w16; j += 16) {
+                const __m512i pix   = fgn_load_u16_16_avx512(l + j);
+                const __m512i scale = fgn_scale_lut_avx512(sp->scaling_lut, pix, sp->bit_depth);
+                const __m512i gr    = _mm512_loadu_si512((const __m512i *)(g + j));
+                fgn_store_u16_16_avx512(
+                    l + j, fgn_blend_avx512(pix, scale, gr, round, shift, min_val, max_val));
+            }
+        }
+    }
+
+    if (width > w16)
+        eb_fgn_add_noise_luma_hbd_avx2(
+            luma + w16, luma_stride, grain + w16, grain_stride, width - w16, height, sp);
+}
+
+void eb_fgn_add_noise_chroma_avx512(uint8_t *chroma, int32_t chroma_stride, const uint8_t *luma,
+                                    int32_t luma_stride, const int32_t *grain,
+                                    int32_t grain_stride, int32_t width, int32_t height,
+                                    int32_t chroma_subsamp_x, int32_t chroma_subsamp_y,
+                                    const FgnScaleParams *sp) {
+    const int32_t w16 = width & ~15;
+
+    if (w16) {
+        const __m512i round     = _mm512_set1_epi32(1 << (sp->scaling_shift - 1));
+        const __m128i shift     = _mm_cvtsi32_si128(sp->scaling_shift);
+        const __m512i min_val   = _mm512_set1_epi32(sp->min_value);
+        const __m512i max_val   = _mm512_set1_epi32(sp->max_value);
+        const __m512i luma_mult = _mm512_set1_epi32(sp->luma_mult);
+        const __m512i mult      = _mm512_set1_epi32(sp->mult);
+        const __m512i offset    = _mm512_set1_epi32(sp->offset);
+        const __m512i max_index = _mm512_set1_epi32((256 << (sp->bit_depth - 8)) - 1);
+
+        for (int32_t i = 0; i < height; i++) {
+            uint8_t *      c = chroma + i * chroma_stride;
+            const uint8_t *l = luma + (i << chroma_subsamp_y) * luma_stride;
+            const int32_t *g = grain + i * grain_stride;
+            for (int32_t j = 0; j < w16; j += 16) {
+                const __m512i average_luma = chroma_subsamp_x
+                                                 ? fgn_average_luma_u8_avx512(l + (j << 1))
+                                                 : fgn_load_u8_16_avx512(l + j);
+                const __m512i pix   = fgn_load_u8_16_avx512(c + j);
+                const __m512i index = fgn_chroma_index_avx512(
+                    average_luma, pix, luma_mult, mult, offset, max_index);
+                const __m512i scale = fgn_scale_lut_avx512(sp->scaling_lut, index, 8);
+                const __m512i gr    = _mm512_loadu_si512((const __m512i *)(g + j));
+                fgn_store_u8_16_avx512(
+                    c + j, fgn_blend_avx512(pix, scale, gr, round, shift, min_val, max_val));
+            }
+        }
+    }
+
+    if (width > w16)
+        eb_fgn_add_noise_chroma_avx2(chroma + w16,
+                                     chroma_stride,
+                                     luma + (w16 << chroma_subsamp_x),
+                                     luma_stride,
+                                     grain + w16,
+                                     grain_stride,
+                                     width - w16,
+                                     height,
+                                     chroma_subsamp_x,
+                                     chroma_subsamp_y,
+                                     sp);
+}
+
+void eb_fgn_add_noise_chroma_hbd_avx512(uint16_t *chroma, int32_t chroma_stride,
+                                        const uint16_t *luma, int32_t luma_stride,
+                                        const int32_t *grain, int32_t grain_stride,
+                                        int32_t width, int32_t height, int32_t chroma_subsamp_x,
+                                        int32_t chroma_subsamp_y, const FgnScaleParams *sp) {
+    const int32_t w16 = width & ~15;
+
+    if (w16) {
+        const __m512i round     = _mm512_set1_epi32(1 << (sp->scaling_shift - 1));
+        const __m128i shift     = _mm_cvtsi32_si128(sp->scaling_shift);
+        const __m512i min_val   = _mm512_set1_epi32(sp->min_value);
+        const __m512i max_val   = _mm512_set1_epi32(sp->max_value);
+        const __m512i luma_mult = _mm512_set1_epi32(sp->luma_mult);
+        const __m512i mult      = _mm512_set1_epi32(sp->mult);
+        const __m512i offset    = _mm512_set1_epi32(sp->offset);
+        const __m512i max_index = _mm512_set1_epi32((256 << (sp->bit_depth - 8)) - 1);
+
+        for (int32_t i = 0; i < height; i++) {
+            uint16_t *      c = chroma + i * chroma_stride;
+            const uint16_t *l = luma + (i << chroma_subsamp_y) * luma_stride;
+            const int32_t * g = grain + i * grain_stride;
+            for (int32_t j = 0; j < w16; j += 16) {
+                const __m512i average_luma = chroma_subsamp_x
+                                                 ? fgn_average_luma_u16_avx512(l + (j << 1))
+                                                 : fgn_load_u16_16_avx512(l + j);
+                const __m512i pix   = fgn_load_u16_16_avx512(c + j);
+                const __m512i index = fgn_chroma_index_avx512(
+                    average_luma, pix, luma_mult, mult, offset, max_index);
+                const __m512i scale =
+                    fgn_scale_lut_avx512(sp->scaling_lut, index, sp->bit_depth);
+                const __m512i gr = _mm512_loadu_si512((const __m512i *)(g + j));
+                fgn_store_u16_16_avx512(
+                    c + j, fgn_blend_avx512(pix, scale, gr, round, shift, min_val, max_val));
+            }
+        }
+    }
+
+    if (width > w16)
+        eb_fgn_add_noise_chroma_hbd_avx2(chroma + w16,
+                                         chroma_stride,
+                                         luma + (w16 << chroma_subsamp_x),
+                                         luma_stride,
+                                         grain + w16,
+                                         grain_stride,
+                                         width - w16,
+                                         height,
+                                         chroma_subsamp_x,
+                                         chroma_subsamp_y,
+                                         sp);
+}
+#endif
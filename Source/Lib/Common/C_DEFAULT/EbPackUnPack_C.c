@@ -181,3 +181,100 @@ void convert_16bit_to_8bit_c(uint16_t *src, uint32_t src_stride, uint8_t *dst, u
         }
     }
 }
+
+#if DEC_OUT_CONVERT
+/************************************************
+* Decoder output conversion : bit depth change and
+* chroma interleaving (NV12 / P010), strides in samples
+************************************************/
+static INLINE uint8_t dec_out_round_u8(uint16_t val, uint32_t shift) {
+    const uint32_t out = shift ? (val + (1 << (shift - 1))) >> shift : val;
+    return (uint8_t)(out > 255 ? 255 : out);
+}
+
+void eb_dec_out_pack_u16_to_u8_c(const uint16_t *src, uint32_t src_stride, uint8_t *dst,
+                                 uint32_t dst_stride, uint32_t width, uint32_t height,
+                                 uint32_t shift) {
+    for (uint32_t j = 0; j < height; j++) {
+        for (uint32_t k = 0; k < width; k++) dst[k] = dec_out_round_u8(src[k], shift);
+        src += src_stride;
+        dst += dst_stride;
+    }
+}
+
+void eb_dec_out_unpack_u8_to_u16_c(const uint8_t *src, uint32_t src_stride, uint16_t *dst,
+                                   uint32_t dst_stride, uint32_t width, uint32_t height,
+                                   uint32_t shift) {
+    for (uint32_t j = 0; j < height; j++) {
+        for (uint32_t k = 0; k < width; k++) dst[k] = (uint16_t)(src[k] << shift);
+        src += src_stride;
+        dst += dst_stride;
+    }
+}
+
+void eb_dec_out_shift_u16_c(const uint16_t *src, uint32_t src_stride, uint16_t *dst,
+                            uint32_t dst_stride, uint32_t width, uint32_t height,
+                            uint32_t shift) {
+    for (uint32_t j = 0; j < height; j++) {
+        for (uint32_t k = 0; k < width; k++) dst[k] = (uint16_t)(src[k] << shift);
+        src += src_stride;
+        dst += dst_stride;
+    }
+}
+
+void eb_dec_out_interleave_u8_c(const uint8_t *src_u, const uint8_t *src_v, uint32_t src_stride,
+                                uint8_t *dst, uint32_t dst_stride, uint32_t width,
+                                uint32_t height) {
+    for (uint32_t j = 0; j < height; j++) {
+        for (uint32_t k = 0; k < width; k++) {
+            dst[2 * k]     = src_u[k];
+            dst[2 * k + 1] = src_v[k];
+        }
+        src_u += src_stride;
+        src_v += src_stride;
+        dst += dst_stride;
+    }
+}
+
+void eb_dec_out_interleave_u16_to_u8_c(const uint16_t *src_u, const uint16_t *src_v,
+                                       uint32_t src_stride, uint8_t *dst, uint32_t dst_stride,
+                                       uint32_t width, uint32_t height, uint32_t shift) {
+    for (uint32_t j = 0; j < height; j++) {
+        for (uint32_t k = 0; k < width; k++) {
+            dst[2 * k]     = dec_out_round_u8(src_u[k], shift);
+            dst[2 * k + 1] = dec_out_round_u8(src_v[k], shift);
+        }
+        src_u += src_stride;
+        src_v += src_stride;
+        dst += dst_stride;
+    }
+}
+
+void eb_dec_out_interleave_u8_to_u16_c(const uint8_t *src_u, const uint8_t *src_v,
+                                       uint32_t src_stride, uint16_t *dst, uint32_t dst_stride,
+                                       uint32_t width, uint32_t height, uint32_t shift) {
+    for (uint32_t j = 0; j < height; j++) {
+        for (uint32_t k = 0; k < width; k++) {
+            dst[2 * k]     = (uint16_t)(src_u[k] << shift);
+            dst[2 * k + 1] = (uint16_t)(src_v[k] << shift);
+        }
+        src_u += src_stride;
+        src_v += src_stride;
+        dst += dst_stride;
+    }
+}
+
+void eb_dec_out_interleave_u16_c(const uint16_t *src_u, const uint16_t *src_v,
+                                 uint32_t src_stride, uint16_t *dst, uint32_t dst_stride,
+                                 uint32_t width, uint32_t height, uint32_t shift) {
+    for (uint32_t j = 0; j < height; j++) {
+        for (uint32_t k = 0; k < width; k++) {
+            dst[2 * k]     = (uint16_t)(src_u[k] << shift);
+            dst[2 * k + 1] = (uint16_t)(src_v[k] << shift);
+        }
+        src_u += src_stride;
+        src_v += src_stride;
+        dst += dst_stride;
+    }
+}
+#endif
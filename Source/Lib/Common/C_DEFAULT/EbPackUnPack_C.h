@@ -40,6 +40,29 @@ void convert_8bit_to_16bit_c(uint8_t *src, uint32_t src_stride, uint16_t *dst, u
 
 void convert_16bit_to_8bit_c(uint16_t *src, uint32_t src_stride, uint8_t *dst, uint32_t dst_stride,
     uint32_t width, uint32_t height);
+#if DEC_OUT_CONVERT
+void eb_dec_out_pack_u16_to_u8_c(const uint16_t *src, uint32_t src_stride, uint8_t *dst,
+                                 uint32_t dst_stride, uint32_t width, uint32_t height,
+                                 uint32_t shift);
+void eb_dec_out_unpack_u8_to_u16_c(const uint8_t *src, uint32_t src_stride, uint16_t *dst,
+                                   uint32_t dst_stride, uint32_t width, uint32_t height,
+                                   uint32_t shift);
+void eb_dec_out_shift_u16_c(const uint16_t *src, uint32_t src_stride, uint16_t *dst,
+                            uint32_t dst_stride, uint32_t width, uint32_t height,
+                            uint32_t shift);
+void eb_dec_out_interleave_u8_c(const uint8_t *src_u, const uint8_t *src_v, uint32_t src_stride,
+                                uint8_t *dst, uint32_t dst_stride, uint32_t width,
+                                uint32_t height);
+void eb_dec_out_interleave_u16_to_u8_c(const uint16_t *src_u, const uint16_t *src_v,
+                                       uint32_t src_stride, uint8_t *dst, uint32_t dst_stride,
+                                       uint32_t width, uint32_t height, uint32_t shift);
+void eb_dec_out_interleave_u8_to_u16_c(const uint8_t *src_u, const uint8_t *src_v,
+                                       uint32_t src_stride, uint16_t *dst, uint32_t dst_stride,
+                                       uint32_t width, uint32_t height, uint32_t shift);
+void eb_dec_out_interleave_u16_c(const uint16_t *src_u, const uint16_t *src_v,
+                                 uint32_t src_stride, uint16_t *dst, uint32_t dst_stride,
+                                 uint32_t width, uint32_t height, uint32_t shift);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -59,6 +59,50 @@ EbErrorType output_bitstream_reset(OutputBitstreamUnit *bitstream_ptr) {
     return return_error;
 }
 
+#if EC_GROWABLE_BUFFERS
+/**********************************
+ * Reserve
+ **********************************/
+EbErrorType output_bitstream_unit_reserve(OutputBitstreamUnit *bitstream_ptr, uint32_t bytes) {
+    const uint32_t used = (uint32_t)(bitstream_ptr->buffer_av1 - bitstream_ptr->buffer_begin_av1);
+    uint8_t *      buffer;
+    uint32_t       buffer_size;
+
+    if (used + bytes <= bitstream_ptr->size) return EB_ErrorNone;
+
+    buffer_size = MAX(2 * bitstream_ptr->size, used + bytes);
+    EB_MALLOC_ARRAY(buffer, buffer_size);
+    if (used) memcpy(buffer, bitstream_ptr->buffer_begin_av1, used);
+    EB_FREE_ARRAY(bitstream_ptr->buffer_begin_av1);
+    bitstream_ptr->buffer_begin_av1 = buffer;
+    bitstream_ptr->buffer_av1       = buffer + used;
+    bitstream_ptr->size             = buffer_size;
+
+    return EB_ErrorNone;
+}
+#endif
+
+#if EC_SB_ROW_PIPELINE
+EbErrorType ec_symbol_log_grow(EcSymbolLog *log) {
+    EcSymbol *symbols;
+    uint32_t  log_size = MAX(2 * log->size, 4096);
+
+    EB_MALLOC_ARRAY(symbols, log_size);
+    if (log->count) memcpy(symbols, log->symbols, log->count * sizeof(*symbols));
+    EB_FREE_ARRAY(log->symbols);
+    log->symbols = symbols;
+    log->size    = log_size;
+
+    return EB_ErrorNone;
+}
+
+void ec_symbol_log_free(EcSymbolLog *log) {
+    EB_FREE_ARRAY(log->symbols);
+    log->count = 0;
+    log->size  = 0;
+}
+#endif
+
 /********************************************************************************************************************************/
 /********************************************************************************************************************************/
 /********************************************************************************************************************************/
@@ -67,7 +111,16 @@ EbErrorType output_bitstream_reset(OutputBitstreamUnit *bitstream_ptr) {
 void eb_aom_daala_start_encode(DaalaWriter *br, uint8_t *source) {
     br->buffer = source;
     br->pos    = 0;
+#if EC_SB_ROW_PIPELINE
+    br->symbol_log = NULL;
+#endif
+#if EC_GROWABLE_BUFFERS
+    br->bitstream_unit = NULL;
+    // The raw bits buffer is only used for the final bytes and is sized then
+    eb_od_ec_enc_init(&br->ec, 0);
+#else
     eb_od_ec_enc_init(&br->ec, 62025);
+#endif
 }
 
 int32_t eb_aom_daala_stop_encode(DaalaWriter *br) {
@@ -76,11 +129,50 @@ int32_t eb_aom_daala_stop_encode(DaalaWriter *br) {
     uint8_t *daala_data;
     daala_data = eb_od_ec_enc_done(&br->ec, &daala_bytes);
     nb_bits    = eb_od_ec_enc_tell(&br->ec);
+#if EC_GROWABLE_BUFFERS
+    if (br->bitstream_unit) {
+        if (output_bitstream_unit_reserve(br->bitstream_unit, daala_bytes) != EB_ErrorNone)
+            daala_bytes = 0;
+        br->buffer = br->bitstream_unit->buffer_av1;
+    }
+#endif
     memcpy(br->buffer, daala_data, daala_bytes);
     br->pos = daala_bytes;
     eb_od_ec_enc_clear(&br->ec);
     return nb_bits;
 }
+#if EC_SB_ROW_PIPELINE
+
+uint32_t eb_aom_write_logged_symbols(DaalaWriter *w, const EcSymbolLog *log, uint32_t start) {
+    uint32_t i;
+
+    for (i = start; i < log->count; i++) {
+        const EcSymbol *sym = &log->symbols[i];
+        AomCdfProb      cdf[CDF_SIZE(2)];
+
+        switch (sym->type) {
+        case EC_SYMBOL_BOOL: aom_daala_write(w, (int32_t)sym->value, sym->param); break;
+        case EC_SYMBOL_LITERAL:
+            aom_daala_write_literal(w, (int32_t)sym->value, sym->param);
+            break;
+        case EC_SYMBOL_CDF:
+            daala_write_symbol(w, (int32_t)sym->value, sym->cdf, sym->param);
+            if (sym->update) update_cdf(sym->cdf, (int32_t)sym->value, sym->param);
+            break;
+        case EC_SYMBOL_PARTITION_HORZ_ALIKE:
+            partition_gather_horz_alike(cdf, sym->cdf, (BlockSize)sym->param);
+            daala_write_symbol(w, (int32_t)sym->value, cdf, 2);
+            break;
+        case EC_SYMBOL_PARTITION_VERT_ALIKE:
+            partition_gather_vert_alike(cdf, sym->cdf, (BlockSize)sym->param);
+            daala_write_symbol(w, (int32_t)sym->value, cdf, 2);
+            break;
+        default: assert(sym->type == EC_SYMBOL_MARK); return i + 1;
+        }
+    }
+    return i;
+}
+#endif
 
 /*A range encoder.
 See entdec.c and the references for implementation details \cite{Mar79,MNW98}.
@@ -107,12 +199,90 @@ month=Jul,
 URL="http://researchcommons.waikato.ac.nz/Bitstream/handle/10289/78/content.pdf"
 }*/
 
+#if EC_GROWABLE_BUFFERS
+/*Closes the current page of the pre-carry buffer and chains a new one after it.
+Return: The new page, or NULL on allocation failure.*/
+static OdEcPrecarryPage *od_ec_enc_next_page(OdEcEnc *enc) {
+    OdEcPrecarryPage *page = (OdEcPrecarryPage *)malloc(sizeof(*page));
+    if (page == NULL) {
+        enc->error = -1;
+        return NULL;
+    }
+    enc->precarry_page->count = enc->page_offs;
+    page->prev                = enc->precarry_page;
+    page->count               = 0;
+    enc->precarry_page        = page;
+    enc->page_offs            = 0;
+    return page;
+}
+
+#endif
+#if EC_FAST_RANGE_CODER
+/*Adds a carry to the bytes written before offset offs of page.*/
+static void od_ec_enc_propagate_carry(OdEcPrecarryPage *page, uint32_t offs) {
+    unsigned sum;
+    do {
+        while (offs == 0) {
+            page = page->prev;
+            assert(page != NULL);
+            offs = page->count;
+        }
+        offs--;
+        sum              = page->data[offs] + 1;
+        page->data[offs] = (uint8_t)sum;
+    } while (sum >> 8);
+}
+
+/*Takes updated low and range values, renormalizes them so that
+32768 <= rng < 65536, and stores them back in the encoder context.
+The 64-bit low is flushed once it holds 40 bits, all its ready bytes at once;
+the bytes are written directly and a carry out of them is added to the bytes
+already written.
+low: The new value of low.
+rng: The new value of the range.*/
+static INLINE void od_ec_enc_normalize(OdEcEnc *enc, OdEcEncWindow low, unsigned rng) {
+    int32_t d;
+    int32_t c;
+    int32_t s;
+    c = enc->cnt;
+    assert(rng <= 65535U);
+    d = 16 - OD_ILOG_NZ(rng);
+    s = c + d;
+    if (s >= 40) {
+        OdEcPrecarryPage *page = enc->precarry_page;
+        uint32_t          offs = enc->page_offs;
+        /*cnt starts at -9, one byte short of the bits held in low.*/
+        const int32_t nbytes = (s >> 3) + 1;
+        uint64_t      output;
+        if (offs + nbytes > OD_EC_PRECARRY_PAGE_SIZE) {
+            page = od_ec_enc_next_page(enc);
+            if (page == NULL) return;
+            offs = 0;
+        }
+        /*c becomes the number of bits of low that are not ready.*/
+        c += 24 - (nbytes << 3);
+        output = low >> c;
+        low &= ((OdEcEncWindow)1 << c) - 1;
+        if (output >> (nbytes << 3)) od_ec_enc_propagate_carry(page, offs);
+        for (int32_t i = nbytes - 1; i >= 0; i--) {
+            page->data[offs + i] = (uint8_t)output;
+            output >>= 8;
+        }
+        enc->offs += nbytes;
+        enc->page_offs = offs + nbytes;
+        s              = c + d - 24;
+    }
+    enc->low = low << d;
+    enc->rng = (int16_t)(rng << d);
+    enc->cnt = (int16_t)s;
+}
+#else
 /*Takes updated low and range values, renormalizes them so that
 32768 <= rng < 65536 (flushing bytes from low to the pre-carry buffer if
 necessary), and stores them back in the encoder context.
 low: The new value of low.
 rng: The new value of the range.*/
-static void od_ec_enc_normalize(OdEcEnc *enc, OdEcWindow low, unsigned rng) {
+static void od_ec_enc_normalize(OdEcEnc *enc, OdEcEncWindow low, unsigned rng) {
     int32_t d;
     int32_t c;
     int32_t s;
@@ -125,6 +295,31 @@ static void od_ec_enc_normalize(OdEcEnc *enc, OdEcWindow low, unsigned rng) {
     shift bits off the end of the window.
     For a 32-bit window this is about the same amount of work, but for a 64-bit
     window it should be a fair win.*/
+#if EC_GROWABLE_BUFFERS
+    if (s >= 0) {
+        OdEcPrecarryPage *page = enc->precarry_page;
+        uint32_t          offs = enc->page_offs;
+        unsigned          m;
+        if (offs + 2 > OD_EC_PRECARRY_PAGE_SIZE) {
+            page = od_ec_enc_next_page(enc);
+            if (page == NULL) return;
+            offs = 0;
+        }
+        c += 16;
+        m = (1 << c) - 1;
+        if (s >= 8) {
+            page->data[offs++] = (uint16_t)(low >> c);
+            low &= m;
+            c -= 8;
+            m >>= 8;
+        }
+        page->data[offs++] = (uint16_t)(low >> c);
+        s                  = c + d - 24;
+        low &= m;
+        enc->offs += offs - enc->page_offs;
+        enc->page_offs = offs;
+    }
+#else
     if (s >= 0) {
         uint16_t *buf;
         uint32_t  storage;
@@ -159,11 +354,14 @@ static void od_ec_enc_normalize(OdEcEnc *enc, OdEcWindow low, unsigned rng) {
         low &= m;
         enc->offs = offs;
     }
+#endif
     enc->low = low << d;
     enc->rng = (int16_t)(rng << d);
     enc->cnt = (int16_t)s;
 }
 
+#endif
+
 /*Initializes the encoder.
 size: The initial size of the buffer, in bytes.*/
 void eb_od_ec_enc_init(OdEcEnc *enc, uint32_t size) {
@@ -174,17 +372,30 @@ void eb_od_ec_enc_init(OdEcEnc *enc, uint32_t size) {
         enc->storage = 0;
         enc->error   = -1;
     }
+#if EC_GROWABLE_BUFFERS
+    enc->precarry_page = (OdEcPrecarryPage *)malloc(sizeof(*enc->precarry_page));
+    if (enc->precarry_page == NULL)
+        enc->error = -1;
+    else {
+        enc->precarry_page->prev  = NULL;
+        enc->precarry_page->count = 0;
+    }
+#else
     enc->precarry_buf     = (uint16_t *)malloc(sizeof(*enc->precarry_buf) * size);
     enc->precarry_storage = size;
     if (size > 0 && enc->precarry_buf == NULL) {
         enc->precarry_storage = 0;
         enc->error            = -1;
     }
+#endif
 }
 
 /*Reinitializes the encoder.*/
 void eb_od_ec_enc_reset(OdEcEnc *enc) {
     enc->offs = 0;
+#if EC_GROWABLE_BUFFERS
+    enc->page_offs = 0;
+#endif
     enc->low  = 0;
     enc->rng  = 0x8000;
     /*This is initialized to -9 so that it crosses zero after we've accumulated
@@ -199,7 +410,15 @@ void eb_od_ec_enc_reset(OdEcEnc *enc) {
 
 /*Frees the buffers used by the encoder.*/
 void eb_od_ec_enc_clear(OdEcEnc *enc) {
+#if EC_GROWABLE_BUFFERS
+    while (enc->precarry_page) {
+        OdEcPrecarryPage *prev = enc->precarry_page->prev;
+        free(enc->precarry_page);
+        enc->precarry_page = prev;
+    }
+#else
     free(enc->precarry_buf);
+#endif
     free(enc->buf);
 }
 
@@ -211,10 +430,10 @@ fh: CDF_PROB_TOP minus the cumulative frequency of all symbols up to and
 including
 the one to be encoded.*/
 static void od_ec_encode_q15(OdEcEnc *enc, unsigned fl, unsigned fh, int32_t s, int32_t nsyms) {
-    OdEcWindow l;
-    unsigned   r;
-    unsigned   u;
-    unsigned   v;
+    OdEcEncWindow l;
+    unsigned      r;
+    unsigned      u;
+    unsigned      v;
     l = enc->low;
     r = enc->rng;
     assert(32768U <= r);
@@ -244,9 +463,9 @@ static void od_ec_encode_q15(OdEcEnc *enc, unsigned fl, unsigned fh, int32_t s,
 val: The value to encode (0 or 1).
 f: The probability that the val is one, scaled by 32768.*/
 void eb_od_ec_encode_bool_q15(OdEcEnc *enc, int32_t val, unsigned f) {
-    OdEcWindow l;
-    unsigned   r;
-    unsigned   v;
+    OdEcEncWindow l;
+    unsigned      r;
+    unsigned      v;
     assert(0 < f);
     assert(f < 32768U);
     l = enc->low;
@@ -279,16 +498,47 @@ void eb_od_ec_encode_cdf_q15(OdEcEnc *enc, int32_t s, const uint16_t *icdf, int3
     od_ec_encode_q15(enc, s > 0 ? icdf[s - 1] : OD_ICDF(0), icdf[s], s, nsyms);
 }
 
+#if EC_FAST_RANGE_CODER
+/*Encodes a run of equiprobable bits, with the same output as a call to
+eb_od_ec_encode_bool_q15() with f = 16384 per bit.
+data: The bits to encode, the most significant one first.
+nbits: The number of bits of data to encode.*/
+void eb_od_ec_encode_literal_q15(OdEcEnc *enc, uint32_t data, int32_t nbits) {
+    for (int32_t i = nbits - 1; i >= 0; i--) {
+        OdEcEncWindow l = enc->low;
+        unsigned   r = enc->rng;
+        const unsigned v =
+            ((r >> 8) * (uint32_t)(16384 >> EC_PROB_SHIFT) >> (7 - EC_PROB_SHIFT)) + EC_MIN_PROB;
+        assert(32768U <= r);
+        if ((data >> i) & 1) {
+            l += r - v;
+            r = v;
+        } else
+            r -= v;
+        od_ec_enc_normalize(enc, l, r);
+    }
+#if OD_MEASURE_EC_OVERHEAD
+    enc->entropy += nbits;
+    enc->nb_symbols += nbits;
+#endif
+}
+#endif
+
 uint8_t *eb_od_ec_enc_done(OdEcEnc *enc, uint32_t *nbytes) {
-    uint8_t *  out;
-    uint32_t   storage;
-    uint16_t * buf;
-    uint32_t   offs;
-    OdEcWindow m;
-    OdEcWindow e;
-    OdEcWindow l;
-    int32_t    c;
-    int32_t    s;
+    uint8_t *     out;
+    uint32_t      storage;
+#if EC_GROWABLE_BUFFERS
+    OdEcPrecarryPage *page;
+    uint32_t          page_offs;
+#else
+    uint16_t *    buf;
+#endif
+    uint32_t      offs;
+    OdEcEncWindow m;
+    OdEcEncWindow e;
+    OdEcEncWindow l;
+    int32_t       c;
+    int32_t       s;
     if (enc->error) return NULL;
 #if OD_MEASURE_EC_OVERHEAD
     {
@@ -308,6 +558,48 @@ uint8_t *eb_od_ec_enc_done(OdEcEnc *enc, uint32_t *nbytes) {
     e = ((l + m) & ~m) | (m + 1);
     s += c;
     offs = enc->offs;
+#if EC_GROWABLE_BUFFERS
+    page      = enc->precarry_page;
+    page_offs = enc->page_offs;
+    if (s > 0) {
+#if EC_FAST_RANGE_CODER
+        OdEcEncWindow n;
+#else
+        unsigned n;
+#endif
+        if (page_offs + ((s + 7) >> 3) > OD_EC_PRECARRY_PAGE_SIZE) {
+            page = od_ec_enc_next_page(enc);
+            if (page == NULL) return NULL;
+            page_offs = 0;
+        }
+#if EC_FAST_RANGE_CODER
+        n = ((OdEcEncWindow)1 << (c + 16)) - 1;
+        do {
+            const unsigned val = (unsigned)(e >> (c + 16));
+            assert(page_offs < OD_EC_PRECARRY_PAGE_SIZE);
+            if (val & 0x100) od_ec_enc_propagate_carry(page, page_offs);
+            page->data[page_offs++] = (uint8_t)val;
+            offs++;
+            e &= n;
+            s -= 8;
+            c -= 8;
+            n >>= 8;
+        } while (s > 0);
+#else
+        n = (1 << (c + 16)) - 1;
+        do {
+            assert(page_offs < OD_EC_PRECARRY_PAGE_SIZE);
+            page->data[page_offs++] = (uint16_t)(e >> (c + 16));
+            offs++;
+            e &= n;
+            s -= 8;
+            c -= 8;
+            n >>= 8;
+        } while (s > 0);
+#endif
+    }
+    page->count = page_offs;
+#else
     buf  = enc->precarry_buf;
     if (s > 0) {
         unsigned n;
@@ -332,6 +624,7 @@ uint8_t *eb_od_ec_enc_done(OdEcEnc *enc, uint32_t *nbytes) {
             n >>= 8;
         } while (s > 0);
     }
+#endif
     /*Make sure there's enough room for the entropy-coded bits.*/
     out     = enc->buf;
     storage = enc->storage;
@@ -351,12 +644,35 @@ uint8_t *eb_od_ec_enc_done(OdEcEnc *enc, uint32_t *nbytes) {
     assert(offs <= storage);
     out = out + storage - offs;
     c   = 0;
+#if EC_FAST_RANGE_CODER
+    /*The carries are already in the pages, gather them.
+    Unlike with the pre-carry buffer, the carries of the final bytes are added
+    to the coded bytes, so the encoder cannot keep going after this call.*/
+    for (; page; page = page->prev) {
+        offs -= page->count;
+        memcpy(out + offs, page->data, page->count);
+    }
+    assert(offs == 0);
+#elif EC_GROWABLE_BUFFERS
+    for (; page; page = page->prev) {
+        page_offs = page->count;
+        while (page_offs > 0) {
+            page_offs--;
+            offs--;
+            c         = page->data[page_offs] + c;
+            out[offs] = (uint8_t)c;
+            c >>= 8;
+        }
+    }
+    assert(offs == 0);
+#else
     while (offs > 0) {
         offs--;
         c         = buf[offs] + c;
         out[offs] = (uint8_t)c;
         c >>= 8;
     }
+#endif
     /*Note: Unless there's an allocation error, if you keep encoding into the
     current buffer and call this function again later, everything will work
     just fine (you won't get a new packet out, but you will get a single
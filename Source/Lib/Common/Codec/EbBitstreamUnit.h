@@ -40,6 +40,11 @@ extern EbErrorType output_bitstream_unit_ctor(OutputBitstreamUnit *bitstream_ptr
                                               uint32_t             buffer_size);
 
 extern EbErrorType output_bitstream_reset(OutputBitstreamUnit *bitstream_ptr);
+#if EC_GROWABLE_BUFFERS
+// Grows the buffer, keeping what was written, so that bytes more can be written at buffer_av1
+extern EbErrorType output_bitstream_unit_reserve(OutputBitstreamUnit *bitstream_ptr,
+                                                 uint32_t             bytes);
+#endif
 
 /********************************************************************************************************************************/
 /********************************************************************************************************************************/
@@ -156,6 +161,12 @@ The 0* term provides compile-time type checking */
 /*OPT: OdEcWindow must be at least 32 bits, but if you have fast arithmetic
 on a larger type, you can speed up the decoder by using it here.*/
 typedef uint32_t OdEcWindow;
+#if EC_FAST_RANGE_CODER
+/*The encoder low register, 64 bits so it can be flushed several bytes at a time.*/
+typedef uint64_t OdEcEncWindow;
+#else
+typedef OdEcWindow OdEcEncWindow;
+#endif
 
 #define OD_EC_WINDOW_SIZE ((int32_t)sizeof(OdEcWindow) * CHAR_BIT)
 
@@ -171,6 +182,26 @@ typedef struct OdEcEnc OdEcEnc;
 
 #define OD_MEASURE_EC_OVERHEAD (0)
 
+#if EC_GROWABLE_BUFFERS
+/*Number of entries in a page of the pre-carry buffer.*/
+#define OD_EC_PRECARRY_PAGE_SIZE (1 << 14)
+
+/*A page of the pre-carry buffer.
+  Pages are chained as the encoder spills into them, so the buffer grows
+  without copying the bytes already coded.*/
+typedef struct OdEcPrecarryPage {
+    struct OdEcPrecarryPage *prev;
+    /*The number of entries used in data, set once the encoder moves on.*/
+    uint32_t count;
+#if EC_FAST_RANGE_CODER
+    /*Output bytes, the carries being already added to them.*/
+    uint8_t data[OD_EC_PRECARRY_PAGE_SIZE];
+#else
+    uint16_t data[OD_EC_PRECARRY_PAGE_SIZE];
+#endif
+} OdEcPrecarryPage;
+#endif
+
 /*The entropy encoder context.*/
 struct OdEcEnc {
     /*Buffered output.
@@ -181,14 +212,23 @@ struct OdEcEnc {
     uint32_t storage;
     /*The offset at which the last byte containing raw bits was written.*/
 
+#if EC_GROWABLE_BUFFERS
+    /*The last page of the buffer for output bytes with their associated carry flags.*/
+    OdEcPrecarryPage *precarry_page;
+    /*The offset at which the next entropy-coded byte will be written in precarry_page.*/
+    uint32_t page_offs;
+    /*The number of entropy-coded bytes written so far.*/
+    uint32_t offs;
+#else
     /*A buffer for output bytes with their associated carry flags.*/
     uint16_t *precarry_buf;
     /*The size of the pre-carry buffer.*/
     uint32_t precarry_storage;
     /*The offset at which the next entropy-coded byte will be written.*/
     uint32_t offs;
+#endif
     /*The low end of the current range.*/
-    OdEcWindow low;
+    OdEcEncWindow low;
     /*The number of values in the current range.*/
     uint16_t rng;
     /*The number of bits of data in the current value.*/
@@ -212,12 +252,64 @@ void eb_od_ec_encode_cdf_q15(OdEcEnc *enc, int32_t s, const uint16_t *cdf, int32
     OD_ARG_NONNULL(1) OD_ARG_NONNULL(3);
 
 void od_ec_enc_bits(OdEcEnc *enc, uint32_t fl, unsigned ftb) OD_ARG_NONNULL(1);
+#if EC_FAST_RANGE_CODER
+void eb_od_ec_encode_literal_q15(OdEcEnc *enc, uint32_t data, int32_t nbits) OD_ARG_NONNULL(1);
+#endif
 
 OD_WARN_UNUSED_RESULT uint8_t *eb_od_ec_enc_done(OdEcEnc *enc, uint32_t *nbytes) OD_ARG_NONNULL(1)
     OD_ARG_NONNULL(2);
 
 OD_WARN_UNUSED_RESULT int32_t eb_od_ec_enc_tell(const OdEcEnc *enc) OD_ARG_NONNULL(1);
 
+#if EC_SB_ROW_PIPELINE
+/********************************************************************************************************************************/
+// Symbols logged by a writer to be arithmetic coded later, in the same order
+typedef enum EcSymbolType {
+    EC_SYMBOL_BOOL,
+    EC_SYMBOL_LITERAL,
+    EC_SYMBOL_CDF,
+    // Split flag of a block crossing the picture edge, coded with the 2-symbol CDF gathered
+    // from the partition CDF (partition_gather_horz_alike / partition_gather_vert_alike)
+    EC_SYMBOL_PARTITION_HORZ_ALIKE,
+    EC_SYMBOL_PARTITION_VERT_ALIKE,
+    // Separates the symbols of two superblocks
+    EC_SYMBOL_MARK
+} EcSymbolType;
+
+typedef struct EcSymbol {
+    AomCdfProb *cdf; // NULL for bools and literals
+    uint32_t    value;
+    uint16_t    param; // probability, bit count, number of symbols or block size
+    uint8_t     type;
+    uint8_t     update; // adapt cdf once coded
+} EcSymbol;
+
+typedef struct EcSymbolLog {
+    EcSymbol *symbols;
+    uint32_t  count;
+    uint32_t  size;
+    int32_t   error; // nonzero if symbols were dropped
+} EcSymbolLog;
+
+extern EbErrorType ec_symbol_log_grow(EcSymbolLog *log);
+extern void        ec_symbol_log_free(EcSymbolLog *log);
+
+static INLINE void ec_symbol_log_push(EcSymbolLog *log, EcSymbolType type, AomCdfProb *cdf,
+                                      uint32_t value, uint16_t param, uint8_t update) {
+    EcSymbol *sym;
+    if (log->count == log->size && ec_symbol_log_grow(log) != EB_ErrorNone) {
+        log->error = -1;
+        return;
+    }
+    sym         = &log->symbols[log->count++];
+    sym->cdf    = cdf;
+    sym->value  = value;
+    sym->param  = param;
+    sym->type   = (uint8_t)type;
+    sym->update = update;
+}
+#endif
+
 /********************************************************************************************************************************/
 //daalaboolwriter.h
 struct DaalaWriter {
@@ -225,12 +317,26 @@ struct DaalaWriter {
     uint8_t *buffer;
     OdEcEnc  ec;
     uint8_t  allow_update_cdf;
+#if EC_GROWABLE_BUFFERS
+    /*When set, buffer is the write position of this unit, grown to fit the coded bytes.*/
+    OutputBitstreamUnit *bitstream_unit;
+#endif
+#if EC_SB_ROW_PIPELINE
+    /*When set, the aom_write functions append to this log instead of coding, see
+      eb_aom_write_logged_symbols().*/
+    EcSymbolLog *symbol_log;
+#endif
 };
 
 typedef struct DaalaWriter DaalaWriter;
 
 void    eb_aom_daala_start_encode(DaalaWriter *w, uint8_t *buffer);
 int32_t eb_aom_daala_stop_encode(DaalaWriter *w);
+#if EC_SB_ROW_PIPELINE
+/*Codes the logged symbols from start up to the next EC_SYMBOL_MARK, adapting their CDFs, and
+  returns the index after the mark.*/
+uint32_t eb_aom_write_logged_symbols(DaalaWriter *w, const EcSymbolLog *log, uint32_t start);
+#endif
 
 static INLINE void aom_daala_write(DaalaWriter *w, int32_t bit, int32_t prob) {
     int32_t p = (0x7FFFFF - (prob << 15) + prob) >> 8;
@@ -256,10 +362,23 @@ typedef struct DaalaWriter AomWriter;
 static INLINE void aom_start_encode(AomWriter *bc, uint8_t *buffer) {
     eb_aom_daala_start_encode(bc, buffer);
 }
+#if EC_GROWABLE_BUFFERS
+static INLINE void aom_start_encode_unit(AomWriter *bc, OutputBitstreamUnit *bitstream_ptr) {
+    eb_aom_daala_start_encode(bc, bitstream_ptr->buffer_av1);
+    bc->bitstream_unit = bitstream_ptr;
+}
+#endif
 
 static INLINE int32_t aom_stop_encode(AomWriter *bc) { return eb_aom_daala_stop_encode(bc); }
 
 static INLINE void aom_write(AomWriter *br, int32_t bit, int32_t probability) {
+#if EC_SB_ROW_PIPELINE
+    if (br->symbol_log) {
+        ec_symbol_log_push(
+            br->symbol_log, EC_SYMBOL_BOOL, NULL, (uint32_t)bit, (uint16_t)probability, 0);
+        return;
+    }
+#endif
     aom_daala_write(br, bit, probability);
 }
 
@@ -267,10 +386,63 @@ static INLINE void aom_write_bit(AomWriter *w, int32_t bit) {
     aom_write(w, bit, 128); // aom_prob_half
 }
 
+#if EC_SB_ROW_PIPELINE
+static INLINE void aom_daala_write_literal(DaalaWriter *w, int32_t data, int32_t bits) {
+#if EC_FAST_RANGE_CODER && !CONFIG_BITSTREAM_DEBUG
+    eb_od_ec_encode_literal_q15(&w->ec, (uint32_t)data, bits);
+#else
+    int32_t bit;
+
+    for (bit = bits - 1; bit >= 0; bit--) aom_daala_write(w, 1 & (data >> bit), 128);
+#endif
+}
+
+static INLINE void aom_write_literal(AomWriter *w, int32_t data, int32_t bits) {
+    if (w->symbol_log) {
+        ec_symbol_log_push(
+            w->symbol_log, EC_SYMBOL_LITERAL, NULL, (uint32_t)data, (uint16_t)bits, 0);
+        return;
+    }
+    aom_daala_write_literal(w, data, bits);
+}
+
+static INLINE void aom_write_cdf(AomWriter *w, int32_t symb, const AomCdfProb *cdf,
+                                 int32_t nsymbs) {
+    if (w->symbol_log) {
+        ec_symbol_log_push(w->symbol_log,
+                           EC_SYMBOL_CDF,
+                           (AomCdfProb *)cdf,
+                           (uint32_t)symb,
+                           (uint16_t)nsymbs,
+                           0);
+        return;
+    }
+    daala_write_symbol(w, symb, cdf, nsymbs);
+}
+
+static INLINE void aom_write_symbol(AomWriter *w, int32_t symb, AomCdfProb *cdf, int32_t nsymbs) {
+    if (w->symbol_log) {
+        // The CDF is adapted when the symbol is coded, so the contexts must not read its values
+        ec_symbol_log_push(w->symbol_log,
+                           EC_SYMBOL_CDF,
+                           cdf,
+                           (uint32_t)symb,
+                           (uint16_t)nsymbs,
+                           w->allow_update_cdf);
+        return;
+    }
+    daala_write_symbol(w, symb, cdf, nsymbs);
+    if (w->allow_update_cdf) update_cdf(cdf, symb, nsymbs);
+}
+#else
 static INLINE void aom_write_literal(AomWriter *w, int32_t data, int32_t bits) {
+#if EC_FAST_RANGE_CODER && !CONFIG_BITSTREAM_DEBUG
+    eb_od_ec_encode_literal_q15(&w->ec, (uint32_t)data, bits);
+#else
     int32_t bit;
 
     for (bit = bits - 1; bit >= 0; bit--) aom_write_bit(w, 1 & (data >> bit));
+#endif
 }
 
 static INLINE void aom_write_cdf(AomWriter *w, int32_t symb, const AomCdfProb *cdf,
@@ -282,6 +454,7 @@ static INLINE void aom_write_symbol(AomWriter *w, int32_t symb, AomCdfProb *cdf,
     aom_write_cdf(w, symb, cdf, nsymbs);
     if (w->allow_update_cdf) update_cdf(cdf, symb, nsymbs);
 }
+#endif
 
 /********************************************************************************************************************************/
 /********************************************************************************************************************************/
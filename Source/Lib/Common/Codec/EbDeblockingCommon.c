@@ -824,6 +824,73 @@ void aom_highbd_lpf_vertical_14_c(uint16_t *s, int p, const uint8_t *blimit,
     int bd) {
     highbd_mb_lpf_vertical_edge_w(s, p, blimit, limit, thresh, 4, bd);
 }
+#if DLF_DUAL_EDGE_AVX2
+// Filter two adjacent 4-sample edges, each with its own thresholds. The
+// second edge starts 4 columns (horizontal) or 4 rows (vertical) after s.
+void aom_highbd_lpf_horizontal_4_dual_c(uint16_t *s, int32_t pitch, const uint8_t *blimit0,
+                                        const uint8_t *limit0, const uint8_t *thresh0,
+                                        const uint8_t *blimit1, const uint8_t *limit1,
+                                        const uint8_t *thresh1, int32_t bd) {
+    aom_highbd_lpf_horizontal_4_c(s, pitch, blimit0, limit0, thresh0, bd);
+    aom_highbd_lpf_horizontal_4_c(s + 4, pitch, blimit1, limit1, thresh1, bd);
+}
+
+void aom_highbd_lpf_horizontal_6_dual_c(uint16_t *s, int32_t pitch, const uint8_t *blimit0,
+                                        const uint8_t *limit0, const uint8_t *thresh0,
+                                        const uint8_t *blimit1, const uint8_t *limit1,
+                                        const uint8_t *thresh1, int32_t bd) {
+    aom_highbd_lpf_horizontal_6_c(s, pitch, blimit0, limit0, thresh0, bd);
+    aom_highbd_lpf_horizontal_6_c(s + 4, pitch, blimit1, limit1, thresh1, bd);
+}
+
+void aom_highbd_lpf_horizontal_8_dual_c(uint16_t *s, int32_t pitch, const uint8_t *blimit0,
+                                        const uint8_t *limit0, const uint8_t *thresh0,
+                                        const uint8_t *blimit1, const uint8_t *limit1,
+                                        const uint8_t *thresh1, int32_t bd) {
+    aom_highbd_lpf_horizontal_8_c(s, pitch, blimit0, limit0, thresh0, bd);
+    aom_highbd_lpf_horizontal_8_c(s + 4, pitch, blimit1, limit1, thresh1, bd);
+}
+
+void aom_highbd_lpf_horizontal_14_dual_c(uint16_t *s, int32_t pitch, const uint8_t *blimit0,
+                                         const uint8_t *limit0, const uint8_t *thresh0,
+                                         const uint8_t *blimit1, const uint8_t *limit1,
+                                         const uint8_t *thresh1, int32_t bd) {
+    aom_highbd_lpf_horizontal_14_c(s, pitch, blimit0, limit0, thresh0, bd);
+    aom_highbd_lpf_horizontal_14_c(s + 4, pitch, blimit1, limit1, thresh1, bd);
+}
+
+void aom_highbd_lpf_vertical_4_dual_c(uint16_t *s, int32_t pitch, const uint8_t *blimit0,
+                                      const uint8_t *limit0, const uint8_t *thresh0,
+                                      const uint8_t *blimit1, const uint8_t *limit1,
+                                      const uint8_t *thresh1, int32_t bd) {
+    aom_highbd_lpf_vertical_4_c(s, pitch, blimit0, limit0, thresh0, bd);
+    aom_highbd_lpf_vertical_4_c(s + 4 * pitch, pitch, blimit1, limit1, thresh1, bd);
+}
+
+void aom_highbd_lpf_vertical_6_dual_c(uint16_t *s, int32_t pitch, const uint8_t *blimit0,
+                                      const uint8_t *limit0, const uint8_t *thresh0,
+                                      const uint8_t *blimit1, const uint8_t *limit1,
+                                      const uint8_t *thresh1, int32_t bd) {
+    aom_highbd_lpf_vertical_6_c(s, pitch, blimit0, limit0, thresh0, bd);
+    aom_highbd_lpf_vertical_6_c(s + 4 * pitch, pitch, blimit1, limit1, thresh1, bd);
+}
+
+void aom_highbd_lpf_vertical_8_dual_c(uint16_t *s, int32_t pitch, const uint8_t *blimit0,
+                                      const uint8_t *limit0, const uint8_t *thresh0,
+                                      const uint8_t *blimit1, const uint8_t *limit1,
+                                      const uint8_t *thresh1, int32_t bd) {
+    aom_highbd_lpf_vertical_8_c(s, pitch, blimit0, limit0, thresh0, bd);
+    aom_highbd_lpf_vertical_8_c(s + 4 * pitch, pitch, blimit1, limit1, thresh1, bd);
+}
+
+void aom_highbd_lpf_vertical_14_dual_c(uint16_t *s, int32_t pitch, const uint8_t *blimit0,
+                                       const uint8_t *limit0, const uint8_t *thresh0,
+                                       const uint8_t *blimit1, const uint8_t *limit1,
+                                       const uint8_t *thresh1, int32_t bd) {
+    aom_highbd_lpf_vertical_14_c(s, pitch, blimit0, limit0, thresh0, bd);
+    aom_highbd_lpf_vertical_14_c(s + 4 * pitch, pitch, blimit1, limit1, thresh1, bd);
+}
+#endif
 
 static INLINE void filter14(int8_t mask, uint8_t thresh, int8_t flat,
     int8_t flat2, uint8_t *op6, uint8_t *op5,
@@ -929,3 +996,69 @@ void aom_lpf_vertical_14_c(uint8_t *s, int p, const uint8_t *blimit,
     const uint8_t *limit, const uint8_t *thresh) {
     mb_lpf_vertical_edge_w(s, p, blimit, limit, thresh, 4);
 }
+#if DLF_DUAL_EDGE_AVX2
+// 8-bit counterparts of the aom_highbd_lpf_*_dual_c() functions above.
+void aom_lpf_horizontal_4_dual_c(uint8_t *s, int32_t pitch, const uint8_t *blimit0,
+                                 const uint8_t *limit0, const uint8_t *thresh0,
+                                 const uint8_t *blimit1, const uint8_t *limit1,
+                                 const uint8_t *thresh1) {
+    aom_lpf_horizontal_4_c(s, pitch, blimit0, limit0, thresh0);
+    aom_lpf_horizontal_4_c(s + 4, pitch, blimit1, limit1, thresh1);
+}
+
+void aom_lpf_horizontal_6_dual_c(uint8_t *s, int32_t pitch, const uint8_t *blimit0,
+                                 const uint8_t *limit0, const uint8_t *thresh0,
+                                 const uint8_t *blimit1, const uint8_t *limit1,
+                                 const uint8_t *thresh1) {
+    aom_lpf_horizontal_6_c(s, pitch, blimit0, limit0, thresh0);
+    aom_lpf_horizontal_6_c(s + 4, pitch, blimit1, limit1, thresh1);
+}
+
+void aom_lpf_horizontal_8_dual_c(uint8_t *s, int32_t pitch, const uint8_t *blimit0,
+                                 const uint8_t *limit0, const uint8_t *thresh0,
+                                 const uint8_t *blimit1, const uint8_t *limit1,
+                                 const uint8_t *thresh1) {
+    aom_lpf_horizontal_8_c(s, pitch, blimit0, limit0, thresh0);
+    aom_lpf_horizontal_8_c(s + 4, pitch, blimit1, limit1, thresh1);
+}
+
+void aom_lpf_horizontal_14_dual_c(uint8_t *s, int32_t pitch, const uint8_t *blimit0,
+                                  const uint8_t *limit0, const uint8_t *thresh0,
+                                  const uint8_t *blimit1, const uint8_t *limit1,
+                                  const uint8_t *thresh1) {
+    aom_lpf_horizontal_14_c(s, pitch, blimit0, limit0, thresh0);
+    aom_lpf_horizontal_14_c(s + 4, pitch, blimit1, limit1, thresh1);
+}
+
+void aom_lpf_vertical_4_dual_c(uint8_t *s, int32_t pitch, const uint8_t *blimit0,
+                               const uint8_t *limit0, const uint8_t *thresh0,
+                               const uint8_t *blimit1, const uint8_t *limit1,
+                               const uint8_t *thresh1) {
+    aom_lpf_vertical_4_c(s, pitch, blimit0, limit0, thresh0);
+    aom_lpf_vertical_4_c(s + 4 * pitch, pitch, blimit1, limit1, thresh1);
+}
+
+void aom_lpf_vertical_6_dual_c(uint8_t *s, int32_t pitch, const uint8_t *blimit0,
+                               const uint8_t *limit0, const uint8_t *thresh0,
+                               const uint8_t *blimit1, const uint8_t *limit1,
+                               const uint8_t *thresh1) {
+    aom_lpf_vertical_6_c(s, pitch, blimit0, limit0, thresh0);
+    aom_lpf_vertical_6_c(s + 4 * pitch, pitch, blimit1, limit1, thresh1);
+}
+
+void aom_lpf_vertical_8_dual_c(uint8_t *s, int32_t pitch, const uint8_t *blimit0,
+                               const uint8_t *limit0, const uint8_t *thresh0,
+                               const uint8_t *blimit1, const uint8_t *limit1,
+                               const uint8_t *thresh1) {
+    aom_lpf_vertical_8_c(s, pitch, blimit0, limit0, thresh0);
+    aom_lpf_vertical_8_c(s + 4 * pitch, pitch, blimit1, limit1, thresh1);
+}
+
+void aom_lpf_vertical_14_dual_c(uint8_t *s, int32_t pitch, const uint8_t *blimit0,
+                                const uint8_t *limit0, const uint8_t *thresh0,
+                                const uint8_t *blimit1, const uint8_t *limit1,
+                                const uint8_t *thresh1) {
+    aom_lpf_vertical_14_c(s, pitch, blimit0, limit0, thresh0);
+    aom_lpf_vertical_14_c(s + 4 * pitch, pitch, blimit1, limit1, thresh1);
+}
+#endif
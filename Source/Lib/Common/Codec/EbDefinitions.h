@@ -145,6 +145,32 @@ extern "C" {
 #endif
 
 #define PALETTE_SPEEDUP 1 //Flag to use optimized version of av1_get_palette_color_index_context()
+#define SB_SIZE_BASED_BLK_ALLOC 1 // Size the per-SB block arrays to the active SB size instead of the 128x128 SB maximum, and build the block geometry once per SB size
+#define DLF_DUAL_EDGE_AVX2 1 // Deblocking of two adjacent 4-sample edges per call, with AVX2 kernels holding both sides of the edge in one register
+#define DLF_CDEF_ROW_PIPELINE 1 // Deblock the frame SB row by SB row and post the CDEF search segments as soon as their rows are deblocked
+#define DLF_SUBSAMPLED_SEARCH 1 // Start the deblocking level search from the qindex model, and run the trial filtering on a subsampled set of SB rows
+#define MD_CAND_CLASS_STATS 1 // Per candidate class MD counters (injected, stage survivors, winners, cycles), gathered and reported per picture and per temporal layer when StatReport is 2
+#define MD_RATE_EST_INCREMENTAL 1 // Only recompute the MD rate tables of the CDF groups that changed since the table was last built
+#define TX_TYPE_PRUNING 1 // Two-stage tx type search: rank the allowed tx types using the transform-domain SATD, then run the full RD on the top-K only
+#define CDEF_REF_SEEDED_SEARCH 1 // Seed the per-SB CDEF strength search with the strengths picked for the co-located SB of the L0 reference, widen it ring by ring and stop once the distortion gain flattens
+#define SGR_INTEGRAL_CACHE 1 // Build the self-guided integral images of a restoration unit once and share them across all the sgr_params_idx candidates of the search
+#define PKT_ZERO_COPY 1 // Write the frame OBUs straight into the output packet and build each temporal unit in place, without the staging bitstream and the per-TU copy
+#define EC_GROWABLE_BUFFERS 1 // Start the entropy coder output buffers small and grow them on demand, and chain the range coder pre-carry buffer in pages instead of reallocating it
+#if EC_GROWABLE_BUFFERS
+#define EC_FAST_RANGE_CODER 1 // 64-bit range encoder window flushed several bytes at a time, bytes written directly with backward carry propagation, and batched equiprobable literals
+#endif
+#define EC_SB_ROW_PIPELINE 1 // Single tile entropy coding: log the symbols of an SB row (contexts, tokens, CDF to adapt) on one thread while the previous rows are arithmetic coded on another
+#define PSNR_METRICS_STAGE 1 // stat_report SSE computed in a dedicated metrics stage with SIMD distortion kernels, packetization waits for it
+#define DEC_CLAMP_PRLL_FRAMES 1 // Decoder: num_p_frames outside [1 - DEC_MAX_NUM_FRM_PRLL] is clamped with a warning instead of silently
+#define DEC_EXT_FRAME_BUF 1 // Decoder: picture memory from the EbSvtAv1ExtFrameBuf callbacks, output returned by reference
+#define DEC_PARSE_RECON_OVERLAP 1 // Decoder MT: wake recon as soon as a tile starts parsing, start LR with CDEF when there is no superres
+#define DEC_PARKED_WORKERS 1 // Decoder MT: park idle workers and row-dependency waiters on a condition variable instead of spinning
+#define DEC_FUSED_POST_FILTER 1 // Decoder MT: run CDEF and LR on the rows an LF thread just completed before deblocking the next row
+#define DEC_POOLED_MT_REALLOC 1 // Decoder MT: size row/tile structures for the sequence maximum, re-init only when a frame outgrows them
+#define FILM_GRAIN_SIMD 1 // Film grain: blend and overlap kernels through RTCD with AVX2/AVX-512 versions
+#define DEC_FAST_ENTROPY 1 // Decoder: 64-bit entropy decoder window refilled 8 bytes at a time, SSE2 CDF search fused with the CDF adaptation, dedicated coeff base range loop
+#define DEC_ROI_DECODE 1 // Decoder: svt_av1_dec_set_roi() reconstructs and filters only the tiles covering a region, reference region tracking
+#define DEC_OUT_CONVERT 1 // Decoder: output copy with bit depth conversion and NV12/P010 interleaving through SIMD kernels, split in row bands over the MT workers
 
 typedef enum MeHpMode {
     EX_HP_MODE        = 0, // Exhaustive  1/2-pel serach mode.
@@ -515,6 +541,20 @@ typedef struct ConvolveParams {
     int32_t      use_dist_wtd_comp_avg;
 } ConvolveParams;
 
+#if FILM_GRAIN_SIMD
+// Film grain scaling state shared by the grain blend kernels
+typedef struct FgnScaleParams {
+    const int32_t *scaling_lut; // 257 entries, [256] repeats [255] for interpolation
+    int32_t        scaling_shift;
+    int32_t        luma_mult; // chroma only
+    int32_t        mult; // chroma only
+    int32_t        offset; // chroma only
+    int32_t        min_value;
+    int32_t        max_value;
+    int32_t        bit_depth;
+} FgnScaleParams;
+#endif
+
 // texture component type
 typedef enum ATTRIBUTE_PACKED {
     COMPONENT_LUMA      = 0, // luma
@@ -584,6 +624,15 @@ typedef enum CandClass {
 } CandClass;
 
 typedef enum MdStage { MD_STAGE_0, MD_STAGE_1, MD_STAGE_2, MD_STAGE_3, MD_STAGE_TOTAL } MdStage;
+#if MD_CAND_CLASS_STATS
+// Candidate class counters: [MD_STAGE_0] holds the injected candidates,
+// [MD_STAGE_1..3] the candidates that survived to that stage
+typedef struct MdClassStats {
+    uint64_t cand_count[MD_STAGE_TOTAL][CAND_CLASS_TOTAL];
+    uint64_t win_count[CAND_CLASS_TOTAL];
+    uint64_t cycles[MD_STAGE_TOTAL][CAND_CLASS_TOTAL];
+} MdClassStats;
+#endif
 
 typedef enum MdStagingMode {
     MD_STAGING_MODE_0,
@@ -2225,6 +2274,9 @@ typedef enum EbPtrType
     EB_MUTEX        = 3,     // mutex
     EB_SEMAPHORE    = 4,     // semaphore
     EB_THREAD       = 5,      // thread handle
+#if DEC_PARKED_WORKERS
+    EB_COND_VAR     = 6,     // condition variable
+#endif
     EB_PTR_TYPE_TOTAL,
 } EbPtrType;
 
@@ -2311,6 +2363,23 @@ extern    uint32_t                   app_malloc_count;
         } \
     } while (0)
 
+#if DEC_PARKED_WORKERS
+#define EB_CREATE_COND_VAR(pointer) \
+    do { \
+        pointer = eb_create_cond_var(); \
+        EB_ADD_MEM(pointer, 1, EB_COND_VAR); \
+    } while (0)
+
+#define EB_DESTROY_COND_VAR(pointer) \
+    do { \
+        if (pointer) { \
+            eb_destroy_cond_var(pointer); \
+            EB_REMOVE_MEM_ENTRY(pointer, EB_COND_VAR); \
+            pointer = NULL; \
+        } \
+    } while (0)
+#endif
+
 
 #define EB_MEMORY() \
 SVT_LOG("Total Number of Mallocs in Library: %d\n", lib_malloc_count); \
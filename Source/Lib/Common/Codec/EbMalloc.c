@@ -135,7 +135,11 @@ static EbBool for_each_mem_entry(uint32_t start, Predicate pred, void* param) {
 
 static const char* mem_type_name(EbPtrType type) {
     static const char* name[EB_PTR_TYPE_TOTAL] = {
-        "malloced memory", "calloced memory", "aligned memory", "mutex", "semaphore", "thread"};
+        "malloced memory", "calloced memory", "aligned memory", "mutex", "semaphore", "thread"
+#if DEC_PARKED_WORKERS
+        , "condition variable"
+#endif
+    };
     return name[type];
 }
 
@@ -309,6 +313,9 @@ void eb_print_memory_usage() {
     SVT_INFO("    mutex count: %d\r\n", (int)sum.amount[EB_MUTEX]);
     SVT_INFO("    semaphore count: %d\r\n", (int)sum.amount[EB_SEMAPHORE]);
     SVT_INFO("    thread count: %d\r\n", (int)sum.amount[EB_THREAD]);
+#if DEC_PARKED_WORKERS
+    SVT_INFO("    condition variable count: %d\r\n", (int)sum.amount[EB_COND_VAR]);
+#endif
     fulless = (double)sum.occupied / MEM_ENTRY_SIZE;
     SVT_INFO("    hash table fulless: %f, hash bucket is %s\r\n",
              fulless,
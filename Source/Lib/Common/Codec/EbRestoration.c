@@ -703,6 +703,28 @@ static void boxsum(int32_t *src, int32_t width, int32_t height, int32_t src_stri
         assert(0 && "Invalid value of r in self-guided filter");
 }
 
+#if SGR_INTEGRAL_CACHE
+// Box sums of squares (A) and sums (B) over the processing unit and a 1-pixel border, from the
+// integral images C (squares) and D (sums) pointing at position (0, 0). The integral images may
+// wrap around at 12-bit; a box sum always fits in 32 bits, so unsigned arithmetic is exact.
+static void boxsum_from_ii(const int32_t *C, const int32_t *D, int32_t ii_stride, int32_t r,
+                           int32_t width, int32_t height, int32_t *A, int32_t *B,
+                           int32_t buf_stride) {
+    for (int32_t i = -1; i < height + 1; ++i) {
+        const uint32_t *c_top = (const uint32_t *)C + (i - r - 1) * ii_stride;
+        const uint32_t *c_bot = (const uint32_t *)C + (i + r) * ii_stride;
+        const uint32_t *d_top = (const uint32_t *)D + (i - r - 1) * ii_stride;
+        const uint32_t *d_bot = (const uint32_t *)D + (i + r) * ii_stride;
+        for (int32_t j = -1; j < width + 1; ++j) {
+            A[i * buf_stride + j] =
+                (int32_t)(c_bot[j + r] - c_bot[j - r - 1] - c_top[j + r] + c_top[j - r - 1]);
+            B[i * buf_stride + j] =
+                (int32_t)(d_bot[j + r] - d_bot[j - r - 1] - d_top[j + r] + d_top[j - r - 1]);
+        }
+    }
+}
+
+#endif
 void eb_decode_xq(const int32_t *xqd, int32_t *xq, const SgrParamsType *params) {
     if (params->r[0] == 0) {
         xq[0] = 0;
@@ -743,7 +765,12 @@ const int32_t eb_one_by_x[MAX_NELEM] = {
 static void selfguided_restoration_fast_internal(int32_t *dgd, int32_t width, int32_t height,
                                                  int32_t dgd_stride, int32_t *dst,
                                                  int32_t dst_stride, int32_t bit_depth,
-                                                 int32_t sgr_params_idx, int32_t radius_idx) {
+                                                 int32_t sgr_params_idx,
+#if SGR_INTEGRAL_CACHE
+                                                 const int32_t *ii_c, const int32_t *ii_d,
+                                                 int32_t ii_stride,
+#endif
+                                                 int32_t radius_idx) {
     const SgrParamsType *const params     = &eb_sgr_params[sgr_params_idx];
     const int32_t              r          = params->r[radius_idx];
     const int32_t              width_ext  = width + 2 * SGRPROJ_BORDER_HORZ;
@@ -763,6 +790,9 @@ static void selfguided_restoration_fast_internal(int32_t *dgd, int32_t width, in
     assert(r <= SGRPROJ_BORDER_VERT - 1 && r <= SGRPROJ_BORDER_HORZ - 1 &&
            "Need SGRPROJ_BORDER_* >= r+1");
 
+#if SGR_INTEGRAL_CACHE
+    if (!ii_c) {
+#endif
     boxsum(dgd - dgd_stride * SGRPROJ_BORDER_VERT - SGRPROJ_BORDER_HORZ,
            width_ext,
            height_ext,
@@ -779,8 +809,14 @@ static void selfguided_restoration_fast_internal(int32_t *dgd, int32_t width, in
            1,
            A,
            buf_stride);
+#if SGR_INTEGRAL_CACHE
+    }
+#endif
     A += SGRPROJ_BORDER_VERT * buf_stride + SGRPROJ_BORDER_HORZ;
     B += SGRPROJ_BORDER_VERT * buf_stride + SGRPROJ_BORDER_HORZ;
+#if SGR_INTEGRAL_CACHE
+    if (ii_c) boxsum_from_ii(ii_c, ii_d, ii_stride, r, width, height, A, B, buf_stride);
+#endif
     // Calculate the eventual A[] and B[] arrays. Include a 1-pixel border - ie,
     // for a 64x64 processing unit, we calculate 66x66 pixels of A[] and B[].
     for (i = -1; i < height + 1; i += 2) {
@@ -883,6 +919,10 @@ static void selfguided_restoration_fast_internal(int32_t *dgd, int32_t width, in
 static void selfguided_restoration_internal(int32_t *dgd, int32_t width, int32_t height,
                                             int32_t dgd_stride, int32_t *dst, int32_t dst_stride,
                                             int32_t bit_depth, int32_t sgr_params_idx,
+#if SGR_INTEGRAL_CACHE
+                                            const int32_t *ii_c, const int32_t *ii_d,
+                                            int32_t ii_stride,
+#endif
                                             int32_t radius_idx) {
     const SgrParamsType *const params     = &eb_sgr_params[sgr_params_idx];
     const int32_t              r          = params->r[radius_idx];
@@ -903,6 +943,9 @@ static void selfguided_restoration_internal(int32_t *dgd, int32_t width, int32_t
     assert(r <= SGRPROJ_BORDER_VERT - 1 && r <= SGRPROJ_BORDER_HORZ - 1 &&
            "Need SGRPROJ_BORDER_* >= r+1");
 
+#if SGR_INTEGRAL_CACHE
+    if (!ii_c) {
+#endif
     boxsum(dgd - dgd_stride * SGRPROJ_BORDER_VERT - SGRPROJ_BORDER_HORZ,
            width_ext,
            height_ext,
@@ -919,8 +962,14 @@ static void selfguided_restoration_internal(int32_t *dgd, int32_t width, int32_t
            1,
            A,
            buf_stride);
+#if SGR_INTEGRAL_CACHE
+    }
+#endif
     A += SGRPROJ_BORDER_VERT * buf_stride + SGRPROJ_BORDER_HORZ;
     B += SGRPROJ_BORDER_VERT * buf_stride + SGRPROJ_BORDER_HORZ;
+#if SGR_INTEGRAL_CACHE
+    if (ii_c) boxsum_from_ii(ii_c, ii_d, ii_stride, r, width, height, A, B, buf_stride);
+#endif
     // Calculate the eventual A[] and B[] arrays. Include a 1-pixel border - ie,
     // for a 64x64 processing unit, we calculate 66x66 pixels of A[] and B[].
     for (i = -1; i < height + 1; ++i) {
@@ -1008,10 +1057,17 @@ static void selfguided_restoration_internal(int32_t *dgd, int32_t width, int32_t
     }
 }
 
+#if SGR_INTEGRAL_CACHE
+static void selfguided_restoration_c(const uint8_t *dgd8, int32_t width, int32_t height,
+                                     int32_t dgd_stride, const int32_t *ii, int32_t *flt0,
+                                     int32_t *flt1, int32_t flt_stride, int32_t sgr_params_idx,
+                                     int32_t bit_depth, int32_t highbd) {
+#else
 void eb_av1_selfguided_restoration_c(const uint8_t *dgd8, int32_t width, int32_t height,
                                      int32_t dgd_stride, int32_t *flt0, int32_t *flt1,
                                      int32_t flt_stride, int32_t sgr_params_idx, int32_t bit_depth,
                                      int32_t highbd) {
+#endif
     int32_t       dgd32_[RESTORATION_PROC_UNIT_PELS];
     const int32_t dgd32_stride = width + 2 * SGRPROJ_BORDER_HORZ;
     int32_t *     dgd32        = dgd32_ + dgd32_stride * SGRPROJ_BORDER_VERT + SGRPROJ_BORDER_HORZ;
@@ -1035,6 +1091,103 @@ void eb_av1_selfguided_restoration_c(const uint8_t *dgd8, int32_t width, int32_t
     // skipping SGR entirely.
     assert(!(params->r[0] == 0 && params->r[1] == 0));
 
+#if SGR_INTEGRAL_CACHE
+    const int32_t  ii_stride = sgr_ii_stride(width);
+    const int32_t *ii_c      = ii ? sgr_ii_origin(ii, ii_stride) : NULL;
+    const int32_t *ii_d      = ii ? sgr_ii_origin(ii + SGRPROJ_II_BUF_ELTS, ii_stride) : NULL;
+    if (params->r[0] > 0)
+        selfguided_restoration_fast_internal(dgd32,
+                                             width,
+                                             height,
+                                             dgd32_stride,
+                                             flt0,
+                                             flt_stride,
+                                             bit_depth,
+                                             sgr_params_idx,
+                                             ii_c,
+                                             ii_d,
+                                             ii_stride,
+                                             0);
+    if (params->r[1] > 0)
+        selfguided_restoration_internal(dgd32,
+                                        width,
+                                        height,
+                                        dgd32_stride,
+                                        flt1,
+                                        flt_stride,
+                                        bit_depth,
+                                        sgr_params_idx,
+                                        ii_c,
+                                        ii_d,
+                                        ii_stride,
+                                        1);
+}
+
+void eb_av1_selfguided_restoration_c(const uint8_t *dgd8, int32_t width, int32_t height,
+                                     int32_t dgd_stride, int32_t *flt0, int32_t *flt1,
+                                     int32_t flt_stride, int32_t sgr_params_idx, int32_t bit_depth,
+                                     int32_t highbd) {
+    selfguided_restoration_c(dgd8,
+                             width,
+                             height,
+                             dgd_stride,
+                             NULL,
+                             flt0,
+                             flt1,
+                             flt_stride,
+                             sgr_params_idx,
+                             bit_depth,
+                             highbd);
+}
+
+void eb_av1_sgr_integral_images_c(const uint8_t *dgd8, int32_t width, int32_t height,
+                                  int32_t dgd_stride, int32_t *ii, int32_t highbd) {
+    const int32_t  buf_stride      = sgr_ii_stride(width);
+    const int32_t  width_ext       = width + 2 * SGRPROJ_BORDER_HORZ;
+    const int32_t  height_ext      = height + 2 * SGRPROJ_BORDER_VERT;
+    const int32_t  dgd_diag_border = SGRPROJ_BORDER_HORZ + dgd_stride * SGRPROJ_BORDER_VERT;
+    const uint8_t *dgd0            = dgd8 - dgd_diag_border;
+    // Unsigned so that the sums of squares may wrap around at 12-bit
+    uint32_t *ctl = (uint32_t *)ii + 7;
+    uint32_t *dtl = (uint32_t *)ii + SGRPROJ_II_BUF_ELTS + 7;
+
+    memset(ctl, 0, sizeof(*ctl) * (width_ext + 1));
+    memset(dtl, 0, sizeof(*dtl) * (width_ext + 1));
+    for (int32_t i = 0; i < height_ext; ++i) {
+        uint32_t *ct    = ctl + (i + 1) * buf_stride;
+        uint32_t *dt    = dtl + (i + 1) * buf_stride;
+        uint32_t  c_row = 0;
+        uint32_t  d_row = 0;
+        ct[0] = dt[0] = 0;
+        for (int32_t j = 0; j < width_ext; ++j) {
+            const uint32_t v = highbd ? CONVERT_TO_SHORTPTR(dgd0)[i * dgd_stride + j]
+                                      : dgd0[i * dgd_stride + j];
+            c_row += v * v;
+            d_row += v;
+            ct[j + 1] = ct[j + 1 - buf_stride] + c_row;
+            dt[j + 1] = dt[j + 1 - buf_stride] + d_row;
+        }
+    }
+}
+
+void eb_av1_selfguided_restoration_from_ii_c(const uint8_t *dgd8, int32_t width, int32_t height,
+                                             int32_t dgd_stride, const int32_t *ii,
+                                             int32_t *flt0, int32_t *flt1, int32_t flt_stride,
+                                             int32_t sgr_params_idx, int32_t bit_depth,
+                                             int32_t highbd) {
+    selfguided_restoration_c(dgd8,
+                             width,
+                             height,
+                             dgd_stride,
+                             ii,
+                             flt0,
+                             flt1,
+                             flt_stride,
+                             sgr_params_idx,
+                             bit_depth,
+                             highbd);
+}
+#else
     if (params->r[0] > 0)
         selfguided_restoration_fast_internal(
             dgd32, width, height, dgd32_stride, flt0, flt_stride, bit_depth, sgr_params_idx, 0);
@@ -1042,6 +1195,7 @@ void eb_av1_selfguided_restoration_c(const uint8_t *dgd8, int32_t width, int32_t
         selfguided_restoration_internal(
             dgd32, width, height, dgd32_stride, flt1, flt_stride, bit_depth, sgr_params_idx, 1);
 }
+#endif
 
 void eb_apply_selfguided_restoration_c(const uint8_t *dat8, int32_t width, int32_t height,
                                        int32_t stride, int32_t eps, const int32_t *xqd,
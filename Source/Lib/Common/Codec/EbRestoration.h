@@ -83,6 +83,22 @@ void eb_apply_selfguided_restoration_c(const uint8_t *dat8, int32_t width, int32
     ((RESTORATION_UNITSIZE_MAX * 3 / 2 + 2 * RESTORATION_BORDER_VERT + RESTORATION_UNIT_OFFSET))
 #define RESTORATION_UNITPELS_MAX (RESTORATION_UNITPELS_HORZ_MAX * RESTORATION_UNITPELS_VERT_MAX)
 
+#if SGR_INTEGRAL_CACHE
+// Integral images of one processing unit, laid out as in
+// eb_av1_selfguided_restoration_avx2(): sums of squares in the first
+// SGRPROJ_II_BUF_ELTS elements, sums in the next SGRPROJ_II_BUF_ELTS.
+#define SGRPROJ_II_BUF_ELTS ALIGN_POWER_OF_TWO(RESTORATION_PROC_UNIT_PELS, 3)
+#define SGRPROJ_II_SIZE (2 * SGRPROJ_II_BUF_ELTS)
+// Processing units in the largest restoration unit (the processing unit and the
+// restoration unit are subsampled together for chroma)
+#define SGRPROJ_II_MAX_PROC_UNITS                                                 \
+    (((RESTORATION_UNITSIZE_MAX * 3 / 2 + RESTORATION_PROC_UNIT_SIZE - 1) /      \
+      RESTORATION_PROC_UNIT_SIZE) *                                               \
+     ((RESTORATION_UNITSIZE_MAX * 3 / 2 + RESTORATION_PROC_UNIT_SIZE - 1) /      \
+      RESTORATION_PROC_UNIT_SIZE))
+#define SGRPROJ_II_CACHE_SIZE (SGRPROJ_II_MAX_PROC_UNITS * SGRPROJ_II_SIZE * sizeof(int32_t))
+
+#endif
 // Two 32-bit buffers needed for the restored versions from two filters
 // TODO(debargha, rupert): Refactor to not need the large tilesize to be stored
 // on the decoder side.
@@ -271,6 +287,18 @@ extern const int32_t       eb_one_by_x[MAX_NELEM];
 void eb_extend_frame(uint8_t *data, int32_t width, int32_t height, int32_t stride,
                      int32_t border_horz, int32_t border_vert, int32_t highbd);
 void eb_decode_xq(const int32_t *xqd, int32_t *xq, const SgrParamsType *params);
+#if SGR_INTEGRAL_CACHE
+// Stride of the integral images of a width-wide processing unit
+static INLINE int32_t sgr_ii_stride(int32_t width) {
+    return ALIGN_POWER_OF_TWO(width + 2 * SGRPROJ_BORDER_HORZ + 16, 3);
+}
+
+// Position (0, 0) of the processing unit in integral image ii (the zero row and
+// column sit at (-SGRPROJ_BORDER_VERT - 1, -SGRPROJ_BORDER_HORZ - 1))
+static INLINE const int32_t *sgr_ii_origin(const int32_t *ii, int32_t buf_stride) {
+    return ii + 7 + 1 + buf_stride + SGRPROJ_BORDER_HORZ + buf_stride * SGRPROJ_BORDER_VERT;
+}
+#endif
 
 // Filter a single loop restoration unit.
 //
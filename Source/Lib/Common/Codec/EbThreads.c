@@ -334,3 +334,117 @@ EbErrorType eb_destroy_mutex(EbHandle mutex_handle) {
 
     return return_error;
 }
+#if DEC_PARKED_WORKERS
+/***************************************
+ * Condition variable
+ * The object owns the lock it is waited on with, so a waiter can
+ * re-check its predicate and park without a lost-wakeup window.
+ ***************************************/
+typedef struct EbCondVar {
+#ifdef _WIN32
+    SRWLOCK            lock;
+    CONDITION_VARIABLE cond;
+#else
+    pthread_mutex_t lock;
+    pthread_cond_t  cond;
+#endif // _WIN32
+} EbCondVar;
+
+/***************************************
+ * eb_create_cond_var
+ ***************************************/
+EbHandle eb_create_cond_var(void) {
+    EbCondVar *cond_var = (EbCondVar *)malloc(sizeof(EbCondVar));
+
+    if (cond_var != NULL) {
+#ifdef _WIN32
+        InitializeSRWLock(&cond_var->lock);
+        InitializeConditionVariable(&cond_var->cond);
+#else
+        if (pthread_mutex_init(&cond_var->lock, NULL)) {
+            free(cond_var);
+            return NULL;
+        }
+        if (pthread_cond_init(&cond_var->cond, NULL)) {
+            pthread_mutex_destroy(&cond_var->lock);
+            free(cond_var);
+            return NULL;
+        }
+#endif // _WIN32
+    }
+    return (EbHandle)cond_var;
+}
+
+/***************************************
+ * eb_lock_cond_var
+ ***************************************/
+EbErrorType eb_lock_cond_var(EbHandle cond_var_handle) {
+    EbCondVar *cond_var = (EbCondVar *)cond_var_handle;
+#ifdef _WIN32
+    AcquireSRWLockExclusive(&cond_var->lock);
+    return EB_ErrorNone;
+#else
+    return pthread_mutex_lock(&cond_var->lock) ? EB_ErrorMutexUnresponsive : EB_ErrorNone;
+#endif // _WIN32
+}
+
+/***************************************
+ * eb_unlock_cond_var
+ ***************************************/
+EbErrorType eb_unlock_cond_var(EbHandle cond_var_handle) {
+    EbCondVar *cond_var = (EbCondVar *)cond_var_handle;
+#ifdef _WIN32
+    ReleaseSRWLockExclusive(&cond_var->lock);
+    return EB_ErrorNone;
+#else
+    return pthread_mutex_unlock(&cond_var->lock) ? EB_ErrorMutexUnresponsive : EB_ErrorNone;
+#endif // _WIN32
+}
+
+/***************************************
+ * eb_wait_cond_var
+ * Must be called with the lock held; returns with it held.
+ * Wake-ups may be spurious, callers re-check their predicate.
+ ***************************************/
+EbErrorType eb_wait_cond_var(EbHandle cond_var_handle) {
+    EbCondVar *cond_var = (EbCondVar *)cond_var_handle;
+#ifdef _WIN32
+    return SleepConditionVariableSRW(&cond_var->cond, &cond_var->lock, INFINITE, 0)
+               ? EB_ErrorNone
+               : EB_ErrorSemaphoreUnresponsive;
+#else
+    return pthread_cond_wait(&cond_var->cond, &cond_var->lock) ? EB_ErrorSemaphoreUnresponsive
+                                                               : EB_ErrorNone;
+#endif // _WIN32
+}
+
+/***************************************
+ * eb_broadcast_cond_var
+ ***************************************/
+EbErrorType eb_broadcast_cond_var(EbHandle cond_var_handle) {
+    EbCondVar *cond_var = (EbCondVar *)cond_var_handle;
+#ifdef _WIN32
+    WakeAllConditionVariable(&cond_var->cond);
+    return EB_ErrorNone;
+#else
+    return pthread_cond_broadcast(&cond_var->cond) ? EB_ErrorSemaphoreUnresponsive
+                                                   : EB_ErrorNone;
+#endif // _WIN32
+}
+
+/***************************************
+ * eb_destroy_cond_var
+ ***************************************/
+EbErrorType eb_destroy_cond_var(EbHandle cond_var_handle) {
+    EbErrorType return_error = EB_ErrorNone;
+    EbCondVar * cond_var     = (EbCondVar *)cond_var_handle;
+
+#ifndef _WIN32
+    if (pthread_cond_destroy(&cond_var->cond)) return_error = EB_ErrorDestroyMutexFailed;
+    if (pthread_mutex_destroy(&cond_var->lock)) return_error = EB_ErrorDestroyMutexFailed;
+#endif // _WIN32
+    free(cond_var);
+
+    return return_error;
+}
+#endif
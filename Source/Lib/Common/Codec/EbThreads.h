@@ -48,6 +48,18 @@ extern EbHandle eb_create_mutex(void);
 extern EbErrorType eb_release_mutex(EbHandle mutex_handle);
 extern EbErrorType eb_block_on_mutex(EbHandle mutex_handle);
 extern EbErrorType eb_destroy_mutex(EbHandle mutex_handle);
+#if DEC_PARKED_WORKERS
+
+/**************************************
+     * Condition variable (owns its lock)
+     **************************************/
+extern EbHandle    eb_create_cond_var(void);
+extern EbErrorType eb_lock_cond_var(EbHandle cond_var_handle);
+extern EbErrorType eb_unlock_cond_var(EbHandle cond_var_handle);
+extern EbErrorType eb_wait_cond_var(EbHandle cond_var_handle);
+extern EbErrorType eb_broadcast_cond_var(EbHandle cond_var_handle);
+extern EbErrorType eb_destroy_cond_var(EbHandle cond_var_handle);
+#endif
 extern EbMemoryMapEntry *memory_map; // library Memory table
 extern uint32_t *        memory_map_index; // library memory index
 extern uint64_t *        total_lib_memory; // library Memory malloc'd
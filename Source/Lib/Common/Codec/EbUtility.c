@@ -1522,7 +1522,16 @@ void log_redundancy_similarity(uint32_t max_block_count) {
         }
     }
 }
+#if SB_SIZE_BASED_BLK_ALLOC
+// SB size the block geometry tables were last built for (0: not built)
+static uint32_t blk_geom_sb_size = 0;
+#endif
 void build_blk_geom(int32_t use_128x128) {
+#if SB_SIZE_BASED_BLK_ALLOC
+    // The tables are shared by all the encoder instances of the process:
+    // only build them when the SB size changes
+    if (blk_geom_sb_size == (uint32_t)(use_128x128 ? 128 : 64)) return;
+#endif
     max_sb                   = use_128x128 ? 128 : 64;
     max_depth                = use_128x128 ? 6 : 5;
     uint32_t max_block_count = use_128x128 ? BLOCK_MAX_COUNT_SB_128 : BLOCK_MAX_COUNT_SB_64;
@@ -1543,6 +1552,9 @@ void build_blk_geom(int32_t use_128x128) {
     finish_depth_scan_all_blks();
 
     log_redundancy_similarity(max_block_count);
+#if SB_SIZE_BASED_BLK_ALLOC
+    blk_geom_sb_size = max_sb;
+#endif
 }
 
 //need to finish filling dps by inherting data from mds
@@ -250,6 +250,26 @@ void setup_common_rtcd_internal(CPU_FLAGS flags) {
     eb_apply_selfguided_restoration = eb_apply_selfguided_restoration_c;
 
     eb_av1_selfguided_restoration = eb_av1_selfguided_restoration_c;
+#if SGR_INTEGRAL_CACHE
+    eb_av1_sgr_integral_images = eb_av1_sgr_integral_images_c;
+    eb_av1_selfguided_restoration_from_ii = eb_av1_selfguided_restoration_from_ii_c;
+#endif
+#if FILM_GRAIN_SIMD
+    eb_fgn_add_noise_luma = eb_fgn_add_noise_luma_c;
+    eb_fgn_add_noise_luma_hbd = eb_fgn_add_noise_luma_hbd_c;
+    eb_fgn_add_noise_chroma = eb_fgn_add_noise_chroma_c;
+    eb_fgn_add_noise_chroma_hbd = eb_fgn_add_noise_chroma_hbd_c;
+    eb_fgn_hor_boundary_overlap = eb_fgn_hor_boundary_overlap_c;
+#endif
+#if DEC_OUT_CONVERT
+    eb_dec_out_pack_u16_to_u8 = eb_dec_out_pack_u16_to_u8_c;
+    eb_dec_out_unpack_u8_to_u16 = eb_dec_out_unpack_u8_to_u16_c;
+    eb_dec_out_shift_u16 = eb_dec_out_shift_u16_c;
+    eb_dec_out_interleave_u8 = eb_dec_out_interleave_u8_c;
+    eb_dec_out_interleave_u16_to_u8 = eb_dec_out_interleave_u16_to_u8_c;
+    eb_dec_out_interleave_u8_to_u16 = eb_dec_out_interleave_u8_to_u16_c;
+    eb_dec_out_interleave_u16 = eb_dec_out_interleave_u16_c;
+#endif
 
     eb_av1_inv_txfm2d_add_16x16 = eb_av1_inv_txfm2d_add_16x16_c;
     eb_av1_inv_txfm2d_add_32x32 = eb_av1_inv_txfm2d_add_32x32_c;
@@ -611,6 +631,16 @@ void setup_common_rtcd_internal(CPU_FLAGS flags) {
     aom_highbd_lpf_vertical_4 = aom_highbd_lpf_vertical_4_c;
     aom_highbd_lpf_vertical_6 = aom_highbd_lpf_vertical_6_c;
     aom_highbd_lpf_vertical_8 = aom_highbd_lpf_vertical_8_c;
+#if DLF_DUAL_EDGE_AVX2
+    aom_highbd_lpf_horizontal_14_dual = aom_highbd_lpf_horizontal_14_dual_c;
+    aom_highbd_lpf_horizontal_4_dual = aom_highbd_lpf_horizontal_4_dual_c;
+    aom_highbd_lpf_horizontal_6_dual = aom_highbd_lpf_horizontal_6_dual_c;
+    aom_highbd_lpf_horizontal_8_dual = aom_highbd_lpf_horizontal_8_dual_c;
+    aom_highbd_lpf_vertical_14_dual = aom_highbd_lpf_vertical_14_dual_c;
+    aom_highbd_lpf_vertical_4_dual = aom_highbd_lpf_vertical_4_dual_c;
+    aom_highbd_lpf_vertical_6_dual = aom_highbd_lpf_vertical_6_dual_c;
+    aom_highbd_lpf_vertical_8_dual = aom_highbd_lpf_vertical_8_dual_c;
+#endif
     aom_lpf_horizontal_14 = aom_lpf_horizontal_14_c;
     aom_lpf_horizontal_4 = aom_lpf_horizontal_4_c;
     aom_lpf_horizontal_6 = aom_lpf_horizontal_6_c;
@@ -619,6 +649,16 @@ void setup_common_rtcd_internal(CPU_FLAGS flags) {
     aom_lpf_vertical_4 = aom_lpf_vertical_4_c;
     aom_lpf_vertical_6 = aom_lpf_vertical_6_c;
     aom_lpf_vertical_8 = aom_lpf_vertical_8_c;
+#if DLF_DUAL_EDGE_AVX2
+    aom_lpf_horizontal_14_dual = aom_lpf_horizontal_14_dual_c;
+    aom_lpf_horizontal_4_dual = aom_lpf_horizontal_4_dual_c;
+    aom_lpf_horizontal_6_dual = aom_lpf_horizontal_6_dual_c;
+    aom_lpf_horizontal_8_dual = aom_lpf_horizontal_8_dual_c;
+    aom_lpf_vertical_14_dual = aom_lpf_vertical_14_dual_c;
+    aom_lpf_vertical_4_dual = aom_lpf_vertical_4_dual_c;
+    aom_lpf_vertical_6_dual = aom_lpf_vertical_6_dual_c;
+    aom_lpf_vertical_8_dual = aom_lpf_vertical_8_dual_c;
+#endif
 
     // eb_aom_highbd_v_predictor
     eb_aom_highbd_v_predictor_16x16 = eb_aom_highbd_v_predictor_16x16_c;
@@ -813,6 +853,52 @@ void setup_common_rtcd_internal(CPU_FLAGS flags) {
     if (flags & HAS_AVX2) eb_av1_highbd_wiener_convolve_add_src = eb_av1_highbd_wiener_convolve_add_src_avx2;
     if (flags & HAS_AVX2) eb_apply_selfguided_restoration = eb_apply_selfguided_restoration_avx2;
     if (flags & HAS_AVX2) eb_av1_selfguided_restoration = eb_av1_selfguided_restoration_avx2;
+#if SGR_INTEGRAL_CACHE
+    if (flags & HAS_AVX2) eb_av1_sgr_integral_images = eb_av1_sgr_integral_images_avx2;
+    if (flags & HAS_AVX2) eb_av1_selfguided_restoration_from_ii = eb_av1_selfguided_restoration_from_ii_avx2;
+#endif
+#if FILM_GRAIN_SIMD
+    SET_AVX2_AVX512(eb_fgn_add_noise_luma,
+        eb_fgn_add_noise_luma_c,
+        eb_fgn_add_noise_luma_avx2,
+        eb_fgn_add_noise_luma_avx512);
+    SET_AVX2_AVX512(eb_fgn_add_noise_luma_hbd,
+        eb_fgn_add_noise_luma_hbd_c,
+        eb_fgn_add_noise_luma_hbd_avx2,
+        eb_fgn_add_noise_luma_hbd_avx512);
+    SET_AVX2_AVX512(eb_fgn_add_noise_chroma,
+        eb_fgn_add_noise_chroma_c,
+        eb_fgn_add_noise_chroma_avx2,
+        eb_fgn_add_noise_chroma_avx512);
+    SET_AVX2_AVX512(eb_fgn_add_noise_chroma_hbd,
+        eb_fgn_add_noise_chroma_hbd_c,
+        eb_fgn_add_noise_chroma_hbd_avx2,
+        eb_fgn_add_noise_chroma_hbd_avx512);
+    SET_AVX2(eb_fgn_hor_boundary_overlap,
+        eb_fgn_hor_boundary_overlap_c,
+        eb_fgn_hor_boundary_overlap_avx2);
+#endif
+#if DEC_OUT_CONVERT
+    SET_AVX2(eb_dec_out_pack_u16_to_u8,
+        eb_dec_out_pack_u16_to_u8_c,
+        eb_dec_out_pack_u16_to_u8_avx2);
+    SET_AVX2(eb_dec_out_unpack_u8_to_u16,
+        eb_dec_out_unpack_u8_to_u16_c,
+        eb_dec_out_unpack_u8_to_u16_avx2);
+    SET_AVX2(eb_dec_out_shift_u16, eb_dec_out_shift_u16_c, eb_dec_out_shift_u16_avx2);
+    SET_AVX2(eb_dec_out_interleave_u8,
+        eb_dec_out_interleave_u8_c,
+        eb_dec_out_interleave_u8_avx2);
+    SET_AVX2(eb_dec_out_interleave_u16_to_u8,
+        eb_dec_out_interleave_u16_to_u8_c,
+        eb_dec_out_interleave_u16_to_u8_avx2);
+    SET_AVX2(eb_dec_out_interleave_u8_to_u16,
+        eb_dec_out_interleave_u8_to_u16_c,
+        eb_dec_out_interleave_u8_to_u16_avx2);
+    SET_AVX2(eb_dec_out_interleave_u16,
+        eb_dec_out_interleave_u16_c,
+        eb_dec_out_interleave_u16_avx2);
+#endif
     if (flags & HAS_AVX2) eb_av1_inv_txfm2d_add_4x4 = eb_av1_inv_txfm2d_add_4x4_avx2;
     if (flags & HAS_AVX2) eb_av1_inv_txfm2d_add_8x8 = eb_av1_inv_txfm2d_add_8x8_avx2;
     if (flags & HAS_AVX2) eb_av1_inv_txfm2d_add_8x16 = eb_av1_highbd_inv_txfm_add_avx2;
@@ -1226,6 +1312,16 @@ void setup_common_rtcd_internal(CPU_FLAGS flags) {
         SET_SSE2(aom_highbd_lpf_vertical_4, aom_highbd_lpf_vertical_4_c, aom_highbd_lpf_vertical_4_sse2);
         SET_SSE2(aom_highbd_lpf_vertical_6, aom_highbd_lpf_vertical_6_c, aom_highbd_lpf_vertical_6_sse2);
         SET_SSE2(aom_highbd_lpf_vertical_8, aom_highbd_lpf_vertical_8_c, aom_highbd_lpf_vertical_8_sse2);
+#if DLF_DUAL_EDGE_AVX2
+        SET_AVX2(aom_highbd_lpf_horizontal_14_dual, aom_highbd_lpf_horizontal_14_dual_c, aom_highbd_lpf_horizontal_14_dual_avx2);
+        SET_AVX2(aom_highbd_lpf_horizontal_4_dual, aom_highbd_lpf_horizontal_4_dual_c, aom_highbd_lpf_horizontal_4_dual_avx2);
+        SET_AVX2(aom_highbd_lpf_horizontal_6_dual, aom_highbd_lpf_horizontal_6_dual_c, aom_highbd_lpf_horizontal_6_dual_avx2);
+        SET_AVX2(aom_highbd_lpf_horizontal_8_dual, aom_highbd_lpf_horizontal_8_dual_c, aom_highbd_lpf_horizontal_8_dual_avx2);
+        SET_AVX2(aom_highbd_lpf_vertical_14_dual, aom_highbd_lpf_vertical_14_dual_c, aom_highbd_lpf_vertical_14_dual_avx2);
+        SET_AVX2(aom_highbd_lpf_vertical_4_dual, aom_highbd_lpf_vertical_4_dual_c, aom_highbd_lpf_vertical_4_dual_avx2);
+        SET_AVX2(aom_highbd_lpf_vertical_6_dual, aom_highbd_lpf_vertical_6_dual_c, aom_highbd_lpf_vertical_6_dual_avx2);
+        SET_AVX2(aom_highbd_lpf_vertical_8_dual, aom_highbd_lpf_vertical_8_dual_c, aom_highbd_lpf_vertical_8_dual_avx2);
+#endif
         SET_SSE2(aom_lpf_horizontal_14, aom_lpf_horizontal_14_c, aom_lpf_horizontal_14_sse2);
         SET_SSE2(aom_lpf_horizontal_4, aom_lpf_horizontal_4_c, aom_lpf_horizontal_4_sse2);
         SET_SSE2(aom_lpf_horizontal_6, aom_lpf_horizontal_6_c, aom_lpf_horizontal_6_sse2);
@@ -1234,6 +1330,16 @@ void setup_common_rtcd_internal(CPU_FLAGS flags) {
         SET_SSE2(aom_lpf_vertical_4, aom_lpf_vertical_4_c, aom_lpf_vertical_4_sse2);
         SET_SSE2(aom_lpf_vertical_6, aom_lpf_vertical_6_c, aom_lpf_vertical_6_sse2);
         SET_SSE2(aom_lpf_vertical_8, aom_lpf_vertical_8_c, aom_lpf_vertical_8_sse2);
+#if DLF_DUAL_EDGE_AVX2
+        SET_AVX2(aom_lpf_horizontal_14_dual, aom_lpf_horizontal_14_dual_c, aom_lpf_horizontal_14_dual_avx2);
+        SET_AVX2(aom_lpf_horizontal_4_dual, aom_lpf_horizontal_4_dual_c, aom_lpf_horizontal_4_dual_avx2);
+        SET_AVX2(aom_lpf_horizontal_6_dual, aom_lpf_horizontal_6_dual_c, aom_lpf_horizontal_6_dual_avx2);
+        SET_AVX2(aom_lpf_horizontal_8_dual, aom_lpf_horizontal_8_dual_c, aom_lpf_horizontal_8_dual_avx2);
+        SET_AVX2(aom_lpf_vertical_14_dual, aom_lpf_vertical_14_dual_c, aom_lpf_vertical_14_dual_avx2);
+        SET_AVX2(aom_lpf_vertical_4_dual, aom_lpf_vertical_4_dual_c, aom_lpf_vertical_4_dual_avx2);
+        SET_AVX2(aom_lpf_vertical_6_dual, aom_lpf_vertical_6_dual_c, aom_lpf_vertical_6_dual_avx2);
+        SET_AVX2(aom_lpf_vertical_8_dual, aom_lpf_vertical_8_dual_c, aom_lpf_vertical_8_dual_avx2);
+#endif
         if (flags & HAS_AVX2) eb_aom_highbd_v_predictor_16x16 = eb_aom_highbd_v_predictor_16x16_avx2;
         if (flags & HAS_AVX2) eb_aom_highbd_v_predictor_16x32 = eb_aom_highbd_v_predictor_16x32_avx2;
         if (flags & HAS_AVX2) eb_aom_highbd_v_predictor_16x4 = eb_aom_highbd_v_predictor_16x4_avx2;
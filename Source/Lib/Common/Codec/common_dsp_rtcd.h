@@ -206,6 +206,37 @@ extern "C" {
     RTCD_EXTERN void(*eb_av1_selfguided_restoration)(const uint8_t *dgd8, int32_t width, int32_t height,
         int32_t dgd_stride, int32_t *flt0, int32_t *flt1, int32_t flt_stride,
         int32_t sgr_params_idx, int32_t bit_depth, int32_t highbd);
+#if SGR_INTEGRAL_CACHE
+    void eb_av1_sgr_integral_images_c(const uint8_t *dgd8, int32_t width, int32_t height, int32_t dgd_stride, int32_t *ii, int32_t highbd);
+    RTCD_EXTERN void(*eb_av1_sgr_integral_images)(const uint8_t *dgd8, int32_t width, int32_t height, int32_t dgd_stride, int32_t *ii, int32_t highbd);
+    void eb_av1_selfguided_restoration_from_ii_c(const uint8_t *dgd8, int32_t width, int32_t height,
+        int32_t dgd_stride, const int32_t *ii, int32_t *flt0, int32_t *flt1, int32_t flt_stride,
+        int32_t sgr_params_idx, int32_t bit_depth, int32_t highbd);
+    RTCD_EXTERN void(*eb_av1_selfguided_restoration_from_ii)(const uint8_t *dgd8, int32_t width, int32_t height,
+        int32_t dgd_stride, const int32_t *ii, int32_t *flt0, int32_t *flt1, int32_t flt_stride,
+        int32_t sgr_params_idx, int32_t bit_depth, int32_t highbd);
+#endif
+#if FILM_GRAIN_SIMD
+    void eb_fgn_add_noise_luma_c(uint8_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, const FgnScaleParams *sp);
+    RTCD_EXTERN void(*eb_fgn_add_noise_luma)(uint8_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, const FgnScaleParams *sp);
+    void eb_fgn_add_noise_luma_hbd_c(uint16_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, const FgnScaleParams *sp);
+    RTCD_EXTERN void(*eb_fgn_add_noise_luma_hbd)(uint16_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, const FgnScaleParams *sp);
+    void eb_fgn_add_noise_chroma_c(uint8_t *chroma, int32_t chroma_stride, const uint8_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, int32_t chroma_subsamp_x, int32_t chroma_subsamp_y, const FgnScaleParams *sp);
+    RTCD_EXTERN void(*eb_fgn_add_noise_chroma)(uint8_t *chroma, int32_t chroma_stride, const uint8_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, int32_t chroma_subsamp_x, int32_t chroma_subsamp_y, const FgnScaleParams *sp);
+    void eb_fgn_add_noise_chroma_hbd_c(uint16_t *chroma, int32_t chroma_stride, const uint16_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, int32_t chroma_subsamp_x, int32_t chroma_subsamp_y, const FgnScaleParams *sp);
+    RTCD_EXTERN void(*eb_fgn_add_noise_chroma_hbd)(uint16_t *chroma, int32_t chroma_stride, const uint16_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, int32_t chroma_subsamp_x, int32_t chroma_subsamp_y, const FgnScaleParams *sp);
+    void eb_fgn_hor_boundary_overlap_c(const int32_t *top_block, int32_t top_stride, const int32_t *bottom_block, int32_t bottom_stride, int32_t *dst_block, int32_t dst_stride, int32_t width, int32_t height, int32_t grain_min, int32_t grain_max);
+    RTCD_EXTERN void(*eb_fgn_hor_boundary_overlap)(const int32_t *top_block, int32_t top_stride, const int32_t *bottom_block, int32_t bottom_stride, int32_t *dst_block, int32_t dst_stride, int32_t width, int32_t height, int32_t grain_min, int32_t grain_max);
+#endif
+#if DEC_OUT_CONVERT
+    RTCD_EXTERN void(*eb_dec_out_pack_u16_to_u8)(const uint16_t *src, uint32_t src_stride, uint8_t *dst, uint32_t dst_stride, uint32_t width, uint32_t height, uint32_t shift);
+    RTCD_EXTERN void(*eb_dec_out_unpack_u8_to_u16)(const uint8_t *src, uint32_t src_stride, uint16_t *dst, uint32_t dst_stride, uint32_t width, uint32_t height, uint32_t shift);
+    RTCD_EXTERN void(*eb_dec_out_shift_u16)(const uint16_t *src, uint32_t src_stride, uint16_t *dst, uint32_t dst_stride, uint32_t width, uint32_t height, uint32_t shift);
+    RTCD_EXTERN void(*eb_dec_out_interleave_u8)(const uint8_t *src_u, const uint8_t *src_v, uint32_t src_stride, uint8_t *dst, uint32_t dst_stride, uint32_t width, uint32_t height);
+    RTCD_EXTERN void(*eb_dec_out_interleave_u16_to_u8)(const uint16_t *src_u, const uint16_t *src_v, uint32_t src_stride, uint8_t *dst, uint32_t dst_stride, uint32_t width, uint32_t height, uint32_t shift);
+    RTCD_EXTERN void(*eb_dec_out_interleave_u8_to_u16)(const uint8_t *src_u, const uint8_t *src_v, uint32_t src_stride, uint16_t *dst, uint32_t dst_stride, uint32_t width, uint32_t height, uint32_t shift);
+    RTCD_EXTERN void(*eb_dec_out_interleave_u16)(const uint16_t *src_u, const uint16_t *src_v, uint32_t src_stride, uint16_t *dst, uint32_t dst_stride, uint32_t width, uint32_t height, uint32_t shift);
+#endif
     void eb_av1_convolve_2d_copy_sr_c(const uint8_t *src, int32_t src_stride, uint8_t *dst, int32_t dst_stride, int32_t w, int32_t h, InterpFilterParams *filter_params_x, InterpFilterParams *filter_params_y, const int32_t subpel_x_q4, const int32_t subpel_y_q4, ConvolveParams *conv_params);
     RTCD_EXTERN void(*eb_av1_convolve_2d_copy_sr)(const uint8_t *src, int32_t src_stride, uint8_t *dst, int32_t dst_stride, int32_t w, int32_t h, InterpFilterParams *filter_params_x, InterpFilterParams *filter_params_y, const int32_t subpel_x_q4, const int32_t subpel_y_q4, ConvolveParams *conv_params);
     void eb_av1_convolve_2d_sr_c(const uint8_t *src, int32_t src_stride, uint8_t *dst, int32_t dst_stride, int32_t w, int32_t h, InterpFilterParams *filter_params_x, InterpFilterParams *filter_params_y, const int32_t subpel_x_q4, const int32_t subpel_y_q4, ConvolveParams *conv_params);
@@ -1070,6 +1101,24 @@ extern "C" {
     RTCD_EXTERN void(*aom_highbd_lpf_vertical_6)(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
     void aom_highbd_lpf_vertical_8_c(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
     RTCD_EXTERN void(*aom_highbd_lpf_vertical_8)(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+#if DLF_DUAL_EDGE_AVX2
+    void aom_highbd_lpf_horizontal_14_dual_c(uint16_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1, int32_t bd);
+    RTCD_EXTERN void(*aom_highbd_lpf_horizontal_14_dual)(uint16_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1, int32_t bd);
+    void aom_highbd_lpf_horizontal_4_dual_c(uint16_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1, int32_t bd);
+    RTCD_EXTERN void(*aom_highbd_lpf_horizontal_4_dual)(uint16_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1, int32_t bd);
+    void aom_highbd_lpf_horizontal_6_dual_c(uint16_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1, int32_t bd);
+    RTCD_EXTERN void(*aom_highbd_lpf_horizontal_6_dual)(uint16_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1, int32_t bd);
+    void aom_highbd_lpf_horizontal_8_dual_c(uint16_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1, int32_t bd);
+    RTCD_EXTERN void(*aom_highbd_lpf_horizontal_8_dual)(uint16_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1, int32_t bd);
+    void aom_highbd_lpf_vertical_14_dual_c(uint16_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1, int32_t bd);
+    RTCD_EXTERN void(*aom_highbd_lpf_vertical_14_dual)(uint16_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1, int32_t bd);
+    void aom_highbd_lpf_vertical_4_dual_c(uint16_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1, int32_t bd);
+    RTCD_EXTERN void(*aom_highbd_lpf_vertical_4_dual)(uint16_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1, int32_t bd);
+    void aom_highbd_lpf_vertical_6_dual_c(uint16_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1, int32_t bd);
+    RTCD_EXTERN void(*aom_highbd_lpf_vertical_6_dual)(uint16_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1, int32_t bd);
+    void aom_highbd_lpf_vertical_8_dual_c(uint16_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1, int32_t bd);
+    RTCD_EXTERN void(*aom_highbd_lpf_vertical_8_dual)(uint16_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1, int32_t bd);
+#endif
     void aom_lpf_horizontal_14_c(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
     RTCD_EXTERN void(*aom_lpf_horizontal_14)(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
     void aom_lpf_horizontal_4_c(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
@@ -1086,6 +1135,24 @@ extern "C" {
     RTCD_EXTERN void(*aom_lpf_vertical_6)(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
     void aom_lpf_vertical_8_c(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
     RTCD_EXTERN void(*aom_lpf_vertical_8)(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+#if DLF_DUAL_EDGE_AVX2
+    void aom_lpf_horizontal_14_dual_c(uint8_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1);
+    RTCD_EXTERN void(*aom_lpf_horizontal_14_dual)(uint8_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1);
+    void aom_lpf_horizontal_4_dual_c(uint8_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1);
+    RTCD_EXTERN void(*aom_lpf_horizontal_4_dual)(uint8_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1);
+    void aom_lpf_horizontal_6_dual_c(uint8_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1);
+    RTCD_EXTERN void(*aom_lpf_horizontal_6_dual)(uint8_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1);
+    void aom_lpf_horizontal_8_dual_c(uint8_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1);
+    RTCD_EXTERN void(*aom_lpf_horizontal_8_dual)(uint8_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1);
+    void aom_lpf_vertical_14_dual_c(uint8_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1);
+    RTCD_EXTERN void(*aom_lpf_vertical_14_dual)(uint8_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1);
+    void aom_lpf_vertical_4_dual_c(uint8_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1);
+    RTCD_EXTERN void(*aom_lpf_vertical_4_dual)(uint8_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1);
+    void aom_lpf_vertical_6_dual_c(uint8_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1);
+    RTCD_EXTERN void(*aom_lpf_vertical_6_dual)(uint8_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1);
+    void aom_lpf_vertical_8_dual_c(uint8_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1);
+    RTCD_EXTERN void(*aom_lpf_vertical_8_dual)(uint8_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1);
+#endif
     uint32_t log2f_32(uint32_t x);
     RTCD_EXTERN uint32_t(*eb_log2f)(uint32_t x);
     void eb_memcpy_c(void  *dst_ptr, void  *src_ptr, size_t size);
@@ -1246,6 +1313,32 @@ extern "C" {
         void eb_av1_selfguided_restoration_avx2(const uint8_t *dgd8, int32_t width, int32_t height,
             int32_t dgd_stride, int32_t *flt0, int32_t *flt1, int32_t flt_stride,
             int32_t sgr_params_idx, int32_t bit_depth, int32_t highbd);
+#if SGR_INTEGRAL_CACHE
+        void eb_av1_sgr_integral_images_avx2(const uint8_t *dgd8, int32_t width, int32_t height, int32_t dgd_stride, int32_t *ii, int32_t highbd);
+        void eb_av1_selfguided_restoration_from_ii_avx2(const uint8_t *dgd8, int32_t width, int32_t height,
+            int32_t dgd_stride, const int32_t *ii, int32_t *flt0, int32_t *flt1, int32_t flt_stride,
+            int32_t sgr_params_idx, int32_t bit_depth, int32_t highbd);
+#endif
+#if FILM_GRAIN_SIMD
+        void eb_fgn_add_noise_luma_avx2(uint8_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, const FgnScaleParams *sp);
+        void eb_fgn_add_noise_luma_avx512(uint8_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, const FgnScaleParams *sp);
+        void eb_fgn_add_noise_luma_hbd_avx2(uint16_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, const FgnScaleParams *sp);
+        void eb_fgn_add_noise_luma_hbd_avx512(uint16_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, const FgnScaleParams *sp);
+        void eb_fgn_add_noise_chroma_avx2(uint8_t *chroma, int32_t chroma_stride, const uint8_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, int32_t chroma_subsamp_x, int32_t chroma_subsamp_y, const FgnScaleParams *sp);
+        void eb_fgn_add_noise_chroma_avx512(uint8_t *chroma, int32_t chroma_stride, const uint8_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, int32_t chroma_subsamp_x, int32_t chroma_subsamp_y, const FgnScaleParams *sp);
+        void eb_fgn_add_noise_chroma_hbd_avx2(uint16_t *chroma, int32_t chroma_stride, const uint16_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, int32_t chroma_subsamp_x, int32_t chroma_subsamp_y, const FgnScaleParams *sp);
+        void eb_fgn_add_noise_chroma_hbd_avx512(uint16_t *chroma, int32_t chroma_stride, const uint16_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, int32_t chroma_subsamp_x, int32_t chroma_subsamp_y, const FgnScaleParams *sp);
+        void eb_fgn_hor_boundary_overlap_avx2(const int32_t *top_block, int32_t top_stride, const int32_t *bottom_block, int32_t bottom_stride, int32_t *dst_block, int32_t dst_stride, int32_t width, int32_t height, int32_t grain_min, int32_t grain_max);
+#endif
+#if DEC_OUT_CONVERT
+        void eb_dec_out_pack_u16_to_u8_avx2(const uint16_t *src, uint32_t src_stride, uint8_t *dst, uint32_t dst_stride, uint32_t width, uint32_t height, uint32_t shift);
+        void eb_dec_out_unpack_u8_to_u16_avx2(const uint8_t *src, uint32_t src_stride, uint16_t *dst, uint32_t dst_stride, uint32_t width, uint32_t height, uint32_t shift);
+        void eb_dec_out_shift_u16_avx2(const uint16_t *src, uint32_t src_stride, uint16_t *dst, uint32_t dst_stride, uint32_t width, uint32_t height, uint32_t shift);
+        void eb_dec_out_interleave_u8_avx2(const uint8_t *src_u, const uint8_t *src_v, uint32_t src_stride, uint8_t *dst, uint32_t dst_stride, uint32_t width, uint32_t height);
+        void eb_dec_out_interleave_u16_to_u8_avx2(const uint16_t *src_u, const uint16_t *src_v, uint32_t src_stride, uint8_t *dst, uint32_t dst_stride, uint32_t width, uint32_t height, uint32_t shift);
+        void eb_dec_out_interleave_u8_to_u16_avx2(const uint8_t *src_u, const uint8_t *src_v, uint32_t src_stride, uint16_t *dst, uint32_t dst_stride, uint32_t width, uint32_t height, uint32_t shift);
+        void eb_dec_out_interleave_u16_avx2(const uint16_t *src_u, const uint16_t *src_v, uint32_t src_stride, uint16_t *dst, uint32_t dst_stride, uint32_t width, uint32_t height, uint32_t shift);
+#endif
 
             void eb_av1_convolve_2d_copy_sr_avx2(const uint8_t *src, int32_t src_stride, uint8_t *dst, int32_t dst_stride, int32_t w, int32_t h, InterpFilterParams *filter_params_x, InterpFilterParams *filter_params_y, const int32_t subpel_x_q4, const int32_t subpel_y_q4, ConvolveParams *conv_params);
             void eb_av1_convolve_2d_copy_sr_avx512(const uint8_t *src, int32_t src_stride, uint8_t *dst, int32_t dst_stride, int32_t w, int32_t h, InterpFilterParams *filter_params_x, InterpFilterParams *filter_params_y, const int32_t subpel_x_q4, const int32_t subpel_y_q4, ConvolveParams *conv_params);
@@ -2196,6 +2289,24 @@ extern "C" {
 
             void aom_highbd_lpf_vertical_8_sse2(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
 
+#if DLF_DUAL_EDGE_AVX2
+            void aom_highbd_lpf_horizontal_14_dual_avx2(uint16_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1, int32_t bd);
+
+            void aom_highbd_lpf_horizontal_4_dual_avx2(uint16_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1, int32_t bd);
+
+            void aom_highbd_lpf_horizontal_6_dual_avx2(uint16_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1, int32_t bd);
+
+            void aom_highbd_lpf_horizontal_8_dual_avx2(uint16_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1, int32_t bd);
+
+            void aom_highbd_lpf_vertical_14_dual_avx2(uint16_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1, int32_t bd);
+
+            void aom_highbd_lpf_vertical_4_dual_avx2(uint16_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1, int32_t bd);
+
+            void aom_highbd_lpf_vertical_6_dual_avx2(uint16_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1, int32_t bd);
+
+            void aom_highbd_lpf_vertical_8_dual_avx2(uint16_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1, int32_t bd);
+
+#endif
             void aom_lpf_horizontal_14_sse2(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
 
             void aom_lpf_horizontal_4_sse2(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
@@ -2212,6 +2323,24 @@ extern "C" {
 
             void aom_lpf_vertical_8_sse2(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
 
+#if DLF_DUAL_EDGE_AVX2
+            void aom_lpf_horizontal_14_dual_avx2(uint8_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1);
+
+            void aom_lpf_horizontal_4_dual_avx2(uint8_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1);
+
+            void aom_lpf_horizontal_6_dual_avx2(uint8_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1);
+
+            void aom_lpf_horizontal_8_dual_avx2(uint8_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1);
+
+            void aom_lpf_vertical_14_dual_avx2(uint8_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1);
+
+            void aom_lpf_vertical_4_dual_avx2(uint8_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1);
+
+            void aom_lpf_vertical_6_dual_avx2(uint8_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1);
+
+            void aom_lpf_vertical_8_dual_avx2(uint8_t *s, int32_t pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1);
+
+#endif
             uint32_t Log2f_SSE2(uint32_t x);
 
             extern void eb_memcpy_intrin_sse (void  *dst_ptr, void  *src_ptr, size_t size);
@@ -19,6 +19,9 @@
 #include <stdlib.h>
 #include "grainSynthesis.h"
 #include "EbLog.h"
+#if FILM_GRAIN_SIMD
+#include "common_dsp_rtcd.h"
+#endif
 
 // Samples with Gaussian distribution in the range of [-2048, 2047] (12 bits)
 // with zero mean and standard deviation of about 512.
@@ -197,9 +200,16 @@ static const int32_t max_luma_legal_range = 235;
 static const int32_t min_chroma_legal_range = 16;
 static const int32_t max_chroma_legal_range = 240;
 
+#if FILM_GRAIN_SIMD
+// one extra entry so the interpolating lookup never needs a x == 255 special case
+static int32_t scaling_lut_y[257];
+static int32_t scaling_lut_cb[257];
+static int32_t scaling_lut_cr[257];
+#else
 static int32_t scaling_lut_y[256];
 static int32_t scaling_lut_cb[256];
 static int32_t scaling_lut_cr[256];
+#endif
 
 static int32_t grain_center;
 static int32_t grain_min;
@@ -278,9 +288,15 @@ static void init_arrays(AomFilmGrain *params, int32_t luma_stride, int32_t chrom
                         int32_t **cr_col_buf, int32_t luma_grain_samples,
                         int32_t chroma_grain_samples, int32_t chroma_subsamp_y,
                         int32_t chroma_subsamp_x) {
+#if FILM_GRAIN_SIMD
+    memset(scaling_lut_y, 0, sizeof(scaling_lut_y));
+    memset(scaling_lut_cb, 0, sizeof(scaling_lut_cb));
+    memset(scaling_lut_cr, 0, sizeof(scaling_lut_cr));
+#else
     memset(scaling_lut_y, 0, sizeof(*scaling_lut_y) * 256);
     memset(scaling_lut_cb, 0, sizeof(*scaling_lut_cb) * 256);
     memset(scaling_lut_cr, 0, sizeof(*scaling_lut_cr) * 256);
+#endif
 
     int32_t num_pos_luma   = 2 * params->ar_coeff_lag * (params->ar_coeff_lag + 1);
     int32_t num_pos_chroma = num_pos_luma;
@@ -568,6 +584,9 @@ static void init_scaling_function(int32_t scaling_points[][2], int32_t num_point
 
     for (int32_t i = scaling_points[num_points - 1][0]; i < 256; i++)
         scaling_lut[i] = scaling_points[num_points - 1][1];
+#if FILM_GRAIN_SIMD
+    scaling_lut[256] = scaling_lut[255];
+#endif
 }
 
 // function that extracts samples from a lut (and interpolates intemediate
@@ -584,6 +603,118 @@ static int32_t scale_lut(int32_t *scaling_lut, int32_t index, int32_t bit_depth)
                 (bit_depth - 8));
 }
 
+#if FILM_GRAIN_SIMD
+void eb_fgn_add_noise_luma_c(uint8_t *luma, int32_t luma_stride, const int32_t *grain,
+                             int32_t grain_stride, int32_t width, int32_t height,
+                             const FgnScaleParams *sp) {
+    int32_t *scaling_lut     = (int32_t *)sp->scaling_lut;
+    int32_t  rounding_offset = (1 << (sp->scaling_shift - 1));
+
+    for (int32_t i = 0; i < height; i++) {
+        for (int32_t j = 0; j < width; j++) {
+            luma[i * luma_stride + j] =
+                clamp(luma[i * luma_stride + j] +
+                          ((scale_lut(scaling_lut, luma[i * luma_stride + j], 8) *
+                                grain[i * grain_stride + j] +
+                            rounding_offset) >>
+                           sp->scaling_shift),
+                      sp->min_value,
+                      sp->max_value);
+        }
+    }
+}
+
+void eb_fgn_add_noise_luma_hbd_c(uint16_t *luma, int32_t luma_stride, const int32_t *grain,
+                                 int32_t grain_stride, int32_t width, int32_t height,
+                                 const FgnScaleParams *sp) {
+    int32_t *scaling_lut     = (int32_t *)sp->scaling_lut;
+    int32_t  rounding_offset = (1 << (sp->scaling_shift - 1));
+
+    for (int32_t i = 0; i < height; i++) {
+        for (int32_t j = 0; j < width; j++) {
+            luma[i * luma_stride + j] =
+                clamp(luma[i * luma_stride + j] +
+                          ((scale_lut(scaling_lut, luma[i * luma_stride + j], sp->bit_depth) *
+                                grain[i * grain_stride + j] +
+                            rounding_offset) >>
+                           sp->scaling_shift),
+                      sp->min_value,
+                      sp->max_value);
+        }
+    }
+}
+
+// The chroma kernels read the co-located luma before the luma grain is added
+void eb_fgn_add_noise_chroma_c(uint8_t *chroma, int32_t chroma_stride, const uint8_t *luma,
+                               int32_t luma_stride, const int32_t *grain, int32_t grain_stride,
+                               int32_t width, int32_t height, int32_t chroma_subsamp_x,
+                               int32_t chroma_subsamp_y, const FgnScaleParams *sp) {
+    int32_t *scaling_lut     = (int32_t *)sp->scaling_lut;
+    int32_t  rounding_offset = (1 << (sp->scaling_shift - 1));
+
+    for (int32_t i = 0; i < height; i++) {
+        const uint8_t *luma_row = luma + (i << chroma_subsamp_y) * luma_stride;
+        for (int32_t j = 0; j < width; j++) {
+            int32_t average_luma;
+            if (chroma_subsamp_x)
+                average_luma = (luma_row[j << 1] + luma_row[(j << 1) + 1] + 1) >> 1;
+            else
+                average_luma = luma_row[j];
+            chroma[i * chroma_stride + j] =
+                clamp(chroma[i * chroma_stride + j] +
+                          ((scale_lut(scaling_lut,
+                                      clamp(((average_luma * sp->luma_mult +
+                                              sp->mult * chroma[i * chroma_stride + j]) >>
+                                             6) +
+                                                sp->offset,
+                                            0,
+                                            (256 << (sp->bit_depth - 8)) - 1),
+                                      8) *
+                                grain[i * grain_stride + j] +
+                            rounding_offset) >>
+                           sp->scaling_shift),
+                      sp->min_value,
+                      sp->max_value);
+        }
+    }
+}
+
+void eb_fgn_add_noise_chroma_hbd_c(uint16_t *chroma, int32_t chroma_stride, const uint16_t *luma,
+                                   int32_t luma_stride, const int32_t *grain,
+                                   int32_t grain_stride, int32_t width, int32_t height,
+                                   int32_t chroma_subsamp_x, int32_t chroma_subsamp_y,
+                                   const FgnScaleParams *sp) {
+    int32_t *scaling_lut     = (int32_t *)sp->scaling_lut;
+    int32_t  rounding_offset = (1 << (sp->scaling_shift - 1));
+
+    for (int32_t i = 0; i < height; i++) {
+        const uint16_t *luma_row = luma + (i << chroma_subsamp_y) * luma_stride;
+        for (int32_t j = 0; j < width; j++) {
+            int32_t average_luma;
+            if (chroma_subsamp_x)
+                average_luma = (luma_row[j << 1] + luma_row[(j << 1) + 1] + 1) >> 1;
+            else
+                average_luma = luma_row[j];
+            chroma[i * chroma_stride + j] =
+                clamp(chroma[i * chroma_stride + j] +
+                          ((scale_lut(scaling_lut,
+                                      clamp(((average_luma * sp->luma_mult +
+                                              sp->mult * chroma[i * chroma_stride + j]) >>
+                                             6) +
+                                                sp->offset,
+                                            0,
+                                            (256 << (sp->bit_depth - 8)) - 1),
+                                      sp->bit_depth) *
+                                grain[i * grain_stride + j] +
+                            rounding_offset) >>
+                           sp->scaling_shift),
+                      sp->min_value,
+                      sp->max_value);
+        }
+    }
+}
+#endif
+
 static void add_noise_to_block(AomFilmGrain *params, uint8_t *luma, uint8_t *cb, uint8_t *cr,
                                int32_t luma_stride, int32_t chroma_stride, int32_t *luma_grain,
                                int32_t *cb_grain, int32_t *cr_grain, int32_t luma_grain_stride,
@@ -598,7 +729,9 @@ static void add_noise_to_block(AomFilmGrain *params, uint8_t *luma, uint8_t *cb,
     int32_t cr_luma_mult = params->cr_luma_mult - 128; // fixed scale
     int32_t cr_offset    = params->cr_offset - 256;
 
+#if !FILM_GRAIN_SIMD
     int32_t rounding_offset = (1 << (params->scaling_shift - 1));
+#endif
 
     int32_t apply_y  = params->num_y_points > 0 ? 1 : 0;
     int32_t apply_cb = (params->num_cb_points > 0 ||
@@ -629,6 +762,62 @@ static void add_noise_to_block(AomFilmGrain *params, uint8_t *luma, uint8_t *cb,
         max_luma = max_chroma = 255;
     }
 
+#if FILM_GRAIN_SIMD
+    int32_t chroma_width  = half_luma_width << (1 - chroma_subsamp_x);
+    int32_t chroma_height = half_luma_height << (1 - chroma_subsamp_y);
+    FgnScaleParams sp;
+    sp.scaling_shift = params->scaling_shift;
+    sp.bit_depth     = bit_depth;
+    sp.min_value     = min_chroma;
+    sp.max_value     = max_chroma;
+
+    if (apply_cb) {
+        sp.scaling_lut = scaling_lut_cb;
+        sp.luma_mult   = cb_luma_mult;
+        sp.mult        = cb_mult;
+        sp.offset      = cb_offset;
+        eb_fgn_add_noise_chroma(cb,
+                                chroma_stride,
+                                luma,
+                                luma_stride,
+                                cb_grain,
+                                chroma_grain_stride,
+                                chroma_width,
+                                chroma_height,
+                                chroma_subsamp_x,
+                                chroma_subsamp_y,
+                                &sp);
+    }
+    if (apply_cr) {
+        sp.scaling_lut = scaling_lut_cr;
+        sp.luma_mult   = cr_luma_mult;
+        sp.mult        = cr_mult;
+        sp.offset      = cr_offset;
+        eb_fgn_add_noise_chroma(cr,
+                                chroma_stride,
+                                luma,
+                                luma_stride,
+                                cr_grain,
+                                chroma_grain_stride,
+                                chroma_width,
+                                chroma_height,
+                                chroma_subsamp_x,
+                                chroma_subsamp_y,
+                                &sp);
+    }
+    if (apply_y) {
+        sp.scaling_lut = scaling_lut_y;
+        sp.min_value   = min_luma;
+        sp.max_value   = max_luma;
+        eb_fgn_add_noise_luma(luma,
+                              luma_stride,
+                              luma_grain,
+                              luma_grain_stride,
+                              half_luma_width << 1,
+                              half_luma_height << 1,
+                              &sp);
+    }
+#else
     for (int32_t i = 0; i < (half_luma_height << (1 - chroma_subsamp_y)); i++) {
         for (int32_t j = 0; j < (half_luma_width << (1 - chroma_subsamp_x)); j++) {
             int32_t average_luma = 0;
@@ -692,6 +881,7 @@ static void add_noise_to_block(AomFilmGrain *params, uint8_t *luma, uint8_t *cb,
             }
         }
     }
+#endif
 }
 
 static void add_noise_to_block_hbd(AomFilmGrain *params, uint16_t *luma, uint16_t *cb, uint16_t *cr,
@@ -710,7 +900,9 @@ static void add_noise_to_block_hbd(AomFilmGrain *params, uint16_t *luma, uint16_
     // offset value depends on the bit depth
     int32_t cr_offset = (params->cr_offset << (bit_depth - 8)) - (1 << bit_depth);
 
+#if !FILM_GRAIN_SIMD
     int32_t rounding_offset = (1 << (params->scaling_shift - 1));
+#endif
 
     int32_t apply_y  = params->num_y_points > 0 ? 1 : 0;
     int32_t apply_cb = params->num_cb_points > 0 ? 1 : 0;
@@ -739,6 +931,62 @@ static void add_noise_to_block_hbd(AomFilmGrain *params, uint16_t *luma, uint16_
         max_luma = max_chroma = (256 << (bit_depth - 8)) - 1;
     }
 
+#if FILM_GRAIN_SIMD
+    int32_t chroma_width  = half_luma_width << (1 - chroma_subsamp_x);
+    int32_t chroma_height = half_luma_height << (1 - chroma_subsamp_y);
+    FgnScaleParams sp;
+    sp.scaling_shift = params->scaling_shift;
+    sp.bit_depth     = bit_depth;
+    sp.min_value     = min_chroma;
+    sp.max_value     = max_chroma;
+
+    if (apply_cb) {
+        sp.scaling_lut = scaling_lut_cb;
+        sp.luma_mult   = cb_luma_mult;
+        sp.mult        = cb_mult;
+        sp.offset      = cb_offset;
+        eb_fgn_add_noise_chroma_hbd(cb,
+                                    chroma_stride,
+                                    luma,
+                                    luma_stride,
+                                    cb_grain,
+                                    chroma_grain_stride,
+                                    chroma_width,
+                                    chroma_height,
+                                    chroma_subsamp_x,
+                                    chroma_subsamp_y,
+                                    &sp);
+    }
+    if (apply_cr) {
+        sp.scaling_lut = scaling_lut_cr;
+        sp.luma_mult   = cr_luma_mult;
+        sp.mult        = cr_mult;
+        sp.offset      = cr_offset;
+        eb_fgn_add_noise_chroma_hbd(cr,
+                                    chroma_stride,
+                                    luma,
+                                    luma_stride,
+                                    cr_grain,
+                                    chroma_grain_stride,
+                                    chroma_width,
+                                    chroma_height,
+                                    chroma_subsamp_x,
+                                    chroma_subsamp_y,
+                                    &sp);
+    }
+    if (apply_y) {
+        sp.scaling_lut = scaling_lut_y;
+        sp.min_value   = min_luma;
+        sp.max_value   = max_luma;
+        eb_fgn_add_noise_luma_hbd(luma,
+                                  luma_stride,
+                                  luma_grain,
+                                  luma_grain_stride,
+                                  half_luma_width << 1,
+                                  half_luma_height << 1,
+                                  &sp);
+    }
+#else
     for (int32_t i = 0; i < (half_luma_height << (1 - chroma_subsamp_y)); i++) {
         for (int32_t j = 0; j < (half_luma_width << (1 - chroma_subsamp_x)); j++) {
             int32_t average_luma = 0;
@@ -801,6 +1049,7 @@ static void add_noise_to_block_hbd(AomFilmGrain *params, uint16_t *luma, uint16_
             }
         }
     }
+#endif
 }
 
 int32_t film_grain_params_equal(AomFilmGrain *pars_a, AomFilmGrain *pars_b) {
@@ -900,9 +1149,54 @@ static void ver_boundary_overlap(int32_t *left_block, int32_t left_stride, int32
     }
 }
 
+#if FILM_GRAIN_SIMD
+void eb_fgn_hor_boundary_overlap_c(const int32_t *top_block, int32_t top_stride,
+                                   const int32_t *bottom_block, int32_t bottom_stride,
+                                   int32_t *dst_block, int32_t dst_stride, int32_t width,
+                                   int32_t height, int32_t grain_min, int32_t grain_max) {
+    if (height == 1) {
+        while (width) {
+            *dst_block =
+                clamp((*top_block * 23 + *bottom_block * 22 + 16) >> 5, grain_min, grain_max);
+            ++top_block;
+            ++bottom_block;
+            ++dst_block;
+            --width;
+        }
+        return;
+    } else if (height == 2) {
+        while (width) {
+            dst_block[0] =
+                clamp((27 * top_block[0] + 17 * bottom_block[0] + 16) >> 5, grain_min, grain_max);
+            dst_block[dst_stride] =
+                clamp((17 * top_block[top_stride] + 27 * bottom_block[bottom_stride] + 16) >> 5,
+                      grain_min,
+                      grain_max);
+            ++top_block;
+            ++bottom_block;
+            ++dst_block;
+            --width;
+        }
+        return;
+    }
+}
+#endif
+
 static void hor_boundary_overlap(int32_t *top_block, int32_t top_stride, int32_t *bottom_block,
                                  int32_t bottom_stride, int32_t *dst_block, int32_t dst_stride,
                                  int32_t width, int32_t height) {
+#if FILM_GRAIN_SIMD
+    eb_fgn_hor_boundary_overlap(top_block,
+                                top_stride,
+                                bottom_block,
+                                bottom_stride,
+                                dst_block,
+                                dst_stride,
+                                width,
+                                height,
+                                grain_min,
+                                grain_max);
+#else
     if (height == 1) {
         while (width) {
             *dst_block =
@@ -928,6 +1222,7 @@ static void hor_boundary_overlap(int32_t *top_block, int32_t top_stride, int32_t
         }
         return;
     }
+#endif
 }
 
 void eb_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb, uint8_t *cr,
@@ -1038,8 +1333,13 @@ void eb_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb,
     init_scaling_function(params->scaling_points_y, params->num_y_points, scaling_lut_y);
 
     if (params->chroma_scaling_from_luma) {
+#if FILM_GRAIN_SIMD
+        memcpy(scaling_lut_cb, scaling_lut_y, sizeof(scaling_lut_y));
+        memcpy(scaling_lut_cr, scaling_lut_y, sizeof(scaling_lut_y));
+#else
         memcpy(scaling_lut_cb, scaling_lut_y, sizeof(*scaling_lut_y) * 256);
         memcpy(scaling_lut_cr, scaling_lut_y, sizeof(*scaling_lut_y) * 256);
+#endif
     } else {
         init_scaling_function(params->scaling_points_cb, params->num_cb_points, scaling_lut_cb);
         init_scaling_function(params->scaling_points_cr, params->num_cr_points, scaling_lut_cr);
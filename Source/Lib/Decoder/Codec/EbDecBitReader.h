@@ -85,11 +85,53 @@ static INLINE int aom_read_cdf_(SvtReader *r, const AomCdfProb *cdf, int nsymbs
 
 static INLINE int aom_read_symbol_(SvtReader *r, AomCdfProb *cdf, int nsymbs ACCT_STR_PARAM) {
     int ret;
+#if DEC_FAST_ENTROPY && !CONFIG_BITSTREAM_DEBUG && !ENABLE_ENTROPY_TRACE
+    if (r->allow_update_cdf) return od_ec_decode_cdf_adapt_q15(&r->ec, cdf, nsymbs, cdf);
+#endif
     ret = svt_read_cdf(r, cdf, nsymbs, ACCT_STR_NAME);
     if (r->allow_update_cdf) dec_update_cdf(cdf, ret, nsymbs);
     return ret;
 }
 
+#if DEC_FAST_ENTROPY
+/*Coefficient base range: reads of the same BR_CDF_SIZE symbol CDF until one is
+   below BR_CDF_SIZE - 1 or COEFF_BASE_RANGE is reached, returns their sum.
+  The CDF and its counter are kept in locals across the reads and written back
+   once, the search is the sum of the three threshold compares.*/
+static INLINE int svt_read_coeff_br(SvtReader *r, AomCdfProb *cdf) {
+    int br = 0;
+#if CONFIG_BITSTREAM_DEBUG || ENABLE_ENTROPY_TRACE
+    for (int idx = 0; idx < COEFF_BASE_RANGE; idx += BR_CDF_SIZE - 1) {
+        const int k = svt_read_symbol(r, cdf, BR_CDF_SIZE, NULL);
+        br += k;
+        if (k < BR_CDF_SIZE - 1) break;
+    }
+#else
+    OdEcDec *const ec = &r->ec;
+    AomCdfProb     icdf[CDF_SIZE(BR_CDF_SIZE)];
+    memcpy(icdf, cdf, sizeof(icdf));
+    for (int idx = 0; idx < COEFF_BASE_RANGE; idx += BR_CDF_SIZE - 1) {
+        const int      n   = BR_CDF_SIZE - 1;
+        const unsigned rng = ec->rng;
+        const unsigned c   = (unsigned)(ec->dif >> (DEC_EC_WINDOW_SIZE - 16));
+        const int      k   = (c < od_ec_cdf_threshold(rng, icdf, n, 0)) +
+                      (c < od_ec_cdf_threshold(rng, icdf, n, 1)) +
+                      (c < od_ec_cdf_threshold(rng, icdf, n, 2));
+        const unsigned u = k ? od_ec_cdf_threshold(rng, icdf, n, k - 1) : rng;
+        const unsigned v = od_ec_cdf_threshold(rng, icdf, n, k);
+        assert(icdf[n] == 0);
+        assert(v < u);
+        if (r->allow_update_cdf) dec_update_cdf(icdf, (int8_t)k, BR_CDF_SIZE);
+        od_ec_dec_normalize(ec, ec->dif - ((DecEcWindow)v << (DEC_EC_WINDOW_SIZE - 16)), u - v, k);
+        br += k;
+        if (k < BR_CDF_SIZE - 1) break;
+    }
+    if (r->allow_update_cdf) memcpy(cdf, icdf, sizeof(icdf));
+#endif
+    return br;
+}
+#endif
+
 static INLINE int aom_read_ns_ae_(SvtReader *r, int nsymbs ACCT_STR_PARAM) {
     int w = get_msb(nsymbs) + 1; //w = FloorLog2(n) + 1
     int m = (1 << w) - nsymbs;
@@ -84,6 +84,67 @@
   Even relatively modest values like 100 would work fine.*/
 #define OD_EC_LOTS_OF_BITS (0x4000)
 
+#if DEC_FAST_ENTROPY
+/*The return value of od_ec_dec_tell does not change across an od_ec_dec_refill
+   call.
+  Called when cnt drops below 0, the window then has room for 6 to 8 bytes. As
+   long as 8 bytes are left in the buffer they are loaded at once, the ones
+   which do not fit entirely are left for the next refill.*/
+void od_ec_dec_refill(OdEcDec *dec) {
+    int                  s;
+    DecEcWindow          dif;
+    int16_t              cnt;
+    const unsigned char *bptr;
+    const unsigned char *end;
+    dif  = dec->dif;
+    cnt  = dec->cnt;
+    bptr = dec->bptr;
+    end  = dec->end;
+    s    = DEC_EC_WINDOW_SIZE - 9 - (cnt + 15);
+    if (end - bptr >= 8) {
+        /*Byte k goes at bit s - 8 * k as in the loop below, the big-endian
+          load has it at 56 - 8 * k.*/
+        const DecEcWindow v = ((DecEcWindow)bptr[0] << 56) | ((DecEcWindow)bptr[1] << 48) |
+                              ((DecEcWindow)bptr[2] << 40) | ((DecEcWindow)bptr[3] << 32) |
+                              ((DecEcWindow)bptr[4] << 24) | ((DecEcWindow)bptr[5] << 16) |
+                              ((DecEcWindow)bptr[6] << 8) | (DecEcWindow)bptr[7];
+        const int n = (s >> 3) + 1;
+        assert(s >= 0 && s <= 56);
+        dif ^= (v >> (56 - s)) & ~(((DecEcWindow)1 << (s & 7)) - 1);
+        cnt += (int16_t)(n << 3);
+        bptr += n;
+    } else {
+        for (; s >= 0 && bptr < end; s -= 8, bptr++) {
+            assert(s <= DEC_EC_WINDOW_SIZE - 8);
+            dif ^= (DecEcWindow)bptr[0] << s;
+            cnt += 8;
+        }
+        if (bptr >= end) {
+            /*Past the end of the buffer the window is filled with zero bits,
+              see the comment in the 32-bit version below.*/
+            dec->tell_offs += OD_EC_LOTS_OF_BITS - cnt;
+            cnt = OD_EC_LOTS_OF_BITS;
+        }
+    }
+    dec->dif  = dif;
+    dec->cnt  = cnt;
+    dec->bptr = bptr;
+}
+
+/*Initializes the decoder.
+  buf: The input buffer to use.
+  storage: The size in bytes of the input buffer.*/
+static void od_ec_dec_init(OdEcDec *dec, const unsigned char *buf, uint32_t storage) {
+    dec->buf       = buf;
+    dec->tell_offs = 10 - (DEC_EC_WINDOW_SIZE - 8);
+    dec->end       = buf + storage;
+    dec->bptr      = buf;
+    dec->dif       = ((DecEcWindow)1 << (DEC_EC_WINDOW_SIZE - 1)) - 1;
+    dec->rng       = 0x8000;
+    dec->cnt       = -15;
+    od_ec_dec_refill(dec);
+}
+#else
 /*The return value of od_ec_dec_tell does not change across an od_ec_dec_refill
    call.*/
 static void od_ec_dec_refill(OdEcDec *dec) {
@@ -230,6 +291,7 @@ int od_ec_decode_cdf_q15(OdEcDec *dec, const uint16_t *icdf, int nsyms) {
     dif -= (OdEcWindow)v << (OD_EC_WINDOW_SIZE - 16);
     return od_ec_dec_normalize(dec, dif, r, ret);
 }
+#endif
 
 /********************************************************************************************************************************/
 /********************************************************************************************************************************/
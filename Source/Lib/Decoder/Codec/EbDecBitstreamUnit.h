@@ -21,6 +21,9 @@
 #include "EbBitstreamUnit.h"
 //Added this EbBitstreamUnit.h because OdEcWindow is defined in it, but
 //we also defining it, so it leads to warning,  so i commented our defination & added EbBitstreamUnit.h file.
+#if DEC_FAST_ENTROPY && defined(ARCH_X86)
+#include <emmintrin.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -48,6 +51,16 @@ extern "C" {
 /*The size in bits of OdEcWindow.*/
 //#define OD_EC_WINDOW_SIZE ((int)sizeof(OdEcWindow) * CHAR_BIT)
 
+#if DEC_FAST_ENTROPY
+/*The decoder keeps its own 64-bit window, independent of the encoder's
+   OdEcWindow, so that a refill brings in up to 8 bytes and covers several
+   symbols.*/
+typedef uint64_t DecEcWindow;
+
+/*The size in bits of DecEcWindow.*/
+#define DEC_EC_WINDOW_SIZE ((int)sizeof(DecEcWindow) * CHAR_BIT)
+#endif
+
 /********************************************************************************************************************************/
 /********************************************************************************************************************************/
 /********************************************************************************************************************************/
@@ -123,15 +136,192 @@ typedef struct OdEcDec {
     As we shift up during renormalization, if we don't have enough bits left in
     the window to fill the top 16, we'll read in more bits of the coded
     value.*/
+#if DEC_FAST_ENTROPY
+    DecEcWindow dif;
+#else
     OdEcWindow dif;
+#endif
     /*The number of values in the current range.*/
     uint16_t rng;
     /*The number of bits of data in the current value.*/
     int16_t cnt;
 } OdEcDec;
 
+#if DEC_FAST_ENTROPY
+void od_ec_dec_refill(OdEcDec *dec);
+
+/*Takes updated dif and range values, renormalizes them so that
+   32768 <= rng < 65536 (reading more bytes from the stream into dif if
+   necessary), and stores them back in the decoder context.
+  Return: ret.*/
+static INLINE int od_ec_dec_normalize(OdEcDec *dec, DecEcWindow dif, unsigned rng, int ret) {
+    assert(rng <= 65535U);
+    /*The number of leading zeros in the 16-bit binary representation of rng.*/
+    const int d = 16 - OD_ILOG_NZ(rng);
+    /*d bits in dec->dif are consumed.*/
+    dec->cnt -= d;
+    /*This is equivalent to shifting in 1's instead of 0's.*/
+    dec->dif = ((dif + 1) << d) - 1;
+    dec->rng = rng << d;
+    if (dec->cnt < 0) od_ec_dec_refill(dec);
+    return ret;
+}
+
+/*Decode a single binary value.
+  f: The probability that the bit is one, scaled by 32768.
+  Return: The value decoded (0 or 1).*/
+static INLINE int od_ec_decode_bool_q15(OdEcDec *dec, unsigned f) {
+    const DecEcWindow dif = dec->dif;
+    const unsigned    r   = dec->rng;
+    assert(0 < f);
+    assert(f < 32768U);
+    assert(dif >> (DEC_EC_WINDOW_SIZE - 16) < r);
+    assert(32768U <= r);
+    const unsigned v =
+        ((r >> 8) * (uint32_t)(f >> EC_PROB_SHIFT) >> (7 - EC_PROB_SHIFT)) + EC_MIN_PROB;
+    const DecEcWindow vw = (DecEcWindow)v << (DEC_EC_WINDOW_SIZE - 16);
+    if (dif >= vw) return od_ec_dec_normalize(dec, dif - vw, r - v, 0);
+    return od_ec_dec_normalize(dec, dif, v, 1);
+}
+
+/*Scaled probability of the symbols above k, the decision thresholds of the
+   search in od_ec_decode_cdf_q15().*/
+static INLINE unsigned od_ec_cdf_threshold(unsigned r, const uint16_t *icdf, int n, int k) {
+    return ((r >> 8) * (uint32_t)(icdf[k] >> EC_PROB_SHIFT) >> (7 - EC_PROB_SHIFT - CDF_SHIFT)) +
+           EC_MIN_PROB * (n - k);
+}
+
+#ifdef ARCH_X86
+/*Same as od_ec_cdf_threshold() on 8 symbols at once. The 17-bit product is
+   rebuilt from the low and high halves before the shift, the result fits 16
+   bits since icdf[] < 32768.*/
+static INLINE __m128i od_ec_cdf_threshold_sse2(const __m128i icdf, const __m128i r8,
+                                               const __m128i min_prob) {
+    const __m128i p  = _mm_srli_epi16(icdf, EC_PROB_SHIFT);
+    const __m128i lo = _mm_mullo_epi16(p, r8);
+    const __m128i hi = _mm_mulhi_epu16(p, r8);
+    const __m128i v  = _mm_or_si128(_mm_srli_epi16(lo, 1), _mm_slli_epi16(hi, 15));
+    return _mm_add_epi16(v, min_prob);
+}
+
+/*One bit per symbol k < n with c < v_k, two bits per lane as returned by
+   _mm_movemask_epi8().*/
+static INLINE uint32_t od_ec_cdf_search_mask_sse2(const __m128i v, const __m128i c) {
+    const __m128i ge = _mm_cmpeq_epi16(_mm_subs_epu16(v, c), _mm_setzero_si128());
+    return (uint32_t)_mm_movemask_epi8(ge) ^ 0xFFFF;
+}
+
+/*The CDF adaptation of dec_update_cdf() on 8 symbols, lanes from n on are
+   written back unchanged.*/
+static INLINE __m128i od_ec_cdf_adapt_sse2(const __m128i icdf, const __m128i lane, int val, int n,
+                                           const __m128i rate) {
+    const __m128i up   = _mm_add_epi16(
+        icdf, _mm_srl_epi16(_mm_sub_epi16(_mm_set1_epi16((int16_t)AOM_ICDF(0)), icdf), rate));
+    const __m128i down = _mm_sub_epi16(icdf, _mm_srl_epi16(icdf, rate));
+    const __m128i is_up   = _mm_cmplt_epi16(lane, _mm_set1_epi16((int16_t)val));
+    const __m128i is_sym  = _mm_cmplt_epi16(lane, _mm_set1_epi16((int16_t)n));
+    const __m128i adapted = _mm_or_si128(_mm_and_si128(is_up, up), _mm_andnot_si128(is_up, down));
+    return _mm_or_si128(_mm_and_si128(is_sym, adapted), _mm_andnot_si128(is_sym, icdf));
+}
+#endif
+
+/*Decodes a symbol given an inverse cumulative distribution function (CDF)
+   table in Q15, and adapts the table to it when adapt_cdf is set.
+  The decision thresholds of all the symbols are compared to the window at
+   once, the decoded symbol is the number of thresholds above it. The CDF is
+   adapted from the same load.
+  icdf: CDF_PROB_TOP minus the CDF, icdf[nsyms - 1] must be 0.
+        Up to 16 entries are read, they must stay within the frame context.
+  nsyms: The number of symbols in the alphabet, at most 16.
+  adapt_cdf: icdf to adapt to the decoded symbol, or NULL.
+  Return: The decoded symbol s.*/
+static INLINE int od_ec_decode_cdf_adapt_q15(OdEcDec *dec, const uint16_t *icdf, int nsyms,
+                                             uint16_t *adapt_cdf) {
+    const DecEcWindow dif = dec->dif;
+    const unsigned    r   = dec->rng;
+    const int         n   = nsyms - 1;
+    const unsigned    c   = (unsigned)(dif >> (DEC_EC_WINDOW_SIZE - 16));
+    int               ret;
+
+    assert(dif >> (DEC_EC_WINDOW_SIZE - 16) < r);
+    assert(icdf[nsyms - 1] == OD_ICDF(CDF_PROB_TOP));
+    assert(32768U <= r);
+    assert(nsyms >= 2 && nsyms <= 16);
+    assert(7 - EC_PROB_SHIFT - CDF_SHIFT >= 0);
+
+    if (nsyms == 2) {
+        const unsigned v = od_ec_cdf_threshold(r, icdf, n, 0);
+        ret              = c < v;
+        if (adapt_cdf) dec_update_cdf(adapt_cdf, (int8_t)ret, nsyms);
+        if (ret) return od_ec_dec_normalize(dec, dif, v, 1);
+        return od_ec_dec_normalize(
+            dec, dif - ((DecEcWindow)v << (DEC_EC_WINDOW_SIZE - 16)), r - v, 0);
+    }
+
+#ifdef ARCH_X86
+    const __m128i lane  = _mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m128i lane4 = _mm_slli_epi16(lane, 2);
+    const __m128i r8    = _mm_set1_epi16((int16_t)(r >> 8));
+    const __m128i cv    = _mm_set1_epi16((int16_t)c);
+    const __m128i icdf0 = _mm_loadu_si128((const __m128i *)icdf);
+    __m128i       icdf1 = _mm_setzero_si128();
+    uint32_t      mask  = od_ec_cdf_search_mask_sse2(
+        od_ec_cdf_threshold_sse2(
+            icdf0, r8, _mm_sub_epi16(_mm_set1_epi16((int16_t)(EC_MIN_PROB * n)), lane4)),
+        cv);
+    if (nsyms > 8) {
+        icdf1 = _mm_loadu_si128((const __m128i *)(icdf + 8));
+        mask |= od_ec_cdf_search_mask_sse2(
+                    od_ec_cdf_threshold_sse2(
+                        icdf1,
+                        r8,
+                        _mm_sub_epi16(_mm_set1_epi16((int16_t)(EC_MIN_PROB * (n - 8))), lane4)),
+                    cv)
+                << 16;
+    }
+    /*Lanes past the last symbol are not part of the alphabet, the search stops
+       at the first threshold not above c as the scalar loop does.*/
+    mask &= (1u << (2 * n)) - 1;
+    ret = get_msb((mask + 1) & ~mask) >> 1;
+#else
+    ret = 0;
+    while (c < od_ec_cdf_threshold(r, icdf, n, ret)) ++ret;
+#endif
+
+    /*Both thresholds come from the CDF before its adaptation.*/
+    const unsigned u = ret ? od_ec_cdf_threshold(r, icdf, n, ret - 1) : r;
+    const unsigned v = od_ec_cdf_threshold(r, icdf, n, ret);
+    assert(v < u);
+    assert(u <= r);
+
+    if (adapt_cdf) {
+#ifdef ARCH_X86
+        const int     count = adapt_cdf[nsyms];
+        const __m128i rate =
+            _mm_cvtsi32_si128(3 + (count > 15) + (count > 31) + (nsyms > 3 ? 2 : 1));
+        assert(adapt_cdf == icdf);
+        _mm_storeu_si128((__m128i *)adapt_cdf, od_ec_cdf_adapt_sse2(icdf0, lane, ret, n, rate));
+        if (nsyms > 8) {
+            _mm_storeu_si128(
+                (__m128i *)(adapt_cdf + 8),
+                od_ec_cdf_adapt_sse2(icdf1, _mm_add_epi16(lane, _mm_set1_epi16(8)), ret, n, rate));
+        }
+        adapt_cdf[nsyms] = (uint16_t)(count + (count < 32));
+#else
+        dec_update_cdf(adapt_cdf, (int8_t)ret, nsyms);
+#endif
+    }
+    return od_ec_dec_normalize(
+        dec, dif - ((DecEcWindow)v << (DEC_EC_WINDOW_SIZE - 16)), u - v, ret);
+}
+
+static INLINE int od_ec_decode_cdf_q15(OdEcDec *dec, const uint16_t *cdf, int nsyms) {
+    return od_ec_decode_cdf_adapt_q15(dec, cdf, nsyms, NULL);
+}
+#else
 int od_ec_decode_bool_q15(OdEcDec *dec, unsigned f);
 int od_ec_decode_cdf_q15(OdEcDec *dec, const uint16_t *cdf, int nsyms);
+#endif
 
 /********************************************************************************************************************************/
 /********************************************************************************************************************************/
@@ -22,6 +22,7 @@
 #include "EbDecNbr.h"
 #include "EbUtility.h"
 #include "EbDecCdef.h"
+#include "EbDecRoi.h"
 
 /*Compute's whether 8x8 block is skip or not skip block*/
 static INLINE int32_t dec_is_8x8_block_skip(BlockModeInfo *mbmi) {
@@ -120,7 +121,13 @@ void svt_cdef_block(EbDecHandle *dec_handle, int32_t *mi_wide_l2, int32_t *mi_hi
     int32_t nhb, nvb;
     int32_t cstart     = 0;
     curr_row_cdef[fbc] = 0;
+#if DEC_ROI_DECODE
+    /* Blocks outside the region of interest are left as unfiltered ones */
+    if (sb_info == NULL || sb_info->sb_cdef_strength[index] == -1 ||
+        !dec_roi_mi_in(&dec_handle->roi_info, fbr * MI_SIZE_64X64, fbc * MI_SIZE_64X64)) {
+#else
     if (sb_info == NULL || sb_info->sb_cdef_strength[index] == -1) {
+#endif
         *cdef_left = 0;
         return;
     }
@@ -524,9 +531,16 @@ void svt_cdef_sb_row_mt(EbDecHandle *dec_handle, int32_t *mi_wide_l2, int32_t *m
         /* Top-Right Sync*/
         if (sb_fbr) {
             if (sb_fbc == pic_width_in_sb - 1) nsync = 0;
+#if DEC_PARKED_WORKERS
+            dec_mt_wait_progress(dec_mt_frame_data,
+                                 (volatile int32_t *)cdef_completed_in_prev_row,
+                                 (int32_t)(sb_fbc + nsync),
+                                 NULL);
+#else
             while (*cdef_completed_in_prev_row < (sb_fbc + nsync))
                 ;
             //Sleep(5); /* ToDo : Change */
+#endif
         }
         /*Curr multi thread implementation of cdef goes through every SB SIZE row*/
         /*If SB SIZE is 128x128, as cdef excepts top right sync,
@@ -584,6 +598,9 @@ void svt_cdef_sb_row_mt(EbDecHandle *dec_handle, int32_t *mi_wide_l2, int32_t *m
         }
         /* Update Top-Right Sync*/
         *cdef_completed_in_row = sb_fbc;
+#if DEC_PARKED_WORKERS
+        dec_mt_notify_progress(dec_mt_frame_data);
+#endif
     }
 }
 
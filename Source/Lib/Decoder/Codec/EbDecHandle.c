@@ -19,6 +19,12 @@
 #include "EbDecMemInit.h"
 #include "EbDecPicMgr.h"
 #include "grainSynthesis.h"
+#if DEC_OUT_CONVERT
+#include "EbDecOutput.h"
+#endif
+#if DEC_ROI_DECODE
+#include "EbDecRoi.h"
+#endif
 
 #ifndef _WIN32
 #include <pthread.h>
@@ -115,6 +121,22 @@ static EbErrorType eb_dec_handle_ctor(EbDecHandle **decHandleDblPtr, EbComponent
     svt_dec_lib_malloc_count = 0;
 
     dec_handle_ptr->start_thread_process = EB_FALSE;
+#if DEC_EXT_FRAME_BUF
+    dec_handle_ptr->ext_frame_buf = EB_FALSE;
+    dec_handle_ptr->out_pic_buf     = NULL;
+    dec_handle_ptr->out_pic_refused = EB_FALSE;
+    dec_handle_ptr->out_pic_held    = 0;
+    dec_handle_ptr->pv_pic_mgr    = NULL;
+#endif
+#if DEC_ROI_DECODE
+    memset(&dec_handle_ptr->roi, 0, sizeof(dec_handle_ptr->roi));
+    dec_handle_ptr->roi_info.enable = EB_FALSE;
+#endif
+#if DEC_OUT_CONVERT
+    dec_handle_ptr->out_job.active     = EB_FALSE;
+    dec_handle_ptr->out_fg_buf      = NULL;
+    dec_handle_ptr->out_fg_buf_size = 0;
+#endif
     memory_map_start_address = NULL;
     memory_map_end_address = NULL;
 
@@ -137,6 +159,302 @@ static void copy_even(uint8_t *luma, uint32_t wd,
             sizeof(*luma) * (wd << use_hbd));
     }
 }
+#if DEC_OUT_CONVERT
+/* Bit depth of the output picture, see eight_bit_output and ten_bit_output */
+static EbBitDepth dec_out_bit_depth(const EbSvtAv1DecConfiguration *config,
+                                    EbBitDepthEnum             recon_bit_depth) {
+    if (config->eight_bit_output) return EB_EIGHT_BIT;
+    if (config->ten_bit_output && recon_bit_depth == EB_8BIT) return EB_TEN_BIT;
+    return (EbBitDepth)recon_bit_depth;
+}
+
+static void dec_out_set_plane(DecOutPlane *plane, const uint8_t *src, const uint8_t *src_v,
+                              uint32_t src_stride, uint8_t *dst, uint32_t dst_stride,
+                              uint32_t width, uint32_t height) {
+    plane->src        = src;
+    plane->src_v      = src_v;
+    plane->src_stride = src_stride;
+    plane->dst        = dst;
+    plane->dst_stride = dst_stride;
+    plane->width      = width;
+    plane->height     = height;
+}
+
+/* Copy from recon buffer to out buffer, with the bit depth conversion and the
+   NV12/P010 chroma interleaving done on the way */
+int svt_dec_out_buf(EbDecHandle *dec_handle_ptr, EbBufferHeaderType *p_buffer) {
+    EbPictureBufferDesc *recon_picture_buf = dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf;
+    EbSvtIOFormat *      out_img           = (EbSvtIOFormat *)p_buffer->p_buffer;
+    DecOutJob *          job               = &dec_handle_ptr->out_job;
+
+    uint8_t *luma = NULL;
+    uint8_t *cb   = NULL;
+    uint8_t *cr   = NULL;
+
+    /* TODO: Should add logic for show_existing_frame */
+    if (0 == dec_handle_ptr->show_frame) {
+        assert(0 == dec_handle_ptr->show_existing_frame);
+        return 0;
+    }
+
+    uint32_t wd = dec_handle_ptr->frame_header.frame_size.superres_upscaled_width;
+    uint32_t ht = dec_handle_ptr->frame_header.frame_size.frame_height;
+    uint32_t sx = 0, sy = 0;
+    /* FilmGrain module req. even dim. for internal operation */
+    int even_w = (wd & 1) ? (wd + 1) : wd;
+    int even_h = (ht & 1) ? (ht + 1) : ht;
+
+    const EbColorFormat color_format = recon_picture_buf->color_format;
+    const EbBitDepth    out_bd =
+        dec_out_bit_depth(&dec_handle_ptr->dec_config, recon_picture_buf->bit_depth);
+    const EbBool nv12 = dec_handle_ptr->dec_config.nv12_output && color_format == EB_YUV420;
+    const EbBool nv12_changed = color_format != EB_YUV400 && nv12 != (out_img->cr == NULL);
+
+    if (out_img->height != ht || out_img->width != wd || out_img->color_fmt != color_format ||
+        out_img->bit_depth != out_bd || nv12_changed) {
+        int size = (out_bd == EB_EIGHT_BIT) ? sizeof(uint8_t) : sizeof(uint16_t);
+
+        int luma_size   = size * even_w * even_h;
+        int chroma_size = -1;
+        out_img->color_fmt = color_format;
+        switch (color_format) {
+        case EB_YUV400:
+            out_img->cb_stride = INT32_MAX;
+            out_img->cr_stride = INT32_MAX;
+            break;
+        case EB_YUV420:
+            /* NV12/P010 : Cb and Cr interleaved in the cb plane */
+            out_img->cb_stride = ((wd + 1) >> 1) << nv12;
+            out_img->cr_stride = out_img->cb_stride;
+            chroma_size        = size * (out_img->cb_stride * ((ht + 1) >> 1));
+            break;
+        case EB_YUV422:
+            out_img->cb_stride = (wd + 1) >> 1;
+            out_img->cr_stride = (wd + 1) >> 1;
+            chroma_size        = size * (((wd + 1) >> 1) * ht);
+            break;
+        case EB_YUV444:
+            out_img->cb_stride = wd;
+            out_img->cr_stride = wd;
+            chroma_size        = size * ht * wd;
+            break;
+        default: SVT_LOG("Unsupported colour format. \n"); return 0;
+        }
+
+        /* FilmGrain module req. even dim. for internal operation */
+        out_img->y_stride  = even_w;
+        out_img->width     = wd;
+        out_img->height    = ht;
+        out_img->bit_depth = out_bd;
+
+        free(out_img->luma);
+        if (color_format != EB_YUV400) {
+            free(out_img->cb);
+            free(out_img->cr);
+        }
+        out_img->luma = (uint8_t *)malloc(luma_size);
+        if (color_format != EB_YUV400) {
+            out_img->cb = (uint8_t *)malloc(chroma_size);
+            out_img->cr = nv12 ? NULL : (uint8_t *)malloc(chroma_size);
+        }
+    }
+
+    switch (color_format) {
+    case EB_YUV400:
+        sx = -1;
+        sy = -1;
+        break;
+    case EB_YUV420:
+        sx = 1;
+        sy = 1;
+        break;
+    case EB_YUV422:
+        sx = 1;
+        sy = 0;
+        break;
+    case EB_YUV444:
+        sx = 0;
+        sy = 0;
+        break;
+    default: assert(0);
+    }
+
+    const int32_t src_hbd =
+        recon_picture_buf->bit_depth != EB_8BIT || dec_handle_ptr->is_16bit_pipeline;
+    const int32_t dst_hbd = out_bd != EB_EIGHT_BIT;
+
+    luma = out_img->luma +
+           ((out_img->origin_y * out_img->y_stride + out_img->origin_x) << dst_hbd);
+    if (nv12) {
+        cb = out_img->cb +
+             ((out_img->cb_stride * (out_img->origin_y >> sy) + ((out_img->origin_x >> sx) << 1))
+              << dst_hbd);
+    } else if (color_format != EB_YUV400) {
+        cb = out_img->cb +
+             ((out_img->cb_stride * (out_img->origin_y >> sy) + (out_img->origin_x >> sx))
+              << dst_hbd);
+        cr = out_img->cr +
+             ((out_img->cr_stride * (out_img->origin_y >> sy) + (out_img->origin_x >> sx))
+              << dst_hbd);
+    }
+
+    AomFilmGrain *film_grain_ptr = &dec_handle_ptr->cur_pic_buf[0]->film_grain_params;
+    const EbBool  apply_grain =
+        !dec_handle_ptr->dec_config.skip_film_grain && film_grain_ptr->apply_grain;
+    const uint32_t in_bd      = recon_picture_buf->bit_depth;
+    const uint32_t out_depth  = out_bd;
+    const uint32_t p010_shift = nv12 && dst_hbd ? 16 - out_depth : 0;
+    const uint32_t cw         = (wd + sx) >> sx;
+    const uint32_t ch         = (ht + sy) >> sy;
+    /* Film grain runs on planar samples at the coded depth. When the output
+       is converted or interleaved, the recon is first copied to out_fg_buf
+       and grained there */
+    const EbBool  grain_copy = apply_grain && (nv12 || out_depth != in_bd);
+    const int32_t grain_hbd  = in_bd != EB_8BIT;
+
+    const uint8_t *src_y  = recon_picture_buf->buffer_y +
+                           ((recon_picture_buf->origin_x +
+                             recon_picture_buf->origin_y * recon_picture_buf->stride_y)
+                            << src_hbd);
+    const uint8_t *src_cb = NULL;
+    const uint8_t *src_cr = NULL;
+    if (color_format != EB_YUV400) {
+        const uint32_t chroma_offset = (recon_picture_buf->origin_x >> sx) +
+                                       ((recon_picture_buf->origin_y >> sy) *
+                                        recon_picture_buf->stride_cb);
+        src_cb = recon_picture_buf->buffer_cb + (chroma_offset << src_hbd);
+        src_cr = recon_picture_buf->buffer_cr + (chroma_offset << src_hbd);
+        assert(recon_picture_buf->stride_cb == recon_picture_buf->stride_cr);
+    }
+    uint32_t src_stride_y = recon_picture_buf->stride_y;
+    uint32_t src_stride_c = recon_picture_buf->stride_cb;
+    int32_t  conv_src_hbd = src_hbd;
+
+    if (grain_copy) {
+        /* Film grain works on even luma dimensions and their chroma counterparts */
+        const uint32_t fg_stride_c = color_format != EB_YUV400 ? even_w >> sx : 0;
+        const size_t   luma_size   = (size_t)(even_w * even_h) << grain_hbd;
+        const size_t   chroma_size = color_format != EB_YUV400
+                                       ? (size_t)(fg_stride_c * (even_h >> sy)) << grain_hbd
+                                       : 0;
+        if (dec_handle_ptr->out_fg_buf_size < luma_size + 2 * chroma_size) {
+            free(dec_handle_ptr->out_fg_buf);
+            dec_handle_ptr->out_fg_buf      = (uint8_t *)malloc(luma_size + 2 * chroma_size);
+            dec_handle_ptr->out_fg_buf_size = 0;
+            if (dec_handle_ptr->out_fg_buf == NULL) return 0;
+            dec_handle_ptr->out_fg_buf_size = luma_size + 2 * chroma_size;
+        }
+        uint8_t *fg_y  = dec_handle_ptr->out_fg_buf;
+        uint8_t *fg_cb = fg_y + luma_size;
+        uint8_t *fg_cr = fg_cb + chroma_size;
+
+        /* Plain copy at the coded depth */
+        job->src_hbd    = (EbBool)src_hbd;
+        job->dst_hbd    = (EbBool)grain_hbd;
+        job->down_shift = 0;
+        job->up_shift   = 0;
+        job->num_planes = 0;
+        dec_out_set_plane(
+            &job->plane[job->num_planes++], src_y, NULL, src_stride_y, fg_y, even_w, wd, ht);
+        if (color_format != EB_YUV400) {
+            dec_out_set_plane(&job->plane[job->num_planes++],
+                              src_cb,
+                              NULL,
+                              src_stride_c,
+                              fg_cb,
+                              fg_stride_c,
+                              cw,
+                              ch);
+            dec_out_set_plane(&job->plane[job->num_planes++],
+                              src_cr,
+                              NULL,
+                              src_stride_c,
+                              fg_cr,
+                              fg_stride_c,
+                              cw,
+                              ch);
+        }
+        dec_out_run_job(dec_handle_ptr);
+
+        film_grain_ptr->bit_depth = in_bd;
+        copy_even(fg_y, wd, ht, even_w, grain_hbd);
+        eb_av1_add_film_grain_run(film_grain_ptr,
+                                  fg_y,
+                                  fg_cb,
+                                  fg_cr,
+                                  even_h,
+                                  even_w,
+                                  even_w,
+                                  fg_stride_c,
+                                  grain_hbd,
+                                  sy,
+                                  sx);
+
+        /* The grained copy is the source of the output conversion */
+        src_y        = fg_y;
+        src_cb       = fg_cb;
+        src_cr       = fg_cr;
+        src_stride_y = even_w;
+        src_stride_c = fg_stride_c;
+        conv_src_hbd = grain_hbd;
+    }
+
+    job->src_hbd    = (EbBool)conv_src_hbd;
+    job->dst_hbd    = (EbBool)dst_hbd;
+    job->down_shift = dst_hbd ? 0 : in_bd - EB_8BIT;
+    job->up_shift   = (out_depth > in_bd ? out_depth - in_bd : 0) + p010_shift;
+    job->num_planes = 0;
+    dec_out_set_plane(
+        &job->plane[job->num_planes++], src_y, NULL, src_stride_y, luma, out_img->y_stride, wd, ht);
+    if (nv12) {
+        dec_out_set_plane(&job->plane[job->num_planes++],
+                          src_cb,
+                          src_cr,
+                          src_stride_c,
+                          cb,
+                          out_img->cb_stride,
+                          cw,
+                          ch);
+    } else if (color_format != EB_YUV400) {
+        dec_out_set_plane(&job->plane[job->num_planes++],
+                          src_cb,
+                          NULL,
+                          src_stride_c,
+                          cb,
+                          out_img->cb_stride,
+                          cw,
+                          ch);
+        dec_out_set_plane(&job->plane[job->num_planes++],
+                          src_cr,
+                          NULL,
+                          src_stride_c,
+                          cr,
+                          out_img->cr_stride,
+                          cw,
+                          ch);
+    }
+    dec_out_run_job(dec_handle_ptr);
+
+    if (apply_grain && !grain_copy) {
+        /* Output at the coded depth and planar, grain is applied in place */
+        film_grain_ptr->bit_depth = in_bd;
+        copy_even(luma, wd, ht, out_img->y_stride, dst_hbd);
+        eb_av1_add_film_grain_run(film_grain_ptr,
+                                  luma,
+                                  cb,
+                                  cr,
+                                  even_h,
+                                  even_w,
+                                  out_img->y_stride,
+                                  out_img->cb_stride,
+                                  dst_hbd,
+                                  sy,
+                                  sx);
+    }
+
+    return 1;
+}
+#else
 /* Copy from recon buffer to out buffer! */
 int svt_dec_out_buf(EbDecHandle *dec_handle_ptr, EbBufferHeaderType *p_buffer) {
     EbPictureBufferDesc *recon_picture_buf = dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf;
@@ -404,6 +722,104 @@ int svt_dec_out_buf(EbDecHandle *dec_handle_ptr, EbBufferHeaderType *p_buffer) {
 
     return 1;
 }
+#endif
+
+#if DEC_EXT_FRAME_BUF
+/* Hand the shown picture to the application by reference, the reference
+   taken in svt_av1_dec_frame moves to the application */
+static int svt_dec_out_pic_ref(EbDecHandle *dec_handle_ptr, EbBufferHeaderType *p_buffer) {
+    EbDecPicBuf *  out_pic = dec_handle_ptr->out_pic_buf;
+    EbSvtIOFormat *out_img = (EbSvtIOFormat *)p_buffer->p_buffer;
+
+    if (out_pic == NULL) return 0;
+    dec_handle_ptr->out_pic_buf = NULL;
+
+    EbPictureBufferDesc *recon_picture_buf = out_pic->ps_pic_buf;
+    uint32_t             wd = dec_handle_ptr->frame_header.frame_size.superres_upscaled_width;
+    uint32_t             ht = dec_handle_ptr->frame_header.frame_size.frame_height;
+    int32_t              use_high_bit_depth = recon_picture_buf->bit_depth == EB_8BIT ? 0 : 1;
+
+    AomFilmGrain *film_grain_ptr = &out_pic->film_grain_params;
+    if (!dec_handle_ptr->dec_config.skip_film_grain && film_grain_ptr->apply_grain) {
+        /* The grain must not reach the reference, synthesize it on a copy */
+        EbDecPicBuf *grain_pic;
+        if (dec_pic_mgr_get_cur_pic(dec_handle_ptr, &grain_pic) != EB_ErrorNone) {
+            dec_ref_count_and_rel(dec_handle_ptr, out_pic);
+            return 0;
+        }
+        EbPictureBufferDesc *grain_buf = grain_pic->ps_pic_buf;
+        uint8_t *            luma, *cb = NULL, *cr = NULL;
+        int32_t              sx = -1, sy = -1;
+        /* FilmGrain module req. even dim. for internal operation */
+        int even_w = (wd & 1) ? (wd + 1) : wd;
+        int even_h = (ht & 1) ? (ht + 1) : ht;
+
+        memcpy(grain_buf->buffer_y,
+               recon_picture_buf->buffer_y,
+               recon_picture_buf->luma_size << use_high_bit_depth);
+        if (recon_picture_buf->color_format != EB_YUV400) {
+            memcpy(grain_buf->buffer_cb,
+                   recon_picture_buf->buffer_cb,
+                   recon_picture_buf->chroma_size << use_high_bit_depth);
+            memcpy(grain_buf->buffer_cr,
+                   recon_picture_buf->buffer_cr,
+                   recon_picture_buf->chroma_size << use_high_bit_depth);
+            sx = recon_picture_buf->color_format == EB_YUV444 ? 0 : 1;
+            sy = recon_picture_buf->color_format == EB_YUV420 ? 1 : 0;
+        }
+
+        switch (recon_picture_buf->bit_depth) {
+        case EB_8BIT: film_grain_ptr->bit_depth = 8; break;
+        case EB_10BIT: film_grain_ptr->bit_depth = 10; break;
+        default: assert(0);
+        }
+        luma = grain_buf->buffer_y +
+               ((grain_buf->origin_y * grain_buf->stride_y + grain_buf->origin_x)
+                << use_high_bit_depth);
+        if (recon_picture_buf->color_format != EB_YUV400) {
+            cb = grain_buf->buffer_cb + (((grain_buf->origin_y >> sy) * grain_buf->stride_cb +
+                                          (grain_buf->origin_x >> sx))
+                                         << use_high_bit_depth);
+            cr = grain_buf->buffer_cr + (((grain_buf->origin_y >> sy) * grain_buf->stride_cr +
+                                          (grain_buf->origin_x >> sx))
+                                         << use_high_bit_depth);
+        }
+        copy_even(luma, wd, ht, grain_buf->stride_y, use_high_bit_depth);
+        eb_av1_add_film_grain_run(film_grain_ptr,
+                                  luma,
+                                  cb,
+                                  cr,
+                                  even_h,
+                                  even_w,
+                                  grain_buf->stride_y,
+                                  grain_buf->stride_cb,
+                                  use_high_bit_depth,
+                                  sy,
+                                  sx);
+
+        dec_ref_count_and_rel(dec_handle_ptr, out_pic);
+        out_pic           = grain_pic;
+        recon_picture_buf = grain_buf;
+    }
+
+    out_img->luma      = recon_picture_buf->buffer_y;
+    out_img->cb        = recon_picture_buf->buffer_cb;
+    out_img->cr        = recon_picture_buf->buffer_cr;
+    out_img->y_stride  = recon_picture_buf->stride_y;
+    out_img->cb_stride = recon_picture_buf->stride_cb;
+    out_img->cr_stride = recon_picture_buf->stride_cr;
+    out_img->origin_x  = recon_picture_buf->origin_x;
+    out_img->origin_y  = recon_picture_buf->origin_y;
+    out_img->width     = wd;
+    out_img->height    = ht;
+    out_img->color_fmt = recon_picture_buf->color_format;
+    out_img->bit_depth = (EbBitDepth)recon_picture_buf->bit_depth;
+
+    p_buffer->wrapper_ptr = out_pic;
+    dec_handle_ptr->out_pic_held++;
+    return 1;
+}
+#endif
 
 /**********************************
 Set Default Library Params
@@ -438,6 +854,14 @@ EbErrorType eb_svt_dec_set_default_parameter(EbSvtAv1DecConfiguration *config_pt
     config_ptr->threads      = 1;
     config_ptr->num_p_frames = 1;
 
+    config_ptr->get_frame_buffer     = NULL;
+    config_ptr->release_frame_buffer = NULL;
+    config_ptr->frame_buffer_priv    = NULL;
+#if DEC_OUT_CONVERT
+    config_ptr->ten_bit_output = 0;
+    config_ptr->nv12_output    = 0;
+#endif
+
     return return_error;
 }
 
@@ -528,6 +952,16 @@ svt_av1_dec_set_parameter(EbComponentType *         svt_dec_component,
     EbDecHandle *dec_handle_ptr = (EbDecHandle *)svt_dec_component->p_component_private;
 
     dec_handle_ptr->dec_config = *config_struct;
+#if DEC_CLAMP_PRLL_FRAMES
+    /* Frames are decoded one at a time */
+    if (config_struct->num_p_frames < 1 || config_struct->num_p_frames > DEC_MAX_NUM_FRM_PRLL) {
+        SVT_LOG("SVT [Warning]: num_p_frames must be [1 - %d], multi frame parallelism is not "
+                "supported. Setting num_p_frames to %d\n",
+                DEC_MAX_NUM_FRM_PRLL,
+                DEC_MAX_NUM_FRM_PRLL);
+        dec_handle_ptr->dec_config.num_p_frames = DEC_MAX_NUM_FRM_PRLL;
+    }
+#endif
     dec_handle_ptr->is_16bit_pipeline = config_struct->is_16bit_pipeline;
 
     return EB_ErrorNone;
@@ -551,6 +985,20 @@ svt_av1_dec_init(EbComponentType *svt_dec_component) {
     dec_handle_ptr->num_frms_prll = 1;
     if (dec_handle_ptr->num_frms_prll > DEC_MAX_NUM_FRM_PRLL)
         dec_handle_ptr->num_frms_prll = DEC_MAX_NUM_FRM_PRLL;
+#if DEC_EXT_FRAME_BUF
+    dec_handle_ptr->ext_frame_buf = dec_handle_ptr->dec_config.get_frame_buffer != NULL &&
+                                    dec_handle_ptr->dec_config.release_frame_buffer != NULL;
+    if (dec_handle_ptr->ext_frame_buf && dec_handle_ptr->is_16bit_pipeline) {
+        SVT_LOG("SVT [Warning]: External frame buffers are not used with the 16bit pipeline\n");
+        dec_handle_ptr->ext_frame_buf = EB_FALSE;
+    }
+    /* Pictures in external frame buffers are returned as decoded */
+    if (dec_handle_ptr->ext_frame_buf &&
+        (dec_handle_ptr->dec_config.eight_bit_output || dec_handle_ptr->dec_config.ten_bit_output ||
+         dec_handle_ptr->dec_config.nv12_output))
+        SVT_LOG("SVT [Warning]: Output conversions are not applied with external frame "
+                "buffers\n");
+#endif
     dec_handle_ptr->seq_header_done = 0;
     dec_handle_ptr->mem_init_done   = 0;
 
@@ -593,6 +1041,12 @@ svt_av1_dec_frame(EbComponentType *svt_dec_component, const uint8_t *data, const
     EbDecHandle *dec_handle_ptr       = (EbDecHandle *)svt_dec_component->p_component_private;
     uint8_t *    data_start           = (uint8_t *)data;
     uint8_t *    data_end             = (uint8_t *)data + data_size;
+#if DEC_EXT_FRAME_BUF
+    /* The next shown picture would replace the pending one */
+    if (dec_handle_ptr->ext_frame_buf && dec_handle_ptr->out_pic_refused &&
+        dec_handle_ptr->out_pic_buf != NULL)
+        return EB_ErrorInsufficientResources;
+#endif
     dec_handle_ptr->seen_frame_header = 0;
 
     while (data_start < data_end) {
@@ -606,6 +1060,18 @@ svt_av1_dec_frame(EbComponentType *svt_dec_component, const uint8_t *data, const
 
         if (return_error != EB_ErrorNone) assert(0);
 
+#if DEC_EXT_FRAME_BUF
+        if (dec_handle_ptr->ext_frame_buf) {
+            /* Keep the shown picture alive past the reference update */
+            dec_ref_count_and_rel(dec_handle_ptr, dec_handle_ptr->out_pic_buf);
+            dec_handle_ptr->out_pic_buf = NULL;
+            if (return_error == EB_ErrorNone && dec_handle_ptr->show_frame &&
+                dec_handle_ptr->cur_pic_buf[0] != NULL) {
+                dec_handle_ptr->out_pic_buf = dec_handle_ptr->cur_pic_buf[0];
+                dec_handle_ptr->out_pic_buf->ref_count++;
+            }
+        }
+#endif
         dec_pic_mgr_update_ref_pic(dec_handle_ptr,
                                    (EB_ErrorNone == return_error) ? 1 : 0,
                                    dec_handle_ptr->frame_header.refresh_frame_flags);
@@ -627,6 +1093,24 @@ svt_av1_dec_frame(EbComponentType *svt_dec_component, const uint8_t *data, const
     return return_error;
 }
 
+#if DEC_ROI_DECODE
+/* Reports the area of the output picture matching a full decode */
+static void svt_dec_roi_frame_info(const EbDecPicBuf *pic_buf, EbAV1FrameInfo *frame_info) {
+    const DecRoiRect *valid = &pic_buf->roi_valid;
+
+    int32_t x0 = AOMMAX(valid->x0, 0);
+    int32_t y0 = AOMMAX(valid->y0, 0);
+    int32_t x1 = AOMMIN(valid->x1, (int32_t)pic_buf->superres_upscaled_width);
+    int32_t y1 = AOMMIN(valid->y1, (int32_t)pic_buf->frame_height);
+
+    frame_info->roi_x           = x0;
+    frame_info->roi_y           = y0;
+    frame_info->roi_width       = x1 > x0 ? x1 - x0 : 0;
+    frame_info->roi_height      = y1 > y0 ? y1 - y0 : 0;
+    frame_info->roi_ref_missing = dec_roi_ref_missing(pic_buf) ? EB_TRUE : EB_FALSE;
+}
+#endif
+
 #ifdef __GNUC__
 __attribute__((visibility("default")))
 #endif
@@ -640,11 +1124,75 @@ svt_av1_dec_get_picture(EbComponentType *svt_dec_component, EbBufferHeaderType *
     if (svt_dec_component == NULL) return EB_ErrorBadParameter;
 
     EbDecHandle *dec_handle_ptr = (EbDecHandle *)svt_dec_component->p_component_private;
+#if DEC_EXT_FRAME_BUF
+    if (dec_handle_ptr->ext_frame_buf) {
+        /* The pool only reserves DEC_MAX_OUT_PIC_HELD pictures for the application,
+           the shown picture stays pending until one is released */
+        if (dec_handle_ptr->out_pic_buf != NULL &&
+            dec_handle_ptr->out_pic_held >= DEC_MAX_OUT_PIC_HELD) {
+            dec_handle_ptr->out_pic_refused = EB_TRUE;
+            return EB_ErrorInsufficientResources;
+        }
+        dec_handle_ptr->out_pic_refused = EB_FALSE;
+        if (0 == svt_dec_out_pic_ref(dec_handle_ptr, p_buffer))
+            return_error = EB_DecNoOutputPicture;
+#if DEC_ROI_DECODE
+        else if (frame_info)
+            svt_dec_roi_frame_info((EbDecPicBuf *)p_buffer->wrapper_ptr, frame_info);
+#endif
+        return return_error;
+    }
+#endif
     /* Copy from recon pointer and return! TODO: Should remove the memcpy! */
     if (0 == svt_dec_out_buf(dec_handle_ptr, p_buffer)) return_error = EB_DecNoOutputPicture;
+#if DEC_ROI_DECODE
+    else if (frame_info)
+        svt_dec_roi_frame_info(dec_handle_ptr->cur_pic_buf[0], frame_info);
+#endif
     return return_error;
 }
 
+#ifdef __GNUC__
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType
+svt_av1_dec_set_roi(EbComponentType *svt_dec_component, const EbSvtAv1DecRoi *roi) {
+    if (svt_dec_component == NULL) return EB_ErrorBadParameter;
+
+#if DEC_ROI_DECODE
+    EbDecHandle *dec_handle_ptr = (EbDecHandle *)svt_dec_component->p_component_private;
+    if (roi == NULL)
+        memset(&dec_handle_ptr->roi, 0, sizeof(dec_handle_ptr->roi));
+    else
+        dec_handle_ptr->roi = *roi;
+    return EB_ErrorNone;
+#else
+    (void)roi;
+    return EB_ErrorBadParameter;
+#endif
+}
+
+#ifdef __GNUC__
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType
+svt_av1_dec_release_picture(EbComponentType *svt_dec_component, EbBufferHeaderType *p_buffer) {
+    if (svt_dec_component == NULL || p_buffer == NULL) return EB_ErrorBadParameter;
+
+#if DEC_EXT_FRAME_BUF
+    EbDecHandle *dec_handle_ptr = (EbDecHandle *)svt_dec_component->p_component_private;
+    if (!dec_handle_ptr->ext_frame_buf || p_buffer->wrapper_ptr == NULL)
+        return EB_ErrorBadParameter;
+
+    dec_ref_count_and_rel(dec_handle_ptr, (EbDecPicBuf *)p_buffer->wrapper_ptr);
+    p_buffer->wrapper_ptr = NULL;
+    if (dec_handle_ptr->out_pic_held > 0) dec_handle_ptr->out_pic_held--;
+    return EB_ErrorNone;
+#else
+    return EB_ErrorBadParameter;
+#endif
+}
+
 #ifdef __GNUC__
 __attribute__((visibility("default")))
 #endif
@@ -656,6 +1204,14 @@ svt_av1_dec_deinit(EbComponentType *svt_dec_component) {
 
     if (dec_handle_ptr) {
         if (dec_handle_ptr->dec_config.threads > 1) dec_sync_all_threads(dec_handle_ptr);
+#if DEC_OUT_CONVERT
+        free(dec_handle_ptr->out_fg_buf);
+        dec_handle_ptr->out_fg_buf = NULL;
+#endif
+#if DEC_EXT_FRAME_BUF
+        if (dec_handle_ptr->ext_frame_buf && dec_handle_ptr->pv_pic_mgr != NULL)
+            dec_pic_mgr_release_ext_frame_bufs(dec_handle_ptr);
+#endif
         if (svt_dec_memory_map) {
             // Loop through the ptr table and free all malloc'd pointers per channel
             EbMemoryMapEntry *memory_entry = svt_dec_memory_map;
@@ -673,6 +1229,9 @@ svt_av1_dec_deinit(EbComponentType *svt_dec_component) {
                     case EB_SEMAPHORE: eb_destroy_semaphore(memory_entry->ptr); break;
                     case EB_THREAD: eb_destroy_thread(memory_entry->ptr); break;
                     case EB_MUTEX: eb_destroy_mutex(memory_entry->ptr); break;
+#if DEC_PARKED_WORKERS
+                    case EB_COND_VAR: eb_destroy_cond_var(memory_entry->ptr); break;
+#endif
                     default: return_error = EB_ErrorMax; break;
                     }
                     EbMemoryMapEntry *tmp_memory_entry = memory_entry;
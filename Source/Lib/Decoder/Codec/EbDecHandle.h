@@ -40,8 +40,69 @@ extern "C" {
 
 /* Maximum number of frames in parallel */
 #define DEC_MAX_NUM_FRM_PRLL 1
+#if DEC_EXT_FRAME_BUF
+/* Output pictures the application may hold by reference */
+#define DEC_MAX_OUT_PIC_HELD 4
+/** Maximum picture buffers needed **/
+#define MAX_PIC_BUFS (REF_FRAMES + 1 + DEC_MAX_NUM_FRM_PRLL + DEC_MAX_OUT_PIC_HELD)
+#else
 /** Maximum picture buffers needed **/
 #define MAX_PIC_BUFS (REF_FRAMES + 1 + DEC_MAX_NUM_FRM_PRLL)
+#endif
+
+#if DEC_ROI_DECODE
+/* Luma rectangle, end exclusive */
+typedef struct DecRoiRect {
+    int32_t x0;
+    int32_t y0;
+    int32_t x1;
+    int32_t y1;
+} DecRoiRect;
+
+/* Superblocks of the current frame that are reconstructed, see svt_av1_dec_set_roi() */
+typedef struct DecRoiInfo {
+    /* Set when only part of the frame is reconstructed */
+    EbBool enable;
+    /* Tile aligned area in mi units, end exclusive */
+    int32_t mi_row_start;
+    int32_t mi_row_end;
+    int32_t mi_col_start;
+    int32_t mi_col_end;
+} DecRoiInfo;
+#endif
+
+#if DEC_OUT_CONVERT
+/* One plane of the output copy, strides and width in samples. For NV12/P010
+   chroma src is the Cb plane, src_v the Cr plane and width the Cb width */
+typedef struct DecOutPlane {
+    const uint8_t *src;
+    const uint8_t *src_v;
+    uint32_t       src_stride;
+    uint8_t *      dst;
+    uint32_t       dst_stride;
+    uint32_t       width;
+    uint32_t       height;
+    uint32_t       band_height;
+    uint32_t       num_bands;
+} DecOutPlane;
+
+/* Output copy of a shown frame, split in row bands shared with the MT workers */
+typedef struct DecOutJob {
+    DecOutPlane plane[MAX_MB_PLANE];
+    int32_t     num_planes;
+    /* 16-bit samples in the source / destination */
+    EbBool   src_hbd;
+    EbBool   dst_hbd;
+    /* Rounding right shift to 8-bit, or left shift to a higher depth or to P010 */
+    uint32_t down_shift;
+    uint32_t up_shift;
+    int32_t  num_units;
+    /* Protected by dec_mt_frame_data.temp_mutex */
+    int32_t          next_unit;
+    volatile int32_t units_done;
+    volatile EbBool  active;
+} DecOutJob;
+#endif
 
 /** Picture Structure **/
 typedef struct EbDecPicBuf {
@@ -89,6 +150,18 @@ typedef struct EbDecPicBuf {
     int8_t ref_deltas[REF_FRAMES];
     // 0 = ZERO_MV, MV
     int8_t mode_deltas[MAX_MODE_LF_DELTAS];
+#if DEC_EXT_FRAME_BUF
+    /* Application memory backing ps_pic_buf planes, buffer is NULL when not held */
+    EbExtFrameBuf ext_frame_buf;
+#endif
+#if DEC_ROI_DECODE
+    /* Area matching a full decode, sides on the frame border are unbounded */
+    DecRoiRect roi_valid;
+    /* Set when a block of roi_valid referenced samples outside the roi_valid
+       of its reference, or a reference that had this flag set. Only accessed
+       atomically, through EbDecRoi.c */
+    volatile int32_t roi_ref_missing;
+#endif
 } EbDecPicBuf;
 
 /* Frame level buffers */
@@ -231,6 +304,18 @@ typedef struct EbDecHandle {
     EbDecPicBuf *cur_pic_buf[DEC_MAX_NUM_FRM_PRLL];
 
     // Callbacks
+#if DEC_EXT_FRAME_BUF
+    /* Picture memory comes from dec_config.get_frame_buffer */
+    EbBool ext_frame_buf;
+    /* Shown picture held for svt_av1_dec_get_picture */
+    EbDecPicBuf *out_pic_buf;
+    /* out_pic_buf was refused for lack of room, decoding waits until it is
+       handed out */
+    EbBool out_pic_refused;
+    /* Pictures returned by reference and not released yet, at most
+       DEC_MAX_OUT_PIC_HELD */
+    int32_t out_pic_held;
+#endif
 
     //DPB + MV, ... buf
 
@@ -255,6 +340,19 @@ typedef struct EbDecHandle {
     struct DecThreadCtxt *thread_ctxt_pa;
 
     EbBool is_16bit_pipeline; // internal bit-depth: when equals 1 internal bit-depth is 16bits regardless of the input bit-depth
+#if DEC_ROI_DECODE
+    /* Region set by svt_av1_dec_set_roi() */
+    EbSvtAv1DecRoi roi;
+    /* Region of the frame being decoded */
+    DecRoiInfo roi_info;
+#endif
+#if DEC_OUT_CONVERT
+    DecOutJob out_job;
+    /* Planar copy at the coded depth, film grain is applied on it ahead of the
+       depth conversion and the NV12 interleave */
+    uint8_t *out_fg_buf;
+    size_t   out_fg_buf_size;
+#endif
 } EbDecHandle;
 
 /* Thread level context data */
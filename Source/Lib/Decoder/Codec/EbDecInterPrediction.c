@@ -32,6 +32,7 @@
 #include "EbDecProcessFrame.h"
 #include "EbDecIntraPrediction.h"
 #include "EbDecInterPrediction.h"
+#include "EbDecRoi.h"
 #include "EbUtility.h"
 #include "EbDefinitions.h"
 #include "EbWarpedMotion.h"
@@ -894,6 +895,23 @@ void svtav1_predict_inter_block_plane(DecModCtxt *dec_mod_ctx, EbDecHandle *dec_
                  (((mode == GLOBALMV || mode == GLOBAL_GLOBALMV) &&
                    (wm_global->wmtype > TRANSLATION)) ||
                   (mi->motion_mode == WARPED_CAUSAL)));
+#if DEC_ROI_DECODE
+            if (plane == 0 && !is_intrabc) {
+                const int32_t is_scaled =
+                    ref_buf->frame_width != cur_frm_hdr->frame_size.frame_width ||
+                    ref_buf->frame_height != cur_frm_hdr->frame_size.frame_height;
+                dec_roi_check_ref(dec_hdl->cur_pic_buf[0],
+                                  ref_buf,
+                                  pre_x,
+                                  pre_y,
+                                  bw,
+                                  bh,
+                                  mi->mv[ref].as_mv,
+                                  part_info->subsampling_x,
+                                  part_info->subsampling_y,
+                                  do_warp || is_scaled);
+            }
+#endif
 
             void *  src;
             int32_t src_stride;
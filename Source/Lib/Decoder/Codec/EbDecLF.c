@@ -27,6 +27,7 @@ Contains the Decoder Loop Filtering related functions*/
 #include "EbDeblockingCommon.h"
 #include "EbDecNbr.h"
 #include "EbDecLF.h"
+#include "EbDecRoi.h"
 #include "common_dsp_rtcd.h"
 #define FILTER_LEN 4
 
@@ -38,6 +39,12 @@ SvtLbdFilterTapFn lbd_vert_filter_tap[FILTER_LEN];
 SvtHbdFilterTapFn hbd_vert_filter_tap[FILTER_LEN];
 SvtLbdFilterTapFn lbd_horz_filter_tap[FILTER_LEN];
 SvtHbdFilterTapFn hbd_horz_filter_tap[FILTER_LEN];
+#if DLF_DUAL_EDGE_AVX2
+SvtLbdDualFilterTapFn lbd_vert_filter_tap_dual[FILTER_LEN];
+SvtLbdDualFilterTapFn lbd_horz_filter_tap_dual[FILTER_LEN];
+SvtHbdDualFilterTapFn hbd_vert_filter_tap_dual[FILTER_LEN];
+SvtHbdDualFilterTapFn hbd_horz_filter_tap_dual[FILTER_LEN];
+#endif
 
 void set_lbd_lf_filter_tap_functions(void) {
     lbd_horz_filter_tap[0] = aom_lpf_horizontal_4;
@@ -49,6 +56,18 @@ void set_lbd_lf_filter_tap_functions(void) {
     lbd_vert_filter_tap[1] = aom_lpf_vertical_6;
     lbd_vert_filter_tap[2] = aom_lpf_vertical_8;
     lbd_vert_filter_tap[3] = aom_lpf_vertical_14;
+#if DLF_DUAL_EDGE_AVX2
+
+    lbd_horz_filter_tap_dual[0] = aom_lpf_horizontal_4_dual;
+    lbd_horz_filter_tap_dual[1] = aom_lpf_horizontal_6_dual;
+    lbd_horz_filter_tap_dual[2] = aom_lpf_horizontal_8_dual;
+    lbd_horz_filter_tap_dual[3] = aom_lpf_horizontal_14_dual;
+
+    lbd_vert_filter_tap_dual[0] = aom_lpf_vertical_4_dual;
+    lbd_vert_filter_tap_dual[1] = aom_lpf_vertical_6_dual;
+    lbd_vert_filter_tap_dual[2] = aom_lpf_vertical_8_dual;
+    lbd_vert_filter_tap_dual[3] = aom_lpf_vertical_14_dual;
+#endif
 }
 
 void set_hbd_lf_filter_tap_functions(void) {
@@ -61,6 +80,18 @@ void set_hbd_lf_filter_tap_functions(void) {
     hbd_vert_filter_tap[1] = aom_highbd_lpf_vertical_6;
     hbd_vert_filter_tap[2] = aom_highbd_lpf_vertical_8;
     hbd_vert_filter_tap[3] = aom_highbd_lpf_vertical_14;
+#if DLF_DUAL_EDGE_AVX2
+
+    hbd_horz_filter_tap_dual[0] = aom_highbd_lpf_horizontal_4_dual;
+    hbd_horz_filter_tap_dual[1] = aom_highbd_lpf_horizontal_6_dual;
+    hbd_horz_filter_tap_dual[2] = aom_highbd_lpf_horizontal_8_dual;
+    hbd_horz_filter_tap_dual[3] = aom_highbd_lpf_horizontal_14_dual;
+
+    hbd_vert_filter_tap_dual[0] = aom_highbd_lpf_vertical_4_dual;
+    hbd_vert_filter_tap_dual[1] = aom_highbd_lpf_vertical_6_dual;
+    hbd_vert_filter_tap_dual[2] = aom_highbd_lpf_vertical_8_dual;
+    hbd_vert_filter_tap_dual[3] = aom_highbd_lpf_vertical_14_dual;
+#endif
 }
 
 /*Population of neighbour block lf params for each 4x4 block*/
@@ -455,6 +486,33 @@ void dec_av1_filter_block_plane_vert(EbDecHandle *dec_handle,
 
                     for (int32_t h = 0; h < min_high; h += 4) {
                         int8_t filter_idx = filter_map[params.filter_length];
+#if DLF_DUAL_EDGE_AVX2
+                        // Every 4-row segment of the run shares the same parameters
+                        if (filter_idx != -1 && h + 8 <= min_high) {
+                            if (is16bit)
+                                hbd_vert_filter_tap_dual[filter_idx]((uint16_t*)(p),
+                                                                     recon_stride,
+                                                                     params.mblim,
+                                                                     params.lim,
+                                                                     params.hev_thr,
+                                                                     params.mblim,
+                                                                     params.lim,
+                                                                     params.hev_thr,
+                                                                     recon_picture_buf->bit_depth);
+                            else
+                                lbd_vert_filter_tap_dual[filter_idx](p,
+                                                                     recon_stride,
+                                                                     params.mblim,
+                                                                     params.lim,
+                                                                     params.hev_thr,
+                                                                     params.mblim,
+                                                                     params.lim,
+                                                                     params.hev_thr);
+                            p += ((8 * recon_stride) << is16bit);
+                            h += 4;
+                            continue;
+                        }
+#endif
                         if (filter_idx != -1) {
                             if (is16bit)
                                 hbd_vert_filter_tap[filter_idx]((uint16_t*)(p),//CONVERT_TO_SHORTPTR(p),
@@ -657,6 +715,33 @@ void dec_av1_filter_block_plane_horz(EbDecHandle *dec_handle, SBInfo *sb_info,
 
                     for (uint8_t w = 0; w < min_width; w += 4) {
                         int filter_idx = filter_map[params.filter_length];
+#if DLF_DUAL_EDGE_AVX2
+                        // Every 4-column segment of the run shares the same parameters
+                        if (filter_idx != -1 && w + 8 <= min_width) {
+                            if (is16bit)
+                                hbd_horz_filter_tap_dual[filter_idx]((uint16_t*)(p),
+                                                                     recon_stride,
+                                                                     params.mblim,
+                                                                     params.lim,
+                                                                     params.hev_thr,
+                                                                     params.mblim,
+                                                                     params.lim,
+                                                                     params.hev_thr,
+                                                                     recon_picture_buf->bit_depth);
+                            else
+                                lbd_horz_filter_tap_dual[filter_idx](p,
+                                                                     recon_stride,
+                                                                     params.mblim,
+                                                                     params.lim,
+                                                                     params.hev_thr,
+                                                                     params.mblim,
+                                                                     params.lim,
+                                                                     params.hev_thr);
+                            p += (8 << is16bit);
+                            w += 4;
+                            continue;
+                        }
+#endif
 
                         if (filter_idx != -1) {
                             if (is16bit)
@@ -698,9 +783,26 @@ void dec_loop_filter_sb(EbDecHandle *dec_handle,
                         int32_t *sb_delta_lf) {
 
     int num_planes = plane_end - plane_start;
+#if DEC_ROI_DECODE
+    /* Outside the region of interest nothing is filtered, the horizontal
+       edges of its last superblock in a row are filtered by the next one */
+    int32_t max_mib_size = seq_header->sb_size == BLOCK_128X128 ? MAX_MIB_SIZE : SB64_MIB_SIZE;
+    int32_t sb_in        = dec_roi_mi_in(&dec_handle->roi_info, mi_row, mi_col);
+    int32_t prev_sb_in   = dec_roi_mi_in(&dec_handle->roi_info, mi_row, mi_col - max_mib_size);
+#endif
     if (frm_hdr->loop_filter_params.combine_vert_horz_lf) {
         /*filter all vertical and horizontal edges in every 64x64 super block
          filter vertical edges*/
+#if DEC_ROI_DECODE
+        if (sb_in)
+            dec_av1_filter_block_plane_vert(dec_handle, sb_info,
+                                            recon_picture_buf,
+                                            lf_ctxt,
+                                            num_planes,
+                                            mi_row,
+                                            mi_col,
+                                            sb_delta_lf);
+#else
         dec_av1_filter_block_plane_vert(dec_handle, sb_info,
                                         recon_picture_buf,
                                         lf_ctxt,
@@ -708,12 +810,17 @@ void dec_loop_filter_sb(EbDecHandle *dec_handle,
                                         mi_row,
                                         mi_col,
                                         sb_delta_lf);
+#endif
 
         /*filter horizontal edges*/
+#if DEC_ROI_DECODE
+        if ((int32_t)mi_col - max_mib_size >= 0 && prev_sb_in) {
+#else
         int32_t max_mib_size =
             seq_header->sb_size == BLOCK_128X128 ? MAX_MIB_SIZE : SB64_MIB_SIZE;
 
         if ((int32_t)mi_col - max_mib_size >= 0) {
+#endif
             dec_av1_filter_block_plane_horz(dec_handle,
                                             (sb_info - 1),
                                             recon_picture_buf,
@@ -725,7 +832,11 @@ void dec_loop_filter_sb(EbDecHandle *dec_handle,
         }
 
         /*Filter the horizontal edges of the last sb in each row*/
+#if DEC_ROI_DECODE
+        if (last_col && sb_in) {
+#else
         if (last_col) {
+#endif
             dec_av1_filter_block_plane_horz(dec_handle, sb_info,
                                             recon_picture_buf,
                                             lf_ctxt,
@@ -735,6 +846,9 @@ void dec_loop_filter_sb(EbDecHandle *dec_handle,
                                             sb_delta_lf);
         }
     } else {
+#if DEC_ROI_DECODE
+        if (!sb_in) return;
+#endif
         /*filter all vertical edges in every 64x64 super block*/
         dec_av1_filter_block_plane_vert(dec_handle, sb_info,
                                         recon_picture_buf,
@@ -788,8 +902,15 @@ void dec_loop_filter_row(EbDecHandle *dec_handle_ptr,
 
         /* Top-Right Sync*/
         if (y_sb_index) {
+#if DEC_PARKED_WORKERS
+            dec_mt_wait_progress(&frame_buf->dec_mt_frame_data,
+                                 sb_lf_completed_in_prev_row,
+                                 MIN((x_sb_index + 2), pic_width_in_sb - 1),
+                                 NULL);
+#else
             while (*sb_lf_completed_in_prev_row < MIN((x_sb_index + 2), pic_width_in_sb - 1))
                 ;
+#endif
         }
         /*LF function for a SB*/
         dec_loop_filter_sb(dec_handle_ptr,
@@ -806,6 +927,9 @@ void dec_loop_filter_row(EbDecHandle *dec_handle_ptr,
                            sb_info->sb_delta_lf);
         /* Update Top-Right Sync*/
         *sb_lf_completed_in_row = x_sb_index;
+#if DEC_PARKED_WORKERS
+        dec_mt_notify_progress(&frame_buf->dec_mt_frame_data);
+#endif
     }
 }
 
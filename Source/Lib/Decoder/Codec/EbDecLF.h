@@ -27,6 +27,16 @@ typedef void (*SvtLbdFilterTapFn)(uint8_t *s, int32_t pitch, const uint8_t *blim
 
 typedef void (*SvtHbdFilterTapFn)(uint16_t *s, int32_t pitch, const uint8_t *blimit,
                                   const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+#if DLF_DUAL_EDGE_AVX2
+typedef void (*SvtLbdDualFilterTapFn)(uint8_t *s, int32_t pitch, const uint8_t *blimit0,
+                                      const uint8_t *limit0, const uint8_t *thresh0,
+                                      const uint8_t *blimit1, const uint8_t *limit1,
+                                      const uint8_t *thresh1);
+typedef void (*SvtHbdDualFilterTapFn)(uint16_t *s, int32_t pitch, const uint8_t *blimit0,
+                                      const uint8_t *limit0, const uint8_t *thresh0,
+                                      const uint8_t *blimit1, const uint8_t *limit1,
+                                      const uint8_t *thresh1, int32_t bd);
+#endif
 
 typedef struct LfCtxt {
     TxSize *tx_size_l;
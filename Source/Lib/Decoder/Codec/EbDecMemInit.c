@@ -333,6 +333,9 @@ static EbErrorType init_parse_context (EbDecHandle  *dec_handle_ptr) {
 
     master_parse_ctx->num_tiles = 0;
     master_parse_ctx->parse_tile_data = NULL;
+#if DEC_POOLED_MT_REALLOC
+    master_parse_ctx->num_ctx_alloc = 0;
+#endif
 
     return return_error;
 }
@@ -501,6 +504,11 @@ EbErrorType dec_mem_init(EbDecHandle  *dec_handle_ptr) {
     if (0 == dec_handle_ptr->seq_header_done)
         return EB_ErrorNone;
 
+#if DEC_EXT_FRAME_BUF
+    /* New sequence geometry: give back the application memory of the old pool */
+    if (dec_handle_ptr->ext_frame_buf && dec_handle_ptr->pv_pic_mgr != NULL)
+        dec_pic_mgr_drop_refs(dec_handle_ptr);
+#endif
     /* init module ctxts */
     return_error |= dec_pic_mgr_init(dec_handle_ptr);
 
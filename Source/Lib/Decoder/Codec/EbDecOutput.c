@@ -0,0 +1,167 @@
+/*
+* Copyright(c) 2019 Netflix, Inc.
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+// SUMMARY
+//   Contains the decoder output copy and format conversion functions
+
+#include <string.h>
+
+#include "EbDefinitions.h"
+#include "EbDecHandle.h"
+#include "EbDecProcess.h"
+#include "EbDecOutput.h"
+#include "common_dsp_rtcd.h"
+
+#if DEC_OUT_CONVERT
+/* Luma rows converted per unit of work, chroma bands cover the same rows */
+#define DEC_OUT_BAND_HEIGHT 64
+
+static void dec_out_convert_band(const DecOutJob *job, const DecOutPlane *plane,
+                                 uint32_t band) {
+    const uint32_t row    = band * plane->band_height;
+    const uint32_t height = AOMMIN(plane->band_height, plane->height - row);
+    const uint32_t src_sz = job->src_hbd ? sizeof(uint16_t) : sizeof(uint8_t);
+    const uint32_t dst_sz = job->dst_hbd ? sizeof(uint16_t) : sizeof(uint8_t);
+    const uint8_t *src    = plane->src + row * plane->src_stride * src_sz;
+    uint8_t *      dst    = plane->dst + row * plane->dst_stride * dst_sz;
+
+    if (plane->src_v != NULL) {
+        const uint8_t *src_v = plane->src_v + row * plane->src_stride * src_sz;
+        if (!job->src_hbd && !job->dst_hbd)
+            eb_dec_out_interleave_u8(
+                src, src_v, plane->src_stride, dst, plane->dst_stride, plane->width, height);
+        else if (!job->dst_hbd)
+            eb_dec_out_interleave_u16_to_u8((const uint16_t *)src,
+                                            (const uint16_t *)src_v,
+                                            plane->src_stride,
+                                            dst,
+                                            plane->dst_stride,
+                                            plane->width,
+                                            height,
+                                            job->down_shift);
+        else if (!job->src_hbd)
+            eb_dec_out_interleave_u8_to_u16(src,
+                                            src_v,
+                                            plane->src_stride,
+                                            (uint16_t *)dst,
+                                            plane->dst_stride,
+                                            plane->width,
+                                            height,
+                                            job->up_shift);
+        else
+            eb_dec_out_interleave_u16((const uint16_t *)src,
+                                      (const uint16_t *)src_v,
+                                      plane->src_stride,
+                                      (uint16_t *)dst,
+                                      plane->dst_stride,
+                                      plane->width,
+                                      height,
+                                      job->up_shift);
+        return;
+    }
+
+    if (job->src_hbd && !job->dst_hbd)
+        eb_dec_out_pack_u16_to_u8((const uint16_t *)src,
+                                  plane->src_stride,
+                                  dst,
+                                  plane->dst_stride,
+                                  plane->width,
+                                  height,
+                                  job->down_shift);
+    else if (!job->src_hbd && job->dst_hbd)
+        eb_dec_out_unpack_u8_to_u16(src,
+                                    plane->src_stride,
+                                    (uint16_t *)dst,
+                                    plane->dst_stride,
+                                    plane->width,
+                                    height,
+                                    job->up_shift);
+    else if (job->up_shift)
+        eb_dec_out_shift_u16((const uint16_t *)src,
+                             plane->src_stride,
+                             (uint16_t *)dst,
+                             plane->dst_stride,
+                             plane->width,
+                             height,
+                             job->up_shift);
+    else if (src != dst) {
+        for (uint32_t i = 0; i < height; i++) {
+            memcpy(dst, src, plane->width * src_sz);
+            src += plane->src_stride * src_sz;
+            dst += plane->dst_stride * dst_sz;
+        }
+    }
+}
+
+/* Units run band major so that the workers touch neighbouring rows of all planes */
+static void dec_out_convert_unit(const DecOutJob *job, int32_t unit) {
+    const uint32_t band  = (uint32_t)(unit / job->num_planes);
+    const int32_t  plane = unit % job->num_planes;
+    if (band < job->plane[plane].num_bands) dec_out_convert_band(job, &job->plane[plane], band);
+}
+
+void dec_out_process_bands(EbDecHandle *dec_handle_ptr) {
+    DecOutJob *     job = &dec_handle_ptr->out_job;
+    DecMtFrameData *dec_mt_frame_data =
+        &dec_handle_ptr->master_frame_buf.cur_frame_bufs[0].dec_mt_frame_data;
+
+    if (!job->active) return;
+    while (1) {
+        int32_t unit = -1;
+        eb_block_on_mutex(dec_mt_frame_data->temp_mutex);
+        if (job->active && job->next_unit < job->num_units) unit = job->next_unit++;
+        eb_release_mutex(dec_mt_frame_data->temp_mutex);
+        if (unit < 0) break;
+
+        dec_out_convert_unit(job, unit);
+
+        eb_block_on_mutex(dec_mt_frame_data->temp_mutex);
+        job->units_done++;
+        eb_release_mutex(dec_mt_frame_data->temp_mutex);
+        dec_mt_notify_progress(dec_mt_frame_data);
+    }
+}
+
+void dec_out_run_job(EbDecHandle *dec_handle_ptr) {
+    DecOutJob *    job         = &dec_handle_ptr->out_job;
+    const uint32_t num_threads = dec_handle_ptr->dec_config.threads;
+    uint32_t       max_bands   = 0;
+
+    for (int32_t i = 0; i < job->num_planes; i++) {
+        DecOutPlane *plane = &job->plane[i];
+        /* Chroma bands hold the chroma rows of the luma band */
+        plane->band_height = i && plane->height < job->plane[0].height
+                                 ? DEC_OUT_BAND_HEIGHT >> 1
+                                 : DEC_OUT_BAND_HEIGHT;
+        plane->num_bands   = (plane->height + plane->band_height - 1) / plane->band_height;
+        max_bands          = AOMMAX(max_bands, plane->num_bands);
+    }
+    job->num_units = (int32_t)max_bands * job->num_planes;
+
+    if (num_threads <= 1 || max_bands <= 1 || !dec_handle_ptr->start_thread_process) {
+        for (int32_t unit = 0; unit < job->num_units; unit++) dec_out_convert_unit(job, unit);
+        return;
+    }
+
+    DecMtFrameData *dec_mt_frame_data =
+        &dec_handle_ptr->master_frame_buf.cur_frame_bufs[0].dec_mt_frame_data;
+    eb_block_on_mutex(dec_mt_frame_data->temp_mutex);
+    job->next_unit  = 0;
+    job->units_done = 0;
+    job->active     = EB_TRUE;
+    eb_release_mutex(dec_mt_frame_data->temp_mutex);
+
+    /* The workers wait for the next frame in svt_setup_motion_field */
+    for (uint32_t lib_thrd = 0; lib_thrd < num_threads - 1; lib_thrd++)
+        eb_post_semaphore(dec_handle_ptr->thread_ctxt_pa[lib_thrd].thread_semaphore);
+
+    dec_out_process_bands(dec_handle_ptr);
+    dec_mt_wait_progress(dec_mt_frame_data, &job->units_done, job->num_units, NULL);
+
+    eb_block_on_mutex(dec_mt_frame_data->temp_mutex);
+    job->active = EB_FALSE;
+    eb_release_mutex(dec_mt_frame_data->temp_mutex);
+}
+#endif
@@ -0,0 +1,29 @@
+/*
+* Copyright(c) 2019 Netflix, Inc.
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef EbDecOutput_h
+#define EbDecOutput_h
+
+#include "EbDecHandle.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if DEC_OUT_CONVERT
+/* Converts the planes set up in dec_handle_ptr->out_job. With threads the
+   idle MT workers are woken to share the row bands */
+void dec_out_run_job(EbDecHandle *dec_handle_ptr);
+
+/* Converts row bands of the active output job until none is left, called
+   by MT workers woken while waiting for the next frame */
+void dec_out_process_bands(EbDecHandle *dec_handle_ptr);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // EbDecOutput_h
@@ -31,6 +31,9 @@
 
 #include "EbDecParseInterBlock.h"
 #include "EbDecProcessFrame.h"
+#if DEC_OUT_CONVERT
+#include "EbDecOutput.h"
+#endif
 
 #include "EbCommonUtils.h"
 #include "EbCoefficients.h"
@@ -970,9 +973,18 @@ void svt_setup_motion_field(EbDecHandle *dec_handle, DecThreadCtxt *thread_ctxt)
     if (is_mt) {
         volatile EbBool *start_motion_proj = &dec_mt_frame_data->start_motion_proj;
 
+#if DEC_OUT_CONVERT
+        /* Idle workers are also woken to share the output copy of the last frame */
+        while (*start_motion_proj != EB_TRUE) {
+            eb_block_on_semaphore(NULL == thread_ctxt ? dec_handle->thread_semaphore
+                                                      : thread_ctxt->thread_semaphore);
+            if (NULL != thread_ctxt) dec_out_process_bands(dec_handle);
+        }
+#else
         while (*start_motion_proj != EB_TRUE)
             eb_block_on_semaphore(NULL == thread_ctxt ? dec_handle->thread_semaphore
                                                       : thread_ctxt->thread_semaphore);
+#endif
 
         DecMtMotionProjInfo *motion_proj_info =
             &dec_mt_frame_data->motion_proj_info;
@@ -1070,9 +1082,17 @@ void svt_setup_motion_field(EbDecHandle *dec_handle, DecThreadCtxt *thread_ctxt)
         eb_release_mutex(dec_mt_frame_data->temp_mutex);
 
         volatile uint32_t *num_threads_header = &dec_mt_frame_data->num_threads_header;
+#if DEC_PARKED_WORKERS
+        dec_mt_notify_progress(dec_mt_frame_data);
+        dec_mt_wait_progress(dec_mt_frame_data,
+                             (volatile int32_t *)num_threads_header,
+                             (int32_t)dec_handle->dec_config.threads,
+                             &dec_mt_frame_data->end_flag);
+#else
         while (*num_threads_header != dec_handle->dec_config.threads &&
               (EB_FALSE == dec_mt_frame_data->end_flag))
             ;
+#endif
     }
 }
 
@@ -1766,12 +1786,16 @@ static INLINE void read_coeffs_reverse_2d(SvtReader *r, TxSize tx_size, int star
         int       level     = svt_read_symbol(r, base_cdf[coeff_ctx], nsymbs, ACCT_STR);
         if (level > NUM_BASE_LEVELS) {
             const int   br_ctx = get_br_ctx_2d(levels, pos, bwl);
+#if DEC_FAST_ENTROPY
+            level += svt_read_coeff_br(r, br_cdf[br_ctx]);
+#else
             AomCdfProb *cdf    = br_cdf[br_ctx];
             for (int idx = 0; idx < COEFF_BASE_RANGE; idx += BR_CDF_SIZE - 1) {
                 const int k = svt_read_symbol(r, cdf, BR_CDF_SIZE, ACCT_STR);
                 level += k;
                 if (k < BR_CDF_SIZE - 1) break;
             }
+#endif
         }
         levels[get_padded_idx(pos, bwl)] = level;
     }
@@ -1792,12 +1816,16 @@ static INLINE void read_coeffs_reverse(SvtReader *r, TxSize tx_size, TxType tx_t
 #else
             const int   br_ctx = get_br_ctx(levels, pos, bwl, tx_type);
 #endif
+#if DEC_FAST_ENTROPY
+            level += svt_read_coeff_br(r, br_cdf[br_ctx]);
+#else
             AomCdfProb *cdf    = br_cdf[br_ctx];
             for (int idx = 0; idx < COEFF_BASE_RANGE; idx += BR_CDF_SIZE - 1) {
                 const int k = svt_read_symbol(r, cdf, BR_CDF_SIZE, ACCT_STR);
                 level += k;
                 if (k < BR_CDF_SIZE - 1) break;
             }
+#endif
         }
         levels[get_padded_idx(pos, bwl)] = level;
     }
@@ -1929,11 +1957,15 @@ uint16_t parse_coeffs(ParseCtxt *parse_ctxt, PartitionInfo *xd, uint32_t blk_row
     if (level > NUM_BASE_LEVELS) {
         const int br_ctx = get_br_ctx_eob(pos, bwl, tx_class);
         cdf              = frm_ctx->coeff_br_cdf[AOMMIN(txs_ctx, TX_32X32)][plane_type][br_ctx];
+#if DEC_FAST_ENTROPY
+        level += svt_read_coeff_br(r, cdf);
+#else
         for (int idx = 0; idx < COEFF_BASE_RANGE / (BR_CDF_SIZE - 1); idx++) {
             int coeff_br = svt_read_symbol(r, cdf, BR_CDF_SIZE, ACCT_STR);
             level += coeff_br;
             if (coeff_br < BR_CDF_SIZE - 1) break;
         }
+#endif
     }
     levels[get_padded_idx(pos, bwl)] = level;
 
@@ -21,6 +21,7 @@
 
 #include "EbDecParseFrame.h"
 #include "EbDecParseHelper.h"
+#include "EbDecRoi.h"
 
 /* Inititalizes prms for current tile from Master TilesInfo ! */
 void svt_tile_init(TileInfo *cur_tile_info, FrameHeader *frame_header, int32_t tile_row,
@@ -295,7 +296,11 @@ EbErrorType parse_tile(EbDecHandle *dec_handle_ptr, ParseCtxt *parse_ctx, TilesI
             // Bit-stream parsing of the superblock
             parse_super_block(dec_handle_ptr, parse_ctx, mi_row, mi_col, sb_info);
 
+#if DEC_ROI_DECODE
+            if (!is_mt && dec_roi_mi_in(&dec_handle_ptr->roi_info, mi_row, mi_col)) {
+#else
             if (!is_mt) {
+#endif
                 /* Init DecModCtxt */
                 DecModCtxt *dec_mod_ctxt = (DecModCtxt *)dec_handle_ptr->pv_dec_mod_ctxt;
                 dec_mod_ctxt->cur_coeff[AOM_PLANE_Y] = sb_info->sb_coeff[AOM_PLANE_Y];
@@ -316,6 +321,9 @@ EbErrorType parse_tile(EbDecHandle *dec_handle_ptr, ParseCtxt *parse_ctx, TilesI
             assert(sb_row >= sb_row_tile_start);
             dec_mt_frame_data->parse_recon_tile_info_array[tile_num]
                 .sb_recon_row_parsed[sb_row - sb_row_tile_start] = 1;
+#if DEC_PARKED_WORKERS
+            dec_mt_notify_progress(dec_mt_frame_data);
+#endif
         }
     }
 
@@ -146,6 +146,10 @@ typedef struct MasterParseCtxt {
 
     /* Curent number of Tiles.*/
     int32_t num_tiles;
+#if DEC_POOLED_MT_REALLOC
+    /* Number of tile contexts allocated, each one for the full frame width */
+    int32_t num_ctx_alloc;
+#endif
 
     /* Array of ParseTileData for each Tile */
     ParseTileData *parse_tile_data;
@@ -37,6 +37,7 @@
 #include "EbDecLF.h"
 
 #include "EbDecCdef.h"
+#include "EbDecRoi.h"
 #include "EbLog.h"
 
 void dec_av1_loop_filter_frame_mt(EbDecHandle *        dec_handle_ptr,
@@ -47,6 +48,10 @@ void dec_av1_loop_filter_frame_mt(EbDecHandle *        dec_handle_ptr,
                                   DecThreadCtxt *thread_ctxt);
 
 EbErrorType dec_system_resource_init(EbDecHandle *dec_handle_ptr, TilesInfo *tiles_info);
+#if DEC_POOLED_MT_REALLOC
+void   dec_mt_frame_geometry_init(EbDecHandle *dec_handle_ptr, TilesInfo *tiles_info);
+EbBool dec_mt_frame_geometry_fits(EbDecHandle *dec_handle_ptr, TilesInfo *tiles_info);
+#endif
 
 /* Scan through the Tiles to find Bitstream offsets */
 void svt_av1_scan_tiles(EbDecHandle *dec_handle_ptr, TilesInfo *tiles_info, ObuHeader *obu_header,
@@ -1564,6 +1569,11 @@ static INLINE EbErrorType reallocate_parse_context_memory(EbDecHandle *    dec_h
     int       num_tiles  = tiles_info.tile_cols * tiles_info.tile_rows;
     int32_t   num_ctx    = num_instances == 1 ? 1 : num_tiles;
     if (num_instances == 1) master_parse_ctx->context_count = num_tiles;
+#if DEC_POOLED_MT_REALLOC
+    /* Existing contexts cover any tile layout with no more tiles */
+    if (num_ctx <= master_parse_ctx->num_ctx_alloc) return EB_ErrorNone;
+    master_parse_ctx->num_ctx_alloc = num_ctx;
+#endif
 
     /* TO-DO this memory will be freed at the end of decode.
        Can be optimized by reallocating the memory when
@@ -1586,7 +1596,12 @@ static INLINE EbErrorType reallocate_parse_context_memory(EbDecHandle *    dec_h
             int     instance = (row * total_cols) + col;
             int32_t num_mi_tile =
                 tiles_info.tile_col_start_mi[col + 1] - tiles_info.tile_col_start_mi[col];
+#if DEC_POOLED_MT_REALLOC
+            (void)num_mi_tile;
+            int32_t num_mi_wide = num_mi_frame;
+#else
             int32_t num_mi_wide = num_instances == 1 ? num_mi_frame : num_mi_tile;
+#endif
             num_mi_wide         = ALIGN_POWER_OF_TWO(num_mi_wide, sb_size_log2 - MI_SIZE_LOG2);
             ParseAboveNbr4x4Ctxt *above_ctx = &master_parse_ctx->parse_above_nbr4x4_ctxt[instance];
             ParseLeftNbr4x4Ctxt * left_ctx  = &master_parse_ctx->parse_left_nbr4x4_ctxt[instance];
@@ -1670,7 +1685,12 @@ static void realloc_parse_memory(EbDecHandle *dec_handle_ptr) {
         reallocate_parse_context_memory(dec_handle_ptr,
             master_parse_ctx, num_instances);
     }
+#if DEC_POOLED_MT_REALLOC
+    /* num_tiles is the allocated count, only ever grown */
+    if (num_tiles > master_parse_ctx->num_tiles)
+#else
     if (num_tiles != master_parse_ctx->num_tiles)
+#endif
         reallocate_parse_tile_data(master_parse_ctx, num_tiles);
 }
 
@@ -1728,6 +1748,15 @@ static void check_mt_support(EbDecHandle *dec_handle_ptr) {
         }
     }
 
+#if DEC_POOLED_MT_REALLOC
+    /* Only a frame outgrowing the pooled capacity needs the teardown */
+    if (do_realloc && dec_mt_frame_geometry_fits(dec_handle_ptr, &tiles_info)) {
+        dec_mt_frame_geometry_init(dec_handle_ptr, &tiles_info);
+        set_prev_frame_info(dec_handle_ptr);
+        realloc_parse_memory(dec_handle_ptr);
+        return;
+    }
+#endif
     if (do_realloc) {
         EbMemoryMapEntry *memory_entry = svt_dec_memory_map;
         EbMemoryMapEntry *previous_entry = NULL;
@@ -1753,6 +1782,9 @@ static void check_mt_support(EbDecHandle *dec_handle_ptr) {
             case EB_SEMAPHORE: eb_destroy_semaphore(memory_entry->ptr); break;
             case EB_THREAD: eb_destroy_thread(memory_entry->ptr); break;
             case EB_MUTEX: eb_destroy_mutex(memory_entry->ptr); break;
+#if DEC_PARKED_WORKERS
+            case EB_COND_VAR: eb_destroy_cond_var(memory_entry->ptr); break;
+#endif
             default: break;
             }
             EbMemoryMapEntry *tmp_memory_entry = memory_entry;
@@ -1769,8 +1801,13 @@ static void check_mt_support(EbDecHandle *dec_handle_ptr) {
     }
 }
 
+#if DEC_EXT_FRAME_BUF
+EbErrorType read_uncompressed_header(Bitstrm *bs, EbDecHandle *dec_handle_ptr,
+                                     ObuHeader *obu_header, int num_planes) {
+#else
 void read_uncompressed_header(Bitstrm *bs, EbDecHandle *dec_handle_ptr, ObuHeader *obu_header,
                               int num_planes) {
+#endif
     SeqHeader *  seq_header = &dec_handle_ptr->seq_header;
     FrameHeader *frame_info = &dec_handle_ptr->frame_header;
     int          id_len = 0, all_frames, frame_is_intra = 0, i, frame_size_override_flag = 0;
@@ -1809,7 +1846,11 @@ void read_uncompressed_header(Bitstrm *bs, EbDecHandle *dec_handle_ptr, ObuHeade
                 PRINT_FRAME("display_frame_id", display_frame_id);
                 if (display_frame_id != frame_info->ref_frame_idx[frame_to_show_map_idx] &&
                     frame_info->ref_valid[frame_to_show_map_idx] == 1)
+#if DEC_EXT_FRAME_BUF
+                    return EB_ErrorNone; // EB_Corrupt_Frame;
+#else
                     return; // EB_Corrupt_Frame;
+#endif
             }
 
             dec_handle_ptr->cur_pic_buf[0] = dec_handle_ptr->ref_frame_map[frame_to_show_map_idx];
@@ -1832,7 +1873,11 @@ void read_uncompressed_header(Bitstrm *bs, EbDecHandle *dec_handle_ptr, ObuHeade
             dec_handle_ptr->show_existing_frame = frame_info->show_existing_frame;
             dec_handle_ptr->show_frame          = frame_info->show_frame;
             dec_handle_ptr->showable_frame      = frame_info->showable_frame;
+#if DEC_EXT_FRAME_BUF
+            return EB_ErrorNone;
+#else
             return;
+#endif
         }
 
         frame_info->frame_type = dec_get_bits(bs, 2);
@@ -1899,7 +1944,11 @@ void read_uncompressed_header(Bitstrm *bs, EbDecHandle *dec_handle_ptr, ObuHeade
             }
             // Bitstream conformance
             if (frame_info->current_frame_id == prev_frame_id || diff_frame_id >= 1 << (id_len - 1))
+#if DEC_EXT_FRAME_BUF
+                return EB_ErrorNone; // EB_Corrupt_Frame;
+#else
                 return; // EB_Corrupt_Frame;
+#endif
         }
 
         //mark_ref_frames( id_len )
@@ -2029,7 +2078,11 @@ void read_uncompressed_header(Bitstrm *bs, EbDecHandle *dec_handle_ptr, ObuHeade
                     (1 << id_len));
                 if (expected_frame_id != frame_info->ref_frame_id[ref_frm_id]) {
                     assert(0);
+#if DEC_EXT_FRAME_BUF
+                    return EB_ErrorNone; // EB_Corrupt_Frame;
+#else
                     return; // EB_Corrupt_Frame;
+#endif
                 }
             }
         }
@@ -2089,8 +2142,13 @@ void read_uncompressed_header(Bitstrm *bs, EbDecHandle *dec_handle_ptr, ObuHeade
              seq_header->color_config.subsampling_y == 0)
         dec_handle_ptr->dec_config.max_color_format = EB_YUV444;
 
+#if DEC_EXT_FRAME_BUF
+    EbErrorType status = dec_pic_mgr_get_cur_pic(dec_handle_ptr, &dec_handle_ptr->cur_pic_buf[0]);
+    if (status != EB_ErrorNone) return status;
+#else
     dec_handle_ptr->cur_pic_buf[0] =
         dec_pic_mgr_get_cur_pic(dec_handle_ptr);
+#endif
 
     svt_setup_frame_buf_refs(dec_handle_ptr);
     /*Temporal MVs allocation */
@@ -2135,6 +2193,11 @@ void read_uncompressed_header(Bitstrm *bs, EbDecHandle *dec_handle_ptr, ObuHeade
         if (EB_FALSE == dec_handle_ptr->start_thread_process) {
             dec_system_resource_init(dec_handle_ptr, &tiles_info);
             dec_handle_ptr->start_thread_process = EB_TRUE;
+#if DEC_PARKED_WORKERS
+            for (uint32_t lib_thrd = 0; lib_thrd < dec_handle_ptr->dec_config.threads - 1;
+                 lib_thrd++)
+                eb_post_semaphore(dec_handle_ptr->thread_ctxt_pa[lib_thrd].thread_semaphore);
+#endif
         }
         check_mt_support(dec_handle_ptr);
     }
@@ -2210,11 +2273,17 @@ void read_uncompressed_header(Bitstrm *bs, EbDecHandle *dec_handle_ptr, ObuHeade
     dec_handle_ptr->show_frame          = frame_info->show_frame;
     dec_handle_ptr->showable_frame      = frame_info->showable_frame;
 
+#if DEC_ROI_DECODE
+    if (!frame_info->show_existing_frame) dec_roi_setup_frame(dec_handle_ptr);
+#endif
     /* TODO: Should be moved to caller */
     if (dec_handle_ptr->dec_config.threads == 1) {
         if (!frame_info->show_existing_frame)
             svt_setup_motion_field(dec_handle_ptr, NULL);
     }
+#if DEC_EXT_FRAME_BUF
+    return EB_ErrorNone;
+#endif
 }
 
 EbErrorType read_frame_header_obu(Bitstrm *bs, EbDecHandle *dec_handle_ptr, ObuHeader *obu_header,
@@ -2225,7 +2294,12 @@ EbErrorType read_frame_header_obu(Bitstrm *bs, EbDecHandle *dec_handle_ptr, ObuH
     uint32_t start_position, end_position, header_bytes;
 
     start_position = get_position(bs);
+#if DEC_EXT_FRAME_BUF
+    status = read_uncompressed_header(bs, dec_handle_ptr, obu_header, num_planes);
+    if (status != EB_ErrorNone) return status;
+#else
     read_uncompressed_header(bs, dec_handle_ptr, obu_header, num_planes);
+#endif
 
     if (allow_intrabc(dec_handle_ptr)) {
         av1_setup_scale_factors_for_frame(&dec_handle_ptr->sf_identity,
@@ -2419,9 +2493,24 @@ EbErrorType read_tile_group_obu(Bitstrm *bs, EbDecHandle *dec_handle_ptr, TilesI
         eb_post_semaphore(dec_handle_ptr->thread_semaphore);
         for (uint32_t lib_thrd = 0; lib_thrd < num_threads - 1; lib_thrd++)
             eb_post_semaphore(dec_handle_ptr->thread_ctxt_pa[lib_thrd].thread_semaphore);
+#if DEC_PARSE_RECON_OVERLAP
+        /* Without superres nothing frame level sits between CDEF and LR :
+           LR rows already wait on cdef_completed_for_row_map, so let the
+           threads done with CDEF go on instead of waiting for the main
+           thread to leave its CDEF loop */
+        if (!do_upscale) {
+            svt_av1_queue_lr_jobs(dec_handle_ptr);
+            dec_mt_frame_data->start_lr_frame = EB_TRUE;
+            eb_post_semaphore(dec_handle_ptr->thread_semaphore);
+            for (uint32_t lib_thrd = 0; lib_thrd < num_threads - 1; lib_thrd++)
+                eb_post_semaphore(dec_handle_ptr->thread_ctxt_pa[lib_thrd].thread_semaphore);
+        }
+        eb_release_mutex(dec_mt_frame_data->temp_mutex);
+#else
         eb_release_mutex(dec_mt_frame_data->temp_mutex);
 
         if(!do_upscale) svt_av1_queue_lr_jobs(dec_handle_ptr);
+#endif
 
         parse_frame_tiles(dec_handle_ptr, 0);
 
@@ -2497,10 +2586,19 @@ EbErrorType read_tile_group_obu(Bitstrm *bs, EbDecHandle *dec_handle_ptr, TilesI
         if (do_upscale) svt_av1_queue_lr_jobs(dec_handle_ptr);
         DecMtFrameData *dec_mt_frame_data =
             &dec_handle_ptr->master_frame_buf.cur_frame_bufs[0].dec_mt_frame_data;
+#if DEC_PARSE_RECON_OVERLAP
+        if (do_upscale) {
+            dec_mt_frame_data->start_lr_frame = EB_TRUE;
+            eb_post_semaphore(dec_handle_ptr->thread_semaphore);
+            for (uint32_t lib_thrd = 0; lib_thrd < num_threads - 1; lib_thrd++)
+                eb_post_semaphore(dec_handle_ptr->thread_ctxt_pa[lib_thrd].thread_semaphore);
+        }
+#else
         dec_mt_frame_data->start_lr_frame = EB_TRUE;
         eb_post_semaphore(dec_handle_ptr->thread_semaphore);
         for (uint32_t lib_thrd = 0; lib_thrd < num_threads - 1; lib_thrd++)
             eb_post_semaphore(dec_handle_ptr->thread_ctxt_pa[lib_thrd].thread_semaphore);
+#endif
         dec_av1_loop_restoration_filter_frame_mt(dec_handle_ptr, NULL);
     } else
         dec_av1_loop_restoration_filter_frame(dec_handle_ptr, 0, /*opt_lr*/ do_lr);
@@ -2618,6 +2716,10 @@ EbErrorType decode_multiple_obu(EbDecHandle *dec_handle_ptr, uint8_t **data, siz
                 dec_handle_ptr->seen_frame_header = 1;
                 status                            = read_frame_header_obu(
                     &bs, dec_handle_ptr, &obu_header, obu_header.obu_type != OBU_FRAME);
+#if DEC_EXT_FRAME_BUF
+                /* No picture buffer for the frame */
+                if (status == EB_ErrorInsufficientResources) return status;
+#endif
             }
             /*else {
                  For OBU_REDUNDANT_FRAME_HEADER, previous frame_header is taken from dec_handle_ptr->frame_header
@@ -61,10 +61,16 @@ EbErrorType dec_pic_mgr_init(EbDecHandle *dec_handle_ptr) {
 
     EbErrorType return_error = EB_ErrorNone;
     int32_t     i;
+#if DEC_EXT_FRAME_BUF
+    EbDecPicMgr *prev_pic_mgr = *pps_pic_mgr;
+#endif
 
     EB_MALLOC_DEC(void *, *pps_pic_mgr, sizeof(EbDecPicMgr), EB_N_PTR);
 
     EbDecPicMgr *ps_pic_mgr = *pps_pic_mgr;
+#if DEC_EXT_FRAME_BUF
+    ps_pic_mgr->prev_pic_mgr = dec_handle_ptr->ext_frame_buf ? prev_pic_mgr : NULL;
+#endif
 
     for (i = 0; i < MAX_PIC_BUFS; i++) {
         ps_pic_mgr->as_dec_pic[i].ps_pic_buf = NULL;
@@ -72,6 +78,11 @@ EbErrorType dec_pic_mgr_init(EbDecHandle *dec_handle_ptr) {
         ps_pic_mgr->as_dec_pic[i].size       = 0;
         ps_pic_mgr->as_dec_pic[i].ref_count  = 0;
         ps_pic_mgr->as_dec_pic[i].mvs        = NULL;
+#if DEC_EXT_FRAME_BUF
+        ps_pic_mgr->as_dec_pic[i].ext_frame_buf.buffer       = NULL;
+        ps_pic_mgr->as_dec_pic[i].ext_frame_buf.buffer_size  = 0;
+        ps_pic_mgr->as_dec_pic[i].ext_frame_buf.private_data = NULL;
+#endif
         EB_MALLOC_DEC(
             uint8_t *, ps_pic_mgr->as_dec_pic[i].segment_maps, size * sizeof(uint8_t), EB_N_PTR);
         memset(ps_pic_mgr->as_dec_pic[i].segment_maps, 0, size);
@@ -92,6 +103,54 @@ static INLINE EbErrorType mvs_8x8_memory_alloc(TemporalMvRef **mvs, FrameHeader
     return EB_ErrorNone;
 }
 
+#if DEC_EXT_FRAME_BUF
+/* Get the plane memory of a picture from the application. The descriptor
+   geometry is set up by dec_eb_recon_picture_buffer_desc_ctor, only the
+   plane pointers are filled here. */
+static EbErrorType dec_pic_buf_get_ext_frame_buf(EbDecHandle *dec_handle_ptr,
+                                                 EbDecPicBuf *pic_buf) {
+    EbSvtAv1DecConfiguration *config   = &dec_handle_ptr->dec_config;
+    EbPictureBufferDesc *     desc     = pic_buf->ps_pic_buf;
+    EbExtFrameBuf *           ext_buf  = &pic_buf->ext_frame_buf;
+    const uint32_t            bytes_pp = (desc->bit_depth > EB_8BIT || desc->is_16bit_pipeline)
+                                             ? 2 : 1;
+    const uint32_t luma_size   = ALIGN_POWER_OF_TWO(desc->luma_size * bytes_pp, 6);
+    const uint32_t chroma_size = desc->color_format == EB_YUV400
+                                     ? 0 : ALIGN_POWER_OF_TWO(desc->chroma_size * bytes_pp, 6);
+    const uint32_t min_size = luma_size + 2 * chroma_size + ALVALUE;
+
+    if (config->get_frame_buffer(ext_buf, min_size, config->frame_buffer_priv) ||
+        ext_buf->buffer == NULL || ext_buf->buffer_size < min_size) {
+        ext_buf->buffer = NULL;
+        return EB_ErrorInsufficientResources;
+    }
+
+    /* Keep the planes aligned as the internal allocator does */
+    uint8_t *base = (uint8_t *)(((uintptr_t)ext_buf->buffer + ALVALUE - 1) &
+                                ~(uintptr_t)(ALVALUE - 1));
+    desc->buffer_y = base;
+    if (chroma_size) {
+        desc->buffer_cb = base + luma_size;
+        desc->buffer_cr = base + luma_size + chroma_size;
+    } else {
+        desc->buffer_cb = NULL;
+        desc->buffer_cr = NULL;
+    }
+    return EB_ErrorNone;
+}
+
+static void dec_pic_buf_release_ext_frame_buf(EbDecHandle *dec_handle_ptr,
+                                              EbDecPicBuf *pic_buf) {
+    EbSvtAv1DecConfiguration *config = &dec_handle_ptr->dec_config;
+    if (pic_buf->ext_frame_buf.buffer == NULL) return;
+    config->release_frame_buffer(&pic_buf->ext_frame_buf, config->frame_buffer_priv);
+    pic_buf->ext_frame_buf.buffer = NULL;
+    pic_buf->ps_pic_buf->buffer_y  = NULL;
+    pic_buf->ps_pic_buf->buffer_cb = NULL;
+    pic_buf->ps_pic_buf->buffer_cr = NULL;
+}
+#endif
+
 /**
 *******************************************************************************
 *
@@ -105,13 +164,19 @@ static INLINE EbErrorType mvs_8x8_memory_alloc(TemporalMvRef **mvs, FrameHeader
 *  Pointer to the Picture manager structure
 *
 * @returns
+*  EB_ErrorInsufficientResources when all the buffers are in use or the
+*  picture memory cannot be allocated
 *
 * @remarks
 *
 *******************************************************************************
 */
 
+#if DEC_EXT_FRAME_BUF
+EbErrorType dec_pic_mgr_get_cur_pic(EbDecHandle *dec_handle_ptr, EbDecPicBuf **pp_pic_buf) {
+#else
 EbDecPicBuf *dec_pic_mgr_get_cur_pic(EbDecHandle *dec_handle_ptr) {
+#endif
     EbDecPicMgr *ps_pic_mgr = (EbDecPicMgr *)dec_handle_ptr->pv_pic_mgr;
     SeqHeader   *seq_header = &dec_handle_ptr->seq_header;
     FrameHeader *frame_info = &dec_handle_ptr->frame_header;
@@ -126,7 +191,12 @@ EbDecPicBuf *dec_pic_mgr_get_cur_pic(EbDecHandle *dec_handle_ptr) {
         if (ps_pic_mgr->as_dec_pic[i].is_free == 1) break;
     }
 
+#if DEC_EXT_FRAME_BUF
+    *pp_pic_buf = NULL;
+    if (i >= MAX_PIC_BUFS) return EB_ErrorInsufficientResources;
+#else
     if (i >= MAX_PIC_BUFS) return NULL;
+#endif
 
     uint16_t       frame_width  = frame_info->frame_size.frame_width;
     uint16_t       frame_height = frame_info->frame_size.frame_height;
@@ -170,32 +240,96 @@ EbDecPicBuf *dec_pic_mgr_get_cur_pic(EbDecHandle *dec_handle_ptr) {
 #endif
 
         input_pic_buf_desc_init_data.split_mode = EB_FALSE;
+#if DEC_EXT_FRAME_BUF
+        /* Planes come from the application, see below */
+        if (dec_handle_ptr->ext_frame_buf) input_pic_buf_desc_init_data.buffer_enable_mask = 0;
+#endif
 
         EbErrorType return_error = dec_eb_recon_picture_buffer_desc_ctor(
             (EbPtr *)&(ps_pic_mgr->as_dec_pic[i].ps_pic_buf),
             (EbPtr)&input_pic_buf_desc_init_data,
             dec_handle_ptr->is_16bit_pipeline);
 
+#if DEC_EXT_FRAME_BUF
+        if (return_error != EB_ErrorNone) return return_error;
+#else
         if (return_error != EB_ErrorNone) return NULL;
+#endif
 
         ps_pic_mgr->as_dec_pic[i].size = frame_size;
 
         /* Memory for storing MV's at 8x8 lvl*/
         EbErrorType ret_err = mvs_8x8_memory_alloc(&ps_pic_mgr->as_dec_pic[i].mvs, frame_info);
+#if DEC_EXT_FRAME_BUF
+        if (ret_err != EB_ErrorNone) return ret_err;
+#else
         if (ret_err != EB_ErrorNone) return NULL;
+#endif
 
         ps_pic_mgr->num_pic_bufs++;
     } else
         assert(ps_pic_mgr->as_dec_pic[i].ps_pic_buf != NULL);
+#if DEC_EXT_FRAME_BUF
+    if (dec_handle_ptr->ext_frame_buf && ps_pic_mgr->as_dec_pic[i].ext_frame_buf.buffer == NULL) {
+        EbErrorType ret_err = dec_pic_buf_get_ext_frame_buf(dec_handle_ptr,
+                                                            &ps_pic_mgr->as_dec_pic[i]);
+        if (ret_err != EB_ErrorNone) return ret_err;
+    }
+#endif
 
     ps_pic_mgr->as_dec_pic[i].is_free   = 0;
     ps_pic_mgr->as_dec_pic[i].ref_count = 1;
 
     pic_buf = &ps_pic_mgr->as_dec_pic[i];
 
+#if DEC_EXT_FRAME_BUF
+    *pp_pic_buf = pic_buf;
+    return EB_ErrorNone;
+#else
     return pic_buf;
+#endif
 }
 
+#if DEC_EXT_FRAME_BUF
+/* Drop one reference, the application memory goes back with the last one */
+void dec_ref_count_and_rel(EbDecHandle *dec_handle_ptr, EbDecPicBuf *ps_pic_buf) {
+    if (ps_pic_buf != NULL) {
+        assert(ps_pic_buf->ref_count > 0);
+        ps_pic_buf->ref_count--;
+
+        if (ps_pic_buf->ref_count == 0) {
+            if (dec_handle_ptr->ext_frame_buf)
+                dec_pic_buf_release_ext_frame_buf(dec_handle_ptr, ps_pic_buf);
+            ps_pic_buf->is_free = 1;
+        }
+    }
+}
+
+/* Drop the references held by the decoder itself. Pictures the application
+   still holds go back on svt_av1_dec_release_picture. */
+void dec_pic_mgr_drop_refs(EbDecHandle *dec_handle_ptr) {
+    for (int32_t i = 0; i < REF_FRAMES; i++) {
+        dec_ref_count_and_rel(dec_handle_ptr, dec_handle_ptr->ref_frame_map[i]);
+        dec_handle_ptr->ref_frame_map[i] = NULL;
+    }
+    dec_ref_count_and_rel(dec_handle_ptr, dec_handle_ptr->out_pic_buf);
+    dec_handle_ptr->out_pic_buf = NULL;
+}
+
+/* Hand back the memory of every picture still holding application memory,
+   including the pools of the previous sequence geometries */
+void dec_pic_mgr_release_ext_frame_bufs(EbDecHandle *dec_handle_ptr) {
+    for (EbDecPicMgr *ps_pic_mgr = (EbDecPicMgr *)dec_handle_ptr->pv_pic_mgr; ps_pic_mgr;
+         ps_pic_mgr = ps_pic_mgr->prev_pic_mgr) {
+        for (int32_t i = 0; i < MAX_PIC_BUFS; i++) {
+            dec_pic_buf_release_ext_frame_buf(dec_handle_ptr, &ps_pic_mgr->as_dec_pic[i]);
+            ps_pic_mgr->as_dec_pic[i].ref_count = 0;
+            ps_pic_mgr->as_dec_pic[i].is_free   = 1;
+        }
+    }
+    dec_handle_ptr->out_pic_held = 0;
+}
+#else
 static INLINE void dec_ref_count_and_rel(EbDecPicBuf *ps_pic_buf) {
     if (ps_pic_buf != NULL) {
         ps_pic_buf->ref_count--;
@@ -204,6 +338,7 @@ static INLINE void dec_ref_count_and_rel(EbDecPicBuf *ps_pic_buf) {
         if (ps_pic_buf->ref_count == 0) ps_pic_buf->is_free = 1;
     }
 }
+#endif
 
 /**
 *******************************************************************************
@@ -231,7 +366,11 @@ void dec_pic_mgr_update_ref_pic(EbDecHandle *dec_handle_ptr, int32_t frame_decod
     /* TODO: Add lock and unlock for MT */
     if (frame_decoded) {
         for (mask = refresh_frame_flags; mask; mask >>= 1) {
+#if DEC_EXT_FRAME_BUF
+            dec_ref_count_and_rel(dec_handle_ptr, dec_handle_ptr->ref_frame_map[ref_index]);
+#else
             dec_ref_count_and_rel(dec_handle_ptr->ref_frame_map[ref_index]);
+#endif
             dec_handle_ptr->ref_frame_map[ref_index] =
                 dec_handle_ptr->next_ref_frame_map[ref_index];
             dec_handle_ptr->next_ref_frame_map[ref_index] = NULL;
@@ -239,7 +378,11 @@ void dec_pic_mgr_update_ref_pic(EbDecHandle *dec_handle_ptr, int32_t frame_decod
         }
 
         for (; ref_index < REF_FRAMES; ++ref_index) {
+#if DEC_EXT_FRAME_BUF
+            dec_ref_count_and_rel(dec_handle_ptr, dec_handle_ptr->ref_frame_map[ref_index]);
+#else
             dec_ref_count_and_rel(dec_handle_ptr->ref_frame_map[ref_index]);
+#endif
             dec_handle_ptr->ref_frame_map[ref_index] =
                 dec_handle_ptr->next_ref_frame_map[ref_index];
             dec_handle_ptr->next_ref_frame_map[ref_index] = NULL;
@@ -249,10 +392,18 @@ void dec_pic_mgr_update_ref_pic(EbDecHandle *dec_handle_ptr, int32_t frame_decod
             //TODO: Add output Q logic
             //assert(0);
         } else
+#if DEC_EXT_FRAME_BUF
+            dec_ref_count_and_rel(dec_handle_ptr, dec_handle_ptr->cur_pic_buf[0]);
+#else
             dec_ref_count_and_rel(dec_handle_ptr->cur_pic_buf[0]);
+#endif
     } else {
         // Nothing was decoded, so just drop this frame buffer
+#if DEC_EXT_FRAME_BUF
+        dec_ref_count_and_rel(dec_handle_ptr, dec_handle_ptr->cur_pic_buf[0]);
+#else
         dec_ref_count_and_rel(dec_handle_ptr->cur_pic_buf[0]);
+#endif
     }
 
     /* Invalidate these references until the next frame starts. */
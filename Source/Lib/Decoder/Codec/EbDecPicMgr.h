@@ -18,6 +18,11 @@ typedef struct EbDecPicMgr {
     /* number of picture buffers */
     uint8_t num_pic_bufs;
 
+#if DEC_EXT_FRAME_BUF
+    /* Manager replaced by this one on a new sequence geometry, its pictures
+       may still hold application memory */
+    struct EbDecPicMgr *prev_pic_mgr;
+#endif
 } EbDecPicMgr;
 
 typedef struct RefFrameInfo {
@@ -29,7 +34,19 @@ typedef struct RefFrameInfo {
 
 EbErrorType dec_pic_mgr_init(EbDecHandle *dec_handle_ptr);
 
+#if DEC_EXT_FRAME_BUF
+EbErrorType dec_pic_mgr_get_cur_pic(EbDecHandle *dec_handle_ptr, EbDecPicBuf **pp_pic_buf);
+#else
 EbDecPicBuf *dec_pic_mgr_get_cur_pic(EbDecHandle *dec_handle_ptr);
+#endif
+
+#if DEC_EXT_FRAME_BUF
+void dec_ref_count_and_rel(EbDecHandle *dec_handle_ptr, EbDecPicBuf *ps_pic_buf);
+
+void dec_pic_mgr_drop_refs(EbDecHandle *dec_handle_ptr);
+
+void dec_pic_mgr_release_ext_frame_bufs(EbDecHandle *dec_handle_ptr);
+#endif
 
 void dec_pic_mgr_update_ref_pic(EbDecHandle *dec_handle_ptr, int32_t frame_decoded,
                                 int32_t refresh_frame_flags);
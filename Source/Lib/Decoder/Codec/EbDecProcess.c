@@ -33,6 +33,9 @@
 #include "EbUtility.h"
 
 #include <stdlib.h>
+#if DEC_PARKED_WORKERS && defined(ARCH_X86)
+#include <emmintrin.h>
+#endif
 
 void *dec_all_stage_kernel(void *input_ptr);
 /*ToDo : Remove all these replications */
@@ -122,6 +125,67 @@ int32_t get_sb_row_to_process(DecMtRowInfo *sb_row_info) {
     return sb_row_to_process;
 }
 
+#if DEC_PARKED_WORKERS
+/* Bounds for the adaptive spin done before parking a waiting thread */
+#define DEC_MT_MIN_SPIN_COUNT 64
+#define DEC_MT_MAX_SPIN_COUNT 4096
+
+#ifdef _WIN32
+#define DEC_MT_FULL_BARRIER() MemoryBarrier()
+#else
+#define DEC_MT_FULL_BARRIER() __sync_synchronize()
+#endif
+
+#ifdef ARCH_X86
+#define DEC_MT_CPU_RELAX() _mm_pause()
+#else
+#define DEC_MT_CPU_RELAX()
+#endif
+
+static INLINE EbBool dec_mt_progress_done(volatile int32_t *progress, int32_t target,
+                                          volatile EbBool *abort_flag) {
+    return *progress >= target || (abort_flag && *abort_flag);
+}
+
+void dec_mt_wait_progress(DecMtFrameData *dec_mt_frame_data, volatile int32_t *progress,
+                          int32_t target, volatile EbBool *abort_flag) {
+    if (dec_mt_progress_done(progress, target, abort_flag)) return;
+
+    /* Dependencies are mostly a few SBs away : spin briefly first, and
+       grow or shrink the budget depending on whether spinning paid off */
+    int32_t spin_count = dec_mt_frame_data->progress_spin_count;
+    for (int32_t i = 0; i < spin_count; i++) {
+        DEC_MT_CPU_RELAX();
+        if (dec_mt_progress_done(progress, target, abort_flag)) {
+            if (spin_count < DEC_MT_MAX_SPIN_COUNT)
+                dec_mt_frame_data->progress_spin_count = spin_count << 1;
+            return;
+        }
+    }
+    if (spin_count > DEC_MT_MIN_SPIN_COUNT)
+        dec_mt_frame_data->progress_spin_count = spin_count >> 1;
+
+    eb_lock_cond_var(dec_mt_frame_data->progress_cond);
+    dec_mt_frame_data->num_progress_waiters++;
+    /* Pairs with the barrier in dec_mt_notify_progress : either the
+       notifier sees the waiter or the waiter sees the progress */
+    DEC_MT_FULL_BARRIER();
+    while (!dec_mt_progress_done(progress, target, abort_flag))
+        eb_wait_cond_var(dec_mt_frame_data->progress_cond);
+    dec_mt_frame_data->num_progress_waiters--;
+    eb_unlock_cond_var(dec_mt_frame_data->progress_cond);
+}
+
+void dec_mt_notify_progress(DecMtFrameData *dec_mt_frame_data) {
+    DEC_MT_FULL_BARRIER();
+    if (dec_mt_frame_data->num_progress_waiters > 0) {
+        eb_lock_cond_var(dec_mt_frame_data->progress_cond);
+        eb_broadcast_cond_var(dec_mt_frame_data->progress_cond);
+        eb_unlock_cond_var(dec_mt_frame_data->progress_cond);
+    }
+}
+#endif
+
 EbErrorType dec_dummy_creator(EbPtr *object_dbl_ptr, EbPtr object_init_data_ptr) {
     DecMtNode *obj;
     *object_dbl_ptr = NULL;
@@ -131,6 +195,60 @@ EbErrorType dec_dummy_creator(EbPtr *object_dbl_ptr, EbPtr object_init_data_ptr)
     return EB_ErrorNone;
 }
 
+#if DEC_POOLED_MT_REALLOC
+/* Binds the MT structures to the frame size and tile layout of the current
+   frame, within the capacity allocated by dec_system_resource_init */
+void dec_mt_frame_geometry_init(EbDecHandle *dec_handle_ptr, TilesInfo *tiles_info) {
+    DecMtFrameData *dec_mt_frame_data =
+        &dec_handle_ptr->master_frame_buf.cur_frame_bufs[0].dec_mt_frame_data;
+    int32_t  num_tiles = tiles_info->tile_cols * tiles_info->tile_rows;
+    int32_t  sb_size_h = block_size_high[dec_handle_ptr->seq_header.sb_size];
+    uint32_t picture_height_in_sb =
+        (dec_handle_ptr->frame_header.frame_size.frame_height + sb_size_h - 1) / sb_size_h;
+
+    assert(num_tiles <= dec_mt_frame_data->alloc_num_tiles);
+
+    dec_mt_frame_data->parse_tile_info.num_sb_rows = num_tiles;
+    dec_mt_frame_data->recon_tile_info.num_sb_rows = num_tiles;
+
+    for (int32_t tiles_ctr = 0; tiles_ctr < num_tiles; tiles_ctr++) {
+        int32_t                  tile_row = tiles_ctr / tiles_info->tile_cols;
+        int32_t                  tile_col = tiles_ctr % tiles_info->tile_cols;
+        DecMtParseReconTileInfo *parse_recon_tile_info =
+            &dec_mt_frame_data->parse_recon_tile_info_array[tiles_ctr];
+        TileInfo *tile_info = &parse_recon_tile_info->tile_info;
+
+        /* init tile info */
+        svt_tile_init(tile_info, &dec_handle_ptr->frame_header, tile_row, tile_col);
+
+        parse_recon_tile_info->tile_num_sb_rows =
+            ((((tile_info->mi_row_end - 1) << MI_SIZE_LOG2) >>
+              dec_handle_ptr->seq_header.sb_size_log2) -
+             ((tile_info->mi_row_start << MI_SIZE_LOG2) >> dec_handle_ptr->seq_header.sb_size_log2) +
+             1);
+    }
+
+    dec_mt_frame_data->lf_frame_info.lf_sb_row_info.num_sb_rows = picture_height_in_sb;
+    dec_mt_frame_data->cdef_sb_row_info.num_sb_rows             = picture_height_in_sb;
+    dec_mt_frame_data->lr_sb_row_info.num_sb_rows               = picture_height_in_sb;
+}
+
+/* Whether the current frame fits in what dec_system_resource_init allocated */
+EbBool dec_mt_frame_geometry_fits(EbDecHandle *dec_handle_ptr, TilesInfo *tiles_info) {
+    DecMtFrameData *dec_mt_frame_data =
+        &dec_handle_ptr->master_frame_buf.cur_frame_bufs[0].dec_mt_frame_data;
+    SeqHeader *seq_header = &dec_handle_ptr->seq_header;
+
+    return dec_mt_frame_data->alloc_sb_size == seq_header->sb_size &&
+           dec_mt_frame_data->alloc_max_frame_width >= seq_header->max_frame_width &&
+           dec_mt_frame_data->alloc_max_frame_height >= seq_header->max_frame_height &&
+           dec_mt_frame_data->alloc_max_frame_height >=
+               dec_handle_ptr->frame_header.frame_size.frame_height &&
+           dec_mt_frame_data->alloc_tile_cols >= tiles_info->tile_cols &&
+           dec_mt_frame_data->alloc_num_tiles >= tiles_info->tile_cols * tiles_info->tile_rows;
+}
+#endif
+
 /************************************
 * System Resource Managers & Fifos
 ************************************/
@@ -157,8 +275,30 @@ EbErrorType dec_system_resource_init(EbDecHandle *dec_handle_ptr, TilesInfo *til
     EB_CREATE_MUTEX(dec_mt_frame_data->motion_proj_info.motion_proj_mutex);
 
     int32_t  sb_size_h = block_size_high[dec_handle_ptr->seq_header.sb_size];
+#if DEC_POOLED_MT_REALLOC
+    /* Row structures are sized for the largest frame of the sequence and
+       the tile capacity never shrinks, so that later frame size or tile
+       layout changes only need dec_mt_frame_geometry_init */
+    if (EB_FALSE == dec_handle_ptr->start_thread_process) {
+        dec_mt_frame_data->alloc_num_tiles = 0;
+        dec_mt_frame_data->alloc_tile_cols = 0;
+    }
+    dec_mt_frame_data->alloc_num_tiles =
+        AOMMAX(dec_mt_frame_data->alloc_num_tiles, num_tiles);
+    dec_mt_frame_data->alloc_tile_cols =
+        AOMMAX(dec_mt_frame_data->alloc_tile_cols, tiles_info->tile_cols);
+    dec_mt_frame_data->alloc_sb_size          = dec_handle_ptr->seq_header.sb_size;
+    dec_mt_frame_data->alloc_max_frame_width  = dec_handle_ptr->seq_header.max_frame_width;
+    dec_mt_frame_data->alloc_max_frame_height = dec_handle_ptr->seq_header.max_frame_height;
+
+    uint32_t picture_height_in_sb =
+        (AOMMAX(dec_handle_ptr->seq_header.max_frame_height,
+                dec_handle_ptr->frame_header.frame_size.frame_height) +
+         sb_size_h - 1) / sb_size_h;
+#else
     uint32_t picture_height_in_sb = (dec_handle_ptr->frame_header.
         frame_size.frame_height + sb_size_h - 1) / sb_size_h;
+#endif
 
     /************************************
     * Contexts
@@ -167,21 +307,63 @@ EbErrorType dec_system_resource_init(EbDecHandle *dec_handle_ptr, TilesInfo *til
     DecMtRowInfo *parse_tile_info = &dec_mt_frame_data->parse_tile_info;
 
     EB_CREATE_MUTEX(parse_tile_info->sbrow_mutex);
+#if !DEC_POOLED_MT_REALLOC
     parse_tile_info->num_sb_rows        = num_tiles;
+#endif
     parse_tile_info->sb_row_to_process  = 0;
 
     /* Recon */
+#if DEC_POOLED_MT_REALLOC
+    EB_MALLOC_DEC(uint32_t *,
+                  dec_mt_frame_data->sb_recon_row_map,
+                  picture_height_in_sb * dec_mt_frame_data->alloc_tile_cols * sizeof(uint32_t),
+                  EB_N_PTR);
+#else
     EB_MALLOC_DEC(uint32_t *,
                   dec_mt_frame_data->sb_recon_row_map,
                   picture_height_in_sb * tiles_info->tile_cols * sizeof(uint32_t),
                   EB_N_PTR);
+#endif
 
     DecMtRowInfo *recon_tile_info = &dec_mt_frame_data->recon_tile_info;
     EB_CREATE_MUTEX(recon_tile_info->sbrow_mutex);
 
+#if !DEC_POOLED_MT_REALLOC
     recon_tile_info->num_sb_rows        = num_tiles;
+#endif
     recon_tile_info->sb_row_to_process  = 0;
     /* recon top right sync */
+#if DEC_POOLED_MT_REALLOC
+    {
+        EB_CREATE_MUTEX(dec_mt_frame_data->tile_switch_mutex);
+
+        EB_MALLOC_DEC(DecMtParseReconTileInfo *,
+                      dec_mt_frame_data->parse_recon_tile_info_array,
+                      dec_mt_frame_data->alloc_num_tiles * sizeof(DecMtParseReconTileInfo),
+                      EB_N_PTR);
+
+        /* Any tile spans at most all the SB rows of the frame */
+        for (int32_t tiles_ctr = 0; tiles_ctr < dec_mt_frame_data->alloc_num_tiles;
+             tiles_ctr++) {
+            DecMtParseReconTileInfo *parse_recon_tile_info =
+                &dec_mt_frame_data->parse_recon_tile_info_array[tiles_ctr];
+
+            EB_MALLOC_DEC(uint32_t *,
+                          parse_recon_tile_info->sb_recon_row_parsed,
+                          picture_height_in_sb * sizeof(uint32_t),
+                          EB_N_PTR);
+            EB_MALLOC_DEC(uint32_t *,
+                          parse_recon_tile_info->sb_recon_completed_in_row,
+                          picture_height_in_sb * sizeof(uint32_t),
+                          EB_N_PTR);
+            EB_MALLOC_DEC(uint32_t *,
+                          parse_recon_tile_info->sb_recon_row_started,
+                          picture_height_in_sb * sizeof(uint32_t),
+                          EB_N_PTR);
+            EB_CREATE_MUTEX(parse_recon_tile_info->tile_sbrow_mutex);
+        }
+    }
+#else
     {
         int32_t tiles_ctr;
 
@@ -247,6 +429,7 @@ EbErrorType dec_system_resource_init(EbDecHandle *dec_handle_ptr, TilesInfo *til
             //    NULL);
         }
     }
+#endif
 
     /* LF */
     EB_MALLOC_DEC(int32_t *,
@@ -262,7 +445,9 @@ EbErrorType dec_system_resource_init(EbDecHandle *dec_handle_ptr, TilesInfo *til
     DecMtRowInfo *lf_sb_row_info = &dec_mt_frame_data->lf_frame_info.lf_sb_row_info;
 
     EB_CREATE_MUTEX(lf_sb_row_info->sbrow_mutex);
+#if !DEC_POOLED_MT_REALLOC
     lf_sb_row_info->num_sb_rows = picture_height_in_sb;
+#endif
     lf_sb_row_info->sb_row_to_process = 0;
 
     /* CDEF */
@@ -324,7 +509,9 @@ EbErrorType dec_system_resource_init(EbDecHandle *dec_handle_ptr, TilesInfo *til
 
     EB_CREATE_MUTEX(cdef_sb_row_info->sbrow_mutex);
 
+#if !DEC_POOLED_MT_REALLOC
     cdef_sb_row_info->num_sb_rows       = picture_height_in_sb;
+#endif
     cdef_sb_row_info->sb_row_to_process = 0;
     /* LR */
     EB_MALLOC_DEC(int32_t *,
@@ -341,7 +528,9 @@ EbErrorType dec_system_resource_init(EbDecHandle *dec_handle_ptr, TilesInfo *til
 
     EB_CREATE_MUTEX(lr_sb_row_info->sbrow_mutex);
 
+#if !DEC_POOLED_MT_REALLOC
     lr_sb_row_info->num_sb_rows         = picture_height_in_sb;
+#endif
     lr_sb_row_info->sb_row_to_process   = 0;
 
     dec_mt_frame_data->temp_mutex = eb_create_mutex();
@@ -354,6 +543,9 @@ EbErrorType dec_system_resource_init(EbDecHandle *dec_handle_ptr, TilesInfo *til
     dec_mt_frame_data->start_lr_frame     = EB_FALSE;
     dec_mt_frame_data->num_threads_cdefed = 0;
     dec_mt_frame_data->num_threads_lred   = 0;
+#if DEC_POOLED_MT_REALLOC
+    dec_mt_frame_geometry_init(dec_handle_ptr, tiles_info);
+#endif
 
     /************************************
     * Thread Handles
@@ -377,6 +569,12 @@ EbErrorType dec_system_resource_init(EbDecHandle *dec_handle_ptr, TilesInfo *til
     if (EB_FALSE == dec_handle_ptr->start_thread_process) {
         dec_mt_frame_data->end_flag           = EB_FALSE;
         dec_mt_frame_data->num_threads_exited = 0;
+#if DEC_PARKED_WORKERS
+        /* Created once : a worker may still be leaving a wait on it */
+        EB_CREATE_COND_VAR(dec_mt_frame_data->progress_cond);
+        dec_mt_frame_data->num_progress_waiters = 0;
+        dec_mt_frame_data->progress_spin_count  = DEC_MT_MIN_SPIN_COUNT;
+#endif
 
         if (num_lib_threads > 0) {
             DecThreadCtxt *thread_ctxt_pa;
@@ -499,6 +697,24 @@ void parse_frame_tiles(EbDecHandle *dec_handle_ptr, DecThreadCtxt *thread_ctxt)
         tile_num = get_sb_row_to_process(&dec_mt_frame_data->parse_tile_info);
         if (-1 != tile_num) {
             dec_mt_frame_data->start_decode_frame = EB_TRUE;
+#if DEC_PARSE_RECON_OVERLAP
+            /* Recon follows the parse SB row by SB row through
+               sb_recon_row_parsed, so wake it before parsing the tile
+               instead of after : with a single tile the other threads
+               would otherwise idle for the whole parse */
+            eb_post_semaphore(dec_handle_ptr->thread_semaphore);
+            for (uint32_t lib_thrd = 0;
+                lib_thrd < dec_handle_ptr->dec_config.threads - 1;
+                 lib_thrd++)
+            {
+                eb_post_semaphore(dec_handle_ptr->
+                    thread_ctxt_pa[lib_thrd].thread_semaphore);
+            }
+            if (EB_ErrorNone != parse_tile_job(dec_handle_ptr, tile_num)) {
+                SVT_LOG("\nParse Issue for Tile %d", tile_num);
+                break;
+            }
+#else
             if (EB_ErrorNone != parse_tile_job(dec_handle_ptr, tile_num)) {
                 SVT_LOG("\nParse Issue for Tile %d", tile_num);
                 break;
@@ -511,6 +727,7 @@ void parse_frame_tiles(EbDecHandle *dec_handle_ptr, DecThreadCtxt *thread_ctxt)
                 eb_post_semaphore(dec_handle_ptr->
                     thread_ctxt_pa[lib_thrd].thread_semaphore);
             }
+#endif
         } else
             break;
     }
@@ -758,6 +975,330 @@ static INLINE void dec_save_CDEF_boundary_lines_SB_row(
 }
 
 /*Frame level function to trigger loop filter for each superblock*/
+#if DEC_FUSED_POST_FILTER
+void pad_pre_lr(EbPictureBufferDesc *recon_picture_buf, int32_t sb_row, int32_t sb_size,
+                int32_t num_rows, uint8_t **curr_blk_recon_buf, int *rec_stride,
+                uint32_t frame_width, uint32_t frame_height, int sx, int sy);
+void pad_post_lr(EbPictureBufferDesc *recon_picture_buf, int32_t sb_row, int32_t sb_size,
+                 int32_t num_rows, int *rec_stride, uint32_t pad_width, uint32_t pad_height,
+                 uint32_t shift, uint32_t frame_width, uint32_t frame_height, int sx, int sy);
+
+/* Per thread state needed to run CDEF on any SB row of the frame */
+typedef struct DecCdefRowCtxt {
+    DECLARE_ALIGNED(16, uint16_t, src[CDEF_INBUF_SIZE]);
+    uint16_t *    colbuf[2 * 3];
+    int32_t       mi_wide_l2[3];
+    int32_t       mi_high_l2[3];
+    uint8_t *     curr_blk_recon_buf[MAX_MB_PLANE];
+    int32_t       curr_recon_stride[MAX_MB_PLANE];
+    Av1PixelRect  tile_rect[MAX_MB_PLANE];
+    Av1PixelRect *tile_rect_p[MAX_MB_PLANE];
+    int32_t       num_planes;
+    EbBool        do_cdef;
+    EbBool        do_lr;
+    EbBool        do_upscale;
+} DecCdefRowCtxt;
+
+/* Per thread state needed to run LR (and its padding) on any SB row */
+typedef struct DecLrRowCtxt {
+    EbPictureBufferDesc *recon_picture_buf;
+    uint8_t *            curr_blk_recon_buf[MAX_MB_PLANE];
+    int32_t              curr_recon_stride[MAX_MB_PLANE];
+    int32_t              recon_stride[MAX_MB_PLANE];
+    Av1PixelRect         tile_rect[MAX_MB_PLANE];
+    Av1PixelRect *       tile_rect_p[MAX_MB_PLANE];
+    int32_t              num_planes;
+    uint32_t             frame_width;
+    uint32_t             frame_height;
+    int                  sx;
+    int                  sy;
+    int32_t              sb_size;
+    int32_t              num_rows;
+    uint32_t             pad_width;
+    uint32_t             pad_height;
+    int32_t              shift;
+    EbBool               do_lr;
+    EbBool               do_upscale;
+    uint8_t *            dst;
+    int                  th_cnt;
+} DecLrRowCtxt;
+
+/* Fused LF -> CDEF -> LR chain : once a thread has deblocked a SB row it
+   goes on with the CDEF and LR rows this made ready, while their pixels
+   and line buffers are still in cache, before deblocking a new row */
+typedef struct DecPostFilterChain {
+    DecCdefRowCtxt cdef_row_ctxt;
+    DecLrRowCtxt   lr_row_ctxt;
+    EbBool         cdef_row_ctxt_init;
+    EbBool         lr_row_ctxt_init;
+} DecPostFilterChain;
+
+/* Picks up the next row of sb_row_info only when the row it depends on
+   in dep_row_map is already done, so that the caller never waits on it */
+static int32_t get_ready_sb_row_to_process(DecMtRowInfo *sb_row_info,
+                                           volatile uint32_t *dep_row_map,
+                                           int32_t dep_row_offset, int32_t last_row) {
+    int32_t sb_row_to_process = -1;
+
+    eb_block_on_mutex(sb_row_info->sbrow_mutex);
+    if (sb_row_info->sb_row_to_process != sb_row_info->num_sb_rows) {
+        int32_t dep_row = AOMMIN(sb_row_info->sb_row_to_process + dep_row_offset, last_row);
+        if (dep_row_map[dep_row]) {
+            sb_row_to_process = sb_row_info->sb_row_to_process;
+            sb_row_info->sb_row_to_process++;
+        }
+    }
+    eb_release_mutex(sb_row_info->sbrow_mutex);
+
+    return sb_row_to_process;
+}
+
+static void dec_cdef_row_ctxt_init(EbDecHandle *dec_handle, DecCdefRowCtxt *ctxt) {
+    EbPictureBufferDesc *recon_picture_ptr = dec_handle->cur_pic_buf[0]->ps_pic_buf;
+    FrameHeader *        frame_header      = &dec_handle->frame_header;
+    EbBool               no_ibc            = !frame_header->allow_intrabc;
+    LrParams *           lr_param          = frame_header->lr_params;
+
+    ctxt->num_planes = av1_num_planes(&dec_handle->seq_header.color_config);
+    ctxt->do_cdef    = no_ibc && !frame_header->coded_lossless &&
+                    (frame_header->cdef_params.cdef_bits ||
+                     frame_header->cdef_params.cdef_y_strength[0] ||
+                     frame_header->cdef_params.cdef_uv_strength[0]);
+    ctxt->do_upscale = no_ibc && !av1_superres_unscaled(&frame_header->frame_size);
+    ctxt->do_lr      = no_ibc &&
+                  (lr_param[AOM_PLANE_Y].frame_restoration_type != RESTORE_NONE ||
+                   lr_param[AOM_PLANE_U].frame_restoration_type != RESTORE_NONE ||
+                   lr_param[AOM_PLANE_V].frame_restoration_type != RESTORE_NONE);
+
+    for (int32_t pli = 0; pli < ctxt->num_planes; pli++) {
+        int32_t is_uv = pli ? 1 : 0;
+        int32_t sub_x = !is_uv ? 0 : dec_handle->seq_header.color_config.subsampling_x;
+        int32_t sub_y = !is_uv ? 0 : dec_handle->seq_header.color_config.subsampling_y;
+        ctxt->mi_wide_l2[pli] = MI_SIZE_LOG2 - sub_x;
+        ctxt->mi_high_l2[pli] = MI_SIZE_LOG2 - sub_y;
+
+        ctxt->tile_rect[pli]   = whole_frame_rect(&dec_handle->cm.frm_size, sub_x, sub_y, is_uv);
+        ctxt->tile_rect_p[pli] = &ctxt->tile_rect[pli];
+
+        derive_blk_pointers(recon_picture_ptr,
+                            pli,
+                            0,
+                            0,
+                            (void *)&ctxt->curr_blk_recon_buf[pli],
+                            &ctxt->curr_recon_stride[pli],
+                            sub_x,
+                            sub_y);
+
+        /* For SB SIZE 128x128 a second colbuf is used while
+           transversing across the 0 - 3 64x64s of the SB */
+        size_t colbuf_size = sizeof(*ctxt->colbuf) *
+            ((CDEF_BLOCKSIZE << ctxt->mi_high_l2[pli]) + 2 * CDEF_VBORDER) * CDEF_HBORDER;
+        ctxt->colbuf[pli] = (uint16_t *)eb_aom_malloc(colbuf_size);
+        if (dec_handle->seq_header.sb_size == BLOCK_128X128)
+            ctxt->colbuf[pli + 3] = (uint16_t *)eb_aom_malloc(colbuf_size);
+    }
+}
+
+static void dec_cdef_row_ctxt_free(EbDecHandle *dec_handle, DecCdefRowCtxt *ctxt) {
+    for (int32_t pli = 0; pli < ctxt->num_planes; pli++) {
+        eb_aom_free(ctxt->colbuf[pli]);
+        if (dec_handle->seq_header.sb_size == BLOCK_128X128) eb_aom_free(ctxt->colbuf[pli + 3]);
+    }
+}
+
+/* CDEF of one SB row, its LF dependency must be met */
+static void dec_cdef_row_mt(EbDecHandle *dec_handle, DecCdefRowCtxt *ctxt, int32_t sb_row) {
+    DecMtFrameData *dec_mt_frame_data =
+        &dec_handle->master_frame_buf.cur_frame_bufs[0].dec_mt_frame_data;
+
+    if (ctxt->do_cdef) {
+        svt_cdef_sb_row_mt(dec_handle,
+                           ctxt->mi_wide_l2,
+                           ctxt->mi_high_l2,
+                           &ctxt->colbuf[0],
+                           sb_row,
+                           &ctxt->src[0],
+                           &ctxt->curr_recon_stride[0],
+                           &ctxt->curr_blk_recon_buf[0]);
+    }
+
+    if (ctxt->do_lr && !ctxt->do_upscale) {
+        // In this case, we should only use CDEF pixels at the top
+        // and bottom of the frame as a whole; internal tile boundaries
+        // can use deblocked pixels from adjacent tiles for context.
+        if (sb_row == 0 || sb_row == dec_mt_frame_data->sb_rows - 1) {
+            dec_save_CDEF_boundary_lines_SB_row(dec_handle,
+                                                ctxt->tile_rect_p,
+                                                sb_row,
+                                                ctxt->curr_blk_recon_buf,
+                                                ctxt->curr_recon_stride,
+                                                ctxt->num_planes);
+        }
+    }
+    /* Update CDEF done map */
+    dec_mt_frame_data->cdef_completed_for_row_map[sb_row] = 1;
+#if DEC_PARKED_WORKERS
+    dec_mt_notify_progress(dec_mt_frame_data);
+#endif
+}
+
+static void dec_lr_row_ctxt_init(EbDecHandle *dec_handle, DecLrRowCtxt *ctxt,
+                                 DecThreadCtxt *thread_ctxt) {
+    EbPictureBufferDesc *recon_picture_buf = dec_handle->cur_pic_buf[0]->ps_pic_buf;
+    FrameHeader *        frame_header      = &dec_handle->frame_header;
+    EbBool               no_ibc            = !frame_header->allow_intrabc;
+    LrParams *           lr_param          = frame_header->lr_params;
+    LrCtxt *             lr_ctxt           = (LrCtxt *)dec_handle->pv_lr_ctxt;
+
+    ctxt->recon_picture_buf = recon_picture_buf;
+    ctxt->num_planes        = av1_num_planes(&dec_handle->seq_header.color_config);
+
+    for (int32_t pli = 0; pli < ctxt->num_planes; pli++) {
+        int32_t sub_x = (pli == 0) ? 0 : dec_handle->seq_header.color_config.subsampling_x;
+        int32_t sub_y = (pli == 0) ? 0 : dec_handle->seq_header.color_config.subsampling_y;
+
+        derive_blk_pointers(recon_picture_buf,
+                            pli,
+                            0,
+                            0,
+                            (void *)&ctxt->curr_blk_recon_buf[pli],
+                            &ctxt->curr_recon_stride[pli],
+                            sub_x,
+                            sub_y);
+
+        ctxt->tile_rect[pli] =
+            whole_frame_rect(&frame_header->frame_size, sub_x, sub_y, pli > 0);
+        ctxt->tile_rect_p[pli] = &ctxt->tile_rect[pli];
+    }
+
+    ctxt->frame_width  = frame_header->frame_size.superres_upscaled_width;
+    ctxt->frame_height = frame_header->frame_size.frame_height;
+    ctxt->sx           = dec_handle->seq_header.color_config.subsampling_x;
+    ctxt->sy           = dec_handle->seq_header.color_config.subsampling_y;
+
+    int32_t sb_size_log2      = dec_handle->seq_header.sb_size_log2;
+    int32_t sb_aligned_height = ALIGN_POWER_OF_TWO(ctxt->frame_height, sb_size_log2);
+    ctxt->sb_size             = dec_handle->seq_header.use_128x128_superblock ? 128 : 64;
+    ctxt->num_rows            = sb_aligned_height >> sb_size_log2;
+
+    ctxt->pad_width  = recon_picture_buf->origin_x;
+    ctxt->pad_height = recon_picture_buf->origin_y;
+    ctxt->shift      = 0;
+    if ((recon_picture_buf->bit_depth != EB_8BIT) || recon_picture_buf->is_16bit_pipeline)
+        ctxt->shift = 1;
+    ctxt->recon_stride[AOM_PLANE_Y] = recon_picture_buf->stride_y << ctxt->shift;
+    ctxt->recon_stride[AOM_PLANE_U] = recon_picture_buf->stride_cb << ctxt->shift;
+    ctxt->recon_stride[AOM_PLANE_V] = recon_picture_buf->stride_cr << ctxt->shift;
+
+    ctxt->do_lr      = no_ibc &&
+                  (lr_param[AOM_PLANE_Y].frame_restoration_type != RESTORE_NONE ||
+                   lr_param[AOM_PLANE_U].frame_restoration_type != RESTORE_NONE ||
+                   lr_param[AOM_PLANE_V].frame_restoration_type != RESTORE_NONE);
+    ctxt->do_upscale = no_ibc && !av1_superres_unscaled(&frame_header->frame_size);
+    ctxt->dst        = NULL == thread_ctxt ? lr_ctxt->dst : thread_ctxt->dst;
+    ctxt->th_cnt     = NULL == thread_ctxt ? 0 : thread_ctxt->thread_cnt;
+}
+
+/* LR and padding of one SB row, its CDEF dependency must be met */
+static void dec_lr_row_mt(EbDecHandle *dec_handle, DecLrRowCtxt *ctxt, int32_t sb_row) {
+    DecMtFrameData *dec_mt_frame_data =
+        &dec_handle->master_frame_buf.cur_frame_bufs[0].dec_mt_frame_data;
+
+    if (ctxt->do_lr && !ctxt->do_upscale) {
+        if (sb_row == 0 || sb_row == dec_mt_frame_data->sb_rows - 1) {
+            dec_save_CDEF_boundary_lines_SB_row(dec_handle,
+                                                ctxt->tile_rect_p,
+                                                sb_row,
+                                                ctxt->curr_blk_recon_buf,
+                                                ctxt->curr_recon_stride,
+                                                ctxt->num_planes);
+        }
+    }
+
+    /* Pad LR_PAD_SIDE pixels for each row before the
+       LR process starts for the current row. */
+    pad_pre_lr(ctxt->recon_picture_buf,
+               sb_row,
+               ctxt->sb_size,
+               ctxt->num_rows,
+               &ctxt->curr_blk_recon_buf[AOM_PLANE_Y],
+               &ctxt->recon_stride[AOM_PLANE_Y],
+               ctxt->frame_width,
+               ctxt->frame_height,
+               ctxt->sx,
+               ctxt->sy);
+
+    /* Row level LR */
+    if (ctxt->do_lr)
+        dec_av1_loop_restoration_filter_row(dec_handle,
+                                            sb_row,
+                                            &ctxt->curr_blk_recon_buf[AOM_PLANE_Y],
+                                            &ctxt->curr_recon_stride[AOM_PLANE_Y],
+                                            ctxt->tile_rect,
+                                            0 /*opt_lr*/,
+                                            ctxt->dst,
+                                            ctxt->th_cnt);
+
+    /* Pad pixels for the previous row to avoid recon buffer */
+    pad_post_lr(ctxt->recon_picture_buf,
+                sb_row,
+                ctxt->sb_size,
+                ctxt->num_rows,
+                &ctxt->recon_stride[AOM_PLANE_Y],
+                ctxt->pad_width,
+                ctxt->pad_height,
+                ctxt->shift,
+                ctxt->frame_width,
+                ctxt->frame_height,
+                ctxt->sx,
+                ctxt->sy);
+
+    /* Update LR done map */
+    dec_mt_frame_data->lr_row_map[sb_row] = 1;
+}
+
+/* Runs every CDEF / LR row whose dependencies are already met, LR first
+   as it consumes the rows CDEF has just written */
+static void dec_post_filter_chain_run(EbDecHandle *dec_handle, DecPostFilterChain *chain,
+                                      DecThreadCtxt *thread_ctxt) {
+    DecMtFrameData *dec_mt_frame_data =
+        &dec_handle->master_frame_buf.cur_frame_bufs[0].dec_mt_frame_data;
+    int32_t last_row = dec_mt_frame_data->sb_rows - 1;
+
+    /* LR jobs are queued before start_lr_frame is raised, which with
+       superres only happens once the whole frame is upscaled */
+    if (!dec_mt_frame_data->start_cdef_frame) return;
+
+    while (1) {
+        int32_t sb_row = -1;
+        if (dec_mt_frame_data->start_lr_frame) {
+            sb_row = get_ready_sb_row_to_process(&dec_mt_frame_data->lr_sb_row_info,
+                                                 dec_mt_frame_data->cdef_completed_for_row_map,
+                                                 0,
+                                                 last_row);
+        }
+        if (-1 != sb_row) {
+            if (!chain->lr_row_ctxt_init) {
+                dec_lr_row_ctxt_init(dec_handle, &chain->lr_row_ctxt, thread_ctxt);
+                chain->lr_row_ctxt_init = EB_TRUE;
+            }
+            dec_lr_row_mt(dec_handle, &chain->lr_row_ctxt, sb_row);
+            continue;
+        }
+        sb_row = get_ready_sb_row_to_process(&dec_mt_frame_data->cdef_sb_row_info,
+                                             dec_mt_frame_data->lf_row_map,
+                                             1,
+                                             last_row);
+        if (-1 == sb_row) break;
+        if (!chain->cdef_row_ctxt_init) {
+            dec_cdef_row_ctxt_init(dec_handle, &chain->cdef_row_ctxt);
+            chain->cdef_row_ctxt_init = EB_TRUE;
+        }
+        dec_cdef_row_mt(dec_handle, &chain->cdef_row_ctxt, sb_row);
+    }
+}
+#endif
+
 void dec_av1_loop_filter_frame_mt(EbDecHandle *dec_handle,
                                   EbPictureBufferDesc *recon_picture_buf,
                                   LfCtxt *lf_ctxt,
@@ -829,6 +1370,11 @@ void dec_av1_loop_filter_frame_mt(EbDecHandle *dec_handle,
 
     DecMtFrameData *dec_mt_frame_data =
         &dec_handle->master_frame_buf.cur_frame_bufs[0].dec_mt_frame_data;
+#if DEC_FUSED_POST_FILTER
+    DecPostFilterChain post_filter_chain;
+    post_filter_chain.cdef_row_ctxt_init = EB_FALSE;
+    post_filter_chain.lr_row_ctxt_init   = EB_FALSE;
+#endif
 
     while (1) {
 #if MT_WAIT_PROFILE
@@ -856,6 +1402,18 @@ void dec_av1_loop_filter_frame_mt(EbDecHandle *dec_handle,
 #if MT_WAIT_PROFILE
             dec_timer_start(&timer);
 #endif
+#if DEC_PARKED_WORKERS
+            (void)start_lf;
+            for (int r = 0; r < 3; r++) {
+                for (int i = 0; i < tiles_info->tile_cols; i++) {
+                    dec_mt_wait_progress(
+                        dec_mt_frame_data,
+                        (volatile int32_t *)&dec_mt_frame_data->sb_recon_row_map[row_index[r] + i],
+                        1,
+                        NULL);
+                }
+            }
+#else
             while ((!start_lf[0]) || (!start_lf[1]) || (!start_lf[2])) {
                 start_lf[0] = 1;
                 start_lf[1] = 1;
@@ -866,6 +1424,7 @@ void dec_av1_loop_filter_frame_mt(EbDecHandle *dec_handle,
                     start_lf[2] &= dec_mt_frame_data->sb_recon_row_map[row_index[2] + i];
                 }
             }
+#endif
 #if MT_WAIT_PROFILE
             dec_display_timer("LFWR", &timer, th_cnt, fp);
 #endif
@@ -891,6 +1450,9 @@ void dec_av1_loop_filter_frame_mt(EbDecHandle *dec_handle,
 
                 /* Update LF done map */
                 dec_mt_frame_data1->lf_row_map[sb_row - 1] = 1;
+#if DEC_PARKED_WORKERS
+                dec_mt_notify_progress(dec_mt_frame_data1);
+#endif
             }
             if (sb_row == dec_mt_frame_data->sb_rows - 1) {
                 dec_save_lf_boundary_lines_sb_row(
@@ -898,10 +1460,21 @@ void dec_av1_loop_filter_frame_mt(EbDecHandle *dec_handle,
 
                 /* Update LF done map */
                 dec_mt_frame_data1->lf_row_map[sb_row] = 1;
+#if DEC_PARKED_WORKERS
+                dec_mt_notify_progress(dec_mt_frame_data1);
+#endif
             }
+#if DEC_FUSED_POST_FILTER
+            /* Filter down the rows this one completed while still hot */
+            dec_post_filter_chain_run(dec_handle, &post_filter_chain, thread_ctxt);
+#endif
         } else
             break;
     }
+#if DEC_FUSED_POST_FILTER
+    if (post_filter_chain.cdef_row_ctxt_init)
+        dec_cdef_row_ctxt_free(dec_handle, &post_filter_chain.cdef_row_ctxt);
+#endif
 }
 
 void svt_av1_queue_cdef_jobs(EbDecHandle *dec_handle_ptr) {
@@ -923,8 +1496,10 @@ void svt_av1_queue_cdef_jobs(EbDecHandle *dec_handle_ptr) {
 }
 
 void svt_cdef_frame_mt(EbDecHandle *dec_handle_ptr, DecThreadCtxt *thread_ctxt) {
+#if !DEC_FUSED_POST_FILTER
     uint8_t *       curr_blk_recon_buf[MAX_MB_PLANE];
     int32_t         curr_recon_stride[MAX_MB_PLANE];
+#endif
     DecMtFrameData *dec_mt_frame_data1 =
         &dec_handle_ptr->master_frame_buf.cur_frame_bufs[0].dec_mt_frame_data;
     volatile EbBool *start_cdef_frame = &dec_mt_frame_data1->start_cdef_frame;
@@ -941,6 +1516,45 @@ void svt_cdef_frame_mt(EbDecHandle *dec_handle_ptr, DecThreadCtxt *thread_ctxt)
 #if MT_WAIT_PROFILE
     dec_display_timer("SCF", &timer, th_cnt, fp);
 #endif
+#if DEC_FUSED_POST_FILTER
+    DecMtFrameData *dec_mt_frame_data =
+        &dec_handle_ptr->master_frame_buf.cur_frame_bufs[0].dec_mt_frame_data;
+    DecCdefRowCtxt cdef_row_ctxt;
+    dec_cdef_row_ctxt_init(dec_handle_ptr, &cdef_row_ctxt);
+    EbBool  do_upscale = cdef_row_ctxt.do_upscale;
+    int32_t sb_row;
+
+    /* Rows left over by the fused chain of the LF stage */
+    while (1) {
+#if MT_WAIT_PROFILE
+        dec_timer_start(&timer);
+#endif
+        sb_row = get_sb_row_to_process(&dec_mt_frame_data->cdef_sb_row_info);
+#if MT_WAIT_PROFILE
+        dec_display_timer("GFCF", &timer, th_cnt, fp);
+#endif
+        if (-1 == sb_row) break;
+
+        /* Ensure all LF jobs are over for row_index (row / row+1) */
+        int32_t offset = sb_row == dec_mt_frame_data->sb_rows - 1 ? 0 : 1;
+#if MT_WAIT_PROFILE
+        dec_timer_start(&timer);
+#endif
+        volatile int32_t *start_cdef =
+            (volatile int32_t *)&dec_mt_frame_data->lf_row_map[sb_row + offset];
+#if DEC_PARKED_WORKERS
+        dec_mt_wait_progress(dec_mt_frame_data, start_cdef, 1, NULL);
+#else
+        while (!*start_cdef)
+            ;
+#endif
+#if MT_WAIT_PROFILE
+        dec_display_timer("CWLF", &timer, th_cnt, fp);
+#endif
+        dec_cdef_row_mt(dec_handle_ptr, &cdef_row_ctxt, sb_row);
+    }
+    dec_cdef_row_ctxt_free(dec_handle_ptr, &cdef_row_ctxt);
+#else
     EbPictureBufferDesc *recon_picture_ptr = dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf;
     const int32_t        num_planes = av1_num_planes(&dec_handle_ptr->seq_header.color_config);
 
@@ -1019,8 +1633,12 @@ void svt_cdef_frame_mt(EbDecHandle *dec_handle_ptr, DecThreadCtxt *thread_ctxt)
 #endif
             volatile int32_t *start_cdef = (volatile int32_t *)&dec_mt_frame_data
                                                 ->lf_row_map[sb_row + offset];
+#if DEC_PARKED_WORKERS
+            dec_mt_wait_progress(dec_mt_frame_data, start_cdef, 1, NULL);
+#else
             while (!*start_cdef)
                 ;
+#endif
             assert(*start_cdef == 1);
 #if MT_WAIT_PROFILE
             dec_display_timer("CWLF", &timer, th_cnt, fp);
@@ -1061,6 +1679,9 @@ void svt_cdef_frame_mt(EbDecHandle *dec_handle_ptr, DecThreadCtxt *thread_ctxt)
             }
             /* Update CDEF done map */
             dec_mt_frame_data1->cdef_completed_for_row_map[sb_row] = 1;
+#if DEC_PARKED_WORKERS
+            dec_mt_notify_progress(dec_mt_frame_data1);
+#endif
 
         } else
             break;
@@ -1071,14 +1692,25 @@ void svt_cdef_frame_mt(EbDecHandle *dec_handle_ptr, DecThreadCtxt *thread_ctxt)
         }
     } else
         for (int32_t pli = 0; pli < num_planes; pli++) { eb_aom_free(colbuf[pli]); }
+#endif
 
     eb_block_on_mutex(dec_mt_frame_data->temp_mutex);
     dec_mt_frame_data->num_threads_cdefed++;
     eb_release_mutex(dec_mt_frame_data->temp_mutex);
+#if DEC_PARKED_WORKERS
+    dec_mt_notify_progress(dec_mt_frame_data);
+#endif
     if (do_upscale) {
         volatile uint32_t *num_threads_cdefed = &dec_mt_frame_data->num_threads_cdefed;
+#if DEC_PARKED_WORKERS
+        dec_mt_wait_progress(dec_mt_frame_data,
+                             (volatile int32_t *)num_threads_cdefed,
+                             (int32_t)dec_handle_ptr->dec_config.threads,
+                             NULL);
+#else
         while (*num_threads_cdefed != dec_handle_ptr->dec_config.threads)
             ;
+#endif
     }
 }
 
@@ -1169,11 +1801,13 @@ void pad_post_lr(EbPictureBufferDesc *recon_picture_buf, int32_t sb_row, int32_t
 void dec_av1_loop_restoration_filter_frame_mt(
     EbDecHandle *dec_handle, DecThreadCtxt *thread_ctxt)
 {
+#if !DEC_FUSED_POST_FILTER
     uint8_t *    curr_blk_recon_buf[MAX_MB_PLANE];
     int32_t      curr_recon_stride[MAX_MB_PLANE];
 
     Av1PixelRect tile_rect[MAX_MB_PLANE];
     Av1PixelRect *tile_rect_p[MAX_MB_PLANE];
+#endif
 
     DecMtFrameData *dec_mt_frame_data =
         &dec_handle->master_frame_buf.cur_frame_bufs[0].dec_mt_frame_data;
@@ -1182,6 +1816,28 @@ void dec_av1_loop_restoration_filter_frame_mt(
         eb_block_on_semaphore(NULL == thread_ctxt ? dec_handle->thread_semaphore
                                                   : thread_ctxt->thread_semaphore);
 
+#if DEC_FUSED_POST_FILTER
+    DecLrRowCtxt lr_row_ctxt;
+    dec_lr_row_ctxt_init(dec_handle, &lr_row_ctxt, thread_ctxt);
+    int32_t sb_row;
+
+    /* Rows left over by the fused chain of the LF stage */
+    while (1) {
+        sb_row = get_sb_row_to_process(&dec_mt_frame_data->lr_sb_row_info);
+        if (-1 == sb_row) break;
+
+        /* Ensure all CDEF jobs are over for row_index row  */
+        volatile int32_t *start_lr =
+            (volatile int32_t *)&dec_mt_frame_data->cdef_completed_for_row_map[sb_row];
+#if DEC_PARKED_WORKERS
+        dec_mt_wait_progress(dec_mt_frame_data, start_lr, 1, NULL);
+#else
+        while (!*start_lr)
+            ;
+#endif
+        dec_lr_row_mt(dec_handle, &lr_row_ctxt, sb_row);
+    }
+#else
     EbPictureBufferDesc *recon_picture_ptr = dec_handle->cur_pic_buf[0]->ps_pic_buf;
     const int32_t        num_planes        = av1_num_planes(&dec_handle->seq_header.color_config);
 
@@ -1248,8 +1904,12 @@ void dec_av1_loop_restoration_filter_frame_mt(
             volatile int32_t *start_lr =
                 (volatile int32_t *)&dec_mt_frame_data->
                 cdef_completed_for_row_map[sb_row];
+#if DEC_PARKED_WORKERS
+            dec_mt_wait_progress(dec_mt_frame_data, start_lr, 1, NULL);
+#else
             while (!*start_lr)
                 ;
+#endif
 
             LrCtxt * lr_ctxt = (LrCtxt *)dec_handle->pv_lr_ctxt;
 
@@ -1312,6 +1972,7 @@ void dec_av1_loop_restoration_filter_frame_mt(
         } else
             break;
     }
+#endif
 
     eb_block_on_mutex(dec_mt_frame_data->temp_mutex);
     dec_mt_frame_data->num_threads_lred++;
@@ -1326,8 +1987,16 @@ void dec_av1_loop_restoration_filter_frame_mt(
     eb_release_mutex(dec_mt_frame_data->temp_mutex);
 
     volatile uint32_t *num_threads_lred = &dec_mt_frame_data->num_threads_lred;
+#if DEC_PARKED_WORKERS
+    dec_mt_notify_progress(dec_mt_frame_data);
+    dec_mt_wait_progress(dec_mt_frame_data,
+                         (volatile int32_t *)num_threads_lred,
+                         (int32_t)dec_handle->dec_config.threads,
+                         &dec_mt_frame_data->end_flag);
+#else
     while (*num_threads_lred != dec_handle->dec_config.threads &&
             EB_FALSE == dec_mt_frame_data->end_flag);
+#endif
 }
 
 void *dec_all_stage_kernel(void *input_ptr) {
@@ -1337,8 +2006,13 @@ void *dec_all_stage_kernel(void *input_ptr) {
     DecMtFrameData *dec_mt_frame_data =
         &dec_handle_ptr->master_frame_buf.cur_frame_bufs[0].dec_mt_frame_data;
     volatile EbBool *start_thread = (volatile EbBool *)&dec_handle_ptr->start_thread_process;
+#if DEC_PARKED_WORKERS
+    while (*start_thread == EB_FALSE)
+        eb_block_on_semaphore(thread_ctxt->thread_semaphore);
+#else
     while (*start_thread == EB_FALSE)
         ;
+#endif
 
     while (1) {
         /* Motion Field Projection */
@@ -1377,6 +2051,9 @@ void dec_sync_all_threads(EbDecHandle *dec_handle_ptr) {
     /* To make all worker exit except main thread! */
     dec_mt_frame_data->num_threads_cdefed = 1;
     dec_mt_frame_data->num_threads_lred   = 1;
+#if DEC_PARKED_WORKERS
+    dec_mt_notify_progress(dec_mt_frame_data);
+#endif
 
     /* To make all worker exit except main thread! */
     dec_mt_frame_data->num_threads_header          = 1;
@@ -236,11 +236,36 @@ typedef struct DecMTFrameData {
     int32_t sb_cols;
     int32_t sb_rows;
 
+#if DEC_POOLED_MT_REALLOC
+    /* Capacity the MT structures were allocated for */
+    int32_t   alloc_num_tiles;
+    int32_t   alloc_tile_cols;
+    BlockSize alloc_sb_size;
+    uint32_t  alloc_max_frame_width;
+    uint32_t  alloc_max_frame_height;
+#endif
+#if DEC_PARKED_WORKERS
+    /* Threads waiting on a row / thread count progress park here;
+       every progress writer broadcasts it when there are waiters */
+    EbHandle         progress_cond;
+    volatile int32_t num_progress_waiters;
+    /* Adaptive spin budget before parking on progress_cond */
+    volatile int32_t progress_spin_count;
+#endif
 #if MT_WAIT_PROFILE
     FILE            *fp;
 #endif
 } DecMtFrameData;
 
+#if DEC_PARKED_WORKERS
+/* Waits until *progress >= target, or *abort_flag (if given) is set.
+   Spins for a short adaptive while and then parks on progress_cond */
+void dec_mt_wait_progress(DecMtFrameData *dec_mt_frame_data, volatile int32_t *progress,
+                          int32_t target, volatile EbBool *abort_flag);
+/* To be called after every progress update a thread may be waiting on */
+void dec_mt_notify_progress(DecMtFrameData *dec_mt_frame_data);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -19,6 +19,7 @@
 #include "EbDecProcessFrame.h"
 #include "EbDecProcessBlock.h"
 #include "EbDecNbr.h"
+#include "EbDecRoi.h"
 #include "EbUtility.h"
 
 /* decode partition */
@@ -114,18 +115,36 @@ EbErrorType decode_tile_row(DecModCtxt *dec_mod_ctxt, TilesInfo *tile_info,
         dec_mod_ctxt->cur_coeff[AOM_PLANE_V] = sb_info->sb_coeff[AOM_PLANE_V];
         /* Top-Right Sync*/
         if (sb_row_in_tile) {
+#if DEC_PARKED_WORKERS
+            dec_mt_wait_progress(&frame_buf->dec_mt_frame_data,
+                                 sb_completed_in_prev_row,
+                                 MIN((sb_col + 2), tile_wd_in_sb),
+                                 NULL);
+#else
             while (*sb_completed_in_prev_row < MIN((sb_col + 2), tile_wd_in_sb))
                 ;
             //Sleep(5); /* ToDo : Change */
+#endif
         }
 
+#if DEC_ROI_DECODE
+        if (dec_roi_mi_in(&dec_handle_ptr->roi_info, mi_row, mi_col))
+            decode_super_block(dec_mod_ctxt, mi_row, mi_col, sb_info);
+#else
         decode_super_block(dec_mod_ctxt, mi_row, mi_col, sb_info);
+#endif
         *sb_completed_in_row = (uint32_t)(sb_col + 1);
+#if DEC_PARKED_WORKERS
+        dec_mt_notify_progress(&frame_buf->dec_mt_frame_data);
+#endif
     }
 
     DecMtFrameData *mt_frame_data = &frame_buf->dec_mt_frame_data;
     int             index         = mi_row / dec_mod_ctxt->seq_header->sb_mi_size;
     mt_frame_data->sb_recon_row_map[(index * tile_info->tile_cols) + tile_col] = 1;
+#if DEC_PARKED_WORKERS
+    dec_mt_notify_progress(mt_frame_data);
+#endif
     return status;
 }
 EbErrorType decode_tile(DecModCtxt *dec_mod_ctxt, TilesInfo *tile_info,
@@ -158,8 +177,17 @@ EbErrorType decode_tile(DecModCtxt *dec_mod_ctxt, TilesInfo *tile_info,
         if (-1 != sb_row_in_tile) {
             volatile int32_t *sb_row_parsed = (volatile int32_t *)&parse_recon_tile_info_array
                                                   ->sb_recon_row_parsed[sb_row_in_tile];
+#if DEC_PARKED_WORKERS
+            EbDecHandle *dec_handle_ptr = (EbDecHandle *)dec_mod_ctxt->dec_handle_ptr;
+            dec_mt_wait_progress(
+                &dec_handle_ptr->master_frame_buf.cur_frame_bufs[0].dec_mt_frame_data,
+                sb_row_parsed,
+                1,
+                NULL);
+#else
             while (0 == *sb_row_parsed)
                 ;
+#endif
 
             sb_row = sb_row_in_tile + sb_row_tile_start;
 
@@ -21,6 +21,7 @@
 #include "EbDecInverseQuantize.h"
 #include "EbDecProcessFrame.h"
 #include "EbDecRestoration.h"
+#include "EbDecRoi.h"
 #include "EbPictureOperators.h"
 #include "EbRestoration.h"
 #include "common_dsp_rtcd.h"
@@ -314,17 +315,35 @@ void dec_av1_loop_restoration_filter_row(EbDecHandle *dec_handle, int32_t sb_row
             if (sb_row) {
                 if (col_y >= tile_w_y - w_y)
                     nsync = 0;
+#if DEC_PARKED_WORKERS
+                dec_mt_wait_progress(
+                    &dec_handle->master_frame_buf.cur_frame_bufs[0].dec_mt_frame_data,
+                    sb_lr_completed_in_prev_row,
+                    sb_col_y + nsync,
+                    NULL);
+#else
                 while (*sb_lr_completed_in_prev_row < (sb_col_y + nsync));
+#endif
             }
         }
         int sx = 0, sy = 0;
         uint8_t* src = NULL;
         uint32_t src_stride = 0;
+#if DEC_ROI_DECODE
+        /* Units outside the region of interest are not restored */
+        int32_t roi_in = dec_roi_mi_in(&dec_handle->roi_info,
+            (sb_row << dec_handle->seq_header.sb_size_log2) >> MI_SIZE_LOG2,
+            col_y >> MI_SIZE_LOG2);
+#endif
 
         for(int32_t plane = 0; plane < num_planes; plane++) {
 
             LrParams *lr_params = &dec_handle->frame_header.lr_params[plane];
+#if DEC_ROI_DECODE
+            if (lr_params->frame_restoration_type == RESTORE_NONE || !roi_in)
+#else
             if (lr_params->frame_restoration_type == RESTORE_NONE)
+#endif
                 continue;
 
             uint16_t lr_size = lr_params->loop_restoration_size;
@@ -446,6 +465,10 @@ void dec_av1_loop_restoration_filter_row(EbDecHandle *dec_handle, int32_t sb_row
 
         if (is_mt) {
             *sb_lr_completed_in_row = sb_col_y;
+#if DEC_PARKED_WORKERS
+            dec_mt_notify_progress(
+                &dec_handle->master_frame_buf.cur_frame_bufs[0].dec_mt_frame_data);
+#endif
         }
     }
 }
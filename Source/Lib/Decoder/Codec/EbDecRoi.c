@@ -0,0 +1,128 @@
+/*
+* Copyright(c) 2019 Netflix, Inc.
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+// SUMMARY
+//   Contains the region of interest decoding functions
+
+#include "EbDefinitions.h"
+#include "EbSvtAv1Dec.h"
+#include "EbDecHandle.h"
+#include "EbDecRoi.h"
+
+#if DEC_ROI_DECODE
+#ifdef _WIN32
+#include <windows.h>
+#define DEC_ROI_FLAG_SET(flag) InterlockedExchange((volatile LONG *)(flag), 1)
+#define DEC_ROI_FLAG_GET(flag) InterlockedCompareExchange((volatile LONG *)(flag), 0, 0)
+#define DEC_ROI_FLAG_CLEAR(flag) InterlockedExchange((volatile LONG *)(flag), 0)
+#else
+#define DEC_ROI_FLAG_SET(flag) __atomic_store_n((flag), 1, __ATOMIC_RELEASE)
+#define DEC_ROI_FLAG_GET(flag) __atomic_load_n((flag), __ATOMIC_ACQUIRE)
+#define DEC_ROI_FLAG_CLEAR(flag) __atomic_store_n((flag), 0, __ATOMIC_RELEASE)
+#endif
+
+/* Samples inside the region edges that the post filters compute from samples
+   outside of it: deblocking modifies up to 6, CDEF derives the direction of the
+   whole 8x8 block and loop restoration reads 3 more */
+#define DEC_ROI_BORDER 16
+
+void dec_roi_setup_frame(EbDecHandle *dec_handle_ptr) {
+    const EbSvtAv1DecRoi *roi          = &dec_handle_ptr->roi;
+    FrameHeader *         frame_header = &dec_handle_ptr->frame_header;
+    TilesInfo *           tiles_info   = &frame_header->tiles_info;
+    DecRoiInfo *          roi_info     = &dec_handle_ptr->roi_info;
+    EbDecPicBuf *         cur_pic_buf  = dec_handle_ptr->cur_pic_buf[0];
+    DecRoiRect *          valid        = &cur_pic_buf->roi_valid;
+
+    roi_info->enable = EB_FALSE;
+    DEC_ROI_FLAG_CLEAR(&cur_pic_buf->roi_ref_missing);
+    valid->x0 = INT32_MIN;
+    valid->y0 = INT32_MIN;
+    valid->x1 = INT32_MAX;
+    valid->y1 = INT32_MAX;
+
+    /* Upscaling and loop restoration work on the upscaled frame */
+    if (roi->width == 0 || roi->height == 0 ||
+        frame_header->frame_size.superres_denominator != SCALE_NUMERATOR)
+        return;
+
+    /* Reference frames also cover the motion of the following frames */
+    const int64_t margin = frame_header->refresh_frame_flags ? roi->ref_margin : 0;
+    const int64_t x0     = AOMMAX((int64_t)roi->x - margin, 0);
+    const int64_t y0     = AOMMAX((int64_t)roi->y - margin, 0);
+    const int64_t x1     = (int64_t)roi->x + roi->width + margin;
+    const int64_t y1     = (int64_t)roi->y + roi->height + margin;
+
+    const int32_t mi_col0 = (int32_t)AOMMIN(x0 >> MI_SIZE_LOG2, frame_header->mi_cols - 1);
+    const int32_t mi_row0 = (int32_t)AOMMIN(y0 >> MI_SIZE_LOG2, frame_header->mi_rows - 1);
+    const int32_t mi_col1 = (int32_t)AOMMIN((x1 + MI_SIZE - 1) >> MI_SIZE_LOG2, INT32_MAX);
+    const int32_t mi_row1 = (int32_t)AOMMIN((y1 + MI_SIZE - 1) >> MI_SIZE_LOG2, INT32_MAX);
+
+    int32_t tile_col0 = 0, tile_row0 = 0;
+    while (tiles_info->tile_col_start_mi[tile_col0 + 1] <= mi_col0) tile_col0++;
+    while (tiles_info->tile_row_start_mi[tile_row0 + 1] <= mi_row0) tile_row0++;
+    int32_t tile_col1 = tile_col0 + 1, tile_row1 = tile_row0 + 1;
+    while (tile_col1 < tiles_info->tile_cols && tiles_info->tile_col_start_mi[tile_col1] < mi_col1)
+        tile_col1++;
+    while (tile_row1 < tiles_info->tile_rows && tiles_info->tile_row_start_mi[tile_row1] < mi_row1)
+        tile_row1++;
+
+    if (tile_col0 == 0 && tile_row0 == 0 && tile_col1 == tiles_info->tile_cols &&
+        tile_row1 == tiles_info->tile_rows)
+        return;
+
+    roi_info->enable       = EB_TRUE;
+    roi_info->mi_col_start = tiles_info->tile_col_start_mi[tile_col0];
+    roi_info->mi_col_end   = tiles_info->tile_col_start_mi[tile_col1];
+    roi_info->mi_row_start = tiles_info->tile_row_start_mi[tile_row0];
+    roi_info->mi_row_end   = tiles_info->tile_row_start_mi[tile_row1];
+
+    if (tile_col0) valid->x0 = (roi_info->mi_col_start << MI_SIZE_LOG2) + DEC_ROI_BORDER;
+    if (tile_row0) valid->y0 = (roi_info->mi_row_start << MI_SIZE_LOG2) + DEC_ROI_BORDER;
+    if (tile_col1 < tiles_info->tile_cols)
+        valid->x1 = (roi_info->mi_col_end << MI_SIZE_LOG2) - DEC_ROI_BORDER;
+    if (tile_row1 < tiles_info->tile_rows)
+        valid->y1 = (roi_info->mi_row_end << MI_SIZE_LOG2) - DEC_ROI_BORDER;
+}
+
+int32_t dec_roi_ref_missing(const EbDecPicBuf *pic_buf) {
+    return DEC_ROI_FLAG_GET((volatile int32_t *)&pic_buf->roi_ref_missing);
+}
+
+void dec_roi_check_ref(EbDecPicBuf *cur_buf, const EbDecPicBuf *ref_buf, int32_t x, int32_t y,
+                       int32_t bw, int32_t bh, MV mv, int32_t ss_x, int32_t ss_y,
+                       int32_t whole_ref) {
+    const DecRoiRect *cur_valid = &cur_buf->roi_valid;
+    const DecRoiRect *valid     = &ref_buf->roi_valid;
+
+    /* Blocks outside the reported area may differ from a full decode anyway */
+    if (x + bw <= cur_valid->x0 || x >= cur_valid->x1 || y + bh <= cur_valid->y0 ||
+        y >= cur_valid->y1)
+        return;
+    if (DEC_ROI_FLAG_GET(&cur_buf->roi_ref_missing)) return;
+    if (dec_roi_ref_missing(ref_buf)) {
+        DEC_ROI_FLAG_SET(&cur_buf->roi_ref_missing);
+        return;
+    }
+    if (dec_roi_rect_is_full(valid)) return;
+    if (whole_ref) {
+        DEC_ROI_FLAG_SET(&cur_buf->roi_ref_missing);
+        return;
+    }
+    /* mv is in 1/8 luma samples, the 8-tap interpolation of a fractional
+       position reads 3 samples before and 4 after the block while full sample
+       positions are copied. A full sample luma position is fractional in
+       subsampled chroma, whose taps span twice as many luma samples. */
+    const int32_t before_x = (mv.col & ((8 << ss_x) - 1)) ? 3 << ss_x : 0;
+    const int32_t after_x  = (mv.col & ((8 << ss_x) - 1)) ? 4 << ss_x : 0;
+    const int32_t before_y = (mv.row & ((8 << ss_y) - 1)) ? 3 << ss_y : 0;
+    const int32_t after_y  = (mv.row & ((8 << ss_y) - 1)) ? 4 << ss_y : 0;
+    x += mv.col >> 3;
+    y += mv.row >> 3;
+    if (x - before_x < valid->x0 || x + bw + after_x > valid->x1 || y - before_y < valid->y0 ||
+        y + bh + after_y > valid->y1)
+        DEC_ROI_FLAG_SET(&cur_buf->roi_ref_missing);
+}
+#endif
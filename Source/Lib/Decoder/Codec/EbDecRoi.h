@@ -0,0 +1,47 @@
+/*
+* Copyright(c) 2019 Netflix, Inc.
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef EbDecRoi_h
+#define EbDecRoi_h
+
+#include "EbDecHandle.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if DEC_ROI_DECODE
+/* Selects the tiles of the current frame covering dec_handle_ptr->roi */
+void dec_roi_setup_frame(EbDecHandle *dec_handle_ptr);
+
+/* Returns 1 when the block at (mi_row, mi_col) is reconstructed */
+static INLINE int32_t dec_roi_mi_in(const DecRoiInfo *roi_info, int32_t mi_row, int32_t mi_col) {
+    return !roi_info->enable ||
+           (mi_row >= roi_info->mi_row_start && mi_row < roi_info->mi_row_end &&
+            mi_col >= roi_info->mi_col_start && mi_col < roi_info->mi_col_end);
+}
+
+static INLINE int32_t dec_roi_rect_is_full(const DecRoiRect *rect) {
+    return rect->x0 == INT32_MIN && rect->y0 == INT32_MIN && rect->x1 == INT32_MAX &&
+           rect->y1 == INT32_MAX;
+}
+
+/* Flags cur_buf when the luma block at (x, y) of the current frame predicted
+   with mv reads samples of ref_buf that do not match a full decode, for luma
+   and the chroma planes subsampled by (ss_x, ss_y). whole_ref is set for warped
+   and scaled prediction, whose source area is not tracked. Called concurrently
+   by the reconstruction threads. */
+void dec_roi_check_ref(EbDecPicBuf *cur_buf, const EbDecPicBuf *ref_buf, int32_t x, int32_t y,
+                       int32_t bw, int32_t bh, MV mv, int32_t ss_x, int32_t ss_y,
+                       int32_t whole_ref);
+
+/* Returns the roi_ref_missing flag of pic_buf */
+int32_t dec_roi_ref_missing(const EbDecPicBuf *pic_buf);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbDecRoi_h
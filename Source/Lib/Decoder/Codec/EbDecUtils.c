@@ -25,7 +25,7 @@ EbErrorType check_add_tplmv_buf(EbDecHandle *dec_handle_ptr) {
                       (dec_handle_ptr->master_frame_buf.tpl_mvs_size < tpl_size);
 
     if (realloc) {
-        /*TODO: Add free now itself */
+        /* The smaller buffer stays in the memory map and is freed at deinit */
         EB_MALLOC_DEC(TemporalMvRef *,
                       dec_handle_ptr->master_frame_buf.tpl_mvs,
                       tpl_size * sizeof(*dec_handle_ptr->master_frame_buf.tpl_mvs),
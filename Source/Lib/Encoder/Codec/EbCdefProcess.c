@@ -83,6 +83,115 @@ EbErrorType cdef_context_ctor(EbThreadContext *  thread_context_ptr,
     return EB_ErrorNone;
 }
 
+#if CDEF_REF_SEEDED_SEARCH
+#define CDEF_SEED_MAX_RING 3 // widest (pri, sec) neighbourhood searched around the seed
+#define CDEF_SEED_FLAT_SHIFT 6 // stop once a ring improves the best distortion by less than 1/64
+#define CDEF_SEED_SPARSE_SHIFT 4 // SBs with fewer than 1/4 of their 8x8 blocks coded only test the seed
+
+/* Strength search state of one SB / plane. Without a seed it enumerates [start_gi, end_gi) once;
+ * with a seed it enumerates {0, seed} and then the Chebyshev rings around the seed in the
+ * (primary, secondary) strength grid, until a ring stops paying off. */
+typedef struct CdefSeedSearch {
+    int32_t  seed_gi;
+    int32_t  start_gi;
+    int32_t  end_gi;
+    int32_t  ring;
+    int32_t  max_ring;
+    EbBool   replay;
+    uint64_t best_mse;
+    uint64_t prev_best_mse;
+    uint8_t  evaluated[TOTAL_STRENGTHS];
+} CdefSeedSearch;
+
+static void cdef_seed_search_init(CdefSeedSearch *s, int32_t seed_gi, int32_t max_ring,
+                                  int32_t start_gi, int32_t end_gi) {
+    s->seed_gi       = seed_gi;
+    s->start_gi      = start_gi;
+    s->end_gi        = end_gi;
+    s->ring          = 0;
+    s->max_ring      = max_ring;
+    s->replay        = EB_FALSE;
+    s->best_mse      = UINT64_MAX;
+    s->prev_best_mse = UINT64_MAX;
+    memset(s->evaluated, 0, sizeof(s->evaluated));
+}
+
+/* Re-run the strengths already evaluated (the Cr plane reuses the Cb candidate set). */
+static void cdef_seed_search_replay(CdefSeedSearch *s) {
+    s->ring   = 0;
+    s->replay = EB_TRUE;
+}
+
+static int32_t cdef_seed_search_next(CdefSeedSearch *s, int32_t *gi_list) {
+    int32_t count = 0;
+    if (s->replay || s->seed_gi < 0) {
+        if (s->ring++) return 0;
+        for (int32_t gi = s->start_gi; gi < s->end_gi; gi++)
+            if (!s->replay || s->evaluated[gi]) gi_list[count++] = gi;
+        return count;
+    }
+    if (s->ring == 0) {
+        s->ring = 1;
+        gi_list[count++] = 0;
+        if (s->seed_gi) gi_list[count++] = s->seed_gi;
+        return count;
+    }
+    // The first ring is always searched; past it, stop when the previous ring was flat
+    if (s->ring > 1 &&
+        s->prev_best_mse - s->best_mse <= (s->prev_best_mse >> CDEF_SEED_FLAT_SHIFT))
+        return 0;
+    const int32_t pri0 = s->seed_gi / CDEF_SEC_STRENGTHS;
+    const int32_t sec0 = s->seed_gi % CDEF_SEC_STRENGTHS;
+    while (!count && s->ring <= s->max_ring) {
+        const int32_t r = s->ring++;
+        for (int32_t pri = AOMMAX(0, pri0 - r); pri <= AOMMIN(CDEF_PRI_STRENGTHS - 1, pri0 + r);
+             pri++) {
+            for (int32_t sec = AOMMAX(0, sec0 - r);
+                 sec <= AOMMIN(CDEF_SEC_STRENGTHS - 1, sec0 + r);
+                 sec++) {
+                const int32_t gi = pri * CDEF_SEC_STRENGTHS + sec;
+                if (AOMMAX(abs(pri - pri0), abs(sec - sec0)) == r && !s->evaluated[gi])
+                    gi_list[count++] = gi;
+            }
+        }
+    }
+    s->prev_best_mse = s->best_mse;
+    return count;
+}
+
+static INLINE void cdef_seed_search_update(CdefSeedSearch *s, int32_t gi, uint64_t mse) {
+    s->evaluated[gi] = 1;
+    s->best_mse      = AOMMIN(s->best_mse, mse);
+}
+
+/* Strengths that were not evaluated get the worst measured distortion of the SB, so the frame
+ * level strength selection never prefers them over a measured one. */
+static void cdef_seed_search_fill(const CdefSeedSearch *s, uint64_t *mse) {
+    uint64_t worst_mse = 0;
+    for (int32_t gi = 0; gi < TOTAL_STRENGTHS; gi++)
+        if (s->evaluated[gi]) worst_mse = AOMMAX(worst_mse, mse[gi]);
+    for (int32_t gi = 0; gi < TOTAL_STRENGTHS; gi++)
+        if (!s->evaluated[gi]) mse[gi] = worst_mse;
+}
+
+/* Reference whose per-SB strengths seed the search, NULL for a full search. */
+static const EbReferenceObject *cdef_seed_reference(PictureControlSet *pcs_ptr, int32_t nvfb,
+                                                    int32_t nhfb) {
+    if (!pcs_ptr->parent_pcs_ptr->cdef_ref_seeded_search || pcs_ptr->slice_type == I_SLICE ||
+        (uint32_t)(nvfb * nhfb) > MAX_NUMBER_OF_TREEBLOCKS_PER_PICTURE)
+        return NULL;
+    const EbReferenceObject *ref_obj =
+        (const EbReferenceObject *)pcs_ptr->ref_pic_ptr_array[REF_LIST_0][0]->object_ptr;
+    return ref_obj->cdef_sb_strength_valid ? ref_obj : NULL;
+}
+
+/* Seed of one plane of the SB at fb_idx, -1 when the co-located SB was not filtered. */
+static INLINE int32_t cdef_seed_gi(const EbReferenceObject *seed_ref, int32_t pli,
+                                   int32_t fb_idx) {
+    return seed_ref ? seed_ref->cdef_sb_strength[pli != 0][fb_idx] : -1;
+}
+#endif
+
 void cdef_seg_search(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr,
                      uint32_t segment_index) {
     struct PictureParentControlSet *ppcs    = pcs_ptr->parent_pcs_ptr;
@@ -170,6 +279,12 @@ void cdef_seg_search(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr,
     }
 
     in = inbuf + CDEF_VBORDER * CDEF_BSTRIDE + CDEF_HBORDER;
+#if CDEF_REF_SEEDED_SEARCH
+    const EbReferenceObject *seed_ref = cdef_seed_reference(pcs_ptr, nvfb, nhfb);
+    CdefSeedSearch           seed_search;
+    int32_t                  gi_list[TOTAL_STRENGTHS];
+    int32_t                  gi_count;
+#endif
 
     for (fbr = y_b64_start_idx; fbr < y_b64_end_idx; ++fbr) {
         for (fbc = x_b64_start_idx; fbc < x_b64_end_idx; ++fbc) {
@@ -208,6 +323,11 @@ void cdef_seg_search(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr,
 
             cdef_count = eb_sb_compute_cdef_list(
                 pcs_ptr, cm, fbr * MI_SIZE_64X64, fbc * MI_SIZE_64X64, dlist, bs);
+#if CDEF_REF_SEEDED_SEARCH
+            // Mostly skipped SBs only compare the seed against no filtering
+            const int32_t max_ring =
+                (cdef_count << CDEF_SEED_SPARSE_SHIFT) < nvb * nhb ? 0 : CDEF_SEED_MAX_RING;
+#endif
 
             for (pli = 0; pli < num_planes; pli++) {
                 for (int i = 0; i < CDEF_INBUF_SIZE; i++) inbuf[i] = CDEF_VERY_LARGE;
@@ -236,7 +356,21 @@ void cdef_seg_search(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr,
                              ? AOMMIN(total_strengths, mid_gi + gi_step)
                              : ppcs->cdef_filter_mode == 1 ? 8 : total_strengths;
 
+#if CDEF_REF_SEEDED_SEARCH
+                if (pli == 2)
+                    cdef_seed_search_replay(&seed_search);
+                else
+                    cdef_seed_search_init(&seed_search,
+                                          cdef_seed_gi(seed_ref, pli, fbr * nhfb + fbc),
+                                          max_ring,
+                                          start_gi,
+                                          end_gi);
+                while ((gi_count = cdef_seed_search_next(&seed_search, gi_list)) > 0) {
+                for (int32_t k = 0; k < gi_count; k++) {
+                    gi = gi_list[k];
+#else
                 for (gi = start_gi; gi < end_gi; gi++) {
+#endif
                     int32_t  threshold;
                     uint64_t curr_mse;
                     int32_t  sec_strength;
@@ -280,7 +414,16 @@ void cdef_seg_search(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr,
                         pcs_ptr->mse_seg[pli][fbr * nhfb + fbc][gi] = curr_mse;
                     else
                         pcs_ptr->mse_seg[1][fbr * nhfb + fbc][gi] += curr_mse;
+#if CDEF_REF_SEEDED_SEARCH
+                    cdef_seed_search_update(&seed_search, gi, curr_mse);
+#endif
                 }
+#if CDEF_REF_SEEDED_SEARCH
+                }
+                if (seed_search.seed_gi >= 0 && pli != 1)
+                    cdef_seed_search_fill(&seed_search,
+                                          pcs_ptr->mse_seg[pli != 0][fbr * nhfb + fbc]);
+#endif
 
                 //if (ppcs->picture_number == 15)
                 //    SVT_LOG(" bs:%i count:%i  mse:%I64i\n", bs, cdef_count,pcs_ptr->mse_seg[0][fbr*nhfb + fbc][4]);
@@ -373,6 +516,12 @@ void cdef_seg_search16bit(PictureControlSet *pcs_ptr, SequenceControlSet *scs_pt
     }
 
     in = inbuf + CDEF_VBORDER * CDEF_BSTRIDE + CDEF_HBORDER;
+#if CDEF_REF_SEEDED_SEARCH
+    const EbReferenceObject *seed_ref = cdef_seed_reference(pcs_ptr, nvfb, nhfb);
+    CdefSeedSearch           seed_search;
+    int32_t                  gi_list[TOTAL_STRENGTHS];
+    int32_t                  gi_count;
+#endif
 
     for (fbr = y_b64_start_idx; fbr < y_b64_end_idx; ++fbr) {
         for (fbc = x_b64_start_idx; fbc < x_b64_end_idx; ++fbc) {
@@ -410,6 +559,11 @@ void cdef_seg_search16bit(PictureControlSet *pcs_ptr, SequenceControlSet *scs_pt
 
             cdef_count = eb_sb_compute_cdef_list(
                 pcs_ptr, cm, fbr * MI_SIZE_64X64, fbc * MI_SIZE_64X64, dlist, bs);
+#if CDEF_REF_SEEDED_SEARCH
+            // Mostly skipped SBs only compare the seed against no filtering
+            const int32_t max_ring =
+                (cdef_count << CDEF_SEED_SPARSE_SHIFT) < nvb * nhb ? 0 : CDEF_SEED_MAX_RING;
+#endif
 
             for (pli = 0; pli < num_planes; pli++) {
                 for (int i = 0; i < CDEF_INBUF_SIZE; i++) inbuf[i] = CDEF_VERY_LARGE;
@@ -438,7 +592,21 @@ void cdef_seg_search16bit(PictureControlSet *pcs_ptr, SequenceControlSet *scs_pt
                              ? AOMMIN(total_strengths, mid_gi + gi_step)
                              : ppcs->cdef_filter_mode == 1 ? 8 : total_strengths;
 
+#if CDEF_REF_SEEDED_SEARCH
+                if (pli == 2)
+                    cdef_seed_search_replay(&seed_search);
+                else
+                    cdef_seed_search_init(&seed_search,
+                                          cdef_seed_gi(seed_ref, pli, fbr * nhfb + fbc),
+                                          max_ring,
+                                          start_gi,
+                                          end_gi);
+                while ((gi_count = cdef_seed_search_next(&seed_search, gi_list)) > 0) {
+                for (int32_t k = 0; k < gi_count; k++) {
+                    gi = gi_list[k];
+#else
                 for (gi = start_gi; gi < end_gi; gi++) {
+#endif
                     int32_t  threshold;
                     uint64_t curr_mse;
                     int32_t  sec_strength;
@@ -482,7 +650,16 @@ void cdef_seg_search16bit(PictureControlSet *pcs_ptr, SequenceControlSet *scs_pt
                         pcs_ptr->mse_seg[pli][fbr * nhfb + fbc][gi] = curr_mse;
                     else
                         pcs_ptr->mse_seg[1][fbr * nhfb + fbc][gi] += curr_mse;
+#if CDEF_REF_SEEDED_SEARCH
+                    cdef_seed_search_update(&seed_search, gi, curr_mse);
+#endif
+                }
+#if CDEF_REF_SEEDED_SEARCH
                 }
+                if (seed_search.seed_gi >= 0 && pli != 1)
+                    cdef_seed_search_fill(&seed_search,
+                                          pcs_ptr->mse_seg[pli != 0][fbr * nhfb + fbc]);
+#endif
             }
         }
     }
@@ -552,6 +729,12 @@ void *cdef_kernel(void *input_ptr) {
                 frm_hdr->cdef_params.cdef_y_strength[0]    = 0;
                 pcs_ptr->parent_pcs_ptr->nb_cdef_strengths = 1;
                 frm_hdr->cdef_params.cdef_uv_strength[0]   = 0;
+#if CDEF_REF_SEEDED_SEARCH
+                if (pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag)
+                    ((EbReferenceObject *)pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr
+                         ->object_ptr)
+                        ->cdef_sb_strength_valid = EB_FALSE;
+#endif
             }
 
             //restoration prep
@@ -315,6 +315,252 @@ static TxSize set_lpf_parameters(Av1DeblockingParameters *const params, const ui
     return ts;
 }
 
+#if DLF_DUAL_EDGE_AVX2
+// Deblocking parameters of the edge at (x, y), in 4x4 units of the SB plane
+static TxSize get_sb_edge_lpf_params(Av1DeblockingParameters *const params,
+                                     const uint64_t mode_step,
+                                     const PictureControlSet *const pcs_ptr,
+                                     const MacroBlockD *const xd, const EdgeDir edge_dir,
+                                     const int32_t plane, const MacroblockdPlane *const plane_ptr,
+                                     const uint32_t mi_row, const uint32_t mi_col, const int32_t x,
+                                     const int32_t y) {
+    const uint32_t curr_x = ((mi_col * MI_SIZE) >> plane_ptr->subsampling_x) + x * MI_SIZE;
+    const uint32_t curr_y = ((mi_row * MI_SIZE) >> plane_ptr->subsampling_y) + y * MI_SIZE;
+    memset(params, 0, sizeof(*params));
+    TxSize tx_size =
+        set_lpf_parameters(params, mode_step, pcs_ptr, xd, edge_dir, curr_x, curr_y, plane, plane_ptr);
+    if (tx_size == TX_INVALID) {
+        params->filter_length = 0;
+        tx_size               = TX_4X4;
+    }
+    assert(tx_size < TX_SIZES_ALL);
+    return tx_size;
+}
+
+static void lpf_filter_edge(const Av1DeblockingParameters *const params, const EdgeDir edge_dir,
+                            uint8_t *p, const int32_t dst_stride, const EbBool is_16bit,
+                            const int32_t bd) {
+    const uint8_t *mblim = params->mblim;
+    const uint8_t *lim   = params->lim;
+    const uint8_t *thr   = params->hev_thr;
+    if (edge_dir == VERT_EDGE) {
+        switch (params->filter_length) {
+        case 4:
+            if (is_16bit)
+                aom_highbd_lpf_vertical_4((uint16_t *)p, dst_stride, mblim, lim, thr, bd);
+            else
+                aom_lpf_vertical_4(p, dst_stride, mblim, lim, thr);
+            break;
+        case 6:
+            if (is_16bit)
+                aom_highbd_lpf_vertical_6((uint16_t *)p, dst_stride, mblim, lim, thr, bd);
+            else
+                aom_lpf_vertical_6(p, dst_stride, mblim, lim, thr);
+            break;
+        case 8:
+            if (is_16bit)
+                aom_highbd_lpf_vertical_8((uint16_t *)p, dst_stride, mblim, lim, thr, bd);
+            else
+                aom_lpf_vertical_8(p, dst_stride, mblim, lim, thr);
+            break;
+        case 14:
+            if (is_16bit)
+                aom_highbd_lpf_vertical_14((uint16_t *)p, dst_stride, mblim, lim, thr, bd);
+            else
+                aom_lpf_vertical_14(p, dst_stride, mblim, lim, thr);
+            break;
+        default: break;
+        }
+    } else {
+        switch (params->filter_length) {
+        case 4:
+            if (is_16bit)
+                aom_highbd_lpf_horizontal_4((uint16_t *)p, dst_stride, mblim, lim, thr, bd);
+            else
+                aom_lpf_horizontal_4(p, dst_stride, mblim, lim, thr);
+            break;
+        case 6:
+            if (is_16bit)
+                aom_highbd_lpf_horizontal_6((uint16_t *)p, dst_stride, mblim, lim, thr, bd);
+            else
+                aom_lpf_horizontal_6(p, dst_stride, mblim, lim, thr);
+            break;
+        case 8:
+            if (is_16bit)
+                aom_highbd_lpf_horizontal_8((uint16_t *)p, dst_stride, mblim, lim, thr, bd);
+            else
+                aom_lpf_horizontal_8(p, dst_stride, mblim, lim, thr);
+            break;
+        case 14:
+            if (is_16bit)
+                aom_highbd_lpf_horizontal_14((uint16_t *)p, dst_stride, mblim, lim, thr, bd);
+            else
+                aom_lpf_horizontal_14(p, dst_stride, mblim, lim, thr);
+            break;
+        default: break;
+        }
+    }
+}
+
+// Filter two adjacent edges of the same length at once: the second edge is 4
+// rows (VERT_EDGE) or 4 columns (HORZ_EDGE) after the first one.
+static void lpf_filter_edge_dual(const Av1DeblockingParameters *const params0,
+                                 const Av1DeblockingParameters *const params1,
+                                 const EdgeDir edge_dir, uint8_t *p, const int32_t dst_stride,
+                                 const EbBool is_16bit, const int32_t bd) {
+    const uint8_t *mblim0 = params0->mblim, *lim0 = params0->lim, *thr0 = params0->hev_thr;
+    const uint8_t *mblim1 = params1->mblim, *lim1 = params1->lim, *thr1 = params1->hev_thr;
+    uint16_t *     p16    = (uint16_t *)p;
+    assert(params0->filter_length == params1->filter_length);
+    switch (params0->filter_length) {
+    case 4:
+        if (edge_dir == VERT_EDGE) {
+            if (is_16bit)
+                aom_highbd_lpf_vertical_4_dual(
+                    p16, dst_stride, mblim0, lim0, thr0, mblim1, lim1, thr1, bd);
+            else
+                aom_lpf_vertical_4_dual(p, dst_stride, mblim0, lim0, thr0, mblim1, lim1, thr1);
+        } else {
+            if (is_16bit)
+                aom_highbd_lpf_horizontal_4_dual(
+                    p16, dst_stride, mblim0, lim0, thr0, mblim1, lim1, thr1, bd);
+            else
+                aom_lpf_horizontal_4_dual(p, dst_stride, mblim0, lim0, thr0, mblim1, lim1, thr1);
+        }
+        break;
+    case 6:
+        if (edge_dir == VERT_EDGE) {
+            if (is_16bit)
+                aom_highbd_lpf_vertical_6_dual(
+                    p16, dst_stride, mblim0, lim0, thr0, mblim1, lim1, thr1, bd);
+            else
+                aom_lpf_vertical_6_dual(p, dst_stride, mblim0, lim0, thr0, mblim1, lim1, thr1);
+        } else {
+            if (is_16bit)
+                aom_highbd_lpf_horizontal_6_dual(
+                    p16, dst_stride, mblim0, lim0, thr0, mblim1, lim1, thr1, bd);
+            else
+                aom_lpf_horizontal_6_dual(p, dst_stride, mblim0, lim0, thr0, mblim1, lim1, thr1);
+        }
+        break;
+    case 8:
+        if (edge_dir == VERT_EDGE) {
+            if (is_16bit)
+                aom_highbd_lpf_vertical_8_dual(
+                    p16, dst_stride, mblim0, lim0, thr0, mblim1, lim1, thr1, bd);
+            else
+                aom_lpf_vertical_8_dual(p, dst_stride, mblim0, lim0, thr0, mblim1, lim1, thr1);
+        } else {
+            if (is_16bit)
+                aom_highbd_lpf_horizontal_8_dual(
+                    p16, dst_stride, mblim0, lim0, thr0, mblim1, lim1, thr1, bd);
+            else
+                aom_lpf_horizontal_8_dual(p, dst_stride, mblim0, lim0, thr0, mblim1, lim1, thr1);
+        }
+        break;
+    case 14:
+        if (edge_dir == VERT_EDGE) {
+            if (is_16bit)
+                aom_highbd_lpf_vertical_14_dual(
+                    p16, dst_stride, mblim0, lim0, thr0, mblim1, lim1, thr1, bd);
+            else
+                aom_lpf_vertical_14_dual(p, dst_stride, mblim0, lim0, thr0, mblim1, lim1, thr1);
+        } else {
+            if (is_16bit)
+                aom_highbd_lpf_horizontal_14_dual(
+                    p16, dst_stride, mblim0, lim0, thr0, mblim1, lim1, thr1, bd);
+            else
+                aom_lpf_horizontal_14_dual(p, dst_stride, mblim0, lim0, thr0, mblim1, lim1, thr1);
+        }
+        break;
+    default: break;
+    }
+}
+
+// Walk the edges of two adjacent 4-sample strips of the SB together (two rows of
+// vertical edges, or two columns of horizontal edges). An edge found at the same
+// position in both strips with the same filter length is filtered by one dual call;
+// all other edges are filtered one by one.
+static void filter_block_plane_edge_pairs(const PictureControlSet *const pcs_ptr,
+                                          const MacroBlockD *const xd, const int32_t plane,
+                                          const MacroblockdPlane *const plane_ptr,
+                                          const uint32_t mi_row, const uint32_t mi_col,
+                                          const EdgeDir edge_dir, const EbBool is_16bit,
+                                          const int32_t bd) {
+    SequenceControlSet *scs_ptr =
+        (SequenceControlSet *)pcs_ptr->parent_pcs_ptr->scs_wrapper_ptr->object_ptr;
+    const uint32_t scale_horz = plane_ptr->subsampling_x;
+    const uint32_t scale_vert = plane_ptr->subsampling_y;
+    uint8_t *const dst_ptr    = plane_ptr->dst.buf;
+    const int32_t  dst_stride = plane_ptr->dst.stride;
+    const int32_t  y_range    = scs_ptr->seq_header.sb_size == BLOCK_128X128
+                                ? (MAX_MIB_SIZE >> scale_vert)
+                                : (SB64_MIB_SIZE >> scale_vert);
+    const int32_t x_range = scs_ptr->seq_header.sb_size == BLOCK_128X128
+                                ? (MAX_MIB_SIZE >> scale_horz)
+                                : (SB64_MIB_SIZE >> scale_horz);
+    const uint64_t mode_step = edge_dir == VERT_EDGE
+                                   ? ((uint64_t)1 << scale_horz)
+                                   : ((uint64_t)pcs_ptr->mi_stride << scale_vert);
+    // strips run across the edges, positions along them
+    const int32_t strip_range = edge_dir == VERT_EDGE ? y_range : x_range;
+    const int32_t pos_range   = edge_dir == VERT_EDGE ? x_range : y_range;
+    const int32_t strip_pitch = edge_dir == VERT_EDGE ? dst_stride * MI_SIZE : MI_SIZE;
+    const int32_t pos_pitch   = edge_dir == VERT_EDGE ? MI_SIZE : dst_stride * MI_SIZE;
+
+    for (int32_t strip = 0; strip < strip_range; strip += 2) {
+        Av1DeblockingParameters params[2];
+        TxSize                  tx_size[2];
+        int32_t                 pos[2] = {0, 0};
+
+        while (pos[0] < pos_range || pos[1] < pos_range) {
+            if (pos[0] == pos[1]) {
+                for (int32_t i = 0; i < 2; i++) {
+                    const int32_t x = edge_dir == VERT_EDGE ? pos[i] : strip + i;
+                    const int32_t y = edge_dir == VERT_EDGE ? strip + i : pos[i];
+                    tx_size[i]      = get_sb_edge_lpf_params(&params[i], mode_step, pcs_ptr, xd,
+                                                        edge_dir, plane, plane_ptr, mi_row,
+                                                        mi_col, x, y);
+                }
+                uint8_t *p =
+                    dst_ptr + ((strip * strip_pitch + pos[0] * pos_pitch) << plane_ptr->is_16bit);
+                if (params[0].filter_length &&
+                    params[0].filter_length == params[1].filter_length)
+                    lpf_filter_edge_dual(
+                        &params[0], &params[1], edge_dir, p, dst_stride, is_16bit, bd);
+                else {
+                    lpf_filter_edge(&params[0], edge_dir, p, dst_stride, is_16bit, bd);
+                    lpf_filter_edge(&params[1],
+                                    edge_dir,
+                                    p + (strip_pitch << plane_ptr->is_16bit),
+                                    dst_stride,
+                                    is_16bit,
+                                    bd);
+                }
+                for (int32_t i = 0; i < 2; i++)
+                    pos[i] += edge_dir == VERT_EDGE ? tx_size_wide_unit[tx_size[i]]
+                                                    : tx_size_high_unit[tx_size[i]];
+            } else {
+                const int32_t i = pos[0] < pos[1] ? 0 : 1;
+                const int32_t x = edge_dir == VERT_EDGE ? pos[i] : strip + i;
+                const int32_t y = edge_dir == VERT_EDGE ? strip + i : pos[i];
+                tx_size[i]      = get_sb_edge_lpf_params(
+                    &params[i], mode_step, pcs_ptr, xd, edge_dir, plane, plane_ptr, mi_row, mi_col, x, y);
+                lpf_filter_edge(
+                    &params[i],
+                    edge_dir,
+                    dst_ptr + (((strip + i) * strip_pitch + pos[i] * pos_pitch) << plane_ptr->is_16bit),
+                    dst_stride,
+                    is_16bit,
+                    bd);
+                pos[i] += edge_dir == VERT_EDGE ? tx_size_wide_unit[tx_size[i]]
+                                                : tx_size_high_unit[tx_size[i]];
+            }
+        }
+    }
+}
+#endif
+
 void eb_av1_filter_block_plane_vert(const PictureControlSet *const pcs_ptr,
                                     const MacroBlockD *const xd, const int32_t plane,
                                     const MacroblockdPlane *const plane_ptr, const uint32_t mi_row,
@@ -327,6 +573,17 @@ void eb_av1_filter_block_plane_vert(const PictureControlSet *const pcs_ptr,
     // 16 bit dblk for loop_filter_mode = 1 needs to enabled after 16bit encdec is done
     if (scs_ptr->static_config.is_16bit_pipeline)
         is_16bit = EB_TRUE;
+#if DLF_DUAL_EDGE_AVX2
+    filter_block_plane_edge_pairs(pcs_ptr,
+                                  xd,
+                                  plane,
+                                  plane_ptr,
+                                  mi_row,
+                                  mi_col,
+                                  VERT_EDGE,
+                                  is_16bit,
+                                  scs_ptr->static_config.encoder_bit_depth);
+#else
     const int32_t  row_step   = MI_SIZE >> MI_SIZE_LOG2;
     const uint32_t scale_horz = plane_ptr->subsampling_x;
     const uint32_t scale_vert = plane_ptr->subsampling_y;
@@ -425,6 +682,7 @@ void eb_av1_filter_block_plane_vert(const PictureControlSet *const pcs_ptr,
             p += ((advance_units * MI_SIZE) << plane_ptr->is_16bit);
         }
     }
+#endif
 }
 
 void eb_av1_filter_block_plane_horz(const PictureControlSet *const pcs_ptr,
@@ -438,6 +696,17 @@ void eb_av1_filter_block_plane_horz(const PictureControlSet *const pcs_ptr,
     // 16 bit dblk for loop_filter_mode = 1 needs to enabled after 16bit encdec is done
     if (scs_ptr->static_config.is_16bit_pipeline)
         is_16bit = EB_TRUE;
+#if DLF_DUAL_EDGE_AVX2
+    filter_block_plane_edge_pairs(pcs_ptr,
+                                  xd,
+                                  plane,
+                                  plane_ptr,
+                                  mi_row,
+                                  mi_col,
+                                  HORZ_EDGE,
+                                  is_16bit,
+                                  scs_ptr->static_config.encoder_bit_depth);
+#else
     const int32_t  col_step   = MI_SIZE >> MI_SIZE_LOG2;
     const uint32_t scale_horz = plane_ptr->subsampling_x;
     const uint32_t scale_vert = plane_ptr->subsampling_y;
@@ -540,6 +809,7 @@ void eb_av1_filter_block_plane_horz(const PictureControlSet *const pcs_ptr,
             p += ((advance_units * dst_stride * MI_SIZE) << plane_ptr->is_16bit);
         }
     }
+#endif
 }
 
 // New function to filter each sb (64x64)
@@ -640,6 +910,31 @@ void loop_filter_sb(EbPictureBufferDesc *frame_buffer, //reconpicture,
     }
 }
 
+#if DLF_CDEF_ROW_PIPELINE
+void eb_av1_loop_filter_sb_rows(EbPictureBufferDesc *frame_buffer, PictureControlSet *pcs_ptr,
+                                int32_t plane_start, int32_t plane_end, uint32_t sb_row_start,
+                                uint32_t sb_row_end) {
+    SequenceControlSet *scs_ptr =
+        (SequenceControlSet *)pcs_ptr->parent_pcs_ptr->scs_wrapper_ptr->object_ptr;
+    uint8_t  sb_size_log2 = (uint8_t)eb_log2f(scs_ptr->sb_size_pix);
+    uint32_t pic_width_in_sb =
+        (pcs_ptr->parent_pcs_ptr->aligned_width + scs_ptr->sb_size_pix - 1) / scs_ptr->sb_size_pix;
+
+    for (uint32_t y_sb_index = sb_row_start; y_sb_index < sb_row_end; ++y_sb_index) {
+        for (uint32_t x_sb_index = 0; x_sb_index < pic_width_in_sb; ++x_sb_index) {
+            loop_filter_sb(frame_buffer,
+                           pcs_ptr,
+                           NULL,
+                           (y_sb_index << sb_size_log2) >> 2,
+                           (x_sb_index << sb_size_log2) >> 2,
+                           plane_start,
+                           plane_end,
+                           x_sb_index == pic_width_in_sb - 1);
+        }
+    }
+}
+
+#endif
 void eb_av1_loop_filter_frame(EbPictureBufferDesc *frame_buffer, PictureControlSet *pcs_ptr,
                               int32_t plane_start, int32_t plane_end) {
     SequenceControlSet *scs_ptr =
@@ -956,6 +1251,131 @@ uint64_t picture_sse_calculations(PictureControlSet *pcs_ptr, EbPictureBufferDes
     }
 }
 
+#if DLF_SUBSAMPLED_SEARCH
+// Returns EB_TRUE if the SB row is one of the rows the subsampled level search filters
+static INLINE EbBool is_lf_search_sb_row(uint32_t sb_row, uint8_t sb_row_step) {
+    return sb_row_step <= 1 || (sb_row % sb_row_step) == (uint32_t)(sb_row_step >> 1);
+}
+
+// Luma rows modified when filtering one SB row: the SB row and the rows above
+// its top edge reached by the horizontal edge filter
+static void get_lf_sb_row_band(PictureControlSet *pcs_ptr, uint32_t sb_row, uint32_t *row_start,
+                               uint32_t *row_end) {
+    const uint32_t sb_size = pcs_ptr->parent_pcs_ptr->scs_ptr->sb_size_pix;
+    const uint32_t height  = pcs_ptr->parent_pcs_ptr->aligned_height;
+    *row_start             = sb_row * sb_size > 8 ? sb_row * sb_size - 8 : 0;
+    *row_end               = AOMMIN((sb_row + 1) * sb_size, height);
+}
+
+static void get_lf_plane(EbPictureBufferDesc *buf, int32_t plane, EbBool is_16bit, uint8_t **ptr,
+                         uint32_t *stride) {
+    switch (plane) {
+    case 0:
+        *stride = buf->stride_y;
+        *ptr    = buf->buffer_y + ((buf->origin_x + buf->origin_y * buf->stride_y) << is_16bit);
+        break;
+    case 1:
+        *stride = buf->stride_cb;
+        *ptr    = buf->buffer_cb +
+               ((buf->origin_x / 2 + buf->origin_y / 2 * buf->stride_cb) << is_16bit);
+        break;
+    default:
+        *stride = buf->stride_cr;
+        *ptr    = buf->buffer_cr +
+               ((buf->origin_x / 2 + buf->origin_y / 2 * buf->stride_cr) << is_16bit);
+        break;
+    }
+}
+
+/******************************************************
+ * Copy the rows of one plane covered by the SB rows of
+ * the subsampled level search
+ ******************************************************/
+static void copy_lf_search_rows(EbPictureBufferDesc *src, EbPictureBufferDesc *dst,
+                                PictureControlSet *pcs_ptr, int32_t plane) {
+    SequenceControlSet *scs_ptr  = pcs_ptr->parent_pcs_ptr->scs_ptr;
+    EbBool              is_16bit = scs_ptr->static_config.is_16bit_pipeline ||
+                      (scs_ptr->static_config.encoder_bit_depth > EB_8BIT);
+    const uint32_t ss       = plane ? 1 : 0;
+    const uint32_t width    = ((uint32_t)(src->width - scs_ptr->pad_right) >> ss) << is_16bit;
+    const uint32_t sb_rows  = (pcs_ptr->parent_pcs_ptr->aligned_height + scs_ptr->sb_size_pix - 1) /
+                             scs_ptr->sb_size_pix;
+    uint8_t *      src_ptr, *dst_ptr;
+    uint32_t       src_stride, dst_stride;
+    get_lf_plane(src, plane, is_16bit, &src_ptr, &src_stride);
+    get_lf_plane(dst, plane, is_16bit, &dst_ptr, &dst_stride);
+    src_stride <<= is_16bit;
+    dst_stride <<= is_16bit;
+
+    for (uint32_t sb_row = 0; sb_row < sb_rows; sb_row++) {
+        if (!is_lf_search_sb_row(sb_row, pcs_ptr->parent_pcs_ptr->dlf_search_sb_row_step))
+            continue;
+        uint32_t row_start, row_end;
+        get_lf_sb_row_band(pcs_ptr, sb_row, &row_start, &row_end);
+        for (uint32_t row = row_start >> ss; row < (row_end >> ss); row++)
+            eb_memcpy(dst_ptr + row * dst_stride, src_ptr + row * src_stride, width);
+    }
+}
+
+/******************************************************
+ * SSE of one plane over the SB rows of the subsampled
+ * level search
+ ******************************************************/
+static uint64_t lf_search_rows_sse(PictureControlSet *pcs_ptr, EbPictureBufferDesc *recon_ptr,
+                                   int32_t plane) {
+    SequenceControlSet * scs_ptr  = pcs_ptr->parent_pcs_ptr->scs_ptr;
+    EbBool               is_16bit = scs_ptr->static_config.is_16bit_pipeline ||
+                      (scs_ptr->static_config.encoder_bit_depth > EB_8BIT);
+    EbPictureBufferDesc *input_picture_ptr =
+        is_16bit ? pcs_ptr->input_frame16bit
+                 : (EbPictureBufferDesc *)pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr;
+    const uint32_t ss      = plane ? 1 : 0;
+    const uint32_t width   = (uint32_t)input_picture_ptr->width >> ss;
+    const uint32_t height  = (uint32_t)input_picture_ptr->height >> ss;
+    const uint32_t sb_rows = (pcs_ptr->parent_pcs_ptr->aligned_height + scs_ptr->sb_size_pix - 1) /
+                             scs_ptr->sb_size_pix;
+    uint8_t *      input_ptr, *recon_buf_ptr;
+    uint32_t       input_stride, recon_stride;
+    uint64_t       sse = 0;
+    get_lf_plane(input_picture_ptr, plane, is_16bit, &input_ptr, &input_stride);
+    get_lf_plane(recon_ptr, plane, is_16bit, &recon_buf_ptr, &recon_stride);
+
+    for (uint32_t sb_row = 0; sb_row < sb_rows; sb_row++) {
+        if (!is_lf_search_sb_row(sb_row, pcs_ptr->parent_pcs_ptr->dlf_search_sb_row_step))
+            continue;
+        uint32_t row_start, row_end;
+        get_lf_sb_row_band(pcs_ptr, sb_row, &row_start, &row_end);
+        row_end = AOMMIN(row_end >> ss, height);
+        for (uint32_t row = row_start >> ss; row < row_end; row++) {
+            if (is_16bit) {
+                const uint16_t *in  = (uint16_t *)input_ptr + row * input_stride;
+                const uint16_t *rec = (uint16_t *)recon_buf_ptr + row * recon_stride;
+                for (uint32_t col = 0; col < width; col++)
+                    sse += (int64_t)SQR((int64_t)in[col] - (int64_t)rec[col]);
+            } else {
+                const uint8_t *in  = input_ptr + row * input_stride;
+                const uint8_t *rec = recon_buf_ptr + row * recon_stride;
+                for (uint32_t col = 0; col < width; col++)
+                    sse += (int64_t)SQR((int64_t)in[col] - (int64_t)rec[col]);
+            }
+        }
+    }
+    return sse;
+}
+
+// Filter the SB rows of the subsampled level search
+static void lf_search_rows_filter(EbPictureBufferDesc *recon_buffer, PictureControlSet *pcs_ptr,
+                                  int32_t plane) {
+    SequenceControlSet *scs_ptr = pcs_ptr->parent_pcs_ptr->scs_ptr;
+    const uint32_t sb_rows = (pcs_ptr->parent_pcs_ptr->aligned_height + scs_ptr->sb_size_pix - 1) /
+                             scs_ptr->sb_size_pix;
+    eb_av1_loop_filter_frame_init(
+        &pcs_ptr->parent_pcs_ptr->frm_hdr, &pcs_ptr->parent_pcs_ptr->lf_info, plane, plane + 1);
+    for (uint32_t sb_row = 0; sb_row < sb_rows; sb_row++)
+        if (is_lf_search_sb_row(sb_row, pcs_ptr->parent_pcs_ptr->dlf_search_sb_row_step))
+            eb_av1_loop_filter_sb_rows(recon_buffer, pcs_ptr, plane, plane + 1, sb_row, sb_row + 1);
+}
+#endif
 static int64_t try_filter_frame(
     //const Yv12BufferConfig *sd,
     //Av1Comp *const cpi,
@@ -963,7 +1383,9 @@ static int64_t try_filter_frame(
     PictureControlSet *pcs_ptr, int32_t filt_level, int32_t partial_frame, int32_t plane,
     int32_t dir) {
     (void)sd;
+#if !DLF_SUBSAMPLED_SEARCH
     (void)partial_frame;
+#endif
     (void)sd;
     int64_t      filt_err;
     FrameHeader *frm_hdr = &pcs_ptr->parent_pcs_ptr->frm_hdr;
@@ -1001,6 +1423,15 @@ static int64_t try_filter_frame(
     case 2: frm_hdr->loop_filter_params.filter_level_v = filter_level[0]; break;
     }
 
+#if DLF_SUBSAMPLED_SEARCH
+    if (partial_frame) {
+        lf_search_rows_filter(recon_buffer, pcs_ptr, plane);
+        filt_err = lf_search_rows_sse(pcs_ptr, recon_buffer, plane);
+        // Re-instate the unfiltered rows
+        copy_lf_search_rows(temp_lf_recon_buffer, recon_buffer, pcs_ptr, plane);
+        return filt_err;
+    }
+#endif
     eb_av1_loop_filter_frame(recon_buffer, pcs_ptr, plane, plane + 1);
 
     filt_err = picture_sse_calculations(pcs_ptr, recon_buffer, plane);
@@ -1063,6 +1494,18 @@ static int32_t search_filter_level(
     // Set each entry to -1
     memset(ss_err, 0xFF, sizeof(ss_err));
     // make a copy of recon_buffer
+#if DLF_SUBSAMPLED_SEARCH
+    if (partial_frame) {
+        // only the searched rows are filtered; the descriptor fields are set by eb_copy_buffer
+        // in the full frame path
+        temp_lf_recon_buffer->origin_x = recon_buffer->origin_x;
+        temp_lf_recon_buffer->origin_y = recon_buffer->origin_y;
+        temp_lf_recon_buffer->stride_y = recon_buffer->stride_y;
+        temp_lf_recon_buffer->stride_cb = recon_buffer->stride_cb;
+        temp_lf_recon_buffer->stride_cr = recon_buffer->stride_cr;
+        copy_lf_search_rows(recon_buffer, temp_lf_recon_buffer, pcs_ptr, plane);
+    } else
+#endif
     eb_copy_buffer(recon_buffer /*cm->frame_to_show*/,
                    temp_lf_recon_buffer /*&cpi->last_frame_uf*/,
                    pcs_ptr,
@@ -57,6 +57,13 @@ void eb_av1_loop_filter_frame(
         PictureControlSet *pcs_ptr,
         /*MacroBlockD *xd,*/ int32_t plane_start, int32_t plane_end/*,
         int32_t partial_frame*/);
+#if DLF_CDEF_ROW_PIPELINE
+// Filter the SB rows [sb_row_start, sb_row_end); the filter levels must have been set up with
+// eb_av1_loop_filter_frame_init(), and the rows above sb_row_start must have been filtered
+void eb_av1_loop_filter_sb_rows(EbPictureBufferDesc *frame_buffer, PictureControlSet *pcs_ptr,
+                                int32_t plane_start, int32_t plane_end, uint32_t sb_row_start,
+                                uint32_t sb_row_end);
+#endif
 
 void eb_av1_pick_filter_level(DlfContext *         context_ptr,
                               EbPictureBufferDesc *srcBuffer, // source input
@@ -90,6 +90,79 @@ EbErrorType dlf_context_ctor(EbThreadContext *thread_context_ptr, const EbEncHan
 /******************************************************
  * Dlf Kernel
  ******************************************************/
+#if DLF_CDEF_ROW_PIPELINE
+/******************************************************
+ * Set the recon and source pointers used by the CDEF search
+ ******************************************************/
+static void set_cdef_input_ptrs(SequenceControlSet *scs_ptr, PictureControlSet *pcs_ptr,
+                                EbPictureBufferDesc *recon_picture_ptr, EbBool is_16bit) {
+    if (scs_ptr->static_config.is_16bit_pipeline || is_16bit) {
+        EbPictureBufferDesc *input_picture_ptr = pcs_ptr->input_frame16bit;
+        pcs_ptr->src[0] = (uint16_t *)recon_picture_ptr->buffer_y +
+                          (recon_picture_ptr->origin_x +
+                           recon_picture_ptr->origin_y * recon_picture_ptr->stride_y);
+        pcs_ptr->src[1] = (uint16_t *)recon_picture_ptr->buffer_cb +
+                          (recon_picture_ptr->origin_x / 2 +
+                           recon_picture_ptr->origin_y / 2 * recon_picture_ptr->stride_cb);
+        pcs_ptr->src[2] = (uint16_t *)recon_picture_ptr->buffer_cr +
+                          (recon_picture_ptr->origin_x / 2 +
+                           recon_picture_ptr->origin_y / 2 * recon_picture_ptr->stride_cr);
+        pcs_ptr->ref_coeff[0] = (uint16_t *)input_picture_ptr->buffer_y +
+                                (input_picture_ptr->origin_x +
+                                 input_picture_ptr->origin_y * input_picture_ptr->stride_y);
+        pcs_ptr->ref_coeff[1] = (uint16_t *)input_picture_ptr->buffer_cb +
+                                (input_picture_ptr->origin_x / 2 +
+                                 input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cb);
+        pcs_ptr->ref_coeff[2] = (uint16_t *)input_picture_ptr->buffer_cr +
+                                (input_picture_ptr->origin_x / 2 +
+                                 input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cr);
+    } else {
+        EbPictureBufferDesc *input_picture_ptr =
+            (EbPictureBufferDesc *)pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr;
+        pcs_ptr->src[0] = (uint16_t *)&(
+            (recon_picture_ptr->buffer_y)[recon_picture_ptr->origin_x +
+                                          recon_picture_ptr->origin_y * recon_picture_ptr->stride_y]);
+        pcs_ptr->src[1] = (uint16_t *)&(
+            (recon_picture_ptr->buffer_cb)[recon_picture_ptr->origin_x / 2 +
+                                           recon_picture_ptr->origin_y / 2 *
+                                               recon_picture_ptr->stride_cb]);
+        pcs_ptr->src[2] = (uint16_t *)&(
+            (recon_picture_ptr->buffer_cr)[recon_picture_ptr->origin_x / 2 +
+                                           recon_picture_ptr->origin_y / 2 *
+                                               recon_picture_ptr->stride_cr]);
+        pcs_ptr->ref_coeff[0] = (uint16_t *)&(
+            (input_picture_ptr->buffer_y)[input_picture_ptr->origin_x +
+                                          input_picture_ptr->origin_y * input_picture_ptr->stride_y]);
+        pcs_ptr->ref_coeff[1] = (uint16_t *)&(
+            (input_picture_ptr->buffer_cb)[input_picture_ptr->origin_x / 2 +
+                                           input_picture_ptr->origin_y / 2 *
+                                               input_picture_ptr->stride_cb]);
+        pcs_ptr->ref_coeff[2] = (uint16_t *)&(
+            (input_picture_ptr->buffer_cr)[input_picture_ptr->origin_x / 2 +
+                                           input_picture_ptr->origin_y / 2 *
+                                               input_picture_ptr->stride_cr]);
+    }
+}
+
+/******************************************************
+ * Post the CDEF search segments of one segment row
+ ******************************************************/
+static void post_cdef_segment_row(DlfContext *context_ptr, PictureControlSet *pcs_ptr,
+                                  EbObjectWrapper *pcs_wrapper_ptr, uint32_t seg_row) {
+    for (uint32_t seg_col = 0; seg_col < pcs_ptr->cdef_segments_column_count; ++seg_col) {
+        EbObjectWrapper *  dlf_results_wrapper_ptr;
+        struct DlfResults *dlf_results_ptr;
+        // Get Empty DLF Results to Cdef
+        eb_get_empty_object(context_ptr->dlf_output_fifo_ptr, &dlf_results_wrapper_ptr);
+        dlf_results_ptr = (struct DlfResults *)dlf_results_wrapper_ptr->object_ptr;
+        dlf_results_ptr->pcs_wrapper_ptr = pcs_wrapper_ptr;
+        dlf_results_ptr->segment_index   = seg_row * pcs_ptr->cdef_segments_column_count + seg_col;
+        // Post DLF Results
+        eb_post_full_object(dlf_results_wrapper_ptr);
+    }
+}
+#endif
+
 void *dlf_kernel(void *input_ptr) {
     // Context & SCS & PCS
     EbThreadContext *   thread_context_ptr = (EbThreadContext *)input_ptr;
@@ -101,9 +174,11 @@ void *dlf_kernel(void *input_ptr) {
     EbObjectWrapper *enc_dec_results_wrapper_ptr;
     EncDecResults *  enc_dec_results_ptr;
 
+#if !DLF_CDEF_ROW_PIPELINE
     //// Output
     EbObjectWrapper *  dlf_results_wrapper_ptr;
     struct DlfResults *dlf_results_ptr;
+#endif
 
     // SB Loop variables
     for (;;) {
@@ -180,6 +255,113 @@ void *dlf_kernel(void *input_ptr) {
         }
 
 
+#if DLF_CDEF_ROW_PIPELINE
+        EbBool               dlf_enable_flag = (EbBool)pcs_ptr->parent_pcs_ptr->loop_filter_mode;
+        Av1Common *          cm              = pcs_ptr->parent_pcs_ptr->av1_cm;
+        EbPictureBufferDesc *recon_picture_ptr;
+        if (pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
+            recon_picture_ptr =
+                scs_ptr->static_config.is_16bit_pipeline || is_16bit
+                    ? ((EbReferenceObject *)pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr
+                           ->object_ptr)
+                          ->reference_picture16bit
+                    : ((EbReferenceObject *)pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr
+                           ->object_ptr)
+                          ->reference_picture;
+        else
+            recon_picture_ptr = scs_ptr->static_config.is_16bit_pipeline || is_16bit
+                                    ? pcs_ptr->recon_picture16bit_ptr
+                                    : pcs_ptr->recon_picture_ptr;
+
+        // The CDEF inputs are set before deblocking so the CDEF search segments can be
+        // posted while the rows below them are still being deblocked
+        if (scs_ptr->seq_header.enable_cdef && pcs_ptr->parent_pcs_ptr->cdef_filter_mode)
+            set_cdef_input_ptrs(scs_ptr, pcs_ptr, recon_picture_ptr, is_16bit);
+
+        pcs_ptr->cdef_segments_column_count = scs_ptr->cdef_segment_column_count;
+        pcs_ptr->cdef_segments_row_count    = scs_ptr->cdef_segment_row_count;
+        pcs_ptr->cdef_segments_total_count =
+            (uint16_t)(pcs_ptr->cdef_segments_column_count * pcs_ptr->cdef_segments_row_count);
+        pcs_ptr->tot_seg_searched_cdef = 0;
+        uint32_t picture_height_in_b64 = (pcs_ptr->parent_pcs_ptr->aligned_height + 64 - 1) / 64;
+        uint32_t cdef_seg_row          = 0;
+#if TILES_PARALLEL
+        uint16_t total_tile_cnt = pcs_ptr->parent_pcs_ptr->av1_cm->tiles_info.tile_cols *
+                                  pcs_ptr->parent_pcs_ptr->av1_cm->tiles_info.tile_rows;
+        if ((dlf_enable_flag && pcs_ptr->parent_pcs_ptr->loop_filter_mode >= 2) ||
+            (dlf_enable_flag && pcs_ptr->parent_pcs_ptr->loop_filter_mode == 1 &&
+             total_tile_cnt > 1)) {
+#else
+        if (dlf_enable_flag && pcs_ptr->parent_pcs_ptr->loop_filter_mode >= 2) {
+#endif
+            eb_av1_loop_filter_init(pcs_ptr);
+            uint8_t  sb_size_log2 = (uint8_t)eb_log2f(scs_ptr->sb_size_pix);
+            uint32_t picture_height_in_sb =
+                (pcs_ptr->parent_pcs_ptr->aligned_height + scs_ptr->sb_size_pix - 1) >>
+                sb_size_log2;
+#if DLF_SUBSAMPLED_SEARCH
+            // The subsampled search starts from the qindex model level, and needs enough
+            // SB rows for the sampled rows to be representative
+            EbBool subsampled_search =
+                picture_height_in_sb > pcs_ptr->parent_pcs_ptr->dlf_search_sb_row_step &&
+                pcs_ptr->parent_pcs_ptr->dlf_search_sb_row_step > 1;
+
+            if (pcs_ptr->parent_pcs_ptr->loop_filter_mode == 2 || subsampled_search) {
+#else
+            if (pcs_ptr->parent_pcs_ptr->loop_filter_mode == 2) {
+#endif
+                eb_av1_pick_filter_level(
+                    context_ptr,
+                    (EbPictureBufferDesc *)pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr,
+                    pcs_ptr,
+                    LPF_PICK_FROM_Q);
+            }
+
+            eb_av1_pick_filter_level(
+                context_ptr,
+                (EbPictureBufferDesc *)pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr,
+                pcs_ptr,
+#if DLF_SUBSAMPLED_SEARCH
+                subsampled_search ? LPF_PICK_FROM_SUBIMAGE : LPF_PICK_FROM_FULL_IMAGE);
+#else
+                LPF_PICK_FROM_FULL_IMAGE);
+#endif
+
+#if NO_ENCDEC
+            //NO DLF
+            pcs_ptr->parent_pcs_ptr->lf.filter_level[0] = 0;
+            pcs_ptr->parent_pcs_ptr->lf.filter_level[1] = 0;
+            pcs_ptr->parent_pcs_ptr->lf.filter_level_u  = 0;
+            pcs_ptr->parent_pcs_ptr->lf.filter_level_v  = 0;
+#endif
+            eb_av1_loop_filter_frame_init(
+                &pcs_ptr->parent_pcs_ptr->frm_hdr, &pcs_ptr->parent_pcs_ptr->lf_info, 0, 3);
+            for (uint32_t sb_row = 0; sb_row < picture_height_in_sb; ++sb_row) {
+                eb_av1_loop_filter_sb_rows(recon_picture_ptr, pcs_ptr, 0, 3, sb_row, sb_row + 1);
+                // A CDEF segment row reads up to one 64x64 row below its last row (128x128 blocks)
+                // plus the CDEF border, and the next SB row top edge filtering still modifies up
+                // to 7 rows above it. The last segment row is kept for after the restoration
+                // boundary lines are saved, so the CDEF application cannot start before that.
+                uint32_t deblocked_height = (sb_row + 1) << sb_size_log2;
+                while (cdef_seg_row + 1 < pcs_ptr->cdef_segments_row_count &&
+                       (SEGMENT_END_IDX(cdef_seg_row,
+                                        picture_height_in_b64,
+                                        pcs_ptr->cdef_segments_row_count) +
+                        2) * 64 + 16 <= deblocked_height)
+                    post_cdef_segment_row(
+                        context_ptr, pcs_ptr, enc_dec_results_ptr->pcs_wrapper_ptr, cdef_seg_row++);
+            }
+        }
+
+        //pre-cdef prep
+        link_eb_to_aom_buffer_desc(recon_picture_ptr, cm->frame_to_show);
+        if (scs_ptr->seq_header.enable_restoration)
+            eb_av1_loop_restoration_save_boundary_lines(cm->frame_to_show, cm, 0);
+
+        while (cdef_seg_row < pcs_ptr->cdef_segments_row_count)
+            post_cdef_segment_row(
+                context_ptr, pcs_ptr, enc_dec_results_ptr->pcs_wrapper_ptr, cdef_seg_row++);
+#else
         EbBool dlf_enable_flag = (EbBool)pcs_ptr->parent_pcs_ptr->loop_filter_mode;
 #if TILES_PARALLEL
         uint16_t total_tile_cnt = pcs_ptr->parent_pcs_ptr->av1_cm->tiles_info.tile_cols *
@@ -353,6 +535,7 @@ void *dlf_kernel(void *input_ptr) {
             eb_post_full_object(dlf_results_wrapper_ptr);
         }
 
+#endif
         // Release EncDec Results
         eb_release_object(enc_dec_results_wrapper_ptr);
     }
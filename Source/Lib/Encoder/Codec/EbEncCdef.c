@@ -1355,6 +1355,25 @@ void finish_cdef_search(EncDecContext *context_ptr, PictureControlSet *pcs_ptr,
         }
     }
 
+#if CDEF_REF_SEEDED_SEARCH
+    // Keep the per-SB strengths with the reference to seed the search of the pictures using it
+    if (ppcs->is_used_as_reference_flag &&
+        (uint32_t)(nvfb * nhfb) <= MAX_NUMBER_OF_TREEBLOCKS_PER_PICTURE) {
+        EbReferenceObject *ref_obj =
+            (EbReferenceObject *)ppcs->reference_picture_wrapper_ptr->object_ptr;
+        memset(ref_obj->cdef_sb_strength, -1, sizeof(ref_obj->cdef_sb_strength));
+        for (i = 0; i < sb_count; i++) {
+            const int32_t sb_fbr  = sb_index[i] / (MI_SIZE_64X64 * pcs_ptr->mi_stride);
+            const int32_t sb_fbc  = (sb_index[i] % pcs_ptr->mi_stride) / MI_SIZE_64X64;
+            const int8_t  best_gi = pcs_ptr->mi_grid_base[sb_index[i]]->mbmi.cdef_strength;
+            ref_obj->cdef_sb_strength[0][sb_fbr * nhfb + sb_fbc] =
+                (int8_t)frm_hdr->cdef_params.cdef_y_strength[best_gi];
+            ref_obj->cdef_sb_strength[1][sb_fbr * nhfb + sb_fbc] =
+                (int8_t)frm_hdr->cdef_params.cdef_uv_strength[best_gi];
+        }
+        ref_obj->cdef_sb_strength_valid = EB_TRUE;
+    }
+#endif
     if (fast) {
         for (int32_t j = 0; j < nb_strengths; j++) {
             frm_hdr->cdef_params.cdef_y_strength[j] =
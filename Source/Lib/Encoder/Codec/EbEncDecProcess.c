@@ -156,7 +156,11 @@ EbErrorType enc_dec_context_ctor(EbThreadContext *  thread_context_ptr,
            0,
            0,
            enable_hbd_mode_decision,
-           static_config->screen_content_mode);
+           static_config->screen_content_mode
+#if SB_SIZE_BASED_BLK_ALLOC
+           , (uint8_t)static_config->super_block_size
+#endif
+           );
     if (enable_hbd_mode_decision)
         context_ptr->md_context->input_sample16bit_buffer = context_ptr->input_sample16bit_buffer;
 
@@ -1424,6 +1428,25 @@ EbErrorType signal_derivation_enc_dec_kernel_oq(SequenceControlSet * scs_ptr,
         context_ptr->tx_search_reduced_set = 0;
     else
         context_ptr->tx_search_reduced_set = 1;
+#if TX_TYPE_PRUNING
+    // Tx type pruning Level                          Settings
+    // 0                                              OFF: full RD for all the allowed tx types
+    // 1                                              SATD-based ranking, full RD for the best 4 tx types
+    // 2                                              SATD-based ranking, full RD for the best 2 tx types
+    // MR and M0 are left untouched in all the PD passes
+    if (context_ptr->pd_pass == PD_PASS_0 || MR_MODE || pcs_ptr->enc_mode <= ENC_M0)
+        context_ptr->tx_type_pruning_level = 0;
+    else if (context_ptr->pd_pass == PD_PASS_1)
+        context_ptr->tx_type_pruning_level = 2;
+    else if (pcs_ptr->parent_pcs_ptr->sc_content_detected)
+        context_ptr->tx_type_pruning_level = 0;
+    else if (pcs_ptr->enc_mode <= ENC_M1)
+        context_ptr->tx_type_pruning_level = 0;
+    else if (pcs_ptr->enc_mode <= ENC_M4)
+        context_ptr->tx_type_pruning_level = 1;
+    else
+        context_ptr->tx_type_pruning_level = 2;
+#endif
     // Interpolation search Level                     Settings
     // 0                                              OFF
     // 1                                              Interpolation search at inter-depth
@@ -2860,6 +2883,11 @@ void *enc_dec_kernel(void *input_ptr) {
         end_of_row_flag    = EB_FALSE;
         sb_row_index_start = sb_row_index_count = 0;
         context_ptr->tot_intra_coded_area       = 0;
+#if MD_CAND_CLASS_STATS
+        memset(&context_ptr->md_context->md_class_stats, 0, sizeof(MdClassStats));
+        context_ptr->md_context->md_class_stats_enabled =
+            scs_ptr->static_config.stat_report > 1;
+#endif
 
         // Segment-loop
         while (assign_enc_dec_segments(segments_ptr,
@@ -3026,6 +3054,26 @@ void *enc_dec_kernel(void *input_ptr) {
                             scs_ptr->enc_dec_segment_col_count_array[pcs_ptr->temporal_layer_index] == 1 ?
                             0 : sb_index;
 
+#if MD_RATE_EST_INCREMENTAL
+                        // The picture-based table already holds the rates of the previous SB CDFs;
+                        // otherwise start from the picture table and its CDFs
+                        const FRAME_CONTEXT *ref_fc;
+                        if (real_sb_idx == 0 && sb_index > 0)
+                            ref_fc = &pcs_ptr->rate_est_fc;
+                        else {
+                            // Copy all fileds from picture
+                            pcs_ptr->rate_est_array[real_sb_idx] = *pcs_ptr->md_rate_estimation_array;
+                            ref_fc = pcs_ptr->coeff_est_entropy_coder_ptr->fc;
+                        }
+
+                        // Compute rate using latest CDFs, only for the CDFs that changed
+                        av1_estimate_rate_incremental(pcs_ptr,
+                            &pcs_ptr->rate_est_array[real_sb_idx],
+                            &pcs_ptr->ec_ctx_array[sb_index],
+                            ref_fc);
+                        if (real_sb_idx == 0)
+                            pcs_ptr->rate_est_fc = pcs_ptr->ec_ctx_array[sb_index];
+#else
                         // Copy all fileds from picture
                         pcs_ptr->rate_est_array[real_sb_idx] = *pcs_ptr->md_rate_estimation_array;
 
@@ -3038,6 +3086,7 @@ void *enc_dec_kernel(void *input_ptr) {
                             &pcs_ptr->ec_ctx_array[sb_index]);
                         av1_estimate_coefficients_rate(&pcs_ptr->rate_est_array[real_sb_idx],
                             &pcs_ptr->ec_ctx_array[sb_index]);
+#endif
 
                         //let the candidate point to the new rate table.
                         uint32_t cand_index;
@@ -3204,6 +3253,9 @@ void *enc_dec_kernel(void *input_ptr) {
 
         eb_block_on_mutex(pcs_ptr->intra_mutex);
         pcs_ptr->intra_coded_area += (uint32_t)context_ptr->tot_intra_coded_area;
+#if MD_CAND_CLASS_STATS
+        md_class_stats_accumulate(&pcs_ptr->md_class_stats, &context_ptr->md_context->md_class_stats);
+#endif
 #if TILES_PARALLEL
         pcs_ptr->enc_dec_coded_sb_count += (uint32_t)context_ptr->coded_sb_count;
         last_sb_flag = (pcs_ptr->sb_total_count_pix == pcs_ptr->enc_dec_coded_sb_count);
@@ -44,6 +44,18 @@ typedef struct RestResults {
 #endif
 } RestResults;
 
+#if PSNR_METRICS_STAGE
+typedef struct MetricsTasks {
+    EbDctor          dctor;
+    EbObjectWrapper *pcs_wrapper_ptr;
+    EbObjectWrapper *reference_picture_wrapper_ptr; // live count held until the SSEs are done
+} MetricsTasks;
+
+typedef struct MetricsTasksInitData {
+    uint32_t junk;
+} MetricsTasksInitData;
+#endif
+
 typedef struct EncDecResultsInitData {
     uint32_t junk;
 } EncDecResultsInitData;
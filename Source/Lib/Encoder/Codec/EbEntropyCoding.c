@@ -297,9 +297,14 @@ static void write_golomb(AomWriter *w, int32_t level) {
     }
     assert(length > 0);
 
+#if EC_FAST_RANGE_CODER
+    aom_write_literal(w, 0, length - 1);
+    aom_write_literal(w, x, length);
+#else
     for (i = 0; i < length - 1; ++i) aom_write_bit(w, 0);
 
     for (i = length - 1; i >= 0; --i) aom_write_bit(w, (x >> i) & 0x01);
+#endif
 }
 
 static const uint8_t eob_to_pos_small[33] = {
@@ -1256,10 +1261,33 @@ static void encode_partition_av1(PictureControlSet *pcs_ptr, FRAME_CONTEXT *fram
         aom_write_symbol(
             ec_writer, p, frame_context->partition_cdf[context_index], partition_cdf_length(bsize));
     } else if (!has_rows && has_cols) {
+#if EC_SB_ROW_PIPELINE
+        // The gathered CDF depends on the partition CDF when the flag is coded
+        if (ec_writer->symbol_log) {
+            ec_symbol_log_push(ec_writer->symbol_log,
+                               EC_SYMBOL_PARTITION_VERT_ALIKE,
+                               frame_context->partition_cdf[context_index],
+                               p == PARTITION_SPLIT,
+                               bsize,
+                               0);
+            return;
+        }
+#endif
         AomCdfProb cdf[CDF_SIZE(2)];
         partition_gather_vert_alike(cdf, frame_context->partition_cdf[context_index], bsize);
         aom_write_symbol(ec_writer, p == PARTITION_SPLIT, cdf, 2);
     } else {
+#if EC_SB_ROW_PIPELINE
+        if (ec_writer->symbol_log) {
+            ec_symbol_log_push(ec_writer->symbol_log,
+                               EC_SYMBOL_PARTITION_HORZ_ALIKE,
+                               frame_context->partition_cdf[context_index],
+                               p == PARTITION_SPLIT,
+                               bsize,
+                               0);
+            return;
+        }
+#endif
         AomCdfProb cdf[CDF_SIZE(2)];
         partition_gather_horz_alike(cdf, frame_context->partition_cdf[context_index], bsize);
         aom_write_symbol(ec_writer, p == PARTITION_SPLIT, cdf, 2);
@@ -1619,6 +1647,9 @@ static void entropy_tile_info_dctor(EbPtr p) {
     EntropyTileInfo *obj = (EntropyTileInfo *)p;
     EB_DELETE(obj->entropy_coder_ptr);
     EB_DESTROY_MUTEX(obj->entropy_coding_mutex);
+#if EC_SB_ROW_PIPELINE
+    for (int i = 0; i < EC_SYMBOL_LOG_ROWS; i++) ec_symbol_log_free(&obj->symbol_log[i]);
+#endif
 }
 
 EbErrorType entropy_tile_info_ctor(EntropyTileInfo *eti, uint32_t buf_size) {
@@ -1634,6 +1665,13 @@ EbErrorType entropy_tile_info_ctor(EntropyTileInfo *eti, uint32_t buf_size) {
     eti->entropy_coding_row_count   = 0;
     eti->entropy_coding_in_progress = 0;
     eti->entropy_coding_tile_done   = EB_FALSE;
+#if EC_SB_ROW_PIPELINE
+    eti->entropy_coding_row_pipeline        = EB_FALSE;
+    eti->entropy_coding_logged_row_count    = 0;
+    eti->entropy_coding_coded_row_count     = 0;
+    eti->entropy_coding_symbols_in_progress = EB_FALSE;
+    memset(eti->symbol_log, 0, sizeof(eti->symbol_log));
+#endif
     return return_error;
 }
 
@@ -1687,11 +1725,23 @@ EbErrorType entropy_coder_ctor(EntropyCoder *entropy_coder_ptr, uint32_t buffer_
 
     EB_MALLOC(entropy_coder_ptr->fc, sizeof(FRAME_CONTEXT));
 
+#if EC_GROWABLE_BUFFERS
+    // The coded bytes grow the buffer as needed (see aom_start_encode_unit)
+    EB_NEW(output_bitstream_ptr,
+           output_bitstream_unit_ctor,
+           MIN(buffer_size, EC_OUTPUT_BUFFER_INIT_SIZE));
+
+    entropy_coder_ptr->ec_output_bitstream_ptr = output_bitstream_ptr;
+
+    // Only reset, never written
+    EB_NEW(output_bitstream_ptr, output_bitstream_unit_ctor, 0);
+#else
     EB_NEW(output_bitstream_ptr, output_bitstream_unit_ctor, buffer_size);
 
     entropy_coder_ptr->ec_output_bitstream_ptr = output_bitstream_ptr;
 
     EB_NEW(output_bitstream_ptr, output_bitstream_unit_ctor, buffer_size);
+#endif
     ((CabacEncodeContext *)entropy_coder_ptr->cabac_encode_context_ptr)
         ->bac_enc_context.m_pc_t_com_bit_if = output_bitstream_ptr;
     return EB_ErrorNone;
@@ -4401,6 +4451,24 @@ static uint32_t write_frame_header_obu(SequenceControlSet *     scs_ptr,
     return total_size;
 }
 
+#if PKT_ZERO_COPY
+/**************************************************
+* get_frame_tile_data_size
+*   Bytes of tile data in the frame OBU, tile size fields included
+**************************************************/
+uint32_t get_frame_tile_data_size(PictureControlSet *pcs_ptr) {
+    Av1Common *const cm       = pcs_ptr->parent_pcs_ptr->av1_cm;
+    const uint16_t   tile_cnt = cm->tiles_info.tile_rows * cm->tiles_info.tile_cols;
+    uint32_t         size     = 0;
+    for (int tile_idx = 0; tile_idx < tile_cnt; tile_idx++) {
+        size += pcs_ptr->entropy_coding_info[tile_idx]->entropy_coder_ptr->ec_writer.pos;
+        if (tile_idx != tile_cnt - 1 && tile_cnt > 1)
+            size += pcs_ptr->tile_size_bytes_minus_1 + 1;
+    }
+    return size;
+}
+
+#endif
 /**************************************************
 * EncodeFrameHeaderHeader
 **************************************************/
@@ -4437,6 +4505,43 @@ EbErrorType write_frame_header_av1(Bitstream *bitstream_ptr, SequenceControlSet
     curr_data_size += write_tile_group_header(
         data + curr_data_size, 0, 0, n_log2_tiles, tile_start_and_end_present_flag);
 
+#if PKT_ZERO_COPY
+    // The payload size is known as soon as the headers are written, so only the header bytes
+    // are shifted to make room for the OBU size field and the tiles go to their final offset.
+    const uint32_t header_size       = curr_data_size - obu_header_size;
+    const uint32_t obu_payload_size  = header_size + (show_existing ? 0 : get_frame_tile_data_size(pcs_ptr));
+    const size_t   length_field_size = eb_aom_uleb_size_in_bytes(obu_payload_size);
+    memmove(data + obu_header_size + length_field_size, data + obu_header_size, header_size);
+    if (write_uleb_obu_size(obu_header_size, obu_payload_size, data) != AOM_CODEC_OK) { assert(0); }
+    curr_data_size += (int32_t)length_field_size;
+
+    if (!show_existing) {
+        int32_t tile_size       = 0;
+        uint8_t tile_size_bytes = 0;
+        for (int tile_idx = 0; tile_idx < tile_cnt; tile_idx++) {
+            tile_size = pcs_ptr->entropy_coding_info[tile_idx]->entropy_coder_ptr->ec_writer.pos;
+            if (tile_idx != tile_cnt - 1 && tile_cnt > 1) {
+                tile_size_bytes = pcs_ptr->tile_size_bytes_minus_1 + 1;
+                mem_put_varsize(data + curr_data_size, tile_size_bytes, tile_size - 1);
+            } else {
+                tile_size_bytes = 0;
+            }
+            OutputBitstreamUnit *ec_output_bitstream_ptr =
+                (OutputBitstreamUnit *)pcs_ptr->entropy_coding_info[tile_idx]
+                    ->entropy_coder_ptr->ec_output_bitstream_ptr;
+            memcpy(data + curr_data_size + tile_size_bytes,
+                   ec_output_bitstream_ptr->buffer_begin_av1,
+                   tile_size);
+            curr_data_size += (tile_size + tile_size_bytes);
+        }
+    }
+    assert((uint32_t)curr_data_size == obu_header_size + length_field_size + obu_payload_size);
+    data += curr_data_size;
+
+    output_bitstream_ptr->buffer_av1 = data;
+    return return_error;
+}
+#else
     if (!show_existing) {
         // Add data from EC stream to Picture Stream.
 #if TILES_PARALLEL
@@ -4482,6 +4587,7 @@ EbErrorType write_frame_header_av1(Bitstream *bitstream_ptr, SequenceControlSet
     output_bitstream_ptr->buffer_av1 = data;
     return return_error;
 }
+#endif
 
 /**************************************************
 * encode_sps_av1
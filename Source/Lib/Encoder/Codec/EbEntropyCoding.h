@@ -211,6 +211,11 @@ extern int32_t eb_av1_get_pred_context_single_ref_p6(const MacroBlockD *xd);
 
 extern EbErrorType write_frame_header_av1(Bitstream *bitstream_ptr, SequenceControlSet *scs_ptr,
                                           PictureControlSet *pcs_ptr, uint8_t show_existing);
+#if PKT_ZERO_COPY
+// Upper bound on the OBU, sequence, frame and tile group header bytes written for one frame
+#define FRAME_OBU_HEADERS_MAX_SIZE 1024
+extern uint32_t get_frame_tile_data_size(PictureControlSet *pcs_ptr);
+#endif
 extern EbErrorType encode_td_av1(uint8_t *bitstream_ptr);
 extern EbErrorType encode_sps_av1(Bitstream *bitstream_ptr, SequenceControlSet *scs_ptr);
 
@@ -13,6 +13,15 @@
 #ifdef __cplusplus
 extern "C" {
 #endif
+#if EC_GROWABLE_BUFFERS
+// Initial buffer_size of the entropy coder output bitstreams, which then grow with the coded tiles
+#define EC_OUTPUT_BUFFER_INIT_SIZE 0x40000
+#endif
+#if EC_SB_ROW_PIPELINE
+// Number of SB rows of a tile whose symbols can be logged ahead of the arithmetic coding
+#define EC_SYMBOL_LOG_ROWS 3
+#endif
+
 typedef struct Bitstream {
     EbDctor dctor;
     OutputBitstreamUnit* output_bitstream_ptr;
@@ -39,6 +48,16 @@ typedef struct EntropyTileInfo
     EbHandle          entropy_coding_mutex;
     EbBool            entropy_coding_in_progress;
     EbBool            entropy_coding_tile_done;
+#if EC_SB_ROW_PIPELINE
+    // When set, the symbols of each SB row are logged in symbol_log[row % EC_SYMBOL_LOG_ROWS]
+    // under the in_progress token, then arithmetic coded in row order under the
+    // symbols_in_progress token, so that the next row can be logged meanwhile
+    EbBool            entropy_coding_row_pipeline;
+    uint32_t          entropy_coding_logged_row_count;
+    uint32_t          entropy_coding_coded_row_count;
+    EbBool            entropy_coding_symbols_in_progress;
+    EcSymbolLog       symbol_log[EC_SYMBOL_LOG_ROWS];
+#endif
 } EntropyTileInfo;
 
 extern EbErrorType entropy_tile_info_ctor(
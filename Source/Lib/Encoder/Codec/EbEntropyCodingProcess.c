@@ -23,6 +23,7 @@
 #include "EbRateControlTasks.h"
 #include "EbCabacContextModel.h"
 #include "EbLog.h"
+#include "EbSvtAv1ErrorCodes.h"
 #include "common_dsp_rtcd.h"
 #define AV1_MIN_TILE_SIZE_BYTES 1
 #if TILES_PARALLEL
@@ -232,15 +233,23 @@ static void reset_entropy_coding_picture(EntropyCodingContext *context_ptr,
             (OutputBitstreamUnit *)(pcs_ptr->entropy_coding_info[tile_idx]
                                         ->entropy_coder_ptr->ec_output_bitstream_ptr);
         //****************************************************************//
+#if !EC_GROWABLE_BUFFERS
         uint8_t *data = output_bitstream_ptr->buffer_av1;
+#endif
         pcs_ptr->entropy_coding_info[tile_idx]->entropy_coder_ptr->ec_writer.allow_update_cdf =
             !pcs_ptr->parent_pcs_ptr->large_scale_tile;
         pcs_ptr->entropy_coding_info[tile_idx]->entropy_coder_ptr->ec_writer.allow_update_cdf =
             pcs_ptr->entropy_coding_info[tile_idx]->entropy_coder_ptr->ec_writer.allow_update_cdf &&
             !frm_hdr->disable_cdf_update;
 
+#if EC_GROWABLE_BUFFERS
+        aom_start_encode_unit(
+            &pcs_ptr->entropy_coding_info[tile_idx]->entropy_coder_ptr->ec_writer,
+            output_bitstream_ptr);
+#else
         aom_start_encode(&pcs_ptr->entropy_coding_info[tile_idx]->entropy_coder_ptr->ec_writer,
                          data);
+#endif
 
         // ADD Reset here
         if (pcs_ptr->parent_pcs_ptr->frm_hdr.primary_ref_frame != PRIMARY_REF_NONE)
@@ -285,12 +294,18 @@ static void reset_entropy_coding_picture(EntropyCodingContext *context_ptr,
         (OutputBitstreamUnit *)(pcs_ptr->entropy_coder_ptr->ec_output_bitstream_ptr);
     //****************************************************************//
 
+#if !EC_GROWABLE_BUFFERS
     uint8_t *data = output_bitstream_ptr->buffer_av1;
+#endif
     pcs_ptr->entropy_coder_ptr->ec_writer.allow_update_cdf =
         !pcs_ptr->parent_pcs_ptr->large_scale_tile;
     pcs_ptr->entropy_coder_ptr->ec_writer.allow_update_cdf =
         pcs_ptr->entropy_coder_ptr->ec_writer.allow_update_cdf && !frm_hdr->disable_cdf_update;
+#if EC_GROWABLE_BUFFERS
+    aom_start_encode_unit(&pcs_ptr->entropy_coder_ptr->ec_writer, output_bitstream_ptr);
+#else
     aom_start_encode(&pcs_ptr->entropy_coder_ptr->ec_writer, data);
+#endif
 
     // ADD Reset here
     if (pcs_ptr->parent_pcs_ptr->frm_hdr.primary_ref_frame != PRIMARY_REF_NONE)
@@ -425,11 +440,23 @@ static EbBool update_entropy_coding_rows(PictureControlSet *pcs_ptr, uint32_t *r
     }
 
     // Release in_progress token
+#if EC_SB_ROW_PIPELINE
+    // With the row pipeline, the token is released as soon as the row symbols are logged
+    if (*initial_process_call == EB_FALSE && ec_ptr->entropy_coding_in_progress == EB_TRUE &&
+        !ec_ptr->entropy_coding_row_pipeline)
+#else
     if (*initial_process_call == EB_FALSE && ec_ptr->entropy_coding_in_progress == EB_TRUE)
+#endif
         ec_ptr->entropy_coding_in_progress = EB_FALSE;
     // Test if the picture is not already complete AND not currently being worked on by another ENCDEC process
     if (ec_ptr->entropy_coding_current_row < ec_ptr->entropy_coding_row_count &&
         ec_ptr->entropy_coding_row_array[ec_ptr->entropy_coding_current_row] == EB_TRUE &&
+#if EC_SB_ROW_PIPELINE
+        // The row symbol log must have been coded
+        (!ec_ptr->entropy_coding_row_pipeline ||
+         (uint32_t)ec_ptr->entropy_coding_current_row <
+             ec_ptr->entropy_coding_coded_row_count + EC_SYMBOL_LOG_ROWS) &&
+#endif
         ec_ptr->entropy_coding_in_progress == EB_FALSE) {
         // Test if the next SB-row is ready to go
         if (ec_ptr->entropy_coding_current_row <= ec_ptr->entropy_coding_current_available_row) {
@@ -488,6 +515,79 @@ static EbBool update_entropy_coding_rows(PictureControlSet *pcs_ptr, uint32_t *r
     return process_next_row;
 }
 #endif
+#if EC_SB_ROW_PIPELINE
+// At the end of each SB-row, send the updated bit-count to Rate Control
+static void post_entropy_coding_row_bits(EntropyCodingContext *context_ptr,
+                                         PictureControlSet *pcs_ptr, uint32_t row_index,
+                                         uint32_t row_total_bits) {
+    EbObjectWrapper * rate_control_task_wrapper_ptr;
+    RateControlTasks *rate_control_task_ptr;
+
+    // Get Empty EncDec Results
+    eb_get_empty_object(context_ptr->rate_control_output_fifo_ptr, &rate_control_task_wrapper_ptr);
+    rate_control_task_ptr = (RateControlTasks *)rate_control_task_wrapper_ptr->object_ptr;
+    rate_control_task_ptr->task_type      = RC_ENTROPY_CODING_ROW_FEEDBACK_RESULT;
+    rate_control_task_ptr->picture_number = pcs_ptr->picture_number;
+    rate_control_task_ptr->row_number     = row_index;
+    rate_control_task_ptr->bit_count      = row_total_bits;
+
+    rate_control_task_ptr->pcs_wrapper_ptr = 0;
+    rate_control_task_ptr->segment_index   = ~0u;
+
+    // Post EncDec Results
+    eb_post_full_object(rate_control_task_wrapper_ptr);
+}
+
+/******************************************************
+ * Code Entropy Coding Rows
+ *  Called once the symbols of an SB row are logged. The
+ *  in_progress token is handed over so that the next row
+ *  can be logged, then, unless another thread already
+ *  holds the symbols_in_progress token, the logged rows
+ *  are arithmetic coded in row order.
+ ******************************************************/
+static void code_entropy_coding_rows(EntropyCodingContext *context_ptr, PictureControlSet *pcs_ptr,
+                                     uint16_t tile_idx, uint32_t first_sb_index,
+                                     uint16_t tile_width_in_sb, uint32_t pic_width_in_sb) {
+    EntropyTileInfo *ec_ptr    = pcs_ptr->entropy_coding_info[tile_idx];
+    AomWriter *      ec_writer = &ec_ptr->entropy_coder_ptr->ec_writer;
+    EbBool           code_rows;
+    uint32_t         row_index;
+
+    eb_block_on_mutex(ec_ptr->entropy_coding_mutex);
+    ec_ptr->entropy_coding_logged_row_count++;
+    ec_ptr->entropy_coding_in_progress         = EB_FALSE;
+    code_rows                                  = !ec_ptr->entropy_coding_symbols_in_progress;
+    ec_ptr->entropy_coding_symbols_in_progress = EB_TRUE;
+    row_index                                  = ec_ptr->entropy_coding_coded_row_count;
+    eb_release_mutex(ec_ptr->entropy_coding_mutex);
+
+    while (code_rows) {
+        const EcSymbolLog *symbol_log     = &ec_ptr->symbol_log[row_index % EC_SYMBOL_LOG_ROWS];
+        uint32_t           row_total_bits = 0;
+        uint32_t           symbol_index   = 0;
+
+        for (uint32_t x_sb_index = 0; x_sb_index < tile_width_in_sb; ++x_sb_index) {
+            SuperBlock *sb_ptr =
+                pcs_ptr->sb_ptr_array[first_sb_index + row_index * pic_width_in_sb + x_sb_index];
+            uint32_t prev_pos = ec_writer->ec.offs;
+
+            symbol_index = eb_aom_write_logged_symbols(ec_writer, symbol_log, symbol_index);
+            sb_ptr->total_bits = (ec_writer->ec.offs - prev_pos) << 3;
+
+            pcs_ptr->parent_pcs_ptr->quantized_coeff_num_bits += sb_ptr->total_bits;
+            row_total_bits += sb_ptr->total_bits;
+        }
+        post_entropy_coding_row_bits(context_ptr, pcs_ptr, row_index, row_total_bits);
+
+        eb_block_on_mutex(ec_ptr->entropy_coding_mutex);
+        row_index = ++ec_ptr->entropy_coding_coded_row_count;
+        code_rows = row_index < ec_ptr->entropy_coding_logged_row_count;
+        ec_ptr->entropy_coding_symbols_in_progress = code_rows;
+        eb_release_mutex(ec_ptr->entropy_coding_mutex);
+    }
+}
+#endif
 /******************************************************
  * Write Stat to File
  * write stat_struct per frame in the first pass
@@ -610,6 +710,17 @@ void *entropy_coding_kernel(void *input_ptr) {
                     eb_release_mutex(pcs_ptr->entropy_coding_pic_mutex);
                     pcs_ptr->entropy_coding_info[tile_idx]->entropy_coding_tile_done = EB_FALSE;
                 }
+#if EC_SB_ROW_PIPELINE
+                EcSymbolLog *symbol_log = NULL;
+                if (pcs_ptr->entropy_coding_info[tile_idx]->entropy_coding_row_pipeline) {
+                    symbol_log = &pcs_ptr->entropy_coding_info[tile_idx]
+                                      ->symbol_log[y_sb_index % EC_SYMBOL_LOG_ROWS];
+                    symbol_log->count = 0;
+                    symbol_log->error = 0;
+                    pcs_ptr->entropy_coding_info[tile_idx]
+                        ->entropy_coder_ptr->ec_writer.symbol_log = symbol_log;
+                }
+#endif
 
                 for (x_sb_index = 0; x_sb_index < tile_width_in_sb; ++x_sb_index) {
                     sb_index = (uint16_t)((x_sb_index + tile_sb_start_x) +
@@ -631,6 +742,19 @@ void *entropy_coding_kernel(void *input_ptr) {
                         context_ptr->tok = pcs_ptr->tile_tok[tile_row][tile_col];
                     }
                     sb_ptr->total_bits = 0;
+#if EC_SB_ROW_PIPELINE
+                    if (symbol_log) {
+                        write_sb(context_ptr,
+                                 sb_ptr,
+                                 pcs_ptr,
+                                 tile_idx,
+                                 pcs_ptr->entropy_coding_info[tile_idx]->entropy_coder_ptr,
+                                 sb_ptr->quantized_coeff);
+                        // The SB bits are counted when its symbols are coded
+                        ec_symbol_log_push(symbol_log, EC_SYMBOL_MARK, NULL, 0, 0, 0);
+                        continue;
+                    }
+#endif
                     uint32_t prev_pos =
                         (x_sb_index == 0 && y_sb_index == 0)
                             ? 0
@@ -653,6 +777,23 @@ void *entropy_coding_kernel(void *input_ptr) {
                     row_total_bits += sb_ptr->total_bits;
                 }
 
+#if EC_SB_ROW_PIPELINE
+                if (symbol_log) {
+                    pcs_ptr->entropy_coding_info[tile_idx]->entropy_coder_ptr->ec_writer.symbol_log =
+                        NULL;
+                    // The log could not grow and lost symbols of the row, which can not be
+                    // logged again since the EC neighbor arrays already hold its blocks
+                    if (symbol_log->error)
+                        CHECK_REPORT_ERROR_NC(scs_ptr->encode_context_ptr->app_callback_ptr,
+                                              EB_ENC_EC_ERROR3);
+                    code_entropy_coding_rows(context_ptr,
+                                             pcs_ptr,
+                                             tile_idx,
+                                             tile_sb_start_x + tile_sb_start_y * pic_width_in_sb,
+                                             tile_width_in_sb,
+                                             pic_width_in_sb);
+                } else
+#endif
                 // At the end of each SB-row, send the updated bit-count to Entropy Coding
                 {
                     EbObjectWrapper * rate_control_task_wrapper_ptr;
@@ -678,8 +819,16 @@ void *entropy_coding_kernel(void *input_ptr) {
                 eb_block_on_mutex(pcs_ptr->entropy_coding_info[tile_idx]->entropy_coding_mutex);
                 if (pcs_ptr->entropy_coding_info[tile_idx]->entropy_coding_tile_done == EB_FALSE) {
                     // If the picture is complete, terminate the slice
+#if EC_SB_ROW_PIPELINE
+                    EntropyTileInfo *ec_ptr = pcs_ptr->entropy_coding_info[tile_idx];
+                    if ((ec_ptr->entropy_coding_row_pipeline
+                             ? ec_ptr->entropy_coding_coded_row_count
+                             : (uint32_t)ec_ptr->entropy_coding_current_row) ==
+                        (uint32_t)ec_ptr->entropy_coding_row_count) {
+#else
                     if (pcs_ptr->entropy_coding_info[tile_idx]->entropy_coding_current_row ==
                         pcs_ptr->entropy_coding_info[tile_idx]->entropy_coding_row_count) {
+#endif
                         uint32_t ref_idx;
 
                         EbBool pic_ready = EB_TRUE;
@@ -391,97 +391,153 @@ void av1_estimate_mv_rate(PictureControlSet *      pcs_ptr,
 * Estimate the rate of the quantised coefficient
 * based on the frame CDF
 ***************************************************************************/
+static AomCdfProb *get_eob_flag_cdf(FRAME_CONTEXT *fc, int32_t eob_multi_size, int32_t plane,
+                                    int32_t ctx) {
+    switch (eob_multi_size) {
+    case 0: return fc->eob_flag_cdf16[plane][ctx];
+    case 1: return fc->eob_flag_cdf32[plane][ctx];
+    case 2: return fc->eob_flag_cdf64[plane][ctx];
+    case 3: return fc->eob_flag_cdf128[plane][ctx];
+    case 4: return fc->eob_flag_cdf256[plane][ctx];
+    case 5: return fc->eob_flag_cdf512[plane][ctx];
+    case 6:
+    default: return fc->eob_flag_cdf1024[plane][ctx];
+    }
+}
+
+static void estimate_eob_rate(MdRateEstimationContext *md_rate_estimation_array,
+                              FRAME_CONTEXT *fc, int32_t eob_multi_size, int32_t plane) {
+    LvMapEobCost *pcost = &md_rate_estimation_array->eob_frac_bits[eob_multi_size][plane];
+    for (int32_t ctx = 0; ctx < 2; ++ctx)
+        av1_get_syntax_rate_from_cdf(
+            pcost->eob_cost[ctx], get_eob_flag_cdf(fc, eob_multi_size, plane, ctx), NULL);
+}
+
+static void estimate_coeff_rate(MdRateEstimationContext *md_rate_estimation_array,
+                                FRAME_CONTEXT *fc, int32_t tx_size, int32_t plane) {
+    LvMapCoeffCost *pcost = &md_rate_estimation_array->coeff_fac_bits[tx_size][plane];
+    int32_t         ctx;
+
+    for (ctx = 0; ctx < TXB_SKIP_CONTEXTS; ++ctx)
+        av1_get_syntax_rate_from_cdf(
+            pcost->txb_skip_cost[ctx], fc->txb_skip_cdf[tx_size][ctx], NULL);
+
+    for (ctx = 0; ctx < SIG_COEF_CONTEXTS_EOB; ++ctx)
+        av1_get_syntax_rate_from_cdf(
+            pcost->base_eob_cost[ctx], fc->coeff_base_eob_cdf[tx_size][plane][ctx], NULL);
+    for (ctx = 0; ctx < SIG_COEF_CONTEXTS; ++ctx)
+        av1_get_syntax_rate_from_cdf(
+            pcost->base_cost[ctx], fc->coeff_base_cdf[tx_size][plane][ctx], NULL);
+    for (int ctx = 0; ctx < SIG_COEF_CONTEXTS; ++ctx) {
+        pcost->base_cost[ctx][4] = 0;
+        pcost->base_cost[ctx][5] =
+            pcost->base_cost[ctx][1] + av1_cost_literal(1) - pcost->base_cost[ctx][0];
+        pcost->base_cost[ctx][6] = pcost->base_cost[ctx][2] - pcost->base_cost[ctx][1];
+        pcost->base_cost[ctx][7] = pcost->base_cost[ctx][3] - pcost->base_cost[ctx][2];
+    }
+    for (ctx = 0; ctx < EOB_COEF_CONTEXTS; ++ctx)
+        av1_get_syntax_rate_from_cdf(
+            pcost->eob_extra_cost[ctx], fc->eob_extra_cdf[tx_size][plane][ctx], NULL);
+
+    for (ctx = 0; ctx < DC_SIGN_CONTEXTS; ++ctx)
+        av1_get_syntax_rate_from_cdf(pcost->dc_sign_cost[ctx], fc->dc_sign_cdf[plane][ctx], NULL);
+
+    for (ctx = 0; ctx < LEVEL_CONTEXTS; ++ctx) {
+        int32_t br_rate[BR_CDF_SIZE];
+        int32_t prev_cost = 0;
+        int32_t i, j;
+#if TXS_DEPTH_2
+        av1_get_syntax_rate_from_cdf(
+            br_rate, fc->coeff_br_cdf[AOMMIN(tx_size, TX_32X32)][plane][ctx], NULL);
+#else
+        av1_get_syntax_rate_from_cdf(br_rate, fc->coeff_br_cdf[tx_size][plane][ctx], NULL);
+#endif
+        for (i = 0; i < COEFF_BASE_RANGE; i += BR_CDF_SIZE - 1) {
+            for (j = 0; j < BR_CDF_SIZE - 1; j++) pcost->lps_cost[ctx][i + j] = prev_cost + br_rate[j];
+            prev_cost += br_rate[j];
+        }
+        pcost->lps_cost[ctx][i] = prev_cost;
+    }
+    for (int ctx = 0; ctx < LEVEL_CONTEXTS; ++ctx) {
+        pcost->lps_cost[ctx][0 + COEFF_BASE_RANGE + 1] = pcost->lps_cost[ctx][0];
+        for (int i = 1; i <= COEFF_BASE_RANGE; ++i) {
+            pcost->lps_cost[ctx][i + COEFF_BASE_RANGE + 1] =
+                pcost->lps_cost[ctx][i] - pcost->lps_cost[ctx][i - 1];
+        }
+    }
+}
+
 void av1_estimate_coefficients_rate(MdRateEstimationContext *md_rate_estimation_array,
                                     FRAME_CONTEXT *          fc) {
     int32_t       num_planes     = 3; // NM - Hardcoded to 3
     const int32_t nplanes        = AOMMIN(num_planes, PLANE_TYPES);
     int32_t       eob_multi_size = 0;
     int32_t       plane          = 0;
-    int32_t       ctx            = 0;
     int32_t       tx_size        = 0;
 
-    for (eob_multi_size = 0; eob_multi_size < 7; ++eob_multi_size) {
-        for (plane = 0; plane < nplanes; ++plane) {
-            LvMapEobCost *pcost = &md_rate_estimation_array->eob_frac_bits[eob_multi_size][plane];
-            for (ctx = 0; ctx < 2; ++ctx) {
-                AomCdfProb *pcdf;
-                switch (eob_multi_size) {
-                case 0: pcdf = fc->eob_flag_cdf16[plane][ctx]; break;
-                case 1: pcdf = fc->eob_flag_cdf32[plane][ctx]; break;
-                case 2: pcdf = fc->eob_flag_cdf64[plane][ctx]; break;
-                case 3: pcdf = fc->eob_flag_cdf128[plane][ctx]; break;
-                case 4: pcdf = fc->eob_flag_cdf256[plane][ctx]; break;
-                case 5: pcdf = fc->eob_flag_cdf512[plane][ctx]; break;
-                case 6:
-                default: pcdf = fc->eob_flag_cdf1024[plane][ctx]; break;
-                }
-                av1_get_syntax_rate_from_cdf(pcost->eob_cost[ctx], pcdf, NULL);
-            }
-        }
-    }
-    for (tx_size = 0; tx_size < TX_SIZES; ++tx_size) {
-        for (plane = 0; plane < nplanes; ++plane) {
-            LvMapCoeffCost *pcost = &md_rate_estimation_array->coeff_fac_bits[tx_size][plane];
-
-            for (ctx = 0; ctx < TXB_SKIP_CONTEXTS; ++ctx)
-                av1_get_syntax_rate_from_cdf(
-                    pcost->txb_skip_cost[ctx], fc->txb_skip_cdf[tx_size][ctx], NULL);
-
-            for (ctx = 0; ctx < SIG_COEF_CONTEXTS_EOB; ++ctx)
-                av1_get_syntax_rate_from_cdf(
-                    pcost->base_eob_cost[ctx], fc->coeff_base_eob_cdf[tx_size][plane][ctx], NULL);
-            for (ctx = 0; ctx < SIG_COEF_CONTEXTS; ++ctx)
-                av1_get_syntax_rate_from_cdf(
-                    pcost->base_cost[ctx], fc->coeff_base_cdf[tx_size][plane][ctx], NULL);
-            for (int ctx = 0; ctx < SIG_COEF_CONTEXTS; ++ctx) {
-                pcost->base_cost[ctx][4] = 0;
-                pcost->base_cost[ctx][5] =
-                    pcost->base_cost[ctx][1] + av1_cost_literal(1) - pcost->base_cost[ctx][0];
-                pcost->base_cost[ctx][6] = pcost->base_cost[ctx][2] - pcost->base_cost[ctx][1];
-                pcost->base_cost[ctx][7] = pcost->base_cost[ctx][3] - pcost->base_cost[ctx][2];
-            }
-            for (ctx = 0; ctx < EOB_COEF_CONTEXTS; ++ctx)
-                av1_get_syntax_rate_from_cdf(
-                    pcost->eob_extra_cost[ctx], fc->eob_extra_cdf[tx_size][plane][ctx], NULL);
-
-            for (ctx = 0; ctx < DC_SIGN_CONTEXTS; ++ctx)
-                av1_get_syntax_rate_from_cdf(
-                    pcost->dc_sign_cost[ctx], fc->dc_sign_cdf[plane][ctx], NULL);
+    for (eob_multi_size = 0; eob_multi_size < 7; ++eob_multi_size)
+        for (plane = 0; plane < nplanes; ++plane)
+            estimate_eob_rate(md_rate_estimation_array, fc, eob_multi_size, plane);
+    for (tx_size = 0; tx_size < TX_SIZES; ++tx_size)
+        for (plane = 0; plane < nplanes; ++plane)
+            estimate_coeff_rate(md_rate_estimation_array, fc, tx_size, plane);
+}
+#if MD_RATE_EST_INCREMENTAL
+#define CDF_GROUP_CHANGED(fc, ref_fc, field) \
+    memcmp((fc)->field, (ref_fc)->field, sizeof((fc)->field))
 
-            for (ctx = 0; ctx < LEVEL_CONTEXTS; ++ctx) {
-                int32_t br_rate[BR_CDF_SIZE];
-                int32_t prev_cost = 0;
-                int32_t i, j;
+// Returns a non-zero value if the CDFs used by the (tx_size, plane) coefficient rates changed
+static int coeff_cdfs_changed(FRAME_CONTEXT *fc, const FRAME_CONTEXT *ref_fc, int32_t tx_size,
+                              int32_t plane) {
 #if TXS_DEPTH_2
-                av1_get_syntax_rate_from_cdf(br_rate, fc->coeff_br_cdf[AOMMIN(tx_size, TX_32X32)][plane][ctx], NULL);
+    const int32_t br_tx_size = AOMMIN(tx_size, TX_32X32);
 #else
-                av1_get_syntax_rate_from_cdf(br_rate, fc->coeff_br_cdf[tx_size][plane][ctx], NULL);
+    const int32_t br_tx_size = tx_size;
 #endif
-                // SVT_LOG("br_rate: ");
-                // for(j = 0; j < BR_CDF_SIZE; j++)
-                //  SVT_LOG("%4d ", br_rate[j]);
-                // SVT_LOG("\n");
-                for (i = 0; i < COEFF_BASE_RANGE; i += BR_CDF_SIZE - 1) {
-                    for (j = 0; j < BR_CDF_SIZE - 1; j++)
-                        pcost->lps_cost[ctx][i + j] = prev_cost + br_rate[j];
-                    prev_cost += br_rate[j];
-                }
-                pcost->lps_cost[ctx][i] = prev_cost;
-                // SVT_LOG("lps_cost: %d %d %2d : ", tx_size, plane, ctx);
-                // for (i = 0; i <= COEFF_BASE_RANGE; i++)
-                //  SVT_LOG("%5d ", pcost->lps_cost[ctx][i]);
-                // SVT_LOG("\n");
-            }
-            for (int ctx = 0; ctx < LEVEL_CONTEXTS; ++ctx) {
-                pcost->lps_cost[ctx][0 + COEFF_BASE_RANGE + 1] = pcost->lps_cost[ctx][0];
-                for (int i = 1; i <= COEFF_BASE_RANGE; ++i) {
-                    pcost->lps_cost[ctx][i + COEFF_BASE_RANGE + 1] =
-                        pcost->lps_cost[ctx][i] - pcost->lps_cost[ctx][i - 1];
-                }
-            }
-        }
-    }
+    return CDF_GROUP_CHANGED(fc, ref_fc, txb_skip_cdf[tx_size]) ||
+           CDF_GROUP_CHANGED(fc, ref_fc, coeff_base_eob_cdf[tx_size][plane]) ||
+           CDF_GROUP_CHANGED(fc, ref_fc, coeff_base_cdf[tx_size][plane]) ||
+           CDF_GROUP_CHANGED(fc, ref_fc, eob_extra_cdf[tx_size][plane]) ||
+           CDF_GROUP_CHANGED(fc, ref_fc, dc_sign_cdf[plane]) ||
+           CDF_GROUP_CHANGED(fc, ref_fc, coeff_br_cdf[br_tx_size][plane]);
+}
+
+/**************************************************************************
+* av1_estimate_rate_incremental()
+* Update a rate table built from the ref_fc CDFs to the fc CDFs.
+* The syntax, MV, EOB and coefficient rates are tracked per CDF group,
+* and only the groups whose CDFs differ are recomputed.
+***************************************************************************/
+void av1_estimate_rate_incremental(PictureControlSet *      pcs_ptr,
+                                   MdRateEstimationContext *md_rate_estimation_array,
+                                   FRAME_CONTEXT *fc, const FRAME_CONTEXT *ref_fc) {
+    const int32_t nplanes = AOMMIN(3, PLANE_TYPES);
+    // Mode syntax elements: all the CDFs from newmv_cdf to the end, except the MV ones
+    const size_t mode_cdfs_0 = offsetof(FRAME_CONTEXT, nmvc) - offsetof(FRAME_CONTEXT, newmv_cdf);
+    const size_t mode_cdfs_1 =
+        offsetof(FRAME_CONTEXT, initialized) - offsetof(FRAME_CONTEXT, intrabc_cdf);
+    if (memcmp(fc->newmv_cdf, ref_fc->newmv_cdf, mode_cdfs_0) ||
+        memcmp(fc->intrabc_cdf, ref_fc->intrabc_cdf, mode_cdfs_1))
+        av1_estimate_syntax_rate(md_rate_estimation_array, pcs_ptr->slice_type == I_SLICE, fc);
+
+    if (memcmp(&fc->nmvc, &ref_fc->nmvc, sizeof(fc->nmvc)) ||
+        (pcs_ptr->parent_pcs_ptr->frm_hdr.allow_intrabc &&
+         memcmp(&fc->ndvc, &ref_fc->ndvc, sizeof(fc->ndvc))))
+        av1_estimate_mv_rate(pcs_ptr, md_rate_estimation_array, fc);
+
+    for (int32_t eob_multi_size = 0; eob_multi_size < 7; ++eob_multi_size)
+        for (int32_t plane = 0; plane < nplanes; ++plane)
+            if (memcmp(get_eob_flag_cdf(fc, eob_multi_size, plane, 0),
+                       get_eob_flag_cdf((FRAME_CONTEXT *)ref_fc, eob_multi_size, plane, 0),
+                       2 * CDF_SIZE(5 + eob_multi_size) * sizeof(AomCdfProb)))
+                estimate_eob_rate(md_rate_estimation_array, fc, eob_multi_size, plane);
+
+    for (int32_t tx_size = 0; tx_size < TX_SIZES; ++tx_size)
+        for (int32_t plane = 0; plane < nplanes; ++plane)
+            if (coeff_cdfs_changed(fc, ref_fc, tx_size, plane))
+                estimate_coeff_rate(md_rate_estimation_array, fc, tx_size, plane);
 }
+#endif
 static INLINE int av1_get_skip_mode_context(const MacroBlockD *xd) {
     const MbModeInfo *const above_mi        = xd->above_mbmi;
     const MbModeInfo *const left_mi         = xd->left_mbmi;
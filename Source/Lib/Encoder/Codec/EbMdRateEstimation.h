@@ -209,6 +209,18 @@ extern void av1_estimate_mv_rate(
         struct PictureControlSet *pcs_ptr,
         MdRateEstimationContext  *md_rate_estimation_array,
         FRAME_CONTEXT            *fc);
+#if MD_RATE_EST_INCREMENTAL
+    /**************************************************************************
+    * av1_estimate_rate_incremental()
+    * Update a rate table built from the ref_fc CDFs to the fc CDFs:
+    * only the rates of the CDF groups that differ are recomputed
+    ***************************************************************************/
+extern void av1_estimate_rate_incremental(
+        struct PictureControlSet *pcs_ptr,
+        MdRateEstimationContext  *md_rate_estimation_array,
+        FRAME_CONTEXT            *fc,
+        const FRAME_CONTEXT      *ref_fc);
+#endif
 #define AVG_CDF_WEIGHT_LEFT      3
 #define AVG_CDF_WEIGHT_TOP       1
 
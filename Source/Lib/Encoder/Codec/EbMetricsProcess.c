@@ -0,0 +1,382 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <stdlib.h>
+
+#include "EbEncHandle.h"
+#include "EbMetricsProcess.h"
+#include "EbEncDecResults.h"
+#include "EbThreads.h"
+#include "EbUtility.h"
+#include "EbReferenceObject.h"
+#include "EbPictureControlSet.h"
+#include "EbPictureOperators.h"
+#include "common_dsp_rtcd.h"
+
+// The distortion kernels accumulate 32-bit partial sums and only cover widths up to 128
+#define METRICS_BLOCK_SIZE 64
+
+/**************************************
+ * Metrics Context
+ **************************************/
+typedef struct MetricsContext {
+    EbFifo *  metrics_input_fifo_ptr;
+    uint16_t *source16; // METRICS_BLOCK_SIZE x METRICS_BLOCK_SIZE 10 bit source block
+} MetricsContext;
+
+static void metrics_context_dctor(EbPtr p) {
+    EbThreadContext *thread_context_ptr = (EbThreadContext *)p;
+    MetricsContext * obj                = (MetricsContext *)thread_context_ptr->priv;
+    EB_FREE_ALIGNED_ARRAY(obj->source16);
+    EB_FREE_ARRAY(obj);
+}
+
+/******************************************************
+ * Metrics Context Constructor
+ ******************************************************/
+EbErrorType metrics_context_ctor(EbThreadContext *  thread_context_ptr,
+                                 const EbEncHandle *enc_handle_ptr, int index) {
+    MetricsContext *context_ptr;
+    EB_CALLOC_ARRAY(context_ptr, 1);
+    thread_context_ptr->priv  = context_ptr;
+    thread_context_ptr->dctor = metrics_context_dctor;
+
+    // Input System Resource Manager FIFO
+    context_ptr->metrics_input_fifo_ptr =
+        eb_system_resource_get_consumer_fifo(enc_handle_ptr->metrics_tasks_resource_ptr, index);
+
+    EB_MALLOC_ALIGNED_ARRAY(context_ptr->source16, METRICS_BLOCK_SIZE * METRICS_BLOCK_SIZE);
+
+    return EB_ErrorNone;
+}
+
+/******************************************************
+ * SSE of an 8 bit plane: the kernels take widths in multiples of 4 and
+ * heights in multiples of 2, the leftover column / row is summed in C
+ ******************************************************/
+static uint64_t sse_8bit(uint8_t *src, uint32_t src_stride, uint8_t *rec, uint32_t rec_stride,
+                         uint32_t width, uint32_t height) {
+    const uint32_t simd_width  = width & ~3;
+    const uint32_t simd_height = height & ~1;
+    uint64_t       sse         = 0;
+
+    for (uint32_t y = 0; y < simd_height; y += METRICS_BLOCK_SIZE) {
+        const uint32_t block_height = MIN(METRICS_BLOCK_SIZE, simd_height - y);
+        for (uint32_t x = 0; x < simd_width; x += METRICS_BLOCK_SIZE)
+            sse += spatial_full_distortion_kernel(src,
+                                                  y * src_stride + x,
+                                                  src_stride,
+                                                  rec,
+                                                  y * rec_stride + x,
+                                                  rec_stride,
+                                                  MIN(METRICS_BLOCK_SIZE, simd_width - x),
+                                                  block_height);
+    }
+
+    for (uint32_t y = 0; y < height; y++) {
+        for (uint32_t x = y < simd_height ? simd_width : 0; x < width; x++)
+            sse += SQR((int32_t)src[y * src_stride + x] - (int32_t)rec[y * rec_stride + x]);
+    }
+    return sse;
+}
+
+/******************************************************
+ * SSE of a 16 bit plane, same kernel constraints as sse_8bit
+ ******************************************************/
+static uint64_t sse_16bit(uint16_t *src, uint32_t src_stride, uint16_t *rec, uint32_t rec_stride,
+                          uint32_t width, uint32_t height) {
+    const uint32_t simd_width  = width & ~3;
+    const uint32_t simd_height = height & ~1;
+    uint64_t       sse         = 0;
+
+    for (uint32_t y = 0; y < simd_height; y += METRICS_BLOCK_SIZE) {
+        const uint32_t block_height = MIN(METRICS_BLOCK_SIZE, simd_height - y);
+        for (uint32_t x = 0; x < simd_width; x += METRICS_BLOCK_SIZE)
+            sse += full_distortion_kernel16_bits((uint8_t *)src,
+                                                 y * src_stride + x,
+                                                 src_stride,
+                                                 (uint8_t *)rec,
+                                                 y * rec_stride + x,
+                                                 rec_stride,
+                                                 MIN(METRICS_BLOCK_SIZE, simd_width - x),
+                                                 block_height);
+    }
+
+    for (uint32_t y = 0; y < height; y++) {
+        for (uint32_t x = y < simd_height ? simd_width : 0; x < width; x++)
+            sse += (uint64_t)SQR((int32_t)src[y * src_stride + x] - (int32_t)rec[y * rec_stride + x]);
+    }
+    return sse;
+}
+
+/******************************************************
+ * SSE of a 10 bit plane stored as 8 bit MSBs + 2 bit LSBs (one per byte):
+ * the source is packed one block at a time and compared with sse_16bit
+ ******************************************************/
+static uint64_t sse_10bit_unpacked(MetricsContext *context_ptr, uint8_t *src, uint32_t src_stride,
+                                   uint8_t *src_bit_inc, uint32_t src_bit_inc_stride,
+                                   uint16_t *rec, uint32_t rec_stride, uint32_t width,
+                                   uint32_t height) {
+    const uint32_t simd_width  = width & ~3;
+    const uint32_t simd_height = height & ~1;
+    uint64_t       sse         = 0;
+
+    for (uint32_t y = 0; y < simd_height; y += METRICS_BLOCK_SIZE) {
+        const uint32_t block_height = MIN(METRICS_BLOCK_SIZE, simd_height - y);
+        for (uint32_t x = 0; x < simd_width; x += METRICS_BLOCK_SIZE) {
+            const uint32_t block_width = MIN(METRICS_BLOCK_SIZE, simd_width - x);
+            pack2d_16_bit_src_mul4(src + y * src_stride + x,
+                                   src_stride,
+                                   src_bit_inc + y * src_bit_inc_stride + x,
+                                   context_ptr->source16,
+                                   src_bit_inc_stride,
+                                   METRICS_BLOCK_SIZE,
+                                   block_width,
+                                   block_height);
+            sse += sse_16bit(context_ptr->source16,
+                             METRICS_BLOCK_SIZE,
+                             rec + y * rec_stride + x,
+                             rec_stride,
+                             block_width,
+                             block_height);
+        }
+    }
+
+    for (uint32_t y = 0; y < height; y++) {
+        for (uint32_t x = y < simd_height ? simd_width : 0; x < width; x++) {
+            const int32_t src_pixel = (src[y * src_stride + x] << 2) |
+                                      ((src_bit_inc[y * src_bit_inc_stride + x] >> 6) & 3);
+            sse += SQR(src_pixel - (int32_t)rec[y * rec_stride + x]);
+        }
+    }
+    return sse;
+}
+
+/******************************************************
+ * SSE of a 10 bit plane in the compressed format (4 LSB pairs per byte laid
+ * out per SB). As in the scalar reference, only multiples of 4 columns of
+ * each SB are measured.
+ ******************************************************/
+static uint64_t sse_10bit_compressed(MetricsContext *context_ptr, uint8_t *src,
+                                     uint32_t src_stride, uint8_t *src_bit_inc, uint16_t *rec,
+                                     uint32_t rec_stride, uint32_t width, uint32_t height,
+                                     uint32_t sb_size) {
+    const uint32_t bit_inc_width = width / 4;
+    uint64_t       sse           = 0;
+
+    for (uint32_t y = 0; y < height; y += sb_size) {
+        const uint32_t sb_height = MIN(sb_size, height - y);
+        for (uint32_t x = 0; x < width; x += sb_size) {
+            const uint32_t sb_width = MIN(sb_size, width - x);
+            compressed_pack_sb(src + y * src_stride + x,
+                               src_stride,
+                               src_bit_inc + y * bit_inc_width + (x / 4) * sb_height,
+                               sb_width / 4,
+                               context_ptr->source16,
+                               METRICS_BLOCK_SIZE,
+                               sb_width,
+                               sb_height);
+            sse += sse_16bit(context_ptr->source16,
+                             METRICS_BLOCK_SIZE,
+                             rec + y * rec_stride + x,
+                             rec_stride,
+                             sb_width & ~3,
+                             sb_height);
+        }
+    }
+    return sse;
+}
+
+/******************************************************
+ * Per plane SSE between the final recon and the unfiltered source
+ ******************************************************/
+static void picture_sse(MetricsContext *context_ptr, PictureControlSet *pcs_ptr,
+                        SequenceControlSet *scs_ptr) {
+    PictureParentControlSet *ppcs_ptr = pcs_ptr->parent_pcs_ptr;
+    EbBool is_16bit = (EbBool)(scs_ptr->static_config.encoder_bit_depth > EB_8BIT);
+    const uint32_t ss_x     = scs_ptr->subsampling_x;
+    const uint32_t ss_y     = scs_ptr->subsampling_y;
+    EbPictureBufferDesc *input_picture_ptr =
+        (EbPictureBufferDesc *)ppcs_ptr->enhanced_unscaled_picture_ptr;
+    EbPictureBufferDesc *recon_ptr;
+    uint64_t             sse_total[3];
+
+    if (ppcs_ptr->is_used_as_reference_flag == EB_TRUE) {
+        EbReferenceObject *ref_obj =
+            (EbReferenceObject *)ppcs_ptr->reference_picture_wrapper_ptr->object_ptr;
+        recon_ptr = is_16bit ? ref_obj->reference_picture16bit : ref_obj->reference_picture;
+    } else
+        recon_ptr = is_16bit ? pcs_ptr->recon_picture16bit_ptr : pcs_ptr->recon_picture_ptr;
+
+    const uint32_t width         = input_picture_ptr->width;
+    const uint32_t height        = input_picture_ptr->height;
+    const uint32_t chroma_width  = width >> ss_x;
+    const uint32_t chroma_height = height >> ss_y;
+    const uint32_t input_luma_offset =
+        input_picture_ptr->origin_x + input_picture_ptr->origin_y * input_picture_ptr->stride_y;
+    const uint32_t input_cb_offset = (input_picture_ptr->origin_x >> ss_x) +
+                                     (input_picture_ptr->origin_y >> ss_y) *
+                                         input_picture_ptr->stride_cb;
+    const uint32_t input_cr_offset = (input_picture_ptr->origin_x >> ss_x) +
+                                     (input_picture_ptr->origin_y >> ss_y) *
+                                         input_picture_ptr->stride_cr;
+    const uint32_t recon_luma_offset =
+        recon_ptr->origin_x + recon_ptr->origin_y * recon_ptr->stride_y;
+    const uint32_t recon_cb_offset =
+        (recon_ptr->origin_x >> ss_x) + (recon_ptr->origin_y >> ss_y) * recon_ptr->stride_cb;
+    const uint32_t recon_cr_offset =
+        (recon_ptr->origin_x >> ss_x) + (recon_ptr->origin_y >> ss_y) * recon_ptr->stride_cr;
+
+    // if current source picture was temporally filtered, use an alternative buffer which stores
+    // the original source picture
+    const EbBool use_saved_source = ppcs_ptr->temporal_filtering_on == EB_TRUE;
+    EbByte       buffer_y  = use_saved_source ? ppcs_ptr->save_enhanced_picture_ptr[0]
+                                             : input_picture_ptr->buffer_y;
+    EbByte       buffer_cb = use_saved_source ? ppcs_ptr->save_enhanced_picture_ptr[1]
+                                              : input_picture_ptr->buffer_cb;
+    EbByte       buffer_cr = use_saved_source ? ppcs_ptr->save_enhanced_picture_ptr[2]
+                                              : input_picture_ptr->buffer_cr;
+    EbByte buffer_bit_inc_y  = use_saved_source ? ppcs_ptr->save_enhanced_picture_bit_inc_ptr[0]
+                                                : input_picture_ptr->buffer_bit_inc_y;
+    EbByte buffer_bit_inc_cb = use_saved_source ? ppcs_ptr->save_enhanced_picture_bit_inc_ptr[1]
+                                                : input_picture_ptr->buffer_bit_inc_cb;
+    EbByte buffer_bit_inc_cr = use_saved_source ? ppcs_ptr->save_enhanced_picture_bit_inc_ptr[2]
+                                                : input_picture_ptr->buffer_bit_inc_cr;
+
+    if (!is_16bit) {
+        sse_total[0] = sse_8bit(buffer_y + input_luma_offset,
+                                input_picture_ptr->stride_y,
+                                recon_ptr->buffer_y + recon_luma_offset,
+                                recon_ptr->stride_y,
+                                width,
+                                height);
+        sse_total[1] = sse_8bit(buffer_cb + input_cb_offset,
+                                input_picture_ptr->stride_cb,
+                                recon_ptr->buffer_cb + recon_cb_offset,
+                                recon_ptr->stride_cb,
+                                chroma_width,
+                                chroma_height);
+        sse_total[2] = sse_8bit(buffer_cr + input_cr_offset,
+                                input_picture_ptr->stride_cr,
+                                recon_ptr->buffer_cr + recon_cr_offset,
+                                recon_ptr->stride_cr,
+                                chroma_width,
+                                chroma_height);
+    } else if (scs_ptr->static_config.ten_bit_format == 1) {
+        sse_total[0] = sse_10bit_compressed(context_ptr,
+                                            buffer_y + input_luma_offset,
+                                            input_picture_ptr->stride_y,
+                                            buffer_bit_inc_y,
+                                            (uint16_t *)recon_ptr->buffer_y + recon_luma_offset,
+                                            recon_ptr->stride_y,
+                                            width,
+                                            height,
+                                            64);
+        sse_total[1] = sse_10bit_compressed(context_ptr,
+                                            buffer_cb + input_cb_offset,
+                                            input_picture_ptr->stride_cb,
+                                            buffer_bit_inc_cb,
+                                            (uint16_t *)recon_ptr->buffer_cb + recon_cb_offset,
+                                            recon_ptr->stride_cb,
+                                            chroma_width,
+                                            chroma_height,
+                                            64 >> ss_x);
+        sse_total[2] = sse_10bit_compressed(context_ptr,
+                                            buffer_cr + input_cr_offset,
+                                            input_picture_ptr->stride_cr,
+                                            buffer_bit_inc_cr,
+                                            (uint16_t *)recon_ptr->buffer_cr + recon_cr_offset,
+                                            recon_ptr->stride_cr,
+                                            chroma_width,
+                                            chroma_height,
+                                            64 >> ss_x);
+    } else {
+        const uint32_t input_luma_bit_inc_offset =
+            input_picture_ptr->origin_x +
+            input_picture_ptr->origin_y * input_picture_ptr->stride_bit_inc_y;
+        const uint32_t input_cb_bit_inc_offset =
+            (input_picture_ptr->origin_x >> ss_x) +
+            (input_picture_ptr->origin_y >> ss_y) * input_picture_ptr->stride_bit_inc_cb;
+        const uint32_t input_cr_bit_inc_offset =
+            (input_picture_ptr->origin_x >> ss_x) +
+            (input_picture_ptr->origin_y >> ss_y) * input_picture_ptr->stride_bit_inc_cr;
+
+        sse_total[0] = sse_10bit_unpacked(context_ptr,
+                                          buffer_y + input_luma_offset,
+                                          input_picture_ptr->stride_y,
+                                          buffer_bit_inc_y + input_luma_bit_inc_offset,
+                                          input_picture_ptr->stride_bit_inc_y,
+                                          (uint16_t *)recon_ptr->buffer_y + recon_luma_offset,
+                                          recon_ptr->stride_y,
+                                          width,
+                                          height);
+        sse_total[1] = sse_10bit_unpacked(context_ptr,
+                                          buffer_cb + input_cb_offset,
+                                          input_picture_ptr->stride_cb,
+                                          buffer_bit_inc_cb + input_cb_bit_inc_offset,
+                                          input_picture_ptr->stride_bit_inc_cb,
+                                          (uint16_t *)recon_ptr->buffer_cb + recon_cb_offset,
+                                          recon_ptr->stride_cb,
+                                          chroma_width,
+                                          chroma_height);
+        sse_total[2] = sse_10bit_unpacked(context_ptr,
+                                          buffer_cr + input_cr_offset,
+                                          input_picture_ptr->stride_cr,
+                                          buffer_bit_inc_cr + input_cr_bit_inc_offset,
+                                          input_picture_ptr->stride_bit_inc_cr,
+                                          (uint16_t *)recon_ptr->buffer_cr + recon_cr_offset,
+                                          recon_ptr->stride_cr,
+                                          chroma_width,
+                                          chroma_height);
+    }
+
+    if (use_saved_source) {
+        for (int plane = 0; plane < 3; plane++) {
+            EB_FREE_ARRAY(ppcs_ptr->save_enhanced_picture_ptr[plane]);
+            if (is_16bit) EB_FREE_ARRAY(ppcs_ptr->save_enhanced_picture_bit_inc_ptr[plane]);
+        }
+    }
+
+    ppcs_ptr->luma_sse = (uint32_t)sse_total[0];
+    ppcs_ptr->cb_sse   = (uint32_t)sse_total[1];
+    ppcs_ptr->cr_sse   = (uint32_t)sse_total[2];
+}
+
+/******************************************************
+ * Metrics Kernel
+ * Computes the stat_report SSEs off the REST -> EC critical path. The
+ * picture stays alive since packetization waits on metrics_done_semaphore
+ * before releasing it; the reference picture is held by the task.
+ ******************************************************/
+void *metrics_kernel(void *input_ptr) {
+    EbThreadContext *thread_context_ptr = (EbThreadContext *)input_ptr;
+    MetricsContext * context_ptr        = (MetricsContext *)thread_context_ptr->priv;
+
+    //// Input
+    EbObjectWrapper *metrics_tasks_wrapper_ptr;
+    MetricsTasks *   metrics_tasks_ptr;
+
+    for (;;) {
+        // Get Metrics Tasks
+        EB_GET_FULL_OBJECT(context_ptr->metrics_input_fifo_ptr, &metrics_tasks_wrapper_ptr);
+        metrics_tasks_ptr = (MetricsTasks *)metrics_tasks_wrapper_ptr->object_ptr;
+        PictureControlSet *pcs_ptr =
+            (PictureControlSet *)metrics_tasks_ptr->pcs_wrapper_ptr->object_ptr;
+        SequenceControlSet *scs_ptr = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
+
+        picture_sse(context_ptr, pcs_ptr, scs_ptr);
+
+        if (metrics_tasks_ptr->reference_picture_wrapper_ptr)
+            eb_release_object(metrics_tasks_ptr->reference_picture_wrapper_ptr);
+
+        // pcs_ptr may be recycled by packetization from here on
+        eb_post_semaphore(pcs_ptr->metrics_done_semaphore);
+
+        // Release Metrics Tasks
+        eb_release_object(metrics_tasks_wrapper_ptr);
+    }
+
+    return NULL;
+}
@@ -0,0 +1,19 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef EbMetricsProcess_h
+#define EbMetricsProcess_h
+
+#include "EbDefinitions.h"
+
+/**************************************
+ * Extern Function Declarations
+ **************************************/
+extern EbErrorType metrics_context_ctor(EbThreadContext *  thread_context_ptr,
+                                        const EbEncHandle *enc_handle_ptr, int index);
+
+extern void *metrics_kernel(void *input_ptr);
+
+#endif // EbMetricsProcess_h
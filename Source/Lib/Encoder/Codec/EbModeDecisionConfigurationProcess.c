@@ -1406,6 +1406,9 @@ void *mode_decision_configuration_kernel(void *input_ptr) {
 
         pcs_ptr->parent_pcs_ptr->average_qp = 0;
         pcs_ptr->intra_coded_area           = 0;
+#if MD_CAND_CLASS_STATS
+        memset(&pcs_ptr->md_class_stats, 0, sizeof(MdClassStats));
+#endif
         // Compute Tc, and Beta offsets for a given picture
         // Set reference cdef strength
         set_reference_cdef_strength(pcs_ptr);
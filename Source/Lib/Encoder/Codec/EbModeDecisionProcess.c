@@ -16,8 +16,13 @@ static void mode_decision_context_dctor(EbPtr p) {
             EB_FREE_ARRAY(obj->palette_cand_array[cd].color_idx_map);
     for (uint32_t cand_index = 0; cand_index < MODE_DECISION_CANDIDATE_MAX_COUNT; ++cand_index) {
         if (obj->fast_candidate_ptr_array[cand_index]->palette_info.color_idx_map)
+#if SB_SIZE_BASED_BLK_ALLOC
+            for (uint32_t coded_leaf_index = 0; coded_leaf_index < obj->max_block_cnt;
+                 ++coded_leaf_index)
+#else
             for (uint32_t coded_leaf_index = 0; coded_leaf_index < BLOCK_MAX_COUNT_SB_128;
                  ++coded_leaf_index)
+#endif
                 if (obj->md_blk_arr_nsq[coded_leaf_index].palette_info.color_idx_map)
                     EB_FREE_ARRAY(obj->md_blk_arr_nsq[coded_leaf_index].palette_info.color_idx_map);
         EB_FREE_ARRAY(obj->fast_candidate_ptr_array[cand_index]->palette_info.color_idx_map);
@@ -77,7 +82,11 @@ static void mode_decision_context_dctor(EbPtr p) {
 EbErrorType mode_decision_context_ctor(ModeDecisionContext *context_ptr, EbColorFormat color_format,
                                        EbFifo *mode_decision_configuration_input_fifo_ptr,
                                        EbFifo *mode_decision_output_fifo_ptr,
-                                       uint8_t enable_hbd_mode_decision, uint8_t cfg_palette) {
+                                       uint8_t enable_hbd_mode_decision, uint8_t cfg_palette
+#if SB_SIZE_BASED_BLK_ALLOC
+                                       , uint8_t sb_size
+#endif
+                                       ) {
     uint32_t buffer_index;
     uint32_t cand_index;
 
@@ -85,6 +94,15 @@ EbErrorType mode_decision_context_ctor(ModeDecisionContext *context_ptr, EbColor
 
     context_ptr->dctor             = mode_decision_context_dctor;
     context_ptr->hbd_mode_decision = enable_hbd_mode_decision;
+#if SB_SIZE_BASED_BLK_ALLOC
+    // Per block buffers are sized to the active SB size
+    const uint32_t max_block_cnt = sb_size == 128 ? BLOCK_MAX_COUNT_SB_128 : BLOCK_MAX_COUNT_SB_64;
+    const uint32_t max_blk_size  = sb_size;
+    context_ptr->max_block_cnt   = (uint16_t)max_block_cnt;
+#else
+    const uint32_t max_block_cnt = BLOCK_MAX_COUNT_SB_128;
+    const uint32_t max_blk_size  = 128;
+#endif
 
     // Input/Output System Resource Manager FIFOs
     context_ptr->mode_decision_configuration_input_fifo_ptr =
@@ -100,9 +118,9 @@ EbErrorType mode_decision_context_ctor(ModeDecisionContext *context_ptr, EbColor
     EB_MALLOC_ARRAY(context_ptr->md_rate_estimation_ptr, 1);
     context_ptr->is_md_rate_estimation_ptr_owner = EB_TRUE;
 
-    EB_MALLOC_ARRAY(context_ptr->md_local_blk_unit, BLOCK_MAX_COUNT_SB_128);
-    EB_MALLOC_ARRAY(context_ptr->md_blk_arr_nsq, BLOCK_MAX_COUNT_SB_128);
-    EB_MALLOC_ARRAY(context_ptr->md_ep_pipe_sb, BLOCK_MAX_COUNT_SB_128);
+    EB_MALLOC_ARRAY(context_ptr->md_local_blk_unit, max_block_cnt);
+    EB_MALLOC_ARRAY(context_ptr->md_blk_arr_nsq, max_block_cnt);
+    EB_MALLOC_ARRAY(context_ptr->md_ep_pipe_sb, max_block_cnt);
 
     // Fast Candidate Array
     EB_MALLOC_ARRAY(context_ptr->fast_candidate_array, MODE_DECISION_CANDIDATE_MAX_COUNT);
@@ -171,27 +189,27 @@ EbErrorType mode_decision_context_ctor(ModeDecisionContext *context_ptr, EbColor
     uint16_t sz                                                 = sizeof(uint16_t);
     if (context_ptr->hbd_mode_decision > EB_8_BIT_MD) {
         EB_MALLOC_ARRAY(context_ptr->md_local_blk_unit[0].neigh_left_recon_16bit[0],
-                        BLOCK_MAX_COUNT_SB_128 * 128 * 3 * sz);
+                        max_block_cnt * max_blk_size * 3 * sz);
         EB_MALLOC_ARRAY(context_ptr->md_local_blk_unit[0].neigh_top_recon_16bit[0],
-                        BLOCK_MAX_COUNT_SB_128 * 128 * 3 * sz);
+                        max_block_cnt * max_blk_size * 3 * sz);
     }
     if (context_ptr->hbd_mode_decision != EB_10_BIT_MD) {
         EB_MALLOC_ARRAY(context_ptr->md_local_blk_unit[0].neigh_left_recon[0],
-                        BLOCK_MAX_COUNT_SB_128 * 128 * 3);
+                        max_block_cnt * max_blk_size * 3);
         EB_MALLOC_ARRAY(context_ptr->md_local_blk_unit[0].neigh_top_recon[0],
-                        BLOCK_MAX_COUNT_SB_128 * 128 * 3);
+                        max_block_cnt * max_blk_size * 3);
     }
     uint32_t coded_leaf_index;
-    for (coded_leaf_index = 0; coded_leaf_index < BLOCK_MAX_COUNT_SB_128; ++coded_leaf_index) {
+    for (coded_leaf_index = 0; coded_leaf_index < max_block_cnt; ++coded_leaf_index) {
         for (int i = 0; i < 3; i++) {
-            size_t offset = (coded_leaf_index * 128 * 3 + i * 128) * sz;
+            size_t offset = (coded_leaf_index * max_blk_size * 3 + i * max_blk_size) * sz;
             context_ptr->md_local_blk_unit[coded_leaf_index].neigh_left_recon_16bit[i] =
                 context_ptr->md_local_blk_unit[0].neigh_left_recon_16bit[0] + offset;
             context_ptr->md_local_blk_unit[coded_leaf_index].neigh_top_recon_16bit[i] =
                 context_ptr->md_local_blk_unit[0].neigh_top_recon_16bit[0] + offset;
         }
         for (int i = 0; i < 3; i++) {
-            size_t offset = coded_leaf_index * 128 * 3 + i * 128;
+            size_t offset = coded_leaf_index * max_blk_size * 3 + i * max_blk_size;
             context_ptr->md_local_blk_unit[coded_leaf_index].neigh_left_recon[i] =
                 context_ptr->md_local_blk_unit[0].neigh_left_recon[0] + offset;
             context_ptr->md_local_blk_unit[coded_leaf_index].neigh_top_recon[i] =
@@ -199,8 +217,8 @@ EbErrorType mode_decision_context_ctor(ModeDecisionContext *context_ptr, EbColor
         }
     }
     context_ptr->md_blk_arr_nsq[0].av1xd                     = NULL;
-    EB_MALLOC_ARRAY(context_ptr->md_blk_arr_nsq[0].av1xd, BLOCK_MAX_COUNT_SB_128);
-    for (coded_leaf_index = 0; coded_leaf_index < BLOCK_MAX_COUNT_SB_128; ++coded_leaf_index) {
+    EB_MALLOC_ARRAY(context_ptr->md_blk_arr_nsq[0].av1xd, max_block_cnt);
+    for (coded_leaf_index = 0; coded_leaf_index < max_block_cnt; ++coded_leaf_index) {
         context_ptr->md_blk_arr_nsq[coded_leaf_index].av1xd =
             context_ptr->md_blk_arr_nsq[0].av1xd + coded_leaf_index;
         context_ptr->md_blk_arr_nsq[coded_leaf_index].segment_id = 0;
@@ -603,3 +621,17 @@ void mode_decision_configure_sb(ModeDecisionContext *context_ptr, PictureControl
 
     return;
 }
+#if MD_CAND_CLASS_STATS
+/******************************************************
+ * Add the candidate class counters of src to dst
+ ******************************************************/
+void md_class_stats_accumulate(MdClassStats *dst, const MdClassStats *src) {
+    for (int cand_class = CAND_CLASS_0; cand_class < CAND_CLASS_TOTAL; cand_class++) {
+        for (int stage = MD_STAGE_0; stage < MD_STAGE_TOTAL; stage++) {
+            dst->cand_count[stage][cand_class] += src->cand_count[stage][cand_class];
+            dst->cycles[stage][cand_class] += src->cycles[stage][cand_class];
+        }
+        dst->win_count[cand_class] += src->win_count[cand_class];
+    }
+}
+#endif
@@ -357,6 +357,10 @@ typedef struct ModeDecisionContext {
     uint8_t combine_class12; // 1:class1 and 2 are combined.
 
     CandClass target_class;
+#if MD_CAND_CLASS_STATS
+    MdClassStats md_class_stats;
+    uint8_t      md_class_stats_enabled; // stat_report 2, set per picture
+#endif
 
     // fast_loop_core signals
     EbBool md_staging_use_bilinear;
@@ -409,6 +413,11 @@ typedef struct ModeDecisionContext {
     uint8_t      tx_search_level;
     uint64_t     tx_weight;
     uint8_t      tx_search_reduced_set;
+#if TX_TYPE_PRUNING
+    uint8_t      tx_type_pruning_level;
+    // Tx types selected by tx_type_search() in the current SB, per [is_inter][tx_size]
+    uint32_t     tx_type_hist[2][TX_SIZES_ALL][TX_TYPES];
+#endif
     uint8_t      interpolation_search_level;
     uint8_t      md_tx_size_search_mode;
     uint8_t      md_pic_obmc_mode;
@@ -424,6 +433,10 @@ typedef struct ModeDecisionContext {
 
     // Signal to control initial and final pass PD setting(s)
     PdPass pd_pass;
+#if SB_SIZE_BASED_BLK_ALLOC
+    // Number of blocks of the per block arrays (md_blk_arr_nsq, md_local_blk_unit, ...)
+    uint16_t max_block_cnt;
+#endif
 
 } ModeDecisionContext;
 
@@ -451,7 +464,11 @@ extern EbErrorType mode_decision_context_ctor(ModeDecisionContext *context_ptr,
                                               EbFifo *mode_decision_configuration_input_fifo_ptr,
                                               EbFifo *mode_decision_output_fifo_ptr,
                                               uint8_t enable_hbd_mode_decision,
-                                              uint8_t cfg_palette);
+                                              uint8_t cfg_palette
+#if SB_SIZE_BASED_BLK_ALLOC
+                                              , uint8_t sb_size
+#endif
+                                              );
 
 #if !TILES_PARALLEL
 extern void reset_mode_decision_neighbor_arrays(PictureControlSet *pcs_ptr);
@@ -496,6 +513,9 @@ extern void cfl_rd_pick_alpha(PictureControlSet *          pcs_ptr,
                               ModeDecisionContext *context_ptr,
                               EbPictureBufferDesc *input_picture_ptr,
                               uint32_t input_cb_origin_in_index, uint32_t blk_chroma_origin_index);
+#if MD_CAND_CLASS_STATS
+extern void md_class_stats_accumulate(MdClassStats *dst, const MdClassStats *src);
+#endif
 
 #ifdef __cplusplus
 }
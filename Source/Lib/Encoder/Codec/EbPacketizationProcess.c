@@ -39,6 +39,10 @@ typedef struct PacketizationContext {
     uint64_t     dpb_disp_order[8], dpb_dec_order[8];
     uint64_t     tot_shown_frames;
     uint64_t     disp_order_continuity_count;
+#if MD_CAND_CLASS_STATS
+    MdClassStats md_class_stats[MAX_TEMPORAL_LAYERS];
+    uint8_t      md_class_stats_enabled; // StatReport 2
+#endif
 } PacketizationContext;
 
 static EbBool is_passthrough_data(EbLinkedListNode *data_node) { return data_node->passthrough; }
@@ -519,6 +523,45 @@ static void print_detailed_frame_info(PacketizationContext* context_ptr, const P
 }
 #endif
 
+#if MD_CAND_CLASS_STATS
+static const char *md_class_name[CAND_CLASS_TOTAL] = {
+    "INTRA", "NEWMV", "MVP", "COMPOUND", "II", "OBMC", "FILTER_INTRA", "PALETTE", "GLOBAL"};
+
+static void print_md_class_stats(const MdClassStats *stats) {
+    uint64_t tot_win    = 0;
+    uint64_t tot_cycles = 0;
+    for (int c = CAND_CLASS_0; c < CAND_CLASS_TOTAL; c++) {
+        tot_win += stats->win_count[c];
+        for (int s = MD_STAGE_0; s < MD_STAGE_TOTAL; s++) tot_cycles += stats->cycles[s][c];
+    }
+    SVT_LOG("  class         injected  stage_1  stage_2  stage_3     wins  win%%  cyc%%\n");
+    for (int c = CAND_CLASS_0; c < CAND_CLASS_TOTAL; c++) {
+        uint64_t cycles = 0;
+        for (int s = MD_STAGE_0; s < MD_STAGE_TOTAL; s++) cycles += stats->cycles[s][c];
+        SVT_LOG("  %-12s %9llu %8llu %8llu %8llu %8llu %5.1f %5.1f\n",
+                md_class_name[c],
+                (unsigned long long)stats->cand_count[MD_STAGE_0][c],
+                (unsigned long long)stats->cand_count[MD_STAGE_1][c],
+                (unsigned long long)stats->cand_count[MD_STAGE_2][c],
+                (unsigned long long)stats->cand_count[MD_STAGE_3][c],
+                (unsigned long long)stats->win_count[c],
+                tot_win ? 100.0 * stats->win_count[c] / tot_win : 0.0,
+                tot_cycles ? 100.0 * cycles / tot_cycles : 0.0);
+    }
+}
+
+static void print_md_class_report(const PacketizationContext *context_ptr) {
+    for (int layer = 0; layer < MAX_TEMPORAL_LAYERS; layer++) {
+        uint64_t injected = 0;
+        for (int c = CAND_CLASS_0; c < CAND_CLASS_TOTAL; c++)
+            injected += context_ptr->md_class_stats[layer].cand_count[MD_STAGE_0][c];
+        if (!injected) continue;
+        SVT_LOG("SVT [info]: MD candidate classes, temporal layer %d\n", layer);
+        print_md_class_stats(&context_ptr->md_class_stats[layer]);
+    }
+}
+#endif
+
 static void collect_frames_info(PacketizationContext* context_ptr, const EncodeContext *encode_context_ptr, int frames) {
     for (int i = 0; i < frames; i++) {
         PacketizationReorderEntry *queue_entry_ptr = get_reorder_queue_entry(encode_context_ptr, i);
@@ -527,6 +570,15 @@ static void collect_frames_info(PacketizationContext* context_ptr, const EncodeC
         print_detailed_frame_info(context_ptr, queue_entry_ptr) ;
 #else
         (void)context_ptr;
+#endif
+#if MD_CAND_CLASS_STATS
+        if (context_ptr->md_class_stats_enabled) {
+            SVT_LOG("POC %i: MD candidate classes\n", (int32_t)queue_entry_ptr->poc);
+            print_md_class_stats(&queue_entry_ptr->md_class_stats);
+            md_class_stats_accumulate(
+                &context_ptr->md_class_stats[queue_entry_ptr->temporal_layer_index],
+                &queue_entry_ptr->md_class_stats);
+        }
 #endif
         // Calculate frame latency in milliseconds
         double   latency               = 0.0;
@@ -550,6 +602,80 @@ static void collect_frames_info(PacketizationContext* context_ptr, const EncodeC
 
 #define TD_SIZE 2
 
+#if PKT_ZERO_COPY
+// Frames are written at TD_SIZE in their packet, so a tu can get its td in front of the first
+// frame without moving it.
+static void write_frame_obus(EncodeContext *encode_context_ptr, SequenceControlSet *scs_ptr,
+                             PictureControlSet *pcs_ptr, EbBufferHeaderType *output_stream_ptr) {
+    Bitstream           bitstream;
+    OutputBitstreamUnit output_bitstream;
+
+    CHECK_REPORT_ERROR((TD_SIZE + FRAME_OBU_HEADERS_MAX_SIZE + get_frame_tile_data_size(pcs_ptr) <=
+                        output_stream_ptr->n_alloc_len),
+                       encode_context_ptr->app_callback_ptr,
+                       EB_ENC_EC_ERROR2);
+
+    memset(&bitstream, 0, sizeof(Bitstream));
+    memset(&output_bitstream, 0, sizeof(OutputBitstreamUnit));
+    bitstream.output_bitstream_ptr    = &output_bitstream;
+    output_bitstream.buffer_begin_av1 = output_stream_ptr->p_buffer + TD_SIZE;
+    output_bitstream_reset(&output_bitstream);
+
+    // Code the SPS
+    if (pcs_ptr->parent_pcs_ptr->frm_hdr.frame_type == KEY_FRAME)
+        encode_sps_av1(&bitstream, scs_ptr);
+
+    write_frame_header_av1(&bitstream, scs_ptr, pcs_ptr, 0);
+
+    output_stream_ptr->n_filled_len = (uint32_t)bitstream_get_bytes_count(&bitstream);
+}
+
+//a tu start with a td, + 0 more not displable frame, + 1 display frame
+static void encode_tu(EncodeContext *encode_context_ptr, int frames, int total_bytes,
+                      EbBufferHeaderType *output_stream_ptr) {
+    total_bytes += TD_SIZE;
+    if (total_bytes > (int)output_stream_ptr->n_alloc_len) {
+        SVT_ERROR("encode size(%d) is too large", total_bytes);
+        return;
+    }
+    //the tu is gathered behind the first frame, which stays in place (it is usually the alt ref,
+    //the largest frame of the tu). the buffer is then handed to the last frame's output_stream_ptr,
+    //which carries the pts.
+    int                 last          = frames - 1;
+    EbBufferHeaderType *tu_stream_ptr =
+        (EbBufferHeaderType *)get_reorder_queue_entry(encode_context_ptr, 0)
+            ->output_stream_wrapper_ptr->object_ptr;
+    uint8_t *dst = tu_stream_ptr->p_buffer + TD_SIZE + tu_stream_ptr->n_filled_len;
+    for (int i = 1; i <= last; i++) {
+        PacketizationReorderEntry *queue_entry_ptr = get_reorder_queue_entry(encode_context_ptr, i);
+        EbBufferHeaderType *       src_stream_ptr =
+            (EbBufferHeaderType *)queue_entry_ptr->output_stream_wrapper_ptr->object_ptr;
+        memcpy(dst, src_stream_ptr->p_buffer + TD_SIZE, src_stream_ptr->n_filled_len);
+        dst += src_stream_ptr->n_filled_len;
+    }
+    for (int i = 0; i < last; i++) {
+        PacketizationReorderEntry *queue_entry_ptr = get_reorder_queue_entry(encode_context_ptr, i);
+        //1. The last frame is a displayable frame, others are undisplayed.
+        //2. We do not push alt ref frame since the overlay frame will carry the pts.
+        if (!queue_entry_ptr->is_alt_ref)
+            push_undisplayed_frame(encode_context_ptr, queue_entry_ptr->output_stream_wrapper_ptr);
+    }
+    if (frames > 1) {
+        uint8_t *      tu_buffer    = tu_stream_ptr->p_buffer;
+        const uint32_t tu_app_flag  = tu_stream_ptr->flags & EB_BUFFERFLAG_APP_BUFFER;
+        tu_stream_ptr->p_buffer     = output_stream_ptr->p_buffer;
+        output_stream_ptr->p_buffer = tu_buffer;
+        tu_stream_ptr->flags = (tu_stream_ptr->flags & ~EB_BUFFERFLAG_APP_BUFFER) |
+                               (output_stream_ptr->flags & EB_BUFFERFLAG_APP_BUFFER);
+        output_stream_ptr->flags = (output_stream_ptr->flags & ~EB_BUFFERFLAG_APP_BUFFER) |
+                                   tu_app_flag;
+        sort_undisplayed_frame(encode_context_ptr);
+    }
+    encode_td_av1(output_stream_ptr->p_buffer);
+    output_stream_ptr->n_filled_len = total_bytes;
+    output_stream_ptr->flags |= EB_BUFFERFLAG_HAS_TD;
+}
+#else
 //a tu start with a td, + 0 more not displable frame, + 1 display frame
 static void encode_tu(EncodeContext *encode_context_ptr, int frames, int total_bytes,
                       EbBufferHeaderType *output_stream_ptr) {
@@ -580,6 +706,7 @@ static void encode_tu(EncodeContext *encode_context_ptr, int frames, int total_b
     output_stream_ptr->n_filled_len = total_bytes;
     output_stream_ptr->flags |= EB_BUFFERFLAG_HAS_TD;
 }
+#endif
 
 static EbErrorType copy_data_from_bitstream(EncodeContext *encode_context_ptr, Bitstream *bitstream_ptr, EbBufferHeaderType *output_stream_ptr) {
     EbErrorType          return_error = EB_ErrorNone;
@@ -681,6 +808,9 @@ void *packetization_kernel(void *input_ptr) {
         scs_ptr = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
         encode_context_ptr = (EncodeContext *)scs_ptr->encode_context_ptr;
         frm_hdr            = &pcs_ptr->parent_pcs_ptr->frm_hdr;
+#if MD_CAND_CLASS_STATS
+        context_ptr->md_class_stats_enabled = scs_ptr->static_config.stat_report > 1;
+#endif
 #if TILES_PARALLEL
         Av1Common *const cm = pcs_ptr->parent_pcs_ptr->av1_cm;
         tile_cnt            = cm->tiles_info.tile_rows * cm->tiles_info.tile_cols;
@@ -699,10 +829,24 @@ void *packetization_kernel(void *input_ptr) {
                             &pcs_ptr->parent_pcs_ptr->output_stream_wrapper_ptr);
         output_stream_wrapper_ptr   = pcs_ptr->parent_pcs_ptr->output_stream_wrapper_ptr;
         output_stream_ptr           = (EbBufferHeaderType *)output_stream_wrapper_ptr->object_ptr;
+#if PKT_ZERO_COPY
+        output_stream_ptr->flags    = 0;
+        output_stream_ptr->p_buffer = NULL;
+        if (scs_ptr->static_config.output_buffer_alloc) {
+            output_stream_ptr->p_buffer = scs_ptr->static_config.output_buffer_alloc(
+                output_stream_ptr->n_alloc_len, scs_ptr->static_config.output_buffer_private_data);
+            if (output_stream_ptr->p_buffer) output_stream_ptr->flags = EB_BUFFERFLAG_APP_BUFFER;
+        }
+        if (!output_stream_ptr->p_buffer)
+            output_stream_ptr->p_buffer = (uint8_t *)malloc(output_stream_ptr->n_alloc_len);
+        assert(output_stream_ptr->p_buffer != NULL && "bit-stream memory allocation failure");
+
+#else
         output_stream_ptr->p_buffer = (uint8_t *)malloc(output_stream_ptr->n_alloc_len);
         assert(output_stream_ptr->p_buffer != NULL && "bit-stream memory allocation failure");
 
         output_stream_ptr->flags = 0;
+#endif
         output_stream_ptr->flags |=
             (encode_context_ptr->terminating_sequence_flag_received == EB_TRUE &&
              pcs_ptr->parent_pcs_ptr->decode_order ==
@@ -721,6 +865,10 @@ void *packetization_kernel(void *input_ptr) {
         output_stream_ptr->qp            = pcs_ptr->parent_pcs_ptr->picture_qp;
 
         if (scs_ptr->static_config.stat_report) {
+#if PSNR_METRICS_STAGE
+            // The metrics stage still reads the source and recon of this picture
+            eb_block_on_semaphore(pcs_ptr->metrics_done_semaphore);
+#endif
             output_stream_ptr->luma_sse = pcs_ptr->parent_pcs_ptr->luma_sse;
             output_stream_ptr->cr_sse   = pcs_ptr->parent_pcs_ptr->cr_sse;
             output_stream_ptr->cb_sse   = pcs_ptr->parent_pcs_ptr->cb_sse;
@@ -770,6 +918,9 @@ void *packetization_kernel(void *input_ptr) {
             (void)picture_manager_results_ptr;
             (void)picture_manager_results_wrapper_ptr;
         }
+#if PKT_ZERO_COPY
+        write_frame_obus(encode_context_ptr, scs_ptr, pcs_ptr, output_stream_ptr);
+#else
         // Reset the Bitstream before writing to it
         bitstream_reset(pcs_ptr->bitstream_ptr);
 
@@ -781,6 +932,7 @@ void *packetization_kernel(void *input_ptr) {
         copy_data_from_bitstream(encode_context_ptr,
                     pcs_ptr->bitstream_ptr,
                     output_stream_ptr);
+#endif
 
         if (pcs_ptr->parent_pcs_ptr->has_show_existing) {
             // Reset the Bitstream before writing to it
@@ -800,6 +952,10 @@ void *packetization_kernel(void *input_ptr) {
                sizeof(Av1RpsNode));
 
         queue_entry_ptr->slice_type = pcs_ptr->slice_type;
+#if MD_CAND_CLASS_STATS
+        queue_entry_ptr->temporal_layer_index = pcs_ptr->temporal_layer_index;
+        queue_entry_ptr->md_class_stats       = pcs_ptr->md_class_stats;
+#endif
 #if DETAILED_FRAME_OUTPUT
         queue_entry_ptr->ref_poc_list0 = pcs_ptr->parent_pcs_ptr->ref_pic_poc_array[REF_LIST_0][0];
         queue_entry_ptr->ref_poc_list1 = pcs_ptr->parent_pcs_ptr->ref_pic_poc_array[REF_LIST_1][0];
@@ -868,6 +1024,9 @@ void *packetization_kernel(void *input_ptr) {
             EbBool eos                = output_stream_ptr->flags &  EB_BUFFERFLAG_EOS;
 
             encode_tu(encode_context_ptr, frames, total_bytes, output_stream_ptr);
+#if MD_CAND_CLASS_STATS
+            if (eos && context_ptr->md_class_stats_enabled) print_md_class_report(context_ptr);
+#endif
 
             if (eos && queue_entry_ptr->has_show_existing)
                 clear_eos_flag(output_stream_ptr);
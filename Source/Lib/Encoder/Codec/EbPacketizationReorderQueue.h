@@ -43,6 +43,10 @@ typedef struct PacketizationReorderEntry {
     //valid when has_show_existing is true
     int64_t    next_pts;
     uint8_t    is_alt_ref;
+#if MD_CAND_CLASS_STATS
+    uint8_t      temporal_layer_index;
+    MdClassStats md_class_stats;
+#endif
 } PacketizationReorderEntry;
 
 extern EbErrorType packetization_reorder_entry_ctor(PacketizationReorderEntry *entry_ptr,
@@ -218,11 +218,17 @@ void picture_control_set_dctor(EbPtr p) {
     EB_FREE_ARRAY(obj->ec_ctx_array);
     EB_FREE_ARRAY(obj->rate_est_array);
     if (obj->tile_tok[0][0]) EB_FREE_ARRAY(obj->tile_tok[0][0]);
+#if SB_SIZE_BASED_BLK_ALLOC
+    if (obj->mdc_sb_array) EB_FREE_ARRAY(obj->mdc_sb_array[0].leaf_data_array);
+#endif
     EB_FREE_ARRAY(obj->mdc_sb_array);
     EB_DESTROY_MUTEX(obj->entropy_coding_pic_mutex);
     EB_DESTROY_MUTEX(obj->intra_mutex);
     EB_DESTROY_MUTEX(obj->cdef_search_mutex);
     EB_DESTROY_MUTEX(obj->rest_search_mutex);
+#if PSNR_METRICS_STAGE
+    EB_DESTROY_SEMAPHORE(obj->metrics_done_semaphore);
+#endif
 }
 #else
 void picture_control_set_dctor(EbPtr p) {
@@ -313,12 +319,18 @@ void picture_control_set_dctor(EbPtr p) {
     EB_FREE_ARRAY(obj->ec_ctx_array);
     EB_FREE_ARRAY(obj->rate_est_array);
     if (obj->tile_tok[0][0]) EB_FREE_ARRAY(obj->tile_tok[0][0]);
+#if SB_SIZE_BASED_BLK_ALLOC
+    if (obj->mdc_sb_array) EB_FREE_ARRAY(obj->mdc_sb_array[0].leaf_data_array);
+#endif
     EB_FREE_ARRAY(obj->mdc_sb_array);
     EB_FREE_ARRAY(obj->qp_array);
     EB_DESTROY_MUTEX(obj->entropy_coding_mutex);
     EB_DESTROY_MUTEX(obj->intra_mutex);
     EB_DESTROY_MUTEX(obj->cdef_search_mutex);
     EB_DESTROY_MUTEX(obj->rest_search_mutex);
+#if PSNR_METRICS_STAGE
+    EB_DESTROY_SEMAPHORE(obj->metrics_done_semaphore);
+#endif
 }
 #endif
 // Token buffer is only used for palette tokens.
@@ -489,8 +501,10 @@ EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr object
     EB_NEW(object_ptr->entropy_coder_ptr, entropy_coder_ctor, SEGMENT_ENTROPY_BUFFER_SIZE);
 #endif
 
+#if !PKT_ZERO_COPY
     // Packetization process Bitstream
     EB_NEW(object_ptr->bitstream_ptr, bitstream_ctor, PACKETIZATION_PROCESS_BUFFER_SIZE);
+#endif
 
     // Rate estimation entropy coder
     EB_NEW(
@@ -549,6 +563,19 @@ EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr object
         object_ptr->tile_tok[0][0] = NULL;
     // Mode Decision Control config
     EB_MALLOC_ARRAY(object_ptr->mdc_sb_array, object_ptr->sb_total_count);
+#if SB_SIZE_BASED_BLK_ALLOC
+    {
+        // One leaf data buffer for all the SBs, sized to the block count of the active SB size
+        const uint32_t max_block_count = init_data_ptr->sb_size_pix == 128 ? BLOCK_MAX_COUNT_SB_128
+                                                                           : BLOCK_MAX_COUNT_SB_64;
+        object_ptr->mdc_sb_array[0].leaf_data_array = NULL;
+        EB_MALLOC_ARRAY(object_ptr->mdc_sb_array[0].leaf_data_array,
+                        object_ptr->sb_total_count * max_block_count);
+        for (uint16_t sb_index = 1; sb_index < object_ptr->sb_total_count; ++sb_index)
+            object_ptr->mdc_sb_array[sb_index].leaf_data_array =
+                object_ptr->mdc_sb_array[0].leaf_data_array + sb_index * max_block_count;
+    }
+#endif
     object_ptr->hbd_mode_decision = init_data_ptr->hbd_mode_decision;
     // Mode Decision Neighbor Arrays
 #if TILES_PARALLEL
@@ -1754,6 +1781,9 @@ EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr object
     EB_MALLOC_ARRAY(object_ptr->mse_seg[1], picture_sb_width * picture_sb_height);
 
     EB_CREATE_MUTEX(object_ptr->rest_search_mutex);
+#if PSNR_METRICS_STAGE
+    EB_CREATE_SEMAPHORE(object_ptr->metrics_done_semaphore, 0, 1);
+#endif
 
     //the granularity is 4x4
     EB_MALLOC_ARRAY(object_ptr->mi_grid_base,
@@ -157,7 +157,11 @@ typedef struct MdcSbData {
     // ME Results
     uint64_t      treeblock_variance;
     uint32_t      leaf_count;
+#if SB_SIZE_BASED_BLK_ALLOC
+    EbMdcLeafData *leaf_data_array;
+#else
     EbMdcLeafData leaf_data_array[BLOCK_MAX_COUNT_SB_128];
+#endif
 } MdcSbData;
 
 /**************************************
@@ -261,6 +265,9 @@ typedef struct PictureControlSet {
 #endif
     EbHandle intra_mutex;
     uint32_t intra_coded_area;
+#if MD_CAND_CLASS_STATS
+    MdClassStats md_class_stats; // protected by intra_mutex
+#endif
     uint32_t tot_seg_searched_cdef;
     EbHandle cdef_search_mutex;
 
@@ -275,6 +282,10 @@ typedef struct PictureControlSet {
 
     uint32_t tot_seg_searched_rest;
     EbHandle rest_search_mutex;
+#if PSNR_METRICS_STAGE
+    // posted by the metrics stage once luma_sse/cb_sse/cr_sse are ready
+    EbHandle metrics_done_semaphore;
+#endif
     uint16_t rest_segments_total_count;
     uint8_t  rest_segments_column_count;
     uint8_t  rest_segments_row_count;
@@ -468,6 +479,10 @@ typedef struct PictureControlSet {
     struct MdRateEstimationContext *rate_est_array;
     uint8_t                         update_cdf;
     FRAME_CONTEXT                   ref_frame_context[REF_FRAMES];
+#if MD_RATE_EST_INCREMENTAL
+    // CDFs the picture-based SB rate table (rate_est_array[0]) was last built from
+    FRAME_CONTEXT                   rate_est_fc;
+#endif
     EbWarpedMotionParams            ref_global_motion[TOTAL_REFS_PER_FRAME];
     struct MdRateEstimationContext *md_rate_estimation_array;
     int8_t                          ref_frame_side[REF_FRAMES];
@@ -707,6 +722,9 @@ typedef struct PictureParentControlSet {
     // Multi-modes signal(s)
     EbPictureDepthMode pic_depth_mode;
     uint8_t            loop_filter_mode;
+#if DLF_SUBSAMPLED_SEARCH
+    uint8_t            dlf_search_sb_row_step; // 1: level search on the full frame, N: on 1 SB row out of N
+#endif
     uint8_t            intra_pred_mode;
     uint8_t            tx_size_search_mode;
     uint8_t            frame_end_cdf_update_mode; // mm-signal: 0: OFF, 1:ON
@@ -804,6 +822,9 @@ typedef struct PictureParentControlSet {
     int32_t             cdef_frame_strength;
     int32_t             cdf_ref_frame_strength;
     int32_t             use_ref_frame_cdef_strength;
+#if CDEF_REF_SEEDED_SEARCH
+    uint8_t             cdef_ref_seeded_search; // seed the CDEF search with the L0 reference strengths
+#endif
     uint8_t             nsq_search_level;
     uint8_t             palette_mode;
     uint8_t             nsq_max_shapes_md; // max number of shapes to be tested in MD
@@ -978,6 +978,17 @@ EbErrorType signal_derivation_multi_processes_oq(
     }
     else
         pcs_ptr->loop_filter_mode = 0;
+#if DLF_SUBSAMPLED_SEARCH
+    // Deblocking level search SB row step       Settings
+    // 1                                          Trial filtering on the full frame
+    // N                                          Trial filtering on 1 SB row out of N
+    if (MR_MODE || pcs_ptr->enc_mode <= ENC_M1)
+        pcs_ptr->dlf_search_sb_row_step = 1;
+    else if (pcs_ptr->enc_mode <= ENC_M4)
+        pcs_ptr->dlf_search_sb_row_step = 2;
+    else
+        pcs_ptr->dlf_search_sb_row_step = 4;
+#endif
 
     // CDEF Level                                   Settings
     // 0                                            OFF
@@ -1003,6 +1014,14 @@ EbErrorType signal_derivation_multi_processes_oq(
     }
     else
         pcs_ptr->cdef_filter_mode = 0;
+#if CDEF_REF_SEEDED_SEARCH
+    // Seeded CDEF search (inter pictures only)
+    // 0                                            OFF: search all strengths
+    // 1                                            ON: search around the L0 reference strengths
+    pcs_ptr->cdef_ref_seeded_search =
+        pcs_ptr->cdef_filter_mode == 5 && pcs_ptr->slice_type != I_SLICE &&
+        pcs_ptr->enc_mode >= ENC_M2;
+#endif
 
     // SG Level                                    Settings
     // 0                                            OFF
@@ -975,6 +975,20 @@ void *picture_manager_kernel(void *input_ptr) {
                                             ->entropy_coding_in_progress = EB_FALSE;
                                         child_pcs_ptr->entropy_coding_info[tileIdx]
                                             ->entropy_coding_tile_done = EB_FALSE;
+#if EC_SB_ROW_PIPELINE
+                                        // Single tile pictures would otherwise be entropy
+                                        // coded on one thread
+                                        child_pcs_ptr->entropy_coding_info[tileIdx]
+                                            ->entropy_coding_row_pipeline =
+                                            tile_cols * tile_rows == 1 &&
+                                            entry_scs_ptr->entropy_coding_process_init_count > 1;
+                                        child_pcs_ptr->entropy_coding_info[tileIdx]
+                                            ->entropy_coding_logged_row_count = 0;
+                                        child_pcs_ptr->entropy_coding_info[tileIdx]
+                                            ->entropy_coding_coded_row_count = 0;
+                                        child_pcs_ptr->entropy_coding_info[tileIdx]
+                                            ->entropy_coding_symbols_in_progress = EB_FALSE;
+#endif
 
                                         for (unsigned rowIndex = 0; rowIndex < MAX_SB_ROWS;
                                              ++rowIndex) {
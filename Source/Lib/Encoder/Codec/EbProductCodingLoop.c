@@ -29,6 +29,22 @@
 #include "EbCodingLoop.h"
 #include "EbLog.h"
 #include "EbCommonUtils.h"
+#if MD_CAND_CLASS_STATS
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Time stamp counter used to profile the MD stages; 0 where not available
+static INLINE uint64_t md_stats_ticks(void) {
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+#endif
 
 EbErrorType generate_md_stage_0_cand(SuperBlock *sb_ptr, ModeDecisionContext *context_ptr,
                                      uint32_t *         fast_candidate_total_count,
@@ -4614,6 +4630,107 @@ void tx_reset_neighbor_arrays(PictureControlSet *pcs_ptr, ModeDecisionContext *c
     }
 }
 
+#if TX_TYPE_PRUNING
+/*
+ * Returns EB_TRUE if tx_type is an allowed and searchable tx type for the current transform block
+ */
+static EbBool is_tx_type_searchable(PictureControlSet *pcs_ptr, ModeDecisionContext *context_ptr,
+                                    int32_t is_inter, TxSetType tx_set_type, TxType tx_type) {
+    const TxSize tx_size = context_ptr->blk_geom->txsize[context_ptr->tx_depth][context_ptr->txb_itr];
+    if (tx_type != DCT_DCT) {
+        if (is_inter) {
+            TxSize          max_tx_size = context_ptr->blk_geom->txsize[0][0];
+            const TxSetType tx_set_type_inter =
+                get_ext_tx_set_type(max_tx_size, is_inter, pcs_ptr->parent_pcs_ptr->frm_hdr.reduced_tx_set);
+            int32_t eset =
+                get_ext_tx_set(max_tx_size, is_inter, pcs_ptr->parent_pcs_ptr->frm_hdr.reduced_tx_set);
+            // eset == 0 should correspond to a set with only DCT_DCT and there
+            // is no need to send the tx_type
+            if (eset <= 0 || av1_ext_tx_used[tx_set_type_inter][tx_type] == 0)
+                return EB_FALSE;
+        }
+        int32_t eset = get_ext_tx_set(tx_size, is_inter, context_ptr->tx_search_reduced_set);
+        if (eset <= 0 || av1_ext_tx_used[tx_set_type][tx_type] == 0)
+            return EB_FALSE;
+        if (context_ptr->blk_geom->tx_height[context_ptr->tx_depth][context_ptr->txb_itr] > 32 ||
+            context_ptr->blk_geom->tx_width[context_ptr->tx_depth][context_ptr->txb_itr] > 32)
+            return EB_FALSE;
+    }
+    if (context_ptr->tx_search_reduced_set && !allowed_tx_set_a[tx_size][tx_type])
+        return EB_FALSE;
+    return EB_TRUE;
+}
+
+/*
+ * Sum of absolute transform coefficients; used as a SATD proxy of the tx type cost
+ */
+static uint64_t tx_coeff_satd(const int32_t *coeff, uint32_t count) {
+    uint64_t satd = 0;
+    for (uint32_t i = 0; i < count; i++) satd += (uint64_t)ABS(coeff[i]);
+    return satd;
+}
+
+static const uint8_t tx_type_pruning_top_k[] = {TX_TYPES, 4, 2};
+
+/*
+ * First stage of the tx type search: rank the tx types of tx_type_list[] using the SATD of
+ * their forward transform, and keep the best tx_type_pruning_top_k[] ones.
+ * DCT_DCT and the tx type mostly selected so far in the SB for the same tx size are always kept.
+ * Returns the updated number of tx types in tx_type_list[].
+ */
+static uint8_t prune_tx_types(ModeDecisionContext *        context_ptr,
+                              ModeDecisionCandidateBuffer *candidate_buffer, int32_t is_inter,
+                              uint32_t txb_origin_index, TxType *tx_type_list,
+                              uint8_t tx_type_count) {
+    const uint8_t top_k = tx_type_pruning_top_k[context_ptr->tx_type_pruning_level];
+    if (tx_type_count <= top_k) return tx_type_count;
+
+    const TxSize    tx_size = context_ptr->blk_geom->txsize[context_ptr->tx_depth][context_ptr->txb_itr];
+    const uint32_t  count   = context_ptr->blk_geom->tx_width[context_ptr->tx_depth][context_ptr->txb_itr] *
+                           context_ptr->blk_geom->tx_height[context_ptr->tx_depth][context_ptr->txb_itr];
+    const uint32_t *hist    = context_ptr->tx_type_hist[is_inter][tx_size];
+    int32_t *       coeff   = &(((int32_t *)context_ptr->trans_quant_buffers_ptr->txb_trans_coeff2_nx2_n_ptr
+                              ->buffer_y)[context_ptr->txb_1d_offset]);
+    uint64_t        satd[TX_TYPES];
+    uint64_t        three_quad_energy;
+    TxType          hist_tx_type = DCT_DCT;
+
+    for (uint8_t txt_itr = 0; txt_itr < tx_type_count; ++txt_itr) {
+        av1_estimate_transform(
+            &(((int16_t *)candidate_buffer->residual_ptr->buffer_y)[txb_origin_index]),
+            candidate_buffer->residual_ptr->stride_y,
+            coeff,
+            NOT_USED_VALUE,
+            tx_size,
+            &three_quad_energy,
+            context_ptr->hbd_mode_decision ? EB_10BIT : EB_8BIT,
+            tx_type_list[txt_itr],
+            PLANE_TYPE_Y,
+            DEFAULT_SHAPE);
+        satd[txt_itr] = tx_coeff_satd(coeff, count);
+        if (hist[tx_type_list[txt_itr]] > hist[hist_tx_type]) hist_tx_type = tx_type_list[txt_itr];
+    }
+
+    // Insertion sort by ascending SATD; the always-kept tx types are moved to the front
+    for (uint8_t txt_itr = 0; txt_itr < tx_type_count; ++txt_itr)
+        if (tx_type_list[txt_itr] == DCT_DCT || tx_type_list[txt_itr] == hist_tx_type)
+            satd[txt_itr] = 0;
+    for (uint8_t i = 1; i < tx_type_count; ++i) {
+        TxType   txt      = tx_type_list[i];
+        uint64_t txt_satd = satd[i];
+        int32_t  j        = i - 1;
+        while (j >= 0 && satd[j] > txt_satd) {
+            tx_type_list[j + 1] = tx_type_list[j];
+            satd[j + 1]         = satd[j];
+            j--;
+        }
+        tx_type_list[j + 1] = txt;
+        satd[j + 1]         = txt_satd;
+    }
+    return top_k;
+}
+#endif
+
 void tx_type_search(PictureControlSet *pcs_ptr,
                     ModeDecisionContext *context_ptr, ModeDecisionCandidateBuffer *candidate_buffer,
                     uint32_t qp) {
@@ -4667,6 +4784,29 @@ void tx_type_search(PictureControlSet *pcs_ptr,
                 &context_ptr->luma_dc_sign_context);
     if (context_ptr->tx_search_reduced_set == 2) txk_end = 2;
     TxType best_tx_type = DCT_DCT;
+#if TX_TYPE_PRUNING
+    TxType  tx_type_list[TX_TYPES];
+    uint8_t tx_type_count = 0;
+    for (tx_type = txk_start; tx_type < txk_end; ++tx_type) {
+        if (context_ptr->tx_search_reduced_set == 2) tx_type = (tx_type == 1) ? IDTX : tx_type;
+        if (is_tx_type_searchable(pcs_ptr, context_ptr, is_inter, tx_set_type, (TxType)tx_type))
+            tx_type_list[tx_type_count++] = (TxType)tx_type;
+    }
+    if (context_ptr->tx_type_pruning_level)
+        tx_type_count = prune_tx_types(context_ptr,
+                                       candidate_buffer,
+                                       is_inter,
+                                       txb_origin_index,
+                                       tx_type_list,
+                                       tx_type_count);
+    for (uint8_t txt_itr = 0; txt_itr < tx_type_count; ++txt_itr) {
+        uint64_t txb_full_distortion[3][DIST_CALC_TOTAL];
+        uint64_t y_txb_coeff_bits = 0;
+        uint32_t y_count_non_zero_coeffs;
+
+        tx_type                        = tx_type_list[txt_itr];
+        context_ptr->three_quad_energy = 0;
+#else
     for (tx_type = txk_start; tx_type < txk_end; ++tx_type) {
         uint64_t txb_full_distortion[3][DIST_CALC_TOTAL];
         uint64_t y_txb_coeff_bits = 0;
@@ -4714,6 +4854,7 @@ void tx_type_search(PictureControlSet *pcs_ptr,
             if (!allowed_tx_set_a[context_ptr->blk_geom->txsize[context_ptr->tx_depth]
                                                                [context_ptr->txb_itr]][tx_type])
                 continue;
+#endif
 
         // For Inter blocks, transform type of chroma follows luma transfrom type
         if (is_inter)
@@ -4905,6 +5046,9 @@ void tx_type_search(PictureControlSet *pcs_ptr,
 
     //  Best Tx Type Pass
     candidate_buffer->candidate_ptr->transform_type[context_ptr->txb_itr] = best_tx_type;
+#if TX_TYPE_PRUNING
+    context_ptr->tx_type_hist[is_inter][tx_size][best_tx_type]++;
+#endif
 
     // For Inter blocks, transform type of chroma follows luma transfrom type
     if (is_inter)
@@ -6183,6 +6327,10 @@ void md_stage_3(PictureControlSet *pcs_ptr, SuperBlock *sb_ptr, BlkStruct *blk_p
                 }
             }
         }
+#endif
+#if MD_CAND_CLASS_STATS
+        const uint64_t start_ticks =
+            context_ptr->md_class_stats_enabled ? md_stats_ticks() : 0;
 #endif
         full_loop_core(pcs_ptr,
                        sb_ptr,
@@ -6196,6 +6344,13 @@ void md_stage_3(PictureControlSet *pcs_ptr, SuperBlock *sb_ptr, BlkStruct *blk_p
                        blk_origin_index,
                        blk_chroma_origin_index,
                        ref_fast_cost);
+#if MD_CAND_CLASS_STATS
+        if (context_ptr->md_class_stats_enabled) {
+            context_ptr->md_class_stats.cand_count[MD_STAGE_3][candidate_ptr->cand_class]++;
+            context_ptr->md_class_stats.cycles[MD_STAGE_3][candidate_ptr->cand_class] +=
+                md_stats_ticks() - start_ticks;
+        }
+#endif
 
         if (context_ptr->full_loop_escape) {
             if (pcs_ptr->slice_type != I_SLICE) {
@@ -7212,6 +7367,10 @@ void md_encode_block(PictureControlSet *pcs_ptr, ModeDecisionContext *context_pt
 
             //Input: md_stage_0_count[cand_class_it]  Output:  md_stage_1_count[cand_class_it]
             context_ptr->target_class = cand_class_it;
+#if MD_CAND_CLASS_STATS
+            const uint64_t start_ticks =
+                context_ptr->md_class_stats_enabled ? md_stats_ticks() : 0;
+#endif
 
             md_stage_0(pcs_ptr,
                         context_ptr,
@@ -7231,6 +7390,11 @@ void md_encode_block(PictureControlSet *pcs_ptr, ModeDecisionContext *context_pt
                         context_ptr->md_stage_0_count[cand_class_it] >
                             context_ptr->md_stage_1_count
                                 [cand_class_it]); //is there need to max the temp buffer
+#if MD_CAND_CLASS_STATS
+            if (context_ptr->md_class_stats_enabled)
+                context_ptr->md_class_stats.cycles[MD_STAGE_0][cand_class_it] +=
+                    md_stats_ticks() - start_ticks;
+#endif
 
             //Sort:  md_stage_1_count[cand_class_it]
             memset(context_ptr->cand_buff_indices[cand_class_it],
@@ -7251,6 +7415,16 @@ void md_encode_block(PictureControlSet *pcs_ptr, ModeDecisionContext *context_pt
         }
     }
     interintra_class_pruning_1(context_ptr, best_md_stage_cost);
+#if MD_CAND_CLASS_STATS
+    if (context_ptr->md_class_stats_enabled) {
+        for (cand_class_it = CAND_CLASS_0; cand_class_it < CAND_CLASS_TOTAL; cand_class_it++) {
+            context_ptr->md_class_stats.cand_count[MD_STAGE_0][cand_class_it] +=
+                context_ptr->md_stage_0_count[cand_class_it];
+            context_ptr->md_class_stats.cand_count[MD_STAGE_1][cand_class_it] +=
+                context_ptr->md_stage_1_count[cand_class_it];
+        }
+    }
+#endif
     memset(
         context_ptr->best_candidate_index_array, 0xFFFFFFFF, MAX_NFL_BUFF * sizeof(uint32_t));
     memset(context_ptr->sorted_candidate_index_array, 0xFFFFFFFF, MAX_NFL * sizeof(uint32_t));
@@ -7274,6 +7448,10 @@ void md_encode_block(PictureControlSet *pcs_ptr, ModeDecisionContext *context_pt
             context_ptr->md_stage_1_count[cand_class_it] > 0 &&
             context_ptr->md_stage_2_count[cand_class_it] > 0) {
             context_ptr->target_class = cand_class_it;
+#if MD_CAND_CLASS_STATS
+            const uint64_t start_ticks =
+                context_ptr->md_class_stats_enabled ? md_stats_ticks() : 0;
+#endif
             md_stage_1(pcs_ptr,
                         context_ptr->sb_ptr,
                         blk_ptr,
@@ -7284,6 +7462,11 @@ void md_encode_block(PictureControlSet *pcs_ptr, ModeDecisionContext *context_pt
                         blk_origin_index,
                         blk_chroma_origin_index,
                         ref_fast_cost);
+#if MD_CAND_CLASS_STATS
+            if (context_ptr->md_class_stats_enabled)
+                context_ptr->md_class_stats.cycles[MD_STAGE_1][cand_class_it] +=
+                    md_stats_ticks() - start_ticks;
+#endif
 
             // Sort the candidates of the target class based on the 1st full loop cost
 
@@ -7300,6 +7483,13 @@ void md_encode_block(PictureControlSet *pcs_ptr, ModeDecisionContext *context_pt
         }
     }
     interintra_class_pruning_2(context_ptr, best_md_stage_cost);
+#if MD_CAND_CLASS_STATS
+    if (context_ptr->md_class_stats_enabled) {
+        for (cand_class_it = CAND_CLASS_0; cand_class_it < CAND_CLASS_TOTAL; cand_class_it++)
+            context_ptr->md_class_stats.cand_count[MD_STAGE_2][cand_class_it] +=
+                context_ptr->md_stage_2_count[cand_class_it];
+    }
+#endif
 
     // 2nd Full-Loop
     best_md_stage_cost    = (uint64_t)~0;
@@ -7314,6 +7504,10 @@ void md_encode_block(PictureControlSet *pcs_ptr, ModeDecisionContext *context_pt
             context_ptr->md_stage_2_count[cand_class_it] > 0 &&
             context_ptr->md_stage_3_count[cand_class_it] > 0) {
             context_ptr->target_class = cand_class_it;
+#if MD_CAND_CLASS_STATS
+            const uint64_t start_ticks =
+                context_ptr->md_class_stats_enabled ? md_stats_ticks() : 0;
+#endif
 
             md_stage_2(pcs_ptr,
                         context_ptr->sb_ptr,
@@ -7325,6 +7519,11 @@ void md_encode_block(PictureControlSet *pcs_ptr, ModeDecisionContext *context_pt
                         blk_origin_index,
                         blk_chroma_origin_index,
                         ref_fast_cost);
+#if MD_CAND_CLASS_STATS
+            if (context_ptr->md_class_stats_enabled)
+                context_ptr->md_class_stats.cycles[MD_STAGE_2][cand_class_it] +=
+                    md_stats_ticks() - start_ticks;
+#endif
 
             // Sort the candidates of the target class based on the 1st full loop cost
 
@@ -7396,6 +7595,10 @@ void md_encode_block(PictureControlSet *pcs_ptr, ModeDecisionContext *context_pt
         context_ptr->prune_ref_frame_for_rec_partitions,
         &best_intra_mode);
     candidate_buffer = candidate_buffer_ptr_array[candidate_index];
+#if MD_CAND_CLASS_STATS
+    if (context_ptr->md_class_stats_enabled)
+        context_ptr->md_class_stats.win_count[candidate_buffer->candidate_ptr->cand_class]++;
+#endif
 
     bestcandidate_buffers[0] = candidate_buffer;
     uint8_t sq_index         = eb_log2f(context_ptr->blk_geom->sq_size) - 2;
@@ -7886,6 +8089,9 @@ EB_EXTERN EbErrorType mode_decision_sb(SequenceControlSet *scs_ptr, PictureContr
 
     EbBool all_blk_init = (pcs_ptr->parent_pcs_ptr->pic_depth_mode <= PIC_SQ_DEPTH_MODE);
     init_sq_nsq_block(scs_ptr, context_ptr);
+#if TX_TYPE_PRUNING
+    memset(context_ptr->tx_type_hist, 0, sizeof(context_ptr->tx_type_hist));
+#endif
 
 #if NEW_MD_LAMBDA
     uint32_t full_lambda =  context_ptr->hbd_mode_decision ?
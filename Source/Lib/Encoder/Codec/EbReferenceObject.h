@@ -29,6 +29,10 @@ typedef struct EbReferenceObject {
     uint8_t              average_intensity;
     AomFilmGrain         film_grain_params; //Film grain parameters for a reference frame
     uint32_t             cdef_frame_strength;
+#if CDEF_REF_SEEDED_SEARCH
+    EbBool cdef_sb_strength_valid; // cdef_sb_strength holds the strengths of the last coded picture
+    int8_t cdef_sb_strength[2][MAX_NUMBER_OF_TREEBLOCKS_PER_PICTURE]; // per-64x64 luma/chroma strength index, -1 when not filtered
+#endif
     int8_t               sg_frame_ep;
     FRAME_CONTEXT        frame_context;
     EbWarpedMotionParams global_motion[TOTAL_REFS_PER_FRAME];
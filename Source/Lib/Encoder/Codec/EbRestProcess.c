@@ -35,6 +35,9 @@ typedef struct RestContext {
     EbFifo *rest_input_fifo_ptr;
     EbFifo *rest_output_fifo_ptr;
     EbFifo *picture_demux_fifo_ptr;
+#if PSNR_METRICS_STAGE
+    EbFifo *metrics_output_fifo_ptr;
+#endif
 
     EbPictureBufferDesc *trial_frame_rst;
 
@@ -47,6 +50,9 @@ typedef struct RestContext {
     // each thread will hence have his own copy of recon to work on.
     // later we can have a search version that does not need the exact right recon
     int32_t *rst_tmpbuf;
+#if SGR_INTEGRAL_CACHE
+    int32_t *sgr_ii_cache;
+#endif
 } RestContext;
 
 void recon_output(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr);
@@ -58,9 +64,15 @@ void pad_ref_and_set_flags(PictureControlSet *pcs_ptr, SequenceControlSet *scs_p
 void generate_padding(EbByte src_pic, uint32_t src_stride, uint32_t original_src_width,
                       uint32_t original_src_height, uint32_t padding_width,
                       uint32_t padding_height);
+#if SGR_INTEGRAL_CACHE
+void restoration_seg_search(int32_t *rst_tmpbuf, int32_t *sgr_ii_cache, Yv12BufferConfig *org_fts,
+                            const Yv12BufferConfig *src, Yv12BufferConfig *trial_frame_rst,
+                            PictureControlSet *pcs_ptr, uint32_t segment_index);
+#else
 void restoration_seg_search(int32_t *rst_tmpbuf, Yv12BufferConfig *org_fts,
                             const Yv12BufferConfig *src, Yv12BufferConfig *trial_frame_rst,
                             PictureControlSet *pcs_ptr, uint32_t segment_index);
+#endif
 void rest_finish_search(PictureParentControlSet *p_pcs_ptr, Macroblock *x, Av1Common *const cm);
 
 void av1_upscale_normative_rows(const Av1Common *cm, const uint8_t *src,
@@ -83,6 +95,9 @@ static void rest_context_dctor(EbPtr p)
     EB_DELETE(obj->trial_frame_rst);
     EB_DELETE(obj->org_rec_frame);
     EB_FREE_ALIGNED(obj->rst_tmpbuf);
+#if SGR_INTEGRAL_CACHE
+    EB_FREE_ALIGNED(obj->sgr_ii_cache);
+#endif
     EB_FREE_ARRAY(obj);
 }
 
@@ -108,6 +123,13 @@ EbErrorType rest_context_ctor(EbThreadContext *  thread_context_ptr,
         eb_system_resource_get_producer_fifo(enc_handle_ptr->rest_results_resource_ptr, index);
     context_ptr->picture_demux_fifo_ptr = eb_system_resource_get_producer_fifo(
         enc_handle_ptr->picture_demux_results_resource_ptr, demux_index);
+#if PSNR_METRICS_STAGE
+    context_ptr->metrics_output_fifo_ptr =
+        enc_handle_ptr->metrics_tasks_resource_ptr
+            ? eb_system_resource_get_producer_fifo(enc_handle_ptr->metrics_tasks_resource_ptr,
+                                                   index)
+            : NULL;
+#endif
 
     {
         EbPictureBufferDescInitData init_data;
@@ -135,6 +157,9 @@ EbErrorType rest_context_ctor(EbThreadContext *  thread_context_ptr,
         }
 
         EB_MALLOC_ALIGNED(context_ptr->rst_tmpbuf, RESTORATION_TMPBUF_SIZE);
+#if SGR_INTEGRAL_CACHE
+        EB_MALLOC_ALIGNED(context_ptr->sgr_ii_cache, SGRPROJ_II_CACHE_SIZE);
+#endif
     }
 
     EbPictureBufferDescInitData temp_lf_recon_desc_init_data;
@@ -527,6 +552,9 @@ void *rest_kernel(void *input_ptr) {
             link_eb_to_aom_buffer_desc(context_ptr->org_rec_frame, &org_fts);
 
             restoration_seg_search(context_ptr->rst_tmpbuf,
+#if SGR_INTEGRAL_CACHE
+                                   context_ptr->sgr_ii_cache,
+#endif
                                    &org_fts,
                                    &cpi_source,
                                    &trial_frame_rst,
@@ -568,8 +596,28 @@ void *rest_kernel(void *input_ptr) {
                 copy_statistics_to_ref_obj_ect(pcs_ptr, scs_ptr);
             }
 
+#if PSNR_METRICS_STAGE
+            // PSNR Calculation: handed to the metrics stage, which keeps the reference
+            // picture alive and signals packetization once the SSEs are ready
+            if (scs_ptr->static_config.stat_report) {
+                EbObjectWrapper *metrics_tasks_wrapper_ptr;
+                eb_get_empty_object(context_ptr->metrics_output_fifo_ptr,
+                                    &metrics_tasks_wrapper_ptr);
+                MetricsTasks *metrics_tasks_ptr =
+                    (MetricsTasks *)metrics_tasks_wrapper_ptr->object_ptr;
+                metrics_tasks_ptr->pcs_wrapper_ptr = cdef_results_ptr->pcs_wrapper_ptr;
+                metrics_tasks_ptr->reference_picture_wrapper_ptr = NULL;
+                if (pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE) {
+                    metrics_tasks_ptr->reference_picture_wrapper_ptr =
+                        pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr;
+                    eb_object_inc_live_count(metrics_tasks_ptr->reference_picture_wrapper_ptr, 1);
+                }
+                eb_post_full_object(metrics_tasks_wrapper_ptr);
+            }
+#else
             // PSNR Calculation
             if (scs_ptr->static_config.stat_report) psnr_calculations(pcs_ptr, scs_ptr);
+#endif
 
             // Pad the reference picture and set ref POC
             if (pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
@@ -80,6 +80,9 @@ typedef struct {
     uint32_t            pic_num;
     Yv12BufferConfig *  org_frame_to_show;
     int32_t *           tmpbuf;
+#if SGR_INTEGRAL_CACHE
+    int32_t *sgr_ii_cache; // integral images of the processing units of the current unit
+#endif
 
     uint8_t *      dgd_buffer;
     int32_t        dgd_stride;
@@ -549,7 +552,12 @@ static INLINE void encode_xq(int32_t *xq, int32_t *xqd, const SgrParamsType *par
 static INLINE void apply_sgr(int32_t sgr_params_idx, const uint8_t *dat8, int32_t width,
                              int32_t height, int32_t dat_stride, int32_t use_highbd,
                              int32_t bit_depth, int32_t pu_width, int32_t pu_height, int32_t *flt0,
+#if SGR_INTEGRAL_CACHE
+                             int32_t *flt1, int32_t flt_stride, const int32_t *ii_cache) {
+    const int32_t *ii = ii_cache;
+#else
                              int32_t *flt1, int32_t flt_stride) {
+#endif
     for (int32_t i = 0; i < height; i += pu_height) {
         const int32_t  h        = AOMMIN(pu_height, height - i);
         int32_t *      flt0_row = flt0 + i * flt_stride;
@@ -560,6 +568,20 @@ static INLINE void apply_sgr(int32_t sgr_params_idx, const uint8_t *dat8, int32_
         for (int32_t j = 0; j < width; j += pu_width) {
             const int32_t w = AOMMIN(pu_width, width - j);
 
+#if SGR_INTEGRAL_CACHE
+            eb_av1_selfguided_restoration_from_ii(dat8_row + j,
+                                                  w,
+                                                  h,
+                                                  dat_stride,
+                                                  ii,
+                                                  flt0_row + j,
+                                                  flt1_row + j,
+                                                  flt_stride,
+                                                  sgr_params_idx,
+                                                  bit_depth,
+                                                  use_highbd);
+            ii += SGRPROJ_II_SIZE;
+#else
             //CHKN SSE
             eb_av1_selfguided_restoration(dat8_row + j,
                                           w,
@@ -571,6 +593,7 @@ static INLINE void apply_sgr(int32_t sgr_params_idx, const uint8_t *dat8, int32_
                                           sgr_params_idx,
                                           bit_depth,
                                           use_highbd);
+#endif
         }
     }
 }
@@ -579,7 +602,11 @@ static SgrprojInfo search_selfguided_restoration(
     const uint8_t *dat8, int32_t width, int32_t height, int32_t dat_stride, const uint8_t *src8,
     int32_t src_stride, int32_t use_highbitdepth, int32_t bit_depth, int32_t pu_width,
     int32_t pu_height, int32_t *rstbuf, int8_t sg_ref_frame_ep[2],
+#if SGR_INTEGRAL_CACHE
+    int32_t sg_frame_ep_cnt[SGRPROJ_PARAMS], int8_t step, int32_t *ii_cache) {
+#else
     int32_t sg_frame_ep_cnt[SGRPROJ_PARAMS], int8_t step) {
+#endif
     int32_t *flt0 = rstbuf;
     int32_t *flt1 = flt0 + RESTORATION_UNITPELS_MAX;
     int32_t  ep, bestep = 0;
@@ -603,6 +630,23 @@ static SgrprojInfo search_selfguided_restoration(
                         ? SGRPROJ_PARAMS
                         : AOMMIN(SGRPROJ_PARAMS, mid_ep + step);
 
+#if SGR_INTEGRAL_CACHE
+    // The integral images only depend on the unit: build them once for all the eps
+    int32_t *ii = ii_cache;
+    for (int32_t i = 0; i < height; i += pu_height) {
+        for (int32_t j = 0; j < width; j += pu_width) {
+            assert(ii < ii_cache + SGRPROJ_II_MAX_PROC_UNITS * SGRPROJ_II_SIZE);
+            eb_av1_sgr_integral_images(dat8 + i * dat_stride + j,
+                                       AOMMIN(pu_width, width - j),
+                                       AOMMIN(pu_height, height - i),
+                                       dat_stride,
+                                       ii,
+                                       use_highbitdepth);
+            ii += SGRPROJ_II_SIZE;
+        }
+    }
+
+#endif
     for (ep = start_ep; ep < end_ep; ep++) {
         int32_t exq[2];
         apply_sgr(ep,
@@ -616,7 +660,12 @@ static SgrprojInfo search_selfguided_restoration(
                   pu_height,
                   flt0,
                   flt1,
+#if SGR_INTEGRAL_CACHE
+                  flt_stride,
+                  ii_cache);
+#else
                   flt_stride);
+#endif
 #ifdef ARCH_X86
         aom_clear_system_state();
 #endif
@@ -1291,7 +1340,12 @@ static void search_sgrproj_seg(const RestorationTileLimits *limits, const Av1Pix
                                                   rsc->tmpbuf,
                                                   cm->sg_ref_frame_ep,
                                                   cm->sg_frame_ep_cnt,
+#if SGR_INTEGRAL_CACHE
+                                                  step,
+                                                  rsc->sgr_ii_cache);
+#else
                                                   step);
+#endif
 
     RestorationUnitInfo rui;
     rui.restoration_type = RESTORE_SGRPROJ;
@@ -1508,9 +1562,15 @@ static double search_rest_type_finish(RestSearchCtxt *rsc, RestorationType rtype
     return RDCOST_DBL(rsc->x->rdmult, rsc->bits >> 4, rsc->sse);
 }
 
+#if SGR_INTEGRAL_CACHE
+void restoration_seg_search(int32_t *rst_tmpbuf, int32_t *sgr_ii_cache, Yv12BufferConfig *org_fts,
+                            const Yv12BufferConfig *src, Yv12BufferConfig *trial_frame_rst,
+                            PictureControlSet *pcs_ptr, uint32_t segment_index) {
+#else
 void restoration_seg_search(int32_t *rst_tmpbuf, Yv12BufferConfig *org_fts,
                             const Yv12BufferConfig *src, Yv12BufferConfig *trial_frame_rst,
                             PictureControlSet *pcs_ptr, uint32_t segment_index) {
+#endif
     Av1Common *const cm         = pcs_ptr->parent_pcs_ptr->av1_cm;
     Macroblock *     x          = pcs_ptr->parent_pcs_ptr->av1x;
     const int32_t    num_planes = 3;
@@ -1532,6 +1592,9 @@ void restoration_seg_search(int32_t *rst_tmpbuf, Yv12BufferConfig *org_fts,
         init_rsc_seg(org_fts, src, cm, x, plane, rusi, trial_frame_rst, &rsc);
 
         rsc_p->tmpbuf = rst_tmpbuf;
+#if SGR_INTEGRAL_CACHE
+        rsc_p->sgr_ii_cache = sgr_ii_cache;
+#endif
 
         const int32_t highbd = rsc.cm->use_highbitdepth;
         eb_extend_frame(rsc.dgd_buffer,
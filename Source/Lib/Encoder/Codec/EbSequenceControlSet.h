@@ -190,6 +190,9 @@ typedef struct SequenceControlSet {
     uint32_t dlf_fifo_init_count;
     uint32_t cdef_fifo_init_count;
     uint32_t rest_fifo_init_count;
+#if PSNR_METRICS_STAGE
+    uint32_t metrics_fifo_init_count;
+#endif
 
     /*!< Thread count for each process */
     uint32_t picture_analysis_process_init_count;
@@ -201,6 +204,9 @@ typedef struct SequenceControlSet {
     uint32_t dlf_process_init_count;
     uint32_t cdef_process_init_count;
     uint32_t rest_process_init_count;
+#if PSNR_METRICS_STAGE
+    uint32_t metrics_process_init_count;
+#endif
     uint32_t total_process_init_count;
 
 } SequenceControlSet;
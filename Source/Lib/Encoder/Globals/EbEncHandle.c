@@ -46,6 +46,9 @@
 #include "EbRestProcess.h"
 #include "EbCdefProcess.h"
 #include "EbDlfProcess.h"
+#if PSNR_METRICS_STAGE
+#include "EbMetricsProcess.h"
+#endif
 #include "EbRateControlResults.h"
 #ifdef ARCH_X86
 #include <immintrin.h>
@@ -606,6 +609,9 @@ EbErrorType load_default_buffer_configuration_settings(
     scs_ptr->dlf_fifo_init_count                         = 300;
     scs_ptr->cdef_fifo_init_count                        = 300;
     scs_ptr->rest_fifo_init_count                        = 300;
+#if PSNR_METRICS_STAGE
+    scs_ptr->metrics_fifo_init_count                     = 300;
+#endif
     //#====================== Processes number ======================
     scs_ptr->total_process_init_count                    = 0;
     if (core_count > 1){
@@ -618,6 +624,9 @@ EbErrorType load_default_buffer_configuration_settings(
         scs_ptr->total_process_init_count += (scs_ptr->dlf_process_init_count                         = MAX(MIN(40, core_count >> 1), core_count));
         scs_ptr->total_process_init_count += (scs_ptr->cdef_process_init_count                        = MAX(MIN(40, core_count >> 1), core_count));
         scs_ptr->total_process_init_count += (scs_ptr->rest_process_init_count                        = MAX(MIN(40, core_count >> 1), core_count));
+#if PSNR_METRICS_STAGE
+        scs_ptr->total_process_init_count += (scs_ptr->metrics_process_init_count                     = MAX(MIN(4, core_count >> 2), 1));
+#endif
     }else{
         scs_ptr->total_process_init_count += (scs_ptr->picture_analysis_process_init_count            = 1);
         scs_ptr->total_process_init_count += (scs_ptr->motion_estimation_process_init_count           = 1);
@@ -628,6 +637,9 @@ EbErrorType load_default_buffer_configuration_settings(
         scs_ptr->total_process_init_count += (scs_ptr->dlf_process_init_count                         = 1);
         scs_ptr->total_process_init_count += (scs_ptr->cdef_process_init_count                        = 1);
         scs_ptr->total_process_init_count += (scs_ptr->rest_process_init_count                        = 1);
+#if PSNR_METRICS_STAGE
+        scs_ptr->total_process_init_count += (scs_ptr->metrics_process_init_count                     = 1);
+#endif
     }
 
     scs_ptr->total_process_init_count += 6; // single processes count
@@ -759,6 +771,11 @@ static void eb_enc_handle_stop_threads(EbEncHandle *enc_handle_ptr)
 
     // Rest Process
     EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->rest_thread_handle_array, control_set_ptr->rest_process_init_count);
+#if PSNR_METRICS_STAGE
+
+    // Metrics Process
+    EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->metrics_thread_handle_array, control_set_ptr->metrics_process_init_count);
+#endif
 
     // Entropy Coding Process
     EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->entropy_coding_thread_handle_array, control_set_ptr->entropy_coding_process_init_count);
@@ -797,6 +814,9 @@ static void eb_enc_handle_dctor(EbPtr p)
     EB_DELETE(enc_handle_ptr->dlf_results_resource_ptr);
     EB_DELETE(enc_handle_ptr->cdef_results_resource_ptr);
     EB_DELETE(enc_handle_ptr->rest_results_resource_ptr);
+#if PSNR_METRICS_STAGE
+    EB_DELETE(enc_handle_ptr->metrics_tasks_resource_ptr);
+#endif
     EB_DELETE(enc_handle_ptr->entropy_coding_results_resource_ptr);
 
     EB_DELETE(enc_handle_ptr->resource_coordination_context_ptr);
@@ -808,6 +828,9 @@ static void eb_enc_handle_dctor(EbPtr p)
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->dlf_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs_ptr->dlf_process_init_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->cdef_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs_ptr->cdef_process_init_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->rest_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs_ptr->rest_process_init_count);
+#if PSNR_METRICS_STAGE
+    EB_DELETE_PTR_ARRAY(enc_handle_ptr->metrics_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs_ptr->metrics_process_init_count);
+#endif
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->entropy_coding_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs_ptr->entropy_coding_process_init_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->scs_instance_array, enc_handle_ptr->encode_instance_total_count);
     EB_DELETE(enc_handle_ptr->picture_decision_context_ptr);
@@ -937,6 +960,31 @@ EbErrorType rest_results_creator(
     return EB_ErrorNone;
 }
 
+#if PSNR_METRICS_STAGE
+EbErrorType metrics_tasks_ctor(
+    MetricsTasks *context_ptr,
+    EbPtr object_init_data_ptr)
+{
+    (void)context_ptr;
+    (void)object_init_data_ptr;
+
+    return EB_ErrorNone;
+}
+
+EbErrorType metrics_tasks_creator(
+    EbPtr *object_dbl_ptr,
+    EbPtr object_init_data_ptr)
+{
+    MetricsTasks* obj;
+
+    *object_dbl_ptr = NULL;
+    EB_NEW(obj, metrics_tasks_ctor, object_init_data_ptr);
+    *object_dbl_ptr = obj;
+
+    return EB_ErrorNone;
+}
+#endif
+
 void init_fn_ptr(void);
 void av1_init_wedge_masks(void);
 /**********************************
@@ -1469,6 +1517,27 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             &rest_result_init_data,
             NULL);
     }
+#if PSNR_METRICS_STAGE
+    //Metrics tasks, the stage only runs with stat_report
+    if (!enc_handle_ptr->scs_instance_array[0]->scs_ptr->static_config.stat_report) {
+        enc_handle_ptr->scs_instance_array[0]->scs_ptr->total_process_init_count -=
+            enc_handle_ptr->scs_instance_array[0]->scs_ptr->metrics_process_init_count;
+        enc_handle_ptr->scs_instance_array[0]->scs_ptr->metrics_process_init_count = 0;
+    }
+    if (enc_handle_ptr->scs_instance_array[0]->scs_ptr->metrics_process_init_count) {
+        MetricsTasksInitData metrics_tasks_init_data;
+
+        EB_NEW(
+            enc_handle_ptr->metrics_tasks_resource_ptr,
+            eb_system_resource_ctor,
+            enc_handle_ptr->scs_instance_array[0]->scs_ptr->metrics_fifo_init_count,
+            enc_handle_ptr->scs_instance_array[0]->scs_ptr->rest_process_init_count,
+            enc_handle_ptr->scs_instance_array[0]->scs_ptr->metrics_process_init_count,
+            metrics_tasks_creator,
+            &metrics_tasks_init_data,
+            NULL);
+    }
+#endif
 
     // Entropy Coding Results
     {
@@ -1635,6 +1704,20 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             process_index,
             1 + process_index);
     }
+#if PSNR_METRICS_STAGE
+    //Metrics Contexts
+    if (enc_handle_ptr->scs_instance_array[0]->scs_ptr->metrics_process_init_count) {
+        EB_ALLOC_PTR_ARRAY(enc_handle_ptr->metrics_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs_ptr->metrics_process_init_count);
+
+        for (process_index = 0; process_index < enc_handle_ptr->scs_instance_array[0]->scs_ptr->metrics_process_init_count; ++process_index) {
+            EB_NEW(
+                enc_handle_ptr->metrics_context_ptr_array[process_index],
+                metrics_context_ctor,
+                enc_handle_ptr,
+                process_index);
+        }
+    }
+#endif
 
     // Entropy Coding Contexts
     EB_ALLOC_PTR_ARRAY(enc_handle_ptr->entropy_coding_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs_ptr->entropy_coding_process_init_count);
@@ -1719,6 +1802,14 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
     EB_CREATE_THREAD_ARRAY(enc_handle_ptr->rest_thread_handle_array, control_set_ptr->rest_process_init_count,
         rest_kernel,
         enc_handle_ptr->rest_context_ptr_array);
+#if PSNR_METRICS_STAGE
+
+    // Metrics Process
+    if (control_set_ptr->metrics_process_init_count)
+        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->metrics_thread_handle_array, control_set_ptr->metrics_process_init_count,
+            metrics_kernel,
+            enc_handle_ptr->metrics_context_ptr_array);
+#endif
 
     // Entropy Coding Process
     EB_CREATE_THREAD_ARRAY(enc_handle_ptr->entropy_coding_thread_handle_array, control_set_ptr->entropy_coding_process_init_count,
@@ -1763,6 +1854,10 @@ EB_API EbErrorType svt_av1_enc_deinit(EbComponentType *svt_enc_component){
         eb_shutdown_process(handle->dlf_results_resource_ptr);
         eb_shutdown_process(handle->cdef_results_resource_ptr);
         eb_shutdown_process(handle->rest_results_resource_ptr);
+#if PSNR_METRICS_STAGE
+        if (handle->metrics_tasks_resource_ptr)
+            eb_shutdown_process(handle->metrics_tasks_resource_ptr);
+#endif
     }
 
     return EB_ErrorNone;
@@ -2300,6 +2395,10 @@ void copy_api_from_app(
                 break;
         }
     }
+#if PKT_ZERO_COPY
+    scs_ptr->static_config.output_buffer_alloc        = config_struct->output_buffer_alloc;
+    scs_ptr->static_config.output_buffer_private_data = config_struct->output_buffer_private_data;
+#endif
 
     return;
 }
@@ -2553,8 +2652,8 @@ static EbErrorType verify_settings(
         return_error = EB_ErrorBadParameter;
     }
 
-    if (config->stat_report > 1) {
-        SVT_LOG("Error instance %u : Invalid StatReport. StatReport must be [0 - 1]\n", channel_number + 1);
+    if (config->stat_report > 2) {
+        SVT_LOG("Error instance %u : Invalid StatReport. StatReport must be [0 - 2]\n", channel_number + 1);
         return_error = EB_ErrorBadParameter;
     }
 
@@ -3034,6 +3133,10 @@ EbErrorType eb_svt_enc_init_parameter(
 
     // Debug info
     config_ptr->recon_enabled = 0;
+#if PKT_ZERO_COPY
+    config_ptr->output_buffer_alloc = NULL;
+    config_ptr->output_buffer_private_data = NULL;
+#endif
 
     // Alt-Ref default values
     config_ptr->enable_altrefs = EB_TRUE;
@@ -3563,7 +3666,11 @@ EB_API void svt_av1_enc_release_out_buffer(
 {
     if (p_buffer && (*p_buffer)->wrapper_ptr)
     {
+#if PKT_ZERO_COPY
+        if ((*p_buffer)->p_buffer && !((*p_buffer)->flags & EB_BUFFERFLAG_APP_BUFFER))
+#else
         if((*p_buffer)->p_buffer)
+#endif
            free((*p_buffer)->p_buffer);
         // Release out put buffer back into the pool
         eb_release_object((EbObjectWrapper  *)(*p_buffer)->wrapper_ptr);
@@ -67,6 +67,9 @@ struct _EbEncHandle {
     EbHandle *dlf_thread_handle_array;
     EbHandle *cdef_thread_handle_array;
     EbHandle *rest_thread_handle_array;
+#if PSNR_METRICS_STAGE
+    EbHandle *metrics_thread_handle_array;
+#endif
 
     EbHandle packetization_thread_handle;
 
@@ -85,6 +88,9 @@ struct _EbEncHandle {
     EbThreadContext **dlf_context_ptr_array;
     EbThreadContext **cdef_context_ptr_array;
     EbThreadContext **rest_context_ptr_array;
+#if PSNR_METRICS_STAGE
+    EbThreadContext **metrics_context_ptr_array;
+#endif
     EbThreadContext * packetization_context_ptr;
 
     // System Resource Managers
@@ -106,6 +112,9 @@ struct _EbEncHandle {
     EbSystemResource * dlf_results_resource_ptr;
     EbSystemResource * cdef_results_resource_ptr;
     EbSystemResource * rest_results_resource_ptr;
+#if PSNR_METRICS_STAGE
+    EbSystemResource * metrics_tasks_resource_ptr;
+#endif
 
     // Callbacks
     EbCallback **app_callback_ptr_array;
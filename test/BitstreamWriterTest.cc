@@ -14,6 +14,7 @@
 #include <math.h>
 #include <stdlib.h>
 #include <random>
+#include <vector>
 #include "EbCabacContextModel.h"
 #if defined(CHAR_BIT)
 #undef CHAR_BIT  // defined in clang/9.1.0/include/limits.h
@@ -276,4 +277,93 @@ TEST(Entropy_BitstreamWriter, write_symbol_with_update) {
                   rnd(gen));
     }
 }
+
+#if EC_GROWABLE_BUFFERS
+TEST(Entropy_BitstreamWriter, write_long_stream_to_growable_unit) {
+    // enough data to span many pre-carry pages and to grow the output unit
+    const int num_values = 200000;
+    std::uniform_int_distribution<int> len_dist(1, 24);
+    std::uniform_int_distribution<int> prob_dist(1, 255);
+    std::bernoulli_distribution rnd(0.5);
+    std::mt19937 gen(deterministic_seeds);
+    std::vector<int> lens(num_values), values(num_values), probs(num_values),
+        bits(num_values);
+
+    OutputBitstreamUnit unit;
+    ASSERT_EQ(output_bitstream_unit_ctor(&unit, 64), EB_ErrorNone);
+    AomWriter bw;
+    memset(&bw, 0, sizeof(bw));
+
+    aom_start_encode_unit(&bw, &unit);
+    for (int i = 0; i < num_values; ++i) {
+        lens[i] = len_dist(gen);
+        values[i] = static_cast<int>(gen() & ((1u << lens[i]) - 1));
+        probs[i] = prob_dist(gen);
+        bits[i] = rnd(gen);
+        aom_write_literal(&bw, values[i], lens[i]);
+        aom_write(&bw, bits[i], probs[i]);
+    }
+    aom_stop_encode(&bw);
+
+    SvtReader br;
+    svt_reader_init(&br, unit.buffer_begin_av1, bw.pos);
+    for (int i = 0; i < num_values; ++i) {
+        ASSERT_EQ(svt_read_literal(&br, lens[i], nullptr), values[i])
+            << "pos: " << i;
+        ASSERT_EQ(svt_read(&br, probs[i], nullptr), bits[i]) << "pos: " << i;
+    }
+    unit.dctor(&unit);
+}
+#endif
+
+#if EC_SB_ROW_PIPELINE
+// Writes the same random symbols straight and through a symbol log, and
+// expects the same bytes and the same adapted CDFs.
+TEST(Entropy_BitstreamWriter, write_logged_symbols) {
+    const int num_values = 10000;
+    const int base_qindex = 20;
+    FRAME_CONTEXT fc[2];
+    memset(fc, 0, sizeof(fc));
+    eb_av1_default_coef_probs(&fc[0], base_qindex);
+    eb_av1_default_coef_probs(&fc[1], base_qindex);
+
+    std::vector<uint8_t> stream_buffer[2] = {std::vector<uint8_t>(1 << 16),
+                                             std::vector<uint8_t>(1 << 16)};
+    AomWriter bw[2];
+    EcSymbolLog symbol_log;
+    memset(bw, 0, sizeof(bw));
+    memset(&symbol_log, 0, sizeof(symbol_log));
+
+    for (int k = 0; k < 2; ++k) {
+        std::mt19937 gen(deterministic_seeds);
+        aom_start_encode(&bw[k], stream_buffer[k].data());
+        bw[k].allow_update_cdf = 1;
+        if (k == 1)
+            bw[k].symbol_log = &symbol_log;
+        for (int i = 0; i < num_values; ++i) {
+            aom_write_symbol(
+                &bw[k], gen() % 4, fc[k].coeff_base_cdf[0][0][i % 42], 4);
+            aom_write_symbol(&bw[k], gen() & 1, fc[k].txb_skip_cdf[0][i % 13], 2);
+            aom_write(&bw[k], gen() & 1, 1 + gen() % 255);
+            aom_write_literal(&bw[k], gen() & 0xfff, 12);
+            if (k == 1 && i % 100 == 99)
+                ec_symbol_log_push(&symbol_log, EC_SYMBOL_MARK, NULL, 0, 0, 0);
+        }
+    }
+
+    bw[1].symbol_log = NULL;
+    uint32_t symbol_index = 0;
+    while (symbol_index < symbol_log.count)
+        symbol_index =
+            eb_aom_write_logged_symbols(&bw[1], &symbol_log, symbol_index);
+    aom_stop_encode(&bw[0]);
+    aom_stop_encode(&bw[1]);
+    ec_symbol_log_free(&symbol_log);
+
+    ASSERT_EQ(bw[0].pos, bw[1].pos);
+    EXPECT_EQ(memcmp(stream_buffer[0].data(), stream_buffer[1].data(), bw[0].pos),
+              0);
+    EXPECT_EQ(memcmp(&fc[0], &fc[1], sizeof(fc[0])), 0);
+}
+#endif
 }  // namespace
@@ -9,6 +9,8 @@
  * @brief Unit test for cdef tools:
  * * aom_lpf_{horizontal, vertical}_{4, 6, 8, 14}_sse2
  * * aom_highbd_lpf_{horizontal, vertical}_{4, 6, 8, 14}_sse2
+ * * aom_lpf_{horizontal, vertical}_{4, 6, 8, 14}_dual_avx2
+ * * aom_highbd_lpf_{horizontal, vertical}_{4, 6, 8, 14}_dual_avx2
  *
  * @author Cidana-Wenyao
  *
@@ -87,7 +89,7 @@ uint8_t get_hev_thresh(ACMRandom *rnd) {
 template <typename Sample, typename FuncType, typename TestParamType>
 class LoopFilterTest : public ::testing::TestWithParam<TestParamType> {
   public:
-    enum LpfType { SINGLE };
+    enum LpfType { SINGLE, DUAL };
     virtual ~LoopFilterTest() {
     }
 
@@ -107,7 +109,7 @@ class LoopFilterTest : public ::testing::TestWithParam<TestParamType> {
             buf[i] = val;
     }
 
-    void init_input_random(Sample *s, Sample *ref_s, ACMRandom *rnd) {
+    virtual void init_input_random(Sample *s, Sample *ref_s, ACMRandom *rnd) {
         for (int i = 0; i < kNumCoeffs; ++i) {
             s[i] = rnd->Rand16() & mask_;
             ref_s[i] = s[i];
@@ -226,6 +228,113 @@ TEST_P(HbdLoopFilterTest, MatchTestRandomData) {
     run_test();
 }
 
+#if DLF_DUAL_EDGE_AVX2
+using LbdDualLoopFilterFunc = void (*)(uint8_t *s, LOOP_PARAM,
+                                       const uint8_t *blimit1,
+                                       const uint8_t *limit1,
+                                       const uint8_t *thresh1);
+using HbdDualLoopFilterFunc = void (*)(uint16_t *s, LOOP_PARAM,
+                                       const uint8_t *blimit1,
+                                       const uint8_t *limit1,
+                                       const uint8_t *thresh1, int bd);
+using LbdDualLpfTestParam =
+    ::testing::tuple<LbdDualLoopFilterFunc, LbdDualLoopFilterFunc, int>;
+using HbdDualLpfTestParam =
+    ::testing::tuple<HbdDualLoopFilterFunc, HbdDualLoopFilterFunc, int>;
+
+// class to test the loop filters of two adjacent edges, the second edge
+// using its own thresholds. Half of the blocks are low amplitude noise
+// around a random level, so that the flat filters are exercised too.
+template <typename Sample, typename FuncType, typename TestParamType>
+class DualLoopFilterTest
+    : public LoopFilterTest<Sample, FuncType, TestParamType> {
+  public:
+    using Base = LoopFilterTest<Sample, FuncType, TestParamType>;
+
+    DualLoopFilterTest() : rnd1_(ACMRandom::DeterministicSeed() + 1) {
+        this->lpf_type_ = Base::DUAL;
+    }
+
+    virtual ~DualLoopFilterTest() {
+    }
+
+    void init_input_random(Sample *s, Sample *ref_s,
+                           ACMRandom *rnd) override {
+        if (rnd->Rand8() & 1) {
+            Base::init_input_random(s, ref_s, rnd);
+            return;
+        }
+        const int mask = this->mask_;
+        const int base = rnd->Rand16() & mask;
+        const int amplitude = (1 << (this->bit_depth_ - 8))
+                              << (rnd->Rand8() % 3);
+        for (int i = 0; i < Base::kNumCoeffs; ++i) {
+            const int v = base + rnd->PseudoUniform(amplitude + 1);
+            s[i] = static_cast<Sample>(v > mask ? mask : v);
+            ref_s[i] = s[i];
+        }
+    }
+
+  protected:
+    // randomly generate the thresholds of the second edge
+    void init_thresh1() {
+        this->init_buffer_with_value(blimit1_, 16, get_outer_thresh(&rnd1_));
+        this->init_buffer_with_value(limit1_, 16, get_inner_thresh(&rnd1_));
+        this->init_buffer_with_value(thresh1_, 16, get_hev_thresh(&rnd1_));
+    }
+
+    uint8_t blimit1_[16];
+    uint8_t limit1_[16];
+    uint8_t thresh1_[16];
+
+  private:
+    ACMRandom rnd1_;
+};
+
+// class to test the low bitdepth loop filters of two adjacent edges
+class LbdDualLoopFilterTest
+    : public DualLoopFilterTest<uint8_t, LbdDualLoopFilterFunc,
+                                LbdDualLpfTestParam> {
+  public:
+    virtual ~LbdDualLoopFilterTest() {
+    }
+
+    void run_lpf(LOOP_PARAM, int bd) override {
+        (void)bd;
+        init_thresh1();
+        lpf_tst_(start_tst_, p, blimit, limit, thresh, blimit1_, limit1_,
+                 thresh1_);
+        lpf_ref_(start_ref_, p, blimit, limit, thresh, blimit1_, limit1_,
+                 thresh1_);
+    }
+};
+
+TEST_P(LbdDualLoopFilterTest, MatchTestRandomData) {
+    run_test();
+}
+
+// class to test the high bitdepth loop filters of two adjacent edges
+class HbdDualLoopFilterTest
+    : public DualLoopFilterTest<uint16_t, HbdDualLoopFilterFunc,
+                                HbdDualLpfTestParam> {
+  public:
+    virtual ~HbdDualLoopFilterTest() {
+    }
+
+    void run_lpf(LOOP_PARAM, int bd) override {
+        init_thresh1();
+        lpf_tst_(start_tst_, p, blimit, limit, thresh, blimit1_, limit1_,
+                 thresh1_, bd);
+        lpf_ref_(start_ref_, p, blimit, limit, thresh, blimit1_, limit1_,
+                 thresh1_, bd);
+    }
+};
+
+TEST_P(HbdDualLoopFilterTest, MatchTestRandomData) {
+    run_test();
+}
+#endif
+
 // target and reference functions in different cases
 /* clang-format off */
 const HbdLpfTestParam kHbdLoop8Test6[] = {
@@ -293,10 +402,88 @@ const LdbLpfTestParam kLoop8Test6[] = {
     make_tuple(&aom_lpf_horizontal_14_sse2, &aom_lpf_horizontal_14_c, 8),
     make_tuple(&aom_lpf_vertical_14_sse2, &aom_lpf_vertical_14_c, 8),
 };
+
+#if DLF_DUAL_EDGE_AVX2
+const LbdDualLpfTestParam kLbdDualLoopTestAvx2[] = {
+    make_tuple(&aom_lpf_horizontal_4_dual_avx2,
+               &aom_lpf_horizontal_4_dual_c, 8),
+    make_tuple(&aom_lpf_horizontal_6_dual_avx2,
+               &aom_lpf_horizontal_6_dual_c, 8),
+    make_tuple(&aom_lpf_horizontal_8_dual_avx2,
+               &aom_lpf_horizontal_8_dual_c, 8),
+    make_tuple(&aom_lpf_horizontal_14_dual_avx2,
+               &aom_lpf_horizontal_14_dual_c, 8),
+    make_tuple(&aom_lpf_vertical_4_dual_avx2,
+               &aom_lpf_vertical_4_dual_c, 8),
+    make_tuple(&aom_lpf_vertical_6_dual_avx2,
+               &aom_lpf_vertical_6_dual_c, 8),
+    make_tuple(&aom_lpf_vertical_8_dual_avx2,
+               &aom_lpf_vertical_8_dual_c, 8),
+    make_tuple(&aom_lpf_vertical_14_dual_avx2,
+               &aom_lpf_vertical_14_dual_c, 8)};
+
+const HbdDualLpfTestParam kHbdDualLoopTestAvx2[] = {
+    make_tuple(&aom_highbd_lpf_horizontal_4_dual_avx2,
+               &aom_highbd_lpf_horizontal_4_dual_c, 8),
+    make_tuple(&aom_highbd_lpf_horizontal_6_dual_avx2,
+               &aom_highbd_lpf_horizontal_6_dual_c, 8),
+    make_tuple(&aom_highbd_lpf_horizontal_8_dual_avx2,
+               &aom_highbd_lpf_horizontal_8_dual_c, 8),
+    make_tuple(&aom_highbd_lpf_horizontal_14_dual_avx2,
+               &aom_highbd_lpf_horizontal_14_dual_c, 8),
+    make_tuple(&aom_highbd_lpf_vertical_4_dual_avx2,
+               &aom_highbd_lpf_vertical_4_dual_c, 8),
+    make_tuple(&aom_highbd_lpf_vertical_6_dual_avx2,
+               &aom_highbd_lpf_vertical_6_dual_c, 8),
+    make_tuple(&aom_highbd_lpf_vertical_8_dual_avx2,
+               &aom_highbd_lpf_vertical_8_dual_c, 8),
+    make_tuple(&aom_highbd_lpf_vertical_14_dual_avx2,
+               &aom_highbd_lpf_vertical_14_dual_c, 8),
+
+    make_tuple(&aom_highbd_lpf_horizontal_4_dual_avx2,
+               &aom_highbd_lpf_horizontal_4_dual_c, 10),
+    make_tuple(&aom_highbd_lpf_horizontal_6_dual_avx2,
+               &aom_highbd_lpf_horizontal_6_dual_c, 10),
+    make_tuple(&aom_highbd_lpf_horizontal_8_dual_avx2,
+               &aom_highbd_lpf_horizontal_8_dual_c, 10),
+    make_tuple(&aom_highbd_lpf_horizontal_14_dual_avx2,
+               &aom_highbd_lpf_horizontal_14_dual_c, 10),
+    make_tuple(&aom_highbd_lpf_vertical_4_dual_avx2,
+               &aom_highbd_lpf_vertical_4_dual_c, 10),
+    make_tuple(&aom_highbd_lpf_vertical_6_dual_avx2,
+               &aom_highbd_lpf_vertical_6_dual_c, 10),
+    make_tuple(&aom_highbd_lpf_vertical_8_dual_avx2,
+               &aom_highbd_lpf_vertical_8_dual_c, 10),
+    make_tuple(&aom_highbd_lpf_vertical_14_dual_avx2,
+               &aom_highbd_lpf_vertical_14_dual_c, 10),
+
+    make_tuple(&aom_highbd_lpf_horizontal_4_dual_avx2,
+               &aom_highbd_lpf_horizontal_4_dual_c, 12),
+    make_tuple(&aom_highbd_lpf_horizontal_6_dual_avx2,
+               &aom_highbd_lpf_horizontal_6_dual_c, 12),
+    make_tuple(&aom_highbd_lpf_horizontal_8_dual_avx2,
+               &aom_highbd_lpf_horizontal_8_dual_c, 12),
+    make_tuple(&aom_highbd_lpf_horizontal_14_dual_avx2,
+               &aom_highbd_lpf_horizontal_14_dual_c, 12),
+    make_tuple(&aom_highbd_lpf_vertical_4_dual_avx2,
+               &aom_highbd_lpf_vertical_4_dual_c, 12),
+    make_tuple(&aom_highbd_lpf_vertical_6_dual_avx2,
+               &aom_highbd_lpf_vertical_6_dual_c, 12),
+    make_tuple(&aom_highbd_lpf_vertical_8_dual_avx2,
+               &aom_highbd_lpf_vertical_8_dual_c, 12),
+    make_tuple(&aom_highbd_lpf_vertical_14_dual_avx2,
+               &aom_highbd_lpf_vertical_14_dual_c, 12)};
+#endif
 /* clang-format on */
 
 INSTANTIATE_TEST_CASE_P(SSE2, LbdLoopFilterTest,
                         ::testing::ValuesIn(kLoop8Test6));
 INSTANTIATE_TEST_CASE_P(SSE2, HbdLoopFilterTest,
                         ::testing::ValuesIn(kHbdLoop8Test6));
+#if DLF_DUAL_EDGE_AVX2
+INSTANTIATE_TEST_CASE_P(AVX2, LbdDualLoopFilterTest,
+                        ::testing::ValuesIn(kLbdDualLoopTestAvx2));
+INSTANTIATE_TEST_CASE_P(AVX2, HbdDualLoopFilterTest,
+                        ::testing::ValuesIn(kHbdDualLoopTestAvx2));
+#endif
 }  // namespace
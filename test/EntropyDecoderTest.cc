@@ -0,0 +1,270 @@
+/*
+ * Copyright(c) 2019 Netflix, Inc.
+ * SPDX - License - Identifier: BSD - 2 - Clause - Patent
+ */
+
+/******************************************************************************
+ * @file EntropyDecoderTest.cc
+ *
+ * @brief Unit test for the 64-bit entropy decoder:
+ * - od_ec_dec_refill
+ * - od_ec_decode_bool_q15
+ * - od_ec_decode_cdf_adapt_q15
+ * - svt_read_coeff_br
+ *
+ ******************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+#include "EbCabacContextModel.h"
+#if defined(CHAR_BIT)
+#undef CHAR_BIT  // defined in clang/9.1.0/include/limits.h
+#endif
+#include "EbDecBitReader.h"
+#include "gtest/gtest.h"
+#include "random.h"
+
+#if DEC_FAST_ENTROPY
+using svt_av1_test_tool::SVTRandom;
+namespace {
+
+/** Reference decoder: the 32-bit window refilled one byte at a time, with the
+ * scalar CDF search and dec_update_cdf(), as before DEC_FAST_ENTROPY */
+typedef struct RefEcDec {
+    const uint8_t *buf;
+    const uint8_t *end;
+    const uint8_t *bptr;
+    int32_t tell_offs;
+    uint32_t dif;
+    uint16_t rng;
+    int16_t cnt;
+} RefEcDec;
+
+const int ref_window_size = 32;
+const int ref_lots_of_bits = 0x4000;
+
+void ref_refill(RefEcDec *dec) {
+    int s = ref_window_size - 9 - (dec->cnt + 15);
+    for (; s >= 0 && dec->bptr < dec->end; s -= 8, dec->bptr++) {
+        dec->dif ^= (uint32_t)dec->bptr[0] << s;
+        dec->cnt += 8;
+    }
+    if (dec->bptr >= dec->end) {
+        dec->tell_offs += ref_lots_of_bits - dec->cnt;
+        dec->cnt = ref_lots_of_bits;
+    }
+}
+
+void ref_init(RefEcDec *dec, const uint8_t *buf, uint32_t size) {
+    dec->buf = buf;
+    dec->end = buf + size;
+    dec->bptr = buf;
+    dec->tell_offs = 10 - (ref_window_size - 8);
+    dec->dif = (1u << (ref_window_size - 1)) - 1;
+    dec->rng = 0x8000;
+    dec->cnt = -15;
+    ref_refill(dec);
+}
+
+int ref_normalize(RefEcDec *dec, uint32_t dif, unsigned rng, int ret) {
+    const int d = 16 - OD_ILOG_NZ(rng);
+    dec->cnt -= d;
+    dec->dif = ((dif + 1) << d) - 1;
+    dec->rng = rng << d;
+    if (dec->cnt < 0)
+        ref_refill(dec);
+    return ret;
+}
+
+int ref_decode_bool(RefEcDec *dec, unsigned f) {
+    const uint32_t dif = dec->dif;
+    const unsigned r = dec->rng;
+    const unsigned v =
+        ((r >> 8) * (uint32_t)(f >> EC_PROB_SHIFT) >> (7 - EC_PROB_SHIFT)) +
+        EC_MIN_PROB;
+    const uint32_t vw = (uint32_t)v << (ref_window_size - 16);
+    if (dif >= vw)
+        return ref_normalize(dec, dif - vw, r - v, 0);
+    return ref_normalize(dec, dif, v, 1);
+}
+
+int ref_decode_cdf(RefEcDec *dec, const uint16_t *icdf, int nsyms) {
+    const uint32_t dif = dec->dif;
+    const unsigned r = dec->rng;
+    const int n = nsyms - 1;
+    const unsigned c = dif >> (ref_window_size - 16);
+    unsigned u;
+    unsigned v = r;
+    int ret = -1;
+    do {
+        u = v;
+        ++ret;
+        v = ((r >> 8) * (uint32_t)(icdf[ret] >> EC_PROB_SHIFT) >>
+             (7 - EC_PROB_SHIFT - CDF_SHIFT)) +
+            EC_MIN_PROB * (n - ret);
+    } while (c < v);
+    return ref_normalize(
+        dec, dif - ((uint32_t)v << (ref_window_size - 16)), u - v, ret);
+}
+
+int ref_read_symbol(RefEcDec *dec, uint16_t *cdf, int nsyms, int adapt) {
+    const int ret = ref_decode_cdf(dec, cdf, nsyms);
+    if (adapt)
+        dec_update_cdf(cdf, (int8_t)ret, nsyms);
+    return ret;
+}
+
+/** Bits consumed so far, refills and reads past the end do not change it */
+template <typename Dec>
+int32_t consumed_bits(const Dec &dec) {
+    return (int32_t)((dec.bptr - dec.buf) * 8) - dec.cnt + dec.tell_offs;
+}
+
+/** CDF array with room for the 16 entries read by the SSE2 search, the
+ * counter and guard entries which must stay untouched */
+const int cdf_array_size = 20;
+
+/**
+ * @brief Unit test for the 64-bit entropy decoder:
+ * - od_ec_dec_refill
+ * - od_ec_decode_bool_q15
+ * - od_ec_decode_cdf_adapt_q15
+ * - svt_read_coeff_br
+ *
+ * Test strategy:
+ * Decode random byte streams with SvtReader and with the reference 32-bit
+ * decoder above, mixing bools, literals, symbols with and without CDF
+ * adaptation, direct od_ec_decode_cdf_adapt_q15 calls and coefficient base
+ * ranges on random CDFs of 2 to 16 symbols. Streams of 1 to 16 bytes refill
+ * at the end of the buffer from the first symbol, longer streams go through
+ * the 8-byte refill before reading past their end.
+ *
+ * Expected result:
+ * Every decoded value, every adapted CDF and counter and the number of bits
+ * consumed match the reference. The entries past the counter are not written.
+ *
+ * Test coverage:
+ * Stream sizes 1 to 16 and 64 to 1024 bytes, CDF counters 0 to 32.
+ */
+class EntropyDecoderTest : public ::testing::Test {
+  public:
+    EntropyDecoderTest()
+        : byte_(0, 255, 0x1234),
+          prob_(0, 255, 0x2345),
+          op_(0, 5, 0x3456),
+          nsyms_(2, 16, 0x4567),
+          count_(0, 32, 0x5678),
+          icdf_(0, CDF_PROB_TOP - 1, 0x6789) {
+    }
+
+    void run_streams(int min_size, int max_size, int num_streams) {
+        SVTRandom size(min_size, max_size, 0x789a);
+        for (int i = 0; i < num_streams; i++) {
+            std::vector<uint8_t> stream(size.random());
+            for (uint8_t &b : stream)
+                b = (uint8_t)byte_.random();
+            // reads go on past the end of the stream
+            const int num_ops = (int)stream.size() * 4 + 64;
+            ASSERT_NO_FATAL_FAILURE(check_stream(stream, num_ops))
+                << "stream " << i << " size " << stream.size();
+        }
+    }
+
+  private:
+    void random_cdf(uint16_t *cdf, int nsyms) {
+        for (int k = 0; k < cdf_array_size; k++)
+            cdf[k] = (uint16_t)icdf_.random();
+        std::sort(cdf, cdf + nsyms - 1, std::greater<uint16_t>());
+        cdf[nsyms - 1] = 0;
+        cdf[nsyms] = (uint16_t)count_.random();
+    }
+
+    void check_stream(const std::vector<uint8_t> &stream, int num_ops) {
+        SvtReader br;
+        RefEcDec ref;
+        svt_reader_init(&br, stream.data(), stream.size());
+        ref_init(&ref, stream.data(), (uint32_t)stream.size());
+        const int32_t tell0 = consumed_bits(br.ec);
+        const int32_t ref_tell0 = consumed_bits(ref);
+
+        uint16_t cdf[cdf_array_size], ref_cdf[cdf_array_size];
+        for (int i = 0; i < num_ops; i++) {
+            const int op = op_.random();
+            const int nsyms = op == 5 ? BR_CDF_SIZE : nsyms_.random();
+            random_cdf(cdf, nsyms);
+            memcpy(ref_cdf, cdf, sizeof(cdf));
+            br.allow_update_cdf = (uint8_t)(byte_.random() & 1);
+            int value = 0, ref_value = 0;
+            switch (op) {
+            case 0: {
+                const int prob = prob_.random();
+                value = svt_read(&br, prob, nullptr);
+                ref_value = ref_decode_bool(
+                    &ref, (0x7FFFFF - (prob << 15) + prob) >> 8);
+                break;
+            }
+            case 1: {
+                const int bits = nsyms;
+                value = svt_read_literal(&br, bits, nullptr);
+                for (int bit = bits - 1; bit >= 0; bit--)
+                    ref_value |= ref_decode_bool(&ref, 16384) << bit;
+                break;
+            }
+            case 2:
+                value = svt_read_cdf(&br, cdf, nsyms, nullptr);
+                ref_value = ref_decode_cdf(&ref, ref_cdf, nsyms);
+                break;
+            case 3:
+                value = svt_read_symbol(&br, cdf, nsyms, nullptr);
+                ref_value = ref_read_symbol(
+                    &ref, ref_cdf, nsyms, br.allow_update_cdf);
+                break;
+            case 4:
+                value = od_ec_decode_cdf_adapt_q15(&br.ec, cdf, nsyms, cdf);
+                ref_value = ref_read_symbol(&ref, ref_cdf, nsyms, 1);
+                break;
+            default:
+                value = svt_read_coeff_br(&br, cdf);
+                for (int idx = 0; idx < COEFF_BASE_RANGE;
+                     idx += BR_CDF_SIZE - 1) {
+                    const int k = ref_read_symbol(
+                        &ref, ref_cdf, BR_CDF_SIZE, br.allow_update_cdf);
+                    ref_value += k;
+                    if (k < BR_CDF_SIZE - 1)
+                        break;
+                }
+                break;
+            }
+            ASSERT_EQ(value, ref_value)
+                << "op " << op << " at " << i << " nsyms " << nsyms;
+            for (int k = 0; k < cdf_array_size; k++) {
+                ASSERT_EQ(cdf[k], ref_cdf[k])
+                    << "op " << op << " at " << i << " nsyms " << nsyms
+                    << " cdf entry " << k;
+            }
+            ASSERT_EQ(br.ec.rng, ref.rng) << "op " << op << " at " << i;
+            ASSERT_EQ(consumed_bits(br.ec) - tell0,
+                      consumed_bits(ref) - ref_tell0)
+                << "op " << op << " at " << i;
+        }
+    }
+
+    SVTRandom byte_;
+    SVTRandom prob_;
+    SVTRandom op_;
+    SVTRandom nsyms_;
+    SVTRandom count_;
+    SVTRandom icdf_;
+};
+
+TEST_F(EntropyDecoderTest, MatchShortStreams) {
+    run_streams(1, 16, 2000);
+}
+
+TEST_F(EntropyDecoderTest, MatchLongStreams) {
+    run_streams(64, 1024, 200);
+}
+
+}  // namespace
+#endif  // DEC_FAST_ENTROPY
@@ -209,6 +209,8 @@ class AddFilmGrainTest : public ::testing::Test {
     static const int chroma_size = luma_size >> 2;
 
     void SetUp() override {
+        // grain blending goes through the RTCD kernels
+        setup_common_rtcd_internal(get_cpu_flags_to_use());
         luma_ = (uint8_t *)eb_aom_malloc(luma_size);
         cb_ = (uint8_t *)eb_aom_malloc(chroma_size);
         cr_ = (uint8_t *)eb_aom_malloc(chroma_size);
@@ -271,6 +273,196 @@ TEST_F(AddFilmGrainTest, MatchTest) {
     }
 }
 
+/**
+ * @brief Unit test for the film grain blend kernels
+ *
+ * Test strategy:
+ *  Run the C and the SIMD versions of the luma / chroma blend kernels and of
+ *  the horizontal boundary overlap on the same random pixels, grain and
+ *  scaling tables, and compare the outputs.
+ *
+ * Test coverage:
+ *  Bit depths 8, 10 and 12, all chroma subsampling modes, random block
+ *  sizes (so both the vector body and the scalar tail are exercised),
+ *  full and restricted output ranges.
+ */
+class FilmGrainBlendTest : public ::testing::TestWithParam<CPU_FLAGS> {
+  public:
+    static const int kMaxSize = 64;
+    static const int kStride = kMaxSize + 8;
+    static const int kBufSize = kStride * kMaxSize;
+
+    void SetUp() override {
+        random_.Reset(libaom_test::ACMRandom::DeterministicSeed());
+    }
+
+  protected:
+    void init_params(int bit_depth) {
+        for (int i = 0; i < 256; ++i)
+            scaling_lut_[i] = random_.Rand8();
+        scaling_lut_[256] = scaling_lut_[255];
+
+        const int grain_center = 128 << (bit_depth - 8);
+        grain_min_ = -grain_center;
+        grain_max_ = (256 << (bit_depth - 8)) - 1 - grain_center;
+        for (int i = 0; i < kBufSize; ++i)
+            grain_[i] = grain_min_ +
+                        random_.PseudoUniform(grain_max_ - grain_min_ + 1);
+
+        sp_.scaling_lut = scaling_lut_;
+        sp_.scaling_shift = 8 + random_.PseudoUniform(4);
+        sp_.luma_mult = random_.PseudoUniform(256) - 128;
+        sp_.mult = random_.PseudoUniform(256) - 128;
+        sp_.offset = (random_.PseudoUniform(512) << (bit_depth - 8)) -
+                     (1 << bit_depth);
+        sp_.bit_depth = bit_depth;
+        if (random_.PseudoUniform(2)) {
+            sp_.min_value = 16 << (bit_depth - 8);
+            sp_.max_value = 235 << (bit_depth - 8);
+        } else {
+            sp_.min_value = 0;
+            sp_.max_value = (256 << (bit_depth - 8)) - 1;
+        }
+    }
+
+    void init_pixels(int bit_depth) {
+        const int mask = (1 << bit_depth) - 1;
+        for (int i = 0; i < kBufSize; ++i) {
+            luma16_[i] = random_.Rand16() & mask;
+            chroma16_ref_[i] = random_.Rand16() & mask;
+            luma8_[i] = (uint8_t)luma16_[i];
+            chroma8_ref_[i] = (uint8_t)chroma16_ref_[i];
+        }
+        memcpy(luma16_tst_, luma16_, sizeof(luma16_));
+        memcpy(luma8_tst_, luma8_, sizeof(luma8_));
+        memcpy(chroma16_tst_, chroma16_ref_, sizeof(chroma16_ref_));
+        memcpy(chroma8_tst_, chroma8_ref_, sizeof(chroma8_ref_));
+    }
+
+    void run_blend_test(int bit_depth) {
+        if ((get_cpu_flags_to_use() & GetParam()) != GetParam())
+            return;
+        setup_common_rtcd_internal(GetParam());
+
+        for (int iter = 0; iter < 200; ++iter) {
+            init_params(bit_depth);
+            init_pixels(bit_depth);
+
+            const int subsamp_x = random_.PseudoUniform(2);
+            const int subsamp_y = random_.PseudoUniform(2);
+            const int width = 1 + random_.PseudoUniform(kMaxSize >> subsamp_x);
+            const int height = 1 + random_.PseudoUniform(kMaxSize >> subsamp_y);
+
+            if (bit_depth == 8) {
+                eb_fgn_add_noise_chroma_c(chroma8_ref_, kStride, luma8_,
+                                          kStride, grain_, kStride, width,
+                                          height, subsamp_x, subsamp_y, &sp_);
+                eb_fgn_add_noise_chroma(chroma8_tst_, kStride, luma8_tst_,
+                                        kStride, grain_, kStride, width,
+                                        height, subsamp_x, subsamp_y, &sp_);
+                eb_fgn_add_noise_luma_c(luma8_, kStride, grain_, kStride,
+                                        width << subsamp_x,
+                                        height << subsamp_y, &sp_);
+                eb_fgn_add_noise_luma(luma8_tst_, kStride, grain_, kStride,
+                                      width << subsamp_x, height << subsamp_y,
+                                      &sp_);
+                EXPECT_EQ(0, memcmp(chroma8_ref_, chroma8_tst_,
+                                    sizeof(chroma8_ref_)))
+                    << "chroma " << width << "x" << height;
+                EXPECT_EQ(0, memcmp(luma8_, luma8_tst_, sizeof(luma8_)))
+                    << "luma " << width << "x" << height;
+            } else {
+                eb_fgn_add_noise_chroma_hbd_c(
+                    chroma16_ref_, kStride, luma16_, kStride, grain_, kStride,
+                    width, height, subsamp_x, subsamp_y, &sp_);
+                eb_fgn_add_noise_chroma_hbd(
+                    chroma16_tst_, kStride, luma16_tst_, kStride, grain_,
+                    kStride, width, height, subsamp_x, subsamp_y, &sp_);
+                eb_fgn_add_noise_luma_hbd_c(luma16_, kStride, grain_, kStride,
+                                            width << subsamp_x,
+                                            height << subsamp_y, &sp_);
+                eb_fgn_add_noise_luma_hbd(luma16_tst_, kStride, grain_,
+                                          kStride, width << subsamp_x,
+                                          height << subsamp_y, &sp_);
+                EXPECT_EQ(0, memcmp(chroma16_ref_, chroma16_tst_,
+                                    sizeof(chroma16_ref_)))
+                    << "chroma " << width << "x" << height;
+                EXPECT_EQ(0, memcmp(luma16_, luma16_tst_, sizeof(luma16_)))
+                    << "luma " << width << "x" << height;
+            }
+            if (HasFailure())
+                return;
+        }
+    }
+
+    void run_overlap_test(int bit_depth) {
+        if ((get_cpu_flags_to_use() & GetParam()) != GetParam())
+            return;
+        setup_common_rtcd_internal(GetParam());
+
+        for (int iter = 0; iter < 200; ++iter) {
+            init_params(bit_depth);
+            const int width = 1 + random_.PseudoUniform(kMaxSize);
+            const int height = 1 + random_.PseudoUniform(2);
+            int32_t dst_ref[2 * kStride], dst_tst[2 * kStride];
+
+            for (int i = 0; i < 2 * kStride; ++i)
+                dst_ref[i] = dst_tst[i] =
+                    grain_min_ +
+                    random_.PseudoUniform(grain_max_ - grain_min_ + 1);
+
+            // the top block is the destination, as in the line buffer
+            // updates of eb_av1_add_film_grain_run()
+            eb_fgn_hor_boundary_overlap_c(dst_ref, kStride, grain_, kStride,
+                                          dst_ref, kStride, width, height,
+                                          grain_min_, grain_max_);
+            eb_fgn_hor_boundary_overlap(dst_tst, kStride, grain_, kStride,
+                                        dst_tst, kStride, width, height,
+                                        grain_min_, grain_max_);
+            EXPECT_EQ(0, memcmp(dst_ref, dst_tst, sizeof(dst_ref)))
+                << width << "x" << height;
+            if (HasFailure())
+                return;
+        }
+    }
+
+    libaom_test::ACMRandom random_;
+    FgnScaleParams sp_;
+    int32_t scaling_lut_[257];
+    int32_t grain_min_, grain_max_;
+    int32_t grain_[kBufSize];
+    uint8_t luma8_[kBufSize], luma8_tst_[kBufSize];
+    uint8_t chroma8_ref_[kBufSize], chroma8_tst_[kBufSize];
+    uint16_t luma16_[kBufSize], luma16_tst_[kBufSize];
+    uint16_t chroma16_ref_[kBufSize], chroma16_tst_[kBufSize];
+};
+
+TEST_P(FilmGrainBlendTest, MatchTest8Bit) {
+    run_blend_test(8);
+}
+
+TEST_P(FilmGrainBlendTest, MatchTest10Bit) {
+    run_blend_test(10);
+}
+
+TEST_P(FilmGrainBlendTest, MatchTest12Bit) {
+    run_blend_test(12);
+}
+
+TEST_P(FilmGrainBlendTest, OverlapMatchTest) {
+    run_overlap_test(8);
+    run_overlap_test(10);
+}
+
+INSTANTIATE_TEST_CASE_P(AVX2, FilmGrainBlendTest,
+                        ::testing::Values((CPU_FLAGS)CPU_FLAGS_AVX2));
+
+#ifndef NON_AVX512_SUPPORT
+INSTANTIATE_TEST_CASE_P(AVX512, FilmGrainBlendTest,
+                        ::testing::Values((CPU_FLAGS)(CPU_FLAGS_AVX2 |
+                                                    CPU_FLAGS_AVX512F)));
+#endif
+
 extern "C" {
 #include "EbPictureControlSet.h"
 #include "EbPictureBufferDesc.h"
@@ -16,6 +16,7 @@
  * - unpack_avg_avx2_intrin
  * - unpack_avg_sse2_intrin
  * - unpack_avg_safe_sub_avx2_intrin
+ * - eb_dec_out_*_avx2 (decoder output conversion)
  *
  * @author Cidana-Ivy, Cidana-Wenyao
  *
@@ -739,4 +740,161 @@ TEST_P(UnPackAvgTest, UnPackSubAvgTest) {
 INSTANTIATE_TEST_CASE_P(UNPACKAVG, UnPackAvgTest,
                         ::testing::ValuesIn(TEST_AVG_SIZES));
 
+#if DEC_OUT_CONVERT
+// test the decoder output conversion kernels eb_dec_out_*_avx2 against their
+// C version, TEST_COMMON_SIZES covers the widths handled by the C tail.
+class DecOutConvertTest : public ::testing::TestWithParam<AreaSize> {
+  public:
+    DecOutConvertTest()
+        : area_width_(std::get<0>(GetParam())),
+          area_height_(std::get<1>(GetParam())) {
+        src_stride_ = MAX_SB_SIZE;
+        // interleaved chroma rows hold twice the samples of a plane row
+        dst_stride_ = 2 * MAX_SB_SIZE;
+        test_size_ = MAX_SB_SQUARE;
+        src_u_ = src_v_ = nullptr;
+        src_u16_ = src_v16_ = nullptr;
+        dst_c_ = dst_avx2_ = nullptr;
+    }
+
+    void SetUp() override {
+        src_u_ = reinterpret_cast<uint8_t *>(eb_aom_memalign(32, test_size_));
+        src_v_ = reinterpret_cast<uint8_t *>(eb_aom_memalign(32, test_size_));
+        src_u16_ = reinterpret_cast<uint16_t *>(
+            eb_aom_memalign(32, sizeof(uint16_t) * test_size_));
+        src_v16_ = reinterpret_cast<uint16_t *>(
+            eb_aom_memalign(32, sizeof(uint16_t) * test_size_));
+        dst_c_ = reinterpret_cast<uint16_t *>(
+            eb_aom_memalign(32, sizeof(uint16_t) * 2 * test_size_));
+        dst_avx2_ = reinterpret_cast<uint16_t *>(
+            eb_aom_memalign(32, sizeof(uint16_t) * 2 * test_size_));
+    }
+
+    void TearDown() override {
+        if (src_u_)
+            eb_aom_free(src_u_);
+        if (src_v_)
+            eb_aom_free(src_v_);
+        if (src_u16_)
+            eb_aom_free(src_u16_);
+        if (src_v16_)
+            eb_aom_free(src_v16_);
+        if (dst_c_)
+            eb_aom_free(dst_c_);
+        if (dst_avx2_)
+            eb_aom_free(dst_avx2_);
+        aom_clear_system_state();
+    }
+
+  protected:
+    void prepare_data(uint32_t bd) {
+        eb_buf_random_u8(src_u_, test_size_);
+        eb_buf_random_u8(src_v_, test_size_);
+        eb_buf_random_u16_with_bd(src_u16_, test_size_, bd);
+        eb_buf_random_u16_with_bd(src_v16_, test_size_, bd);
+        // same fill so that the samples between the rows compare too
+        memset(dst_c_, 0xA5, sizeof(uint16_t) * 2 * test_size_);
+        memset(dst_avx2_, 0xA5, sizeof(uint16_t) * 2 * test_size_);
+    }
+
+    void check_output(const char *name, uint32_t shift) {
+        EXPECT_EQ(0,
+                  memcmp(dst_c_, dst_avx2_, sizeof(uint16_t) * 2 * test_size_))
+            << name << " failed with shift " << shift << " and size ("
+            << area_width_ << "," << area_height_ << ")";
+    }
+
+    void run_test() {
+        uint8_t *dst_c8 = reinterpret_cast<uint8_t *>(dst_c_);
+        uint8_t *dst_avx2_8 = reinterpret_cast<uint8_t *>(dst_avx2_);
+        for (int i = 0; i < RANDOM_TIME; i++) {
+            for (uint32_t shift = 0; shift <= 4; shift += 2) {
+                prepare_data(8 + shift);
+                eb_dec_out_pack_u16_to_u8_c(src_u16_, src_stride_, dst_c8,
+                                            dst_stride_, area_width_,
+                                            area_height_, shift);
+                eb_dec_out_pack_u16_to_u8_avx2(src_u16_, src_stride_,
+                                               dst_avx2_8, dst_stride_,
+                                               area_width_, area_height_,
+                                               shift);
+                check_output("eb_dec_out_pack_u16_to_u8", shift);
+
+                prepare_data(8 + shift);
+                eb_dec_out_interleave_u16_to_u8_c(src_u16_, src_v16_,
+                                                  src_stride_, dst_c8,
+                                                  dst_stride_, area_width_,
+                                                  area_height_, shift);
+                eb_dec_out_interleave_u16_to_u8_avx2(src_u16_, src_v16_,
+                                                     src_stride_, dst_avx2_8,
+                                                     dst_stride_, area_width_,
+                                                     area_height_, shift);
+                check_output("eb_dec_out_interleave_u16_to_u8", shift);
+
+                prepare_data(10);
+                eb_dec_out_unpack_u8_to_u16_c(src_u_, src_stride_, dst_c_,
+                                              dst_stride_, area_width_,
+                                              area_height_, shift);
+                eb_dec_out_unpack_u8_to_u16_avx2(src_u_, src_stride_,
+                                                 dst_avx2_, dst_stride_,
+                                                 area_width_, area_height_,
+                                                 shift);
+                check_output("eb_dec_out_unpack_u8_to_u16", shift);
+
+                prepare_data(10);
+                eb_dec_out_shift_u16_c(src_u16_, src_stride_, dst_c_,
+                                       dst_stride_, area_width_,
+                                       area_height_, shift);
+                eb_dec_out_shift_u16_avx2(src_u16_, src_stride_, dst_avx2_,
+                                          dst_stride_, area_width_,
+                                          area_height_, shift);
+                check_output("eb_dec_out_shift_u16", shift);
+
+                prepare_data(10);
+                eb_dec_out_interleave_u8_to_u16_c(src_u_, src_v_, src_stride_,
+                                                  dst_c_, dst_stride_,
+                                                  area_width_, area_height_,
+                                                  shift);
+                eb_dec_out_interleave_u8_to_u16_avx2(src_u_, src_v_,
+                                                     src_stride_, dst_avx2_,
+                                                     dst_stride_, area_width_,
+                                                     area_height_, shift);
+                check_output("eb_dec_out_interleave_u8_to_u16", shift);
+
+                prepare_data(10);
+                eb_dec_out_interleave_u16_c(src_u16_, src_v16_, src_stride_,
+                                            dst_c_, dst_stride_, area_width_,
+                                            area_height_, 6 + shift / 2);
+                eb_dec_out_interleave_u16_avx2(src_u16_, src_v16_,
+                                               src_stride_, dst_avx2_,
+                                               dst_stride_, area_width_,
+                                               area_height_, 6 + shift / 2);
+                check_output("eb_dec_out_interleave_u16", 6 + shift / 2);
+            }
+
+            prepare_data(8);
+            eb_dec_out_interleave_u8_c(src_u_, src_v_, src_stride_, dst_c8,
+                                       dst_stride_, area_width_, area_height_);
+            eb_dec_out_interleave_u8_avx2(src_u_, src_v_, src_stride_,
+                                          dst_avx2_8, dst_stride_,
+                                          area_width_, area_height_);
+            check_output("eb_dec_out_interleave_u8", 0);
+        }
+    }
+
+    uint8_t *src_u_, *src_v_;
+    uint16_t *src_u16_, *src_v16_;
+    uint16_t *dst_c_, *dst_avx2_;
+    uint32_t src_stride_, dst_stride_;
+    uint32_t area_width_, area_height_;
+    uint32_t test_size_;
+};
+
+TEST_P(DecOutConvertTest, DecOutConvertTest) {
+    run_test();
+};
+
+INSTANTIATE_TEST_CASE_P(DECOUTCONVERT, DecOutConvertTest,
+                        ::testing::ValuesIn(TEST_COMMON_SIZES));
+#endif
+
 }  // namespace
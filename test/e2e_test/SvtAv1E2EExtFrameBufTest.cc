@@ -0,0 +1,294 @@
+/*
+ * Copyright(c) 2019 Netflix, Inc.
+ * SPDX - License - Identifier: BSD - 2 - Clause - Patent
+ */
+
+/******************************************************************************
+ * @file SvtAv1E2EExtFrameBufTest.cc
+ *
+ * @brief SVT-AV1 decoder external frame buffer E2E test
+ *
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <list>
+#include <set>
+#include <string>
+#include <vector>
+#include "EbSvtAv1Enc.h"
+#include "EbSvtAv1Dec.h"
+#include "gtest/gtest.h"
+#include "SvtAv1E2EFramework.h"
+
+using namespace svt_av1_e2e_test;
+using namespace svt_av1_e2e_test_vector;
+using std::string;
+using std::vector;
+
+/** Pictures the decoder lets the application hold at a time */
+static const size_t max_held_pictures = 4;
+
+/** Memory handed to the decoder through the frame buffer callbacks */
+typedef struct ExtBufPool {
+    std::set<uint8_t *> live;
+    uint32_t alloc_count;
+    uint32_t release_count;
+    bool unknown_release;
+} ExtBufPool;
+
+static int get_frame_buffer(EbExtFrameBuf *frame_buf, uint32_t min_size,
+                            void *private_data) {
+    ExtBufPool *pool = (ExtBufPool *)private_data;
+    frame_buf->buffer = (uint8_t *)malloc(min_size);
+    if (!frame_buf->buffer)
+        return -1;
+    frame_buf->buffer_size = min_size;
+    frame_buf->private_data = nullptr;
+    pool->live.insert(frame_buf->buffer);
+    pool->alloc_count++;
+    return 0;
+}
+
+static int release_frame_buffer(EbExtFrameBuf *frame_buf, void *private_data) {
+    ExtBufPool *pool = (ExtBufPool *)private_data;
+    if (!pool->live.erase(frame_buf->buffer)) {
+        pool->unknown_release = true;
+        return -1;
+    }
+    free(frame_buf->buffer);
+    pool->release_count++;
+    return 0;
+}
+
+/** Picture returned by reference, with its position in output order */
+typedef struct HeldPicture {
+    EbBufferHeaderType header;
+    EbSvtIOFormat pic;
+    size_t index;
+} HeldPicture;
+
+/** Copies the luma plane of pic, width samples apart */
+static vector<uint8_t> copy_luma(const EbSvtIOFormat &pic) {
+    const uint32_t sample_size = pic.bit_depth == EB_EIGHT_BIT ? 1 : 2;
+    const uint32_t row_size = pic.width * sample_size;
+    vector<uint8_t> luma(row_size * pic.height);
+    for (uint32_t y = 0; y < pic.height; y++)
+        memcpy(&luma[y * row_size],
+               pic.luma + ((pic.origin_y + y) * pic.y_stride + pic.origin_x) *
+                              sample_size,
+               row_size);
+    return luma;
+}
+
+static void init_decoder(EbComponentType **handle, uint32_t width,
+                         uint32_t height, uint32_t bit_depth,
+                         ExtBufPool *pool) {
+    EbSvtAv1DecConfiguration config;
+    ASSERT_EQ(svt_av1_dec_init_handle(handle, nullptr, &config),
+              EB_ErrorNone);
+    config.max_picture_width = width;
+    config.max_picture_height = height;
+    config.max_bit_depth = bit_depth > 8 ? EB_TEN_BIT : EB_EIGHT_BIT;
+    config.max_color_format = EB_YUV420;
+    if (pool) {
+        config.get_frame_buffer = get_frame_buffer;
+        config.release_frame_buffer = release_frame_buffer;
+        config.frame_buffer_priv = pool;
+    }
+    ASSERT_EQ(svt_av1_dec_set_parameter(*handle, &config), EB_ErrorNone);
+    ASSERT_EQ(svt_av1_dec_init(*handle), EB_ErrorNone);
+}
+
+/** Decodes units into planes allocated by the decoder */
+static void decode_copied(const vector<vector<uint8_t>> &units, uint32_t width,
+                          uint32_t height, uint32_t bit_depth,
+                          vector<vector<uint8_t>> &frames) {
+    EbComponentType *handle = nullptr;
+    ASSERT_NO_FATAL_FAILURE(
+        init_decoder(&handle, width, height, bit_depth, nullptr));
+
+    EbSvtIOFormat pic;
+    memset(&pic, 0, sizeof(pic));
+    pic.color_fmt = EB_YUV420;
+    EbBufferHeaderType buffer;
+    memset(&buffer, 0, sizeof(buffer));
+    buffer.p_buffer = (uint8_t *)&pic;
+
+    EbAV1StreamInfo stream_info;
+    EbAV1FrameInfo frame_info;
+    for (const vector<uint8_t> &unit : units) {
+        EXPECT_EQ(svt_av1_dec_frame(handle, unit.data(), unit.size(), 0),
+                  EB_ErrorNone);
+        while (svt_av1_dec_get_picture(
+                   handle, &buffer, &stream_info, &frame_info) ==
+               EB_ErrorNone)
+            frames.push_back(copy_luma(pic));
+    }
+    EXPECT_EQ(svt_av1_dec_deinit(handle), EB_ErrorNone);
+    EXPECT_EQ(svt_av1_dec_deinit_handle(handle), EB_ErrorNone);
+    free(pic.luma);
+    free(pic.cb);
+    free(pic.cr);
+}
+
+/**
+ * @brief SVT-AV1 decoder E2E test of the external frame buffer callbacks
+ *
+ * Test strategy:
+ * Encode the test vectors and save the bitstream. Decode it with planes
+ * allocated by the decoder, then with get_frame_buffer and
+ * release_frame_buffer set. Hold every picture returned by reference until
+ * the decoder refuses the next one, then release the oldest with
+ * svt_av1_dec_release_picture().
+ *
+ * Expected result:
+ * A held picture still matches the picture decoded into the decoder planes
+ * when it is released. Once a picture is refused, svt_av1_dec_frame()
+ * returns EB_ErrorInsufficientResources until it is obtained, and no
+ * picture is lost. Every buffer obtained through get_frame_buffer is handed
+ * back once through release_frame_buffer by the end of svt_av1_dec_deinit().
+ *
+ * Test coverage:
+ * Default test vectors
+ */
+class ExtFrameBufTest : public SvtAv1E2ETestFramework {
+  protected:
+    void config_test() override {
+        enable_save_bitstream = true;
+        enable_config = true;
+        SvtAv1E2ETestFramework::config_test();
+    }
+
+    void run_ext_frame_buf_test() {
+        config_test();
+        for (auto test_vector : enc_setting.test_vectors) {
+            init_test(test_vector);
+            ASSERT_NO_FATAL_FAILURE(run_encode_process());
+            ASSERT_NE(output_file_, nullptr);
+            fflush(output_file_->file);
+            check_ext_frame_buf(std::get<0>(test_vector) + ".ivf",
+                                std::get<3>(test_vector),
+                                std::get<4>(test_vector),
+                                std::get<5>(test_vector));
+            deinit_test();
+        }
+    }
+
+    void check_ext_frame_buf(const string &path, uint32_t width,
+                             uint32_t height, uint32_t bit_depth) {
+        vector<vector<uint8_t>> units;
+        ASSERT_TRUE(read_ivf_units(path, units)) << "can not read " << path;
+        ASSERT_NO_FATAL_FAILURE(
+            decode_copied(units, width, height, bit_depth, copied_));
+        ASSERT_FALSE(copied_.empty());
+
+        ExtBufPool pool;
+        pool.alloc_count = 0;
+        pool.release_count = 0;
+        pool.unknown_release = false;
+        EbComponentType *handle = nullptr;
+        ASSERT_NO_FATAL_FAILURE(
+            init_decoder(&handle, width, height, bit_depth, &pool));
+        decode_held(handle, units);
+        // a picture refused after the last unit comes once one is released
+        while (!held_.empty()) {
+            release_oldest(handle);
+            get_pictures(handle);
+        }
+        EXPECT_EQ(svt_av1_dec_deinit(handle), EB_ErrorNone);
+        EXPECT_EQ(svt_av1_dec_deinit_handle(handle), EB_ErrorNone);
+
+        EXPECT_EQ(output_count_, copied_.size());
+        EXPECT_GT(refusal_count_, 0u);
+        EXPECT_GT(pool.alloc_count, 0u);
+        EXPECT_EQ(pool.alloc_count, pool.release_count);
+        EXPECT_TRUE(pool.live.empty());
+        EXPECT_FALSE(pool.unknown_release);
+        copied_.clear();
+        output_count_ = 0;
+        refusal_count_ = 0;
+    }
+
+  private:
+    void decode_held(EbComponentType *handle,
+                     const vector<vector<uint8_t>> &units) {
+        for (const vector<uint8_t> &unit : units) {
+            EbErrorType err;
+            while ((err = svt_av1_dec_frame(
+                        handle, unit.data(), unit.size(), 0)) ==
+                   EB_ErrorInsufficientResources) {
+                // only a refused picture blocks the decoding
+                ASSERT_TRUE(refused_);
+                ASSERT_EQ(held_.size(), max_held_pictures);
+                refusal_count_++;
+                release_oldest(handle);
+                ASSERT_NO_FATAL_FAILURE(get_pictures(handle));
+                ASSERT_FALSE(refused_);
+            }
+            ASSERT_EQ(err, EB_ErrorNone);
+            ASSERT_NO_FATAL_FAILURE(get_pictures(handle));
+        }
+    }
+
+    void get_pictures(EbComponentType *handle) {
+        EbAV1StreamInfo stream_info;
+        EbAV1FrameInfo frame_info;
+        for (;;) {
+            held_.push_back(HeldPicture());
+            HeldPicture &held = held_.back();
+            memset(&held.header, 0, sizeof(held.header));
+            memset(&held.pic, 0, sizeof(held.pic));
+            held.header.p_buffer = (uint8_t *)&held.pic;
+            held.index = output_count_;
+            const EbErrorType err = svt_av1_dec_get_picture(
+                handle, &held.header, &stream_info, &frame_info);
+            if (err != EB_ErrorNone) {
+                held_.pop_back();
+                if (err == EB_ErrorInsufficientResources) {
+                    ASSERT_EQ(held_.size(), max_held_pictures);
+                    refused_ = true;
+                } else
+                    ASSERT_EQ(err, EB_DecNoOutputPicture);
+                return;
+            }
+            ASSERT_NE(held.header.wrapper_ptr, nullptr);
+            ASSERT_LT(output_count_, copied_.size());
+            refused_ = false;
+            output_count_++;
+        }
+    }
+
+    void release_oldest(EbComponentType *handle) {
+        HeldPicture &held = held_.front();
+        EXPECT_EQ(held.pic.width * held.pic.height *
+                      (held.pic.bit_depth == EB_EIGHT_BIT ? 1 : 2),
+                  copied_[held.index].size());
+        EXPECT_TRUE(copy_luma(held.pic) == copied_[held.index])
+            << "picture " << held.index << " changed while held";
+        EXPECT_EQ(svt_av1_dec_release_picture(handle, &held.header),
+                  EB_ErrorNone);
+        // a picture is released once
+        EXPECT_EQ(svt_av1_dec_release_picture(handle, &held.header),
+                  EB_ErrorBadParameter);
+        held_.pop_front();
+    }
+
+    vector<vector<uint8_t>> copied_; /**< pictures decoded into own planes */
+    std::list<HeldPicture> held_;    /**< pictures held, oldest first */
+    size_t output_count_ = 0;        /**< pictures returned by reference */
+    uint32_t refusal_count_ = 0;     /**< svt_av1_dec_frame() refusals */
+    bool refused_ = false;           /**< last picture was refused */
+};
+
+TEST_P(ExtFrameBufTest, HoldAndReleasePictures) {
+    run_ext_frame_buf_test();
+}
+
+static const std::vector<EncTestSetting> ext_frame_buf_settings = {
+    {"ExtFrameBufTest1", {}, default_test_vectors},
+};
+
+INSTANTIATE_TEST_CASE_P(SvtAv1, ExtFrameBufTest,
+                        ::testing::ValuesIn(ext_frame_buf_settings),
+                        EncTestSetting::GetSettingName);
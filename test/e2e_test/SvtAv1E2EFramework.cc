@@ -581,6 +581,30 @@ static void write_ivf_frame_header(
         fwrite(header, 1, IVF_FRAME_HEADER_SIZE, ivf->file);
 }
 
+bool SvtAv1E2ETestFramework::read_ivf_units(
+    const std::string &path, std::vector<std::vector<uint8_t>> &units) {
+    FILE *file = nullptr;
+    FOPEN(file, path.c_str(), "rb");
+    if (!file)
+        return false;
+    uint8_t header[IVF_STREAM_HEADER_SIZE];
+    bool ok = fread(header, 1, IVF_STREAM_HEADER_SIZE, file) ==
+                  IVF_STREAM_HEADER_SIZE &&
+              !memcmp(header, "DKIF", 4);
+    uint8_t frame_header[IVF_FRAME_HEADER_SIZE];
+    while (ok && fread(frame_header, 1, IVF_FRAME_HEADER_SIZE, file) ==
+                     IVF_FRAME_HEADER_SIZE) {
+        const uint32_t size = frame_header[0] | (frame_header[1] << 8) |
+                              (frame_header[2] << 16) |
+                              ((uint32_t)frame_header[3] << 24);
+        std::vector<uint8_t> unit(size);
+        ok = fread(unit.data(), 1, size, file) == size;
+        units.push_back(unit);
+    }
+    fclose(file);
+    return ok && !units.empty();
+}
+
 void SvtAv1E2ETestFramework::write_compress_data(
     const EbBufferHeaderType *output) {
     write_ivf_frame_header(output_file_, output->n_filled_len);
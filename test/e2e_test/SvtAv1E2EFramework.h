@@ -134,6 +134,12 @@ class SvtAv1E2ETestFramework : public ::testing::TestWithParam<EncTestSetting> {
      * into decoder */
     static void get_recon_frame(const SvtAv1Context &ctxt, FrameQueue *recon,
                                 bool &is_eos);
+    /** read the frames of an ivf file saved with enable_save_bitstream
+     * @param path  path of the ivf file
+     * @param units  payload of each ivf frame, one temporal unit each
+     * @return true if the file holds at least one complete frame */
+    static bool read_ivf_units(const std::string &path,
+                               std::vector<std::vector<uint8_t>> &units);
 
   private:
     /** write ivf header to output file */
@@ -0,0 +1,196 @@
+/*
+ * Copyright(c) 2019 Netflix, Inc.
+ * SPDX - License - Identifier: BSD - 2 - Clause - Patent
+ */
+
+/******************************************************************************
+ * @file SvtAv1E2ERoiDecodeTest.cc
+ *
+ * @brief SVT-AV1 decoder region of interest E2E test
+ *
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "EbSvtAv1Enc.h"
+#include "EbSvtAv1Dec.h"
+#include "gtest/gtest.h"
+#include "SvtAv1E2EFramework.h"
+
+using namespace svt_av1_e2e_test;
+using namespace svt_av1_e2e_test_vector;
+using std::string;
+using std::vector;
+
+/** Luma plane, stored width samples apart, and region of interest report of
+ * a decoded picture */
+typedef struct RoiDecodedFrame {
+    vector<uint8_t> luma;
+    uint32_t sample_size;
+    EbAV1FrameInfo info;
+} RoiDecodedFrame;
+
+/** Decodes units with the SVT-AV1 decoder, optionally restricted to roi. The
+ * output planes are allocated by the decoder */
+static void decode_units(const vector<vector<uint8_t>> &units, uint32_t width,
+                         uint32_t height, uint32_t bit_depth, uint32_t threads,
+                         const EbSvtAv1DecRoi *roi,
+                         vector<RoiDecodedFrame> &frames) {
+    EbComponentType *handle = nullptr;
+    EbSvtAv1DecConfiguration config;
+    ASSERT_EQ(svt_av1_dec_init_handle(&handle, nullptr, &config),
+              EB_ErrorNone);
+    config.max_picture_width = width;
+    config.max_picture_height = height;
+    config.max_bit_depth = bit_depth > 8 ? EB_TEN_BIT : EB_EIGHT_BIT;
+    config.max_color_format = EB_YUV420;
+    config.threads = threads;
+    ASSERT_EQ(svt_av1_dec_set_parameter(handle, &config), EB_ErrorNone);
+    ASSERT_EQ(svt_av1_dec_init(handle), EB_ErrorNone);
+    if (roi) {
+        ASSERT_EQ(svt_av1_dec_set_roi(handle, roi), EB_ErrorNone);
+    }
+
+    EbSvtIOFormat pic;
+    memset(&pic, 0, sizeof(pic));
+    pic.color_fmt = EB_YUV420;
+    EbBufferHeaderType buffer;
+    memset(&buffer, 0, sizeof(buffer));
+    buffer.p_buffer = (uint8_t *)&pic;
+
+    EbAV1StreamInfo stream_info;
+    EbAV1FrameInfo frame_info;
+    for (const vector<uint8_t> &unit : units) {
+        EXPECT_EQ(svt_av1_dec_frame(handle, unit.data(), unit.size(), 0),
+                  EB_ErrorNone);
+        while (svt_av1_dec_get_picture(
+                   handle, &buffer, &stream_info, &frame_info) ==
+               EB_ErrorNone) {
+            EXPECT_EQ(pic.width, width);
+            EXPECT_EQ(pic.height, height);
+            RoiDecodedFrame frame;
+            frame.sample_size = pic.bit_depth == EB_EIGHT_BIT ? 1 : 2;
+            frame.info = frame_info;
+            const uint32_t row_size = pic.width * frame.sample_size;
+            frame.luma.resize(row_size * pic.height);
+            for (uint32_t y = 0; y < pic.height; y++)
+                memcpy(&frame.luma[y * row_size],
+                       pic.luma + y * pic.y_stride * frame.sample_size,
+                       row_size);
+            frames.push_back(frame);
+        }
+    }
+    EXPECT_EQ(svt_av1_dec_deinit(handle), EB_ErrorNone);
+    EXPECT_EQ(svt_av1_dec_deinit_handle(handle), EB_ErrorNone);
+    free(pic.luma);
+    free(pic.cb);
+    free(pic.cr);
+}
+
+/**
+ * @brief SVT-AV1 decoder E2E test of region of interest decoding
+ *
+ * Test strategy:
+ * Encode the test vectors with 4x2 tiles and save the bitstream. Decode it
+ * in full and with a region of interest in the top left quarter, which
+ * leaves tiles unreconstructed, with 1 and 4 threads.
+ *
+ * Expected result:
+ * Both decodes output the same number of pictures. The area reported in
+ * EbAV1FrameInfo is not empty and narrower than the picture for the first
+ * picture, and matches the full decode for every picture that does not
+ * report roi_ref_missing.
+ *
+ * Test coverage:
+ * Default test vectors
+ */
+class RoiDecodeTest : public SvtAv1E2ETestFramework {
+  protected:
+    void config_test() override {
+        enable_save_bitstream = true;
+        enable_config = true;
+        SvtAv1E2ETestFramework::config_test();
+    }
+
+    void run_roi_test() {
+        config_test();
+        for (auto test_vector : enc_setting.test_vectors) {
+            init_test(test_vector);
+            ASSERT_NO_FATAL_FAILURE(run_encode_process());
+            ASSERT_NE(output_file_, nullptr);
+            fflush(output_file_->file);
+            check_roi_decode(std::get<0>(test_vector) + ".ivf",
+                             std::get<3>(test_vector),
+                             std::get<4>(test_vector),
+                             std::get<5>(test_vector));
+            deinit_test();
+        }
+    }
+
+    void check_roi_decode(const string &path, uint32_t width, uint32_t height,
+                          uint32_t bit_depth) {
+        vector<vector<uint8_t>> units;
+        ASSERT_TRUE(read_ivf_units(path, units)) << "can not read " << path;
+
+        vector<RoiDecodedFrame> full;
+        ASSERT_NO_FATAL_FAILURE(
+            decode_units(units, width, height, bit_depth, 1, nullptr, full));
+        EbSvtAv1DecRoi roi = {0, 0, width / 4, height / 4, 64};
+        for (uint32_t threads : {1u, 4u}) {
+            vector<RoiDecodedFrame> part;
+            ASSERT_NO_FATAL_FAILURE(decode_units(
+                units, width, height, bit_depth, threads, &roi, part));
+            ASSERT_NO_FATAL_FAILURE(check_roi_frames(full, part, width, height))
+                << "threads " << threads;
+        }
+    }
+
+    void check_roi_frames(const vector<RoiDecodedFrame> &full,
+                          const vector<RoiDecodedFrame> &part, uint32_t width,
+                          uint32_t height) {
+        ASSERT_EQ(full.size(), part.size());
+        ASSERT_FALSE(part.empty());
+        // the tiles right of the region are not reconstructed
+        EXPECT_GT(part[0].info.roi_width, 0u);
+        EXPECT_LT(part[0].info.roi_width, width);
+        EXPECT_GT(part[0].info.roi_height, 0u);
+        EXPECT_EQ(part[0].info.roi_ref_missing, EB_FALSE);
+
+        for (size_t i = 0; i < part.size(); i++) {
+            const EbAV1FrameInfo &info = part[i].info;
+            if (info.roi_ref_missing) {
+                continue;
+            }
+            ASSERT_LE(info.roi_x + info.roi_width, width);
+            ASSERT_LE(info.roi_y + info.roi_height, height);
+            ASSERT_EQ(full[i].sample_size, part[i].sample_size);
+            const uint32_t row_size = info.roi_width * part[i].sample_size;
+            for (uint32_t y = info.roi_y; y < info.roi_y + info.roi_height;
+                 y++) {
+                const size_t offset =
+                    (y * width + info.roi_x) * part[i].sample_size;
+                ASSERT_EQ(memcmp(&full[i].luma[offset],
+                                 &part[i].luma[offset],
+                                 row_size),
+                          0)
+                    << "picture " << i << " differs at row " << y;
+            }
+        }
+    }
+};
+
+TEST_P(RoiDecodeTest, MatchFullDecode) {
+    run_roi_test();
+}
+
+static const std::vector<EncTestSetting> roi_decode_settings = {
+    {"RoiDecodeTest1",
+     {{"TileCol", "2"}, {"TileRow", "1"}},
+     default_test_vectors},
+};
+
+INSTANTIATE_TEST_CASE_P(SvtAv1, RoiDecodeTest,
+                        ::testing::ValuesIn(roi_decode_settings),
+                        EncTestSetting::GetSettingName);
@@ -482,6 +482,147 @@ INSTANTIATE_TEST_CASE_P(
     ::testing::Combine(::testing::Values(eb_apply_selfguided_restoration_avx2),
                        ::testing::ValuesIn(highbd_params_avx2)));
 
+#if SGR_INTEGRAL_CACHE
+typedef void (*SgrIntegralFunc)(const uint8_t *dgd8, int32_t width,
+                                int32_t height, int32_t dgd_stride, int32_t *ii,
+                                int32_t highbd);
+typedef void (*SgrFromIIFunc)(const uint8_t *dgd8, int32_t width,
+                              int32_t height, int32_t dgd_stride,
+                              const int32_t *ii, int32_t *flt0, int32_t *flt1,
+                              int32_t flt_stride, int32_t sgr_params_idx,
+                              int32_t bit_depth, int32_t highbd);
+
+// Test parameter list:
+//  <integral images, filter from integral images, bit_depth, highbd>
+typedef tuple<SgrIntegralFunc, SgrFromIIFunc, int32_t, int32_t>
+    SgrIntegralTestParam;
+
+// The filter outputs built from cached integral images must match
+// eb_av1_selfguided_restoration_c() for every parameter set.
+class AV1SelfguidedIntegralTest
+    : public ::testing::TestWithParam<SgrIntegralTestParam> {
+  public:
+    virtual ~AV1SelfguidedIntegralTest() {
+    }
+    virtual void SetUp() {
+    }
+
+    virtual void TearDown() {
+        aom_clear_system_state();
+    }
+
+  protected:
+    void RunCorrectnessTest() {
+        SgrIntegralFunc integral_fun = TEST_GET_PARAM(0);
+        SgrFromIIFunc from_ii_fun = TEST_GET_PARAM(1);
+        const int32_t bit_depth = TEST_GET_PARAM(2);
+        const int32_t highbd = TEST_GET_PARAM(3);
+        const int32_t mask = (1 << bit_depth) - 1;
+        const int32_t stride = 128, flt_stride = 72;
+        const int NUM_ITERS = 20;
+
+        uint16_t *input16_ =
+            (uint16_t *)eb_aom_memalign(32, stride * 96 * sizeof(uint16_t));
+        uint8_t *input8_ =
+            (uint8_t *)eb_aom_memalign(32, stride * 96 * sizeof(uint8_t));
+        int32_t *ii = (int32_t *)eb_aom_memalign(
+            32, SGRPROJ_II_SIZE * sizeof(int32_t));
+        int32_t *flt_ref = (int32_t *)eb_aom_memalign(
+            32, 2 * flt_stride * 64 * sizeof(int32_t));
+        int32_t *flt_tst = (int32_t *)eb_aom_memalign(
+            32, 2 * flt_stride * 64 * sizeof(int32_t));
+        uint16_t *input16 = input16_ + stride * 16 + 16;
+        uint8_t *input8 = input8_ + stride * 16 + 16;
+        const uint8_t *dgd =
+            highbd ? CONVERT_TO_BYTEPTR(input16) : (const uint8_t *)input8;
+
+        ACMRandom rnd(ACMRandom::DeterministicSeed());
+
+        for (int i = 0; i < NUM_ITERS; ++i) {
+            // Alternate noise and smooth content, which saturate differently
+            for (int j = 0; j < stride * 96; ++j) {
+                input16_[j] = (i & 1) ? (rnd.Rand16() & mask)
+                                      : ((j % stride) * 3 + (j / stride)) & mask;
+                input8_[j] = (uint8_t)(input16_[j] & 0xFF);
+            }
+            // Full and partial processing units
+            const int32_t w = i < 2 ? 64 : 1 + rnd.PseudoUniform(64);
+            const int32_t h = i < 2 ? 64 : 1 + rnd.PseudoUniform(64);
+
+            integral_fun(dgd, w, h, stride, ii, highbd);
+            for (int32_t ep = 0; ep < SGRPROJ_PARAMS; ++ep) {
+                const SgrParamsType *const params = &eb_sgr_params[ep];
+                eb_av1_selfguided_restoration_c(dgd,
+                                                w,
+                                                h,
+                                                stride,
+                                                flt_ref,
+                                                flt_ref + flt_stride * 64,
+                                                flt_stride,
+                                                ep,
+                                                bit_depth,
+                                                highbd);
+                from_ii_fun(dgd,
+                            w,
+                            h,
+                            stride,
+                            ii,
+                            flt_tst,
+                            flt_tst + flt_stride * 64,
+                            flt_stride,
+                            ep,
+                            bit_depth,
+                            highbd);
+                for (int32_t f = 0; f < 2; ++f) {
+                    if (params->r[f] == 0)
+                        continue;
+                    for (int32_t y = 0; y < h; ++y)
+                        for (int32_t x = 0; x < w; ++x) {
+                            const int32_t idx =
+                                f * flt_stride * 64 + y * flt_stride + x;
+                            ASSERT_EQ(flt_ref[idx], flt_tst[idx])
+                                << "ep " << ep << " filter " << f << " w " << w
+                                << " h " << h << " (" << x << ", " << y << ")";
+                        }
+                }
+            }
+        }
+
+        eb_aom_free(input16_);
+        eb_aom_free(input8_);
+        eb_aom_free(ii);
+        eb_aom_free(flt_ref);
+        eb_aom_free(flt_tst);
+    }
+};
+
+TEST_P(AV1SelfguidedIntegralTest, CorrectnessTest) {
+    RunCorrectnessTest();
+}
+
+INSTANTIATE_TEST_CASE_P(
+    C, AV1SelfguidedIntegralTest,
+    ::testing::Values(make_tuple(eb_av1_sgr_integral_images_c,
+                                 eb_av1_selfguided_restoration_from_ii_c, 8, 0),
+                      make_tuple(eb_av1_sgr_integral_images_c,
+                                 eb_av1_selfguided_restoration_from_ii_c, 10, 1),
+                      make_tuple(eb_av1_sgr_integral_images_c,
+                                 eb_av1_selfguided_restoration_from_ii_c, 12,
+                                 1)));
+
+INSTANTIATE_TEST_CASE_P(
+    AVX2, AV1SelfguidedIntegralTest,
+    ::testing::Values(
+        make_tuple(eb_av1_sgr_integral_images_avx2,
+                   eb_av1_selfguided_restoration_from_ii_avx2, 8, 0),
+        make_tuple(eb_av1_sgr_integral_images_avx2,
+                   eb_av1_selfguided_restoration_from_ii_avx2, 8, 1),
+        make_tuple(eb_av1_sgr_integral_images_avx2,
+                   eb_av1_selfguided_restoration_from_ii_avx2, 10, 1),
+        make_tuple(eb_av1_sgr_integral_images_avx2,
+                   eb_av1_selfguided_restoration_from_ii_avx2, 12, 1)));
+#endif
+
 #if 0
 // To test integral_images() and integral_images_highbd(), make them not static,
 // and add declarations to header file.